@@ -13,12 +13,34 @@ int main(int argc, char **argv)
     GLcanvas gui;
     gui.push(&m);
 
-    AO_data data;
-    ambient_occlusion(m,data);
-    m.updateGL();
+    // AO is refined progressively, a little at each frame, while the
+    // mesh is already on screen (see ambient_occlusion.h for details)
+    AO_progressive ao;
+    ambient_occlusion_init(m,ao);
+    gui.lazy_polling = false; // keep redrawing until AO has converged
+
+    gui.callback_frame = [&]()
+    {
+        if(gui.lazy_polling) return;
+        gui.lazy_polling = ambient_occlusion_refine(ao,20000);
+        ambient_occlusion_apply(m,ao);
+
+        // the AO of a vertex is averaged over its incident polys, hence
+        // the colors of all the polys around the refined ones change
+        std::vector<uint> pids;
+        for(uint pid : ao.updated)
+        for(uint vid : m.adj_p2v(pid))
+        for(uint nbr : m.adj_v2p(vid))
+        {
+            pids.push_back(nbr);
+        }
+        REMOVE_DUPLICATES_FROM_VEC(pids);
+        m.updateGL_polys(pids, RENDER_TRI_COLORS);
+    };
 
     gui.callback_app_controls = [&]()
     {
+        ImGui::Text("Rays: %llu", static_cast<unsigned long long>(ao.tot_rays));
         if(ImGui::SliderFloat("AO", &m.AO_alpha, 0.f, 1.f))
         {
             m.updateGL();
@@ -0,0 +1,326 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/3d_printing/build_dir_analyzer.h>
+#include <cinolib/Moller_Trumbore_intersection.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/vector_serialization.h>
+#include <cinolib/deg_rad.h>
+#include <algorithm>
+#include <cmath>
+
+namespace cinolib
+{
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+BuildDirAnalyzer::BuildDirAnalyzer(const Trimesh<M,V,E,P> & m)
+{
+    c     = m.centroid();
+    verts = m.vector_verts();
+    tris  = serialized_vids_from_polys(m.vector_polys());
+
+    normals.resize(m.num_polys());
+    centers.resize(m.num_polys());
+    areas.resize(m.num_polys());
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](const uint pid)
+    {
+        vec3d n = m.poly_data(pid).normal;
+        n.normalize();
+        normals.at(pid) = n;
+        centers.at(pid) = m.poly_centroid(pid);
+        areas.at(pid)   = m.poly_area(pid);
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+float BuildDirAnalyzer::height(const vec3d & build_dir, float & floor) const
+{
+    // same arithmetic of height_along_build_dir
+    float min =  inf_float;
+    float max = -inf_float;
+    for(const vec3d & p : verts)
+    {
+        float h = (float)(p - c).dot(build_dir);
+        min = std::min(min, h);
+        max = std::max(max, h);
+    }
+    floor = min;
+    return max - min;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BuildDirAnalyzer::hanging(const vec3d & build_dir, const float thresh, std::vector<uint> & polys) const
+{
+    // angle(build_dir,n) - 90 > thresh  <=>  cos(angle) < cos(90 + thresh)
+    double cos_max = std::cos(to_rad(90.0 + thresh));
+    polys.clear();
+    for(uint pid=0; pid<normals.size(); ++pid)
+    {
+        const vec3d & n = normals[pid];
+        double dot = n.dot(build_dir);
+        // degenerate normals have infinite angle in overhangs(), and are therefore hanging
+        if(dot < cos_max || n.is_deg()) polys.push_back(pid);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BuildDirAnalyzer::cast(const vec3d & build_dir, Scratch & s) const
+{
+    uint nh = s.hanging.size();
+    s.pairs.resize(nh);
+    if(nh==0) return;
+
+    // orthonormal frame (u,w) for the plane orthogonal to the build direction
+    vec3d u = (std::fabs(build_dir.x()) < 0.9) ? vec3d(1,0,0) : vec3d(0,1,0);
+    u = build_dir.cross(u);
+    u.normalize();
+    vec3d w = build_dir.cross(u);
+
+    // projected bbox of each triangle
+    uint nv = verts.size();
+    uint nt = normals.size();
+    s.proj.resize(2*nv);
+    for(uint vid=0; vid<nv; ++vid)
+    {
+        s.proj[2*vid  ] = verts[vid].dot(u);
+        s.proj[2*vid+1] = verts[vid].dot(w);
+    }
+    double extent = 0;
+    s.boxes.resize(4*nt);
+    for(uint tid=0; tid<nt; ++tid)
+    {
+        const uint * t = &tris[3*tid];
+        double     * b = &s.boxes[4*tid];
+        for(int i=0; i<2; ++i)
+        {
+            b[i  ] = std::min(s.proj[2*t[0]+i], std::min(s.proj[2*t[1]+i], s.proj[2*t[2]+i]));
+            b[i+2] = std::max(s.proj[2*t[0]+i], std::max(s.proj[2*t[1]+i], s.proj[2*t[2]+i]));
+            extent += b[i+2] - b[i];
+        }
+    }
+    extent /= 2*nt;
+
+    // the grid only covers the footprint of the overhangs (i.e. the origins of the rays)
+    double min[2] = {  inf_double,  inf_double };
+    double max[2] = { -inf_double, -inf_double };
+    s.rays.resize(2*nh);
+    for(uint i=0; i<nh; ++i)
+    {
+        const vec3d & o = centers[s.hanging[i]];
+        double * q = &s.rays[2*i];
+        q[0] = o.dot(u);
+        q[1] = o.dot(w);
+        for(int k=0; k<2; ++k)
+        {
+            min[k] = std::min(min[k], q[k]);
+            max[k] = std::max(max[k], q[k]);
+        }
+    }
+    double diag = std::max(max[0]-min[0], max[1]-min[1]);
+    double eps  = std::max(1e-9, 1e-6*diag); // conservative binning
+    for(int k=0; k<2; ++k)
+    {
+        min[k] -= eps;
+        max[k] += eps;
+    }
+
+    // aim for a number of cells in the order of the number of triangles, but
+    // avoid cells much smaller than triangles, which would be binned many times
+    double area   = (max[0]-min[0])*(max[1]-min[1]);
+    double cell   = std::max(extent, std::sqrt(area/nt));
+    int    res[2] = { std::max(1, std::min(4096, int((max[0]-min[0])/cell))),
+                      std::max(1, std::min(4096, int((max[1]-min[1])/cell))) };
+    double inv[2] = { res[0]/(max[0]-min[0]), res[1]/(max[1]-min[1]) };
+
+    auto cell_range = [&](const double * b, int r[]) -> bool
+    {
+        for(int k=0; k<2; ++k)
+        {
+            if(b[k+2]+eps<min[k] || b[k]-eps>max[k]) return false;
+            r[2*k  ] = std::max(0,        int((b[k  ]-eps-min[k])*inv[k]));
+            r[2*k+1] = std::min(res[k]-1, int((b[k+2]+eps-min[k])*inv[k]));
+        }
+        return true;
+    };
+
+    // bin triangles (counting sort)
+    s.cell_beg.assign(res[0]*res[1]+1, 0);
+    for(uint tid=0; tid<nt; ++tid)
+    {
+        int r[4];
+        if(!cell_range(&s.boxes[4*tid], r)) continue;
+        for(int y=r[2]; y<=r[3]; ++y)
+        for(int x=r[0]; x<=r[1]; ++x) ++s.cell_beg[y*res[0]+x+1];
+    }
+    for(uint i=1; i<s.cell_beg.size(); ++i) s.cell_beg[i] += s.cell_beg[i-1];
+    s.cell_tris.resize(s.cell_beg.back());
+    for(uint tid=0; tid<nt; ++tid)
+    {
+        int r[4];
+        if(!cell_range(&s.boxes[4*tid], r)) continue;
+        for(int y=r[2]; y<=r[3]; ++y)
+        for(int x=r[0]; x<=r[1]; ++x) s.cell_tris[s.cell_beg[y*res[0]+x]++] = tid;
+    }
+    for(uint i=s.cell_beg.size()-1; i>0; --i) s.cell_beg[i] = s.cell_beg[i-1];
+    s.cell_beg[0] = 0;
+
+    // rays are processed cell by cell, so that rays in the same batch test the same triangles
+    s.order.resize(nh);
+    for(uint i=0; i<nh; ++i)
+    {
+        int x = std::max(0, std::min(res[0]-1, int((s.rays[2*i  ]-min[0])*inv[0])));
+        int y = std::max(0, std::min(res[1]-1, int((s.rays[2*i+1]-min[1])*inv[1])));
+        s.order[i] = std::make_pair(uint(y*res[0]+x), i);
+    }
+    std::sort(s.order.begin(), s.order.end());
+
+    // cast one ray from the center of each overhang, against the build direction
+    vec3d dir = -build_dir;
+    for(const auto & r : s.order)
+    {
+        uint           pid = s.hanging[r.second];
+        const vec3d  & o   = centers[pid];
+        const double * q   = &s.rays[2*r.second];
+
+        // keeps the two closest hits, with the same ordering of the hit
+        // set used in overhangs(). The first hit is skipped if it is the
+        // starting triangle itself
+        std::pair<double,uint> hit[2] = { {inf_double,0}, {inf_double,0} };
+        for(uint i=s.cell_beg[r.first]; i<s.cell_beg[r.first+1]; ++i)
+        {
+            uint tid = s.cell_tris[i];
+            const double * b = &s.boxes[4*tid];
+            if(q[0]<b[0]-eps || q[1]<b[1]-eps || q[0]>b[2]+eps || q[1]>b[3]+eps) continue;
+
+            const uint * t = &tris[3*tid];
+            bool   backside, coplanar;
+            double t_hit;
+            vec3d  bary;
+            if(Moller_Trumbore_intersection(o, dir, verts[t[0]], verts[t[1]], verts[t[2]], backside, coplanar, t_hit, bary) && t_hit>=0)
+            {
+                auto h = std::make_pair(t_hit,tid);
+                if(h<hit[0])      { hit[1] = hit[0]; hit[0] = h; }
+                else if(h<hit[1]) { hit[1] = h; }
+            }
+        }
+        auto pair = std::make_pair(pid,pid);
+        int  i    = (hit[0].first<inf_double && hit[0].second==pid) ? 1 : 0;
+        if(hit[i].first<inf_double) pair.second = hit[i].second;
+        s.pairs[r.second] = pair;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BuildDirAnalyzer::overhangs(const vec3d                             & build_dir,
+                                 const float                               thresh,
+                                       std::vector<std::pair<uint,uint>> & polys_hanging) const
+{
+    thread_local Scratch s;
+    hanging(build_dir, thresh, s.hanging);
+    cast(build_dir, s);
+    polys_hanging = s.pairs;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+BuildDirScore BuildDirAnalyzer::score(const vec3d             & build_dir,
+                                      const float               thresh,
+                                      const bool                with_supports,
+                                      const std::vector<bool> & crit_srf,
+                                      const float               crit_boost) const
+{
+    BuildDirScore score;
+    score.height = height(build_dir, score.floor);
+    if(!with_supports) return score;
+
+    thread_local Scratch s;
+    hanging(build_dir, thresh, s.hanging);
+    cast(build_dir, s);
+    score.n_overhangs = s.hanging.size();
+
+    // same arithmetic of supports_contact_area and supports_volume
+    score.contact_area = 0;
+    score.supp_volume  = 0;
+    for(const auto & o : s.pairs)
+    {
+        score.contact_area += areas[o.first];
+        if(o.second!=o.first) score.contact_area += areas[o.first];
+
+        float area  = areas[o.first];
+        float z_beg = (centers[o.first] - c).dot(build_dir);
+        float z_end = (o.first==o.second) ? score.floor : (centers[o.second] - c).dot(build_dir);
+        score.supp_volume += area* (z_beg - z_end);
+    }
+
+    // penalty for critical surfaces (see optimal_build_dir)
+    if(!crit_srf.empty())
+    {
+        for(const auto & o : s.pairs)
+        {
+            if(crit_srf.at(o.first)) score.contact_area += areas[o.first] * crit_boost;
+            if(o.second!=o.first && crit_srf.at(o.second)) score.contact_area += areas[o.second] * crit_boost;
+        }
+    }
+    return score;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+std::vector<BuildDirScore> BuildDirAnalyzer::score(const std::vector<vec3d> & build_dirs,
+                                                   const float                thresh,
+                                                   const bool                 with_supports,
+                                                   const std::vector<bool>  & crit_srf,
+                                                   const float                crit_boost) const
+{
+    std::vector<BuildDirScore> scores(build_dirs.size());
+    PARALLEL_FOR(0, build_dirs.size(), 1, [&](const uint i)
+    {
+        scores.at(i) = score(build_dirs.at(i), thresh, with_supports, crit_srf, crit_boost);
+    });
+    return scores;
+}
+
+}
@@ -0,0 +1,149 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_BUILD_DIR_ANALYZER_H
+#define CINO_BUILD_DIR_ANALYZER_H
+
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/min_max_inf.h>
+
+namespace cinolib
+{
+
+/* Batched evaluation of the per direction metrics used to search for the optimal
+ * build orientation (see optimal_build_dir). For each candidate build direction it
+ * computes the same quantities returned by
+ *
+ *     - height_along_build_dir
+ *     - overhangs (version with rays cast below each overhang)
+ *     - supports_contact_area
+ *     - supports_volume
+ *
+ * but everything that does not depend on the direction (vertices, normals, areas
+ * and centroids of triangles) is extracted from the mesh and cached only once, in
+ * flat arrays. Many directions can be scored at once, and are evaluated in parallel.
+ *
+ * Rays shot from the overhangs are all parallel to the build direction. Rather than
+ * traversing an octree ray by ray, the analyzer projects the triangles onto a plane
+ * orthogonal to the build direction and bins them in a 2D uniform grid restricted to
+ * the footprint of the overhangs. Each ray then only tests the triangles binned in
+ * its cell. Grid buffers are thread local and reused across directions, hence no
+ * memory is allocated once they reached their maximum size.
+ *
+ * Overhangs are detected by comparing the cosine between normal and build direction
+ * with the cosine of the threshold angle, which avoids the evaluation of an acos for
+ * each triangle. Results may therefore differ from overhangs() only for triangles
+ * whose angle is exactly at the threshold.
+*/
+
+struct BuildDirScore
+{
+    float height       = inf_float; // see height_along_build_dir
+    float floor        = inf_float; // lowest vertex projection along the build direction
+    float contact_area = inf_float; // see supports_contact_area (with boost for critical surfaces)
+    float supp_volume  = inf_float; // see supports_volume
+    uint  n_overhangs  = 0;         // number of overhanging triangles
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class BuildDirAnalyzer
+{
+    public:
+
+        template<class M, class V, class E, class P>
+        explicit BuildDirAnalyzer(const Trimesh<M,V,E,P> & m);
+
+        //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // Same output of overhangs(m,thresh,build_dir,polys_hanging), sorted by ID of
+        // the hanging triangle. Each pair contains the ID of a hanging triangle and the
+        // ID of the first triangle below it (or the hanging triangle itself, if none)
+        void overhangs(const vec3d                             & build_dir, // assumed to be unit length!
+                       const float                               thresh,    // degrees
+                             std::vector<std::pair<uint,uint>> & polys_hanging) const;
+
+        //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // If crit_srf is not empty it flags critical triangles. The area of critical triangles
+        // touched by supports is multiplied by crit_boost and added to the contact area.
+        // If with_supports is false, only height and floor are computed
+        BuildDirScore score(const vec3d             & build_dir, // assumed to be unit length!
+                            const float               thresh,    // degrees
+                            const bool                with_supports = true,
+                            const std::vector<bool> & crit_srf      = {},
+                            const float               crit_boost    = 0.f) const;
+
+        // scores all the input directions in parallel
+        std::vector<BuildDirScore> score(const std::vector<vec3d> & build_dirs, // assumed to be unit length!
+                                         const float                thresh,     // degrees
+                                         const bool                 with_supports = true,
+                                         const std::vector<bool>  & crit_srf      = {},
+                                         const float                crit_boost    = 0.f) const;
+
+    protected:
+
+        // per thread buffers, reused across directions
+        struct Scratch
+        {
+            std::vector<uint>                 hanging;   // overhanging triangles
+            std::vector<double>               proj;      // vertex projections on the plane orthogonal to the build dir (2 per vert)
+            std::vector<double>               boxes;     // projected bbox of each triangle (min_u, min_w, max_u, max_w)
+            std::vector<double>               rays;      // projected ray origins (2 per overhang)
+            std::vector<uint>                 cell_beg;  // uniform grid in CSR layout: triangles of cell c are
+            std::vector<uint>                 cell_tris; // cell_tris[cell_beg[c]] ... cell_tris[cell_beg[c+1]-1]
+            std::vector<std::pair<uint,uint>> order;     // (cell,overhang) pairs, sorted by cell
+            std::vector<std::pair<uint,uint>> pairs;     // output (see overhangs)
+        };
+
+        float height (const vec3d & build_dir, float & floor) const;
+        void  hanging(const vec3d & build_dir, const float thresh, std::vector<uint> & polys) const;
+        void  cast   (const vec3d & build_dir, Scratch & s) const;
+
+        vec3d               c;       // mesh centroid
+        std::vector<vec3d>  verts;   // mesh vertices
+        std::vector<uint>   tris;    // triangles (3 vids per triangle)
+        std::vector<vec3d>  normals; // per triangle unit normal
+        std::vector<vec3d>  centers; // per triangle centroid
+        std::vector<double> areas;   // per triangle area
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "build_dir_analyzer.cpp"
+#endif
+
+#endif // CINO_BUILD_DIR_ANALYZER_H
@@ -34,19 +34,17 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/3d_printing/optimal_build_dir.h>
-#include <cinolib/3d_printing/overhangs.h>
-#include <cinolib/3d_printing/height_along_build_dir.h>
-#include <cinolib/3d_printing/supports_contact_area.h>
-#include <cinolib/3d_printing/supports_volume.h>
+#include <cinolib/3d_printing/build_dir_analyzer.h>
 #include <cinolib/3d_printing/shadow_on_build_platform.h>
 #include <cinolib/sphere_coverage.h>
+#include <cinolib/parallel_for.h>
 
 namespace cinolib
 {
 
 template<class M, class V, class E, class P>
 CINO_INLINE
-vec3d optimal_build_dir(const DrawableTrimesh<M,V,E,P> & m,
+vec3d optimal_build_dir(const Trimesh<M,V,E,P>         & m,
                         const OptimalBuildDirOptions   & opt,
                               float                    & best_height,
                               float                    & best_shadow_area,
@@ -59,10 +57,14 @@ vec3d optimal_build_dir(const DrawableTrimesh<M,V,E,P> & m,
     sphere_coverage(opt.n_dirs, dirs);
 
     // cache everything that can be cached to speed up computation
-    GLFWwindow *GL_context = create_offline_GL_context(opt.buffer_size, opt.buffer_size);
-    u_int8_t   *data       = new u_int8_t[opt.buffer_size*opt.buffer_size];
-    Octree octree;
-    octree.build_from_mesh_polys(m);
+    BuildDirAnalyzer analyzer(m);
+    std::vector<bool> crit_srf;
+    if(!opt.crit_srf.empty())
+    {
+        crit_srf.resize(m.num_polys(), false);
+        for(uint pid : opt.crit_srf) crit_srf.at(pid) = true;
+    }
+    bool with_supports = (opt.w_support_contact>0 || opt.w_support_volume>0);
 
     // compute scores for all candidate directions. scores are stored separately because this will
     // allow to normalize them in the same range and combine them in a meaningful way...
@@ -72,56 +74,28 @@ vec3d optimal_build_dir(const DrawableTrimesh<M,V,E,P> & m,
     std::vector<float> c(opt.n_dirs, inf_float); // area of the contacts between model and supports
     std::vector<float> v(opt.n_dirs, inf_float); // volume of the supports
     //
-    for(uint i=0; i<opt.n_dirs; ++i)
+    PARALLEL_FOR(0, opt.n_dirs, 1, [&](uint i)
     {
-        bool skip = false;
         for(const vec3d & fd : opt.forb_dirs)
         {
-            if(fd.angle_deg(dirs[i])<opt.forb_cone_angle)
-            {
-                skip = true;
-                break;
-            }
+            if(fd.angle_deg(dirs[i])<opt.forb_cone_angle) return;
         }
-        if(skip) continue;
-
-        // NOTE: this call is 90% of the computational cost
-        std::vector<std::pair<uint,uint>> polys_hanging;
-        overhangs(m, opt.overhang_threshold, dirs[i], polys_hanging, octree);
 
+        // height, overhangs (with rays cast below them) and supports. The volume of supports
+        // is estimated assuming they expand from the overhang down to the floor, i.e. the
         // projection of the "lowest" mesh vertex along the build direction
-        // this is used further down to estimate the volume of support structures
-        // which are supposed to expand from the overhang down to the floor
-        float floor;
-
-        h[i] = (opt.w_height         >0) ? height_along_build_dir(m, dirs[i], floor) : 0.f;
-        a[i] = (opt.w_shadow_area    >0) ? shadow_on_build_platform(m, dirs[i], opt.buffer_size, data, GL_context) : 0.f;
-        c[i] = (opt.w_support_contact>0) ? supports_contact_area(m, polys_hanging) : 0.f;
-        v[i] = (opt.w_support_volume >0) ? supports_volume(m, dirs[i], floor, polys_hanging) : 0.f;
-
-        // add penalty for critical surfaces
-        if(opt.w_support_contact>0 &&
-           opt.crit_srf.size()  >0)
-        {
-            for(auto & ov : polys_hanging)
-            {
-                // scale overhang area
-                if(CONTAINS(opt.crit_srf,ov.first))
-                {
-                    c[i] += m.poly_area(ov.first) * opt.crit_srf_boost;
-                }
-                // scale area of poly vertically below overhang
-                if(ov.second!=ov.first && CONTAINS(opt.crit_srf,ov.second))
-                {
-                    c[i] += m.poly_area(ov.second) * opt.crit_srf_boost;
-                }
-            }
-        }
-    }
+        BuildDirScore s = analyzer.score(dirs[i], opt.overhang_threshold, with_supports, crit_srf, opt.crit_srf_boost);
+
+        // per thread rasterization buffer, reused across directions (cast_shadow_CPU
+        // clears it). Rasterization is serial, as directions are already processed in parallel
+        thread_local std::vector<uint8_t> data;
+        if(opt.w_shadow_area>0) data.resize(opt.buffer_size*opt.buffer_size);
 
-    // release memory
-    destroy_offline_GL_context(GL_context);
-    delete[] data;
+        h[i] = (opt.w_height         >0) ? s.height : 0.f;
+        a[i] = (opt.w_shadow_area    >0) ? shadow_on_build_platform_CPU(m, dirs[i], opt.buffer_size, data.data(), false) : 0.f;
+        c[i] = (opt.w_support_contact>0) ? s.contact_area : 0.f;
+        v[i] = (opt.w_support_volume >0) ? s.supp_volume  : 0.f;
+    });
 
     // normalize all scores in [0,1]
     auto h_minmax = std::minmax_element(h.begin(), h.end());
@@ -169,7 +143,7 @@ vec3d optimal_build_dir(const DrawableTrimesh<M,V,E,P> & m,
 
 template<class M, class V, class E, class P>
 CINO_INLINE
-vec3d optimal_build_dir(const DrawableTrimesh<M,V,E,P> & m,
+vec3d optimal_build_dir(const Trimesh<M,V,E,P>         & m,
                         const OptimalBuildDirOptions   & opt)
 {
     float best_height;
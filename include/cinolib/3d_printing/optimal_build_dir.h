@@ -36,7 +36,8 @@
 #ifndef CINO_OPTIMAL_BUILD_DIR_H
 #define CINO_OPTIMAL_BUILD_DIR_H
 
-#include <cinolib/meshes/drawable_trimesh.h>
+#include <cinolib/meshes/trimesh.h>
+#include <unordered_set>
 
 namespace cinolib
 {
@@ -70,6 +71,11 @@ namespace cinolib
  * falls within a forbidden cone will receive infinite energy and will therefore be
  * discarded.
  *
+ * Shadow area is computed with a software rasterizer (see cast_shadow_CPU), hence no
+ * GL context is needed and the method can run headless. Candidate directions are
+ * evaluated in parallel, each thread using its own rasterization buffer, and all
+ * sharing the same BuildDirAnalyzer for the remaining metrics (build_dir_analyzer.h).
+ *
  * Critical surfaces: users can indicate portions of the surface that are critical,
  * for example because they require higher finish than other parts. Critical surfaces
  * are passed in input in the form of a vector of triangle indices. When calculating
@@ -99,7 +105,7 @@ struct OptimalBuildDirOptions
 
 template<class M, class V, class E, class P>
 CINO_INLINE
-vec3d optimal_build_dir(const DrawableTrimesh<M,V,E,P> & m,
+vec3d optimal_build_dir(const Trimesh<M,V,E,P>         & m,
                         const OptimalBuildDirOptions   & opt,
                               float                    & best_height,
                               float                    & best_shadow_area,
@@ -110,7 +116,7 @@ vec3d optimal_build_dir(const DrawableTrimesh<M,V,E,P> & m,
 
 template<class M, class V, class E, class P>
 CINO_INLINE
-vec3d optimal_build_dir(const DrawableTrimesh<M,V,E,P> & m,
+vec3d optimal_build_dir(const Trimesh<M,V,E,P>         & m,
                         const OptimalBuildDirOptions   & opt);
 
 }
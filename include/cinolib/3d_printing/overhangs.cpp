@@ -81,15 +81,12 @@ void overhangs(const Trimesh<M,V,E,P>                  & m,
     {
         uint pid  = tmp[i];
         auto pair = std::make_pair(pid,pid);
-        std::set<std::pair<double,uint>> hits;
-        if(octree.intersects_ray(m.poly_centroid(pid), -build_dir, hits))
+        double t;
+        uint   hit;
+        // skip the starting polygon
+        if(octree.first_hit(m.poly_centroid(pid), -build_dir, 0, inf_double, [pid](uint id){ return id==pid; }, t, hit))
         {
-            auto hit = hits.begin();
-            if(hit->second==pid) ++hit; // skip the first hit, it's the starting polygon
-            if(hit!=hits.end())
-            {
-                pair.second = hit->second;
-            }
+            pair.second = hit;
         }
         // critical section
         {
@@ -34,12 +34,31 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/3d_printing/shadow_on_build_platform.h>
+#include <cinolib/cast_shadow_CPU.h>
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
 #include <cinolib/cast_shadow.h>
 #include <cinolib/gl/offline_gl_context.h>
+#endif
 
 namespace cinolib
 {
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+float shadow_on_build_platform_CPU(const Trimesh<M,V,E,P> & m,         //
+                                   const vec3d            & build_dir, //
+                                   const uint               img_size,  // buffer will be img_size x img_size
+                                         uint8_t          * data,      //
+                                   const bool               parallel)  // tiled parallel rasterization
+{
+    uint shadow_pixels = cast_shadow_CPU(m, build_dir, img_size, img_size, data, parallel);
+    return (float)shadow_pixels/(img_size*img_size);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 float shadow_on_build_platform(const DrawableTrimesh<M,V,E,P> & m,         //
@@ -77,4 +96,6 @@ float shadow_on_build_platform(const DrawableTrimesh<M,V,E,P> & m,          //
     return (float)shadow_pixels/(img_size*img_size);
 }
 
+#endif // CINOLIB_USES_OPENGL_GLFW_IMGUI
+
 }
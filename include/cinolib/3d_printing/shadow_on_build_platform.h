@@ -36,12 +36,35 @@
 #ifndef CINO_SHADOW_ON_BUILD_PLATFORM_H
 #define CINO_SHADOW_ON_BUILD_PLATFORM_H
 
+#include <cinolib/meshes/trimesh.h>
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
 #include <cinolib/meshes/drawable_trimesh.h>
 #include <cinolib/gl/gl_glfw.h>
+#endif
 
 namespace cinolib
 {
 
+/* Headless version of the methods below, which rasterizes the mesh on the
+ * CPU (see cast_shadow_CPU) and does not need any GL context. Since there is
+ * no GL state involved, it can be safely called from multiple threads (e.g.
+ * to evaluate many build directions at once), provided that each thread uses
+ * its own buffer. In that case, set parallel to false to avoid spawning nested
+ * threads for the tiled rasterization.
+*/
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+float shadow_on_build_platform_CPU(const Trimesh<M,V,E,P> & m,                //
+                                   const vec3d            & build_dir,        //
+                                   const uint               img_size,         // buffer will be img_size x img_size
+                                         uint8_t          * data,             //
+                                   const bool               parallel = true); // tiled parallel rasterization
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
+
 /* projects the mesh m onto the building platform using rasterization
  * on an offline GL buffer of size img_size x img_size. This can be
  * useful to aid packing methods that aim to optimally fill the building
@@ -70,7 +93,7 @@ float shadow_on_build_platform(const DrawableTrimesh<M,V,E,P> & m,           //
                                const uint                       img_size,    // frame buffer will be img_size x img_size
                                      u_int8_t                 * data,        //
                                      GLFWwindow               * GL_context); // cached for amortized computation
-
+#endif
 
 }
 
@@ -35,6 +35,8 @@
 *********************************************************************************/
 #include <cinolib/3d_printing/sliced_object.h>
 #include <cinolib/io/read_CLI.h>
+#include <cinolib/io/write_CLI.h>
+#include <cinolib/parallel_for.h>
 #include <cinolib/triangle_wrap.h>
 #include <cinolib/vector_serialization.h>
 #include <cinolib/ANSI_color_codes.h>
@@ -90,35 +92,32 @@ void SlicedObj<M,V,E,P>::init(const std::vector<std::vector<std::vector<vec3d>>>
 {
     uint num_slices = slice_polys.size();
 
+    // supports are thickened polylines, hence they are ignored if thick_radius is not positive
+    bool use_supports = thick_radius>0 && !supports.empty();
+    const std::vector<std::vector<vec3d>> no_supports;
+
+    // skip empty slices
+    std::vector<uint> sids;
     for(uint sid=0; sid<num_slices; ++sid)
     {
         uint np = slice_holes.at(sid).size();
-        uint nh = slice_polys.at(sid).size();
-        uint ns = (thick_radius>0) ? supports.at(sid).size() : 0;
-
-        std::cout << "processing slice " << sid << " out of " << num_slices << "\t(" << np << " polys / " << nh << " holes / "  << ns << " supports)" << std::endl;
+        uint ns = use_supports ? supports.at(sid).size() : 0;
 
         if(np>0) z.push_back(slice_holes.at(sid).front().front().z()); else
         if(ns>0) z.push_back(supports.at(sid).front().front().z());    else
         continue; // empty slice, skip it
+        sids.push_back(sid);
+    }
 
-        std::vector<BoostPolygon> polys;
-        std::vector<BoostPolygon> holes;
-        for(auto p : slice_holes.at(sid)) polys.push_back(make_polygon(p));
-        for(auto h : slice_polys.at(sid)) holes.push_back(make_polygon(h));
-        if(thick_radius>0)
-        {
-            for(auto s : supports.at(sid)) polys.push_back(make_polygon(s, thick_radius));
-        }
-
-        BoostMultiPolygon mp;
-        for(auto p : polys) mp = polygon_union(mp, p);
-        for(auto p : holes) mp = polygon_difference(mp, p);
-        mp = polygon_simplify(mp, 0.1*thick_radius);
+    std::cout << "processing " << sids.size() << " slices out of " << num_slices << std::endl;
 
-        assert(mp.size()>0);
-        slices.push_back(mp);
-    }
+    slices.resize(sids.size());
+    PARALLEL_FOR(0, sids.size(), 1, [&](const uint i)
+    {
+        uint sid = sids.at(i);
+        slices.at(i) = slice_to_multipolygon(slice_holes.at(sid), slice_polys.at(sid), use_supports ? supports.at(sid) : no_supports, thick_radius);
+        assert(slices.at(i).size()>0);
+    });
 
     triangulate_slices();
 }
@@ -234,4 +233,125 @@ bool SlicedObj<M,V,E,P>::slice_contains(const uint sid, const vec2d & p) const
     return polygon_contains(slices.at(sid), p, true);
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// splits a multipolygon into external (outer rings) and internal (holes) polylines
+CINO_INLINE
+void multipolygon_to_polylines(const BoostMultiPolygon               & mp,
+                               const double                            z,
+                                     std::vector<std::vector<vec3d>> & external_polylines,
+                                     std::vector<std::vector<vec3d>> & internal_polylines)
+{
+    auto ring_to_polyline = [&](const BoostPolygon::ring_type & ring)
+    {
+        std::vector<vec3d> pl;
+        for(uint i=0; i+1<ring.size(); ++i) // first and last verts coincide...
+        {
+            pl.push_back(vec3d(boost::geometry::get<0>(ring.at(i)),
+                               boost::geometry::get<1>(ring.at(i)), z));
+        }
+        return pl;
+    };
+    external_polylines.clear();
+    internal_polylines.clear();
+    for(const BoostPolygon & p : mp)
+    {
+        external_polylines.push_back(ring_to_polyline(p.outer()));
+        for(const auto & hole : p.inners()) internal_polylines.push_back(ring_to_polyline(hole));
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void SlicedObj<M,V,E,P>::save_CLI(const char * filename) const
+{
+    CLIWriter writer(filename);
+    std::vector<std::vector<vec3d>> external, internal;
+    for(uint sid=0; sid<num_slices(); ++sid)
+    {
+        multipolygon_to_polylines(slices.at(sid), z.at(sid), external, internal);
+        writer.write_layer(z.at(sid), internal, external, {});
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+BoostMultiPolygon slice_to_multipolygon(const std::vector<std::vector<vec3d>> & external_polylines,
+                                        const std::vector<std::vector<vec3d>> & internal_polylines,
+                                        const std::vector<std::vector<vec3d>> & open_polylines,
+                                        const double                            thick_radius)
+{
+    std::vector<BoostPolygon> polys;
+    std::vector<BoostPolygon> holes;
+    for(const auto & p : external_polylines) polys.push_back(make_polygon(p));
+    for(const auto & h : internal_polylines) holes.push_back(make_polygon(h));
+    if(thick_radius>0)
+    {
+        for(const auto & s : open_polylines) polys.push_back(make_polygon(s, thick_radius));
+    }
+
+    BoostMultiPolygon mp = polygon_union(polys);
+    if(!holes.empty()) mp = polygon_difference(mp, polygon_union(holes));
+    return polygon_simplify(mp, 0.1*thick_radius);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void stream_CLI_slices(const char   * filename_in,
+                       const char   * filename_out,
+                       const double   thick_radius,
+                       const uint     batch_size)
+{
+    assert(batch_size>0);
+
+    CLIReader reader(filename_in);
+    CLIWriter writer(filename_out);
+
+    struct Layer
+    {
+        double                          z;
+        std::vector<std::vector<vec3d>> internal, external, open;
+        BoostMultiPolygon               mp;
+    };
+    std::vector<Layer> batch(batch_size);
+
+    bool eof = false;
+    while(!eof)
+    {
+        // read a batch of (non empty) layers
+        uint n = 0;
+        while(n<batch_size)
+        {
+            Layer & l = batch.at(n);
+            if(!reader.next_layer(l.z, l.internal, l.external, l.open))
+            {
+                eof = true;
+                break;
+            }
+            bool empty = l.external.empty() && (thick_radius<=0 || l.open.empty());
+            if(!empty) ++n;
+        }
+
+        // process them in parallel
+        PARALLEL_FOR(0, n, 1, [&](const uint i)
+        {
+            Layer & l = batch.at(i);
+            l.mp = slice_to_multipolygon(l.external, l.internal, l.open, thick_radius);
+        });
+
+        // append them to the output file
+        std::vector<std::vector<vec3d>> external, internal;
+        for(uint i=0; i<n; ++i)
+        {
+            multipolygon_to_polylines(batch.at(i).mp, batch.at(i).z, external, internal);
+            writer.write_layer(batch.at(i).z, internal, external, {});
+        }
+    }
+    std::cout << "streamed " << writer.num_layers() << " slices (" << reader.num_layers() << " layers in input)" << std::endl;
+}
+
 }
@@ -83,6 +83,11 @@ class SlicedObj : public Trimesh<M,V,E,P>
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+        // writes slices as closed polylines (supports are already merged into them)
+        void save_CLI(const char * filename) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
     protected:
 
         void init(const std::vector<std::vector<std::vector<vec3d>>> & slice_polys,
@@ -101,6 +106,32 @@ class SlicedObj : public Trimesh<M,V,E,P>
         std::vector<std::vector<std::vector<vec3d>>> hatches;      // unused so far, just keeping them
 };
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Computes the region occupied by a slice, as the union of the external polylines
+// and of the supports thickened by thick_radius, minus the union of the internal
+// polylines (holes). Each union is computed with a single batched boolean (see the
+// vector version of polygon_union), rather than accumulating one polygon at a time
+CINO_INLINE
+BoostMultiPolygon slice_to_multipolygon(const std::vector<std::vector<vec3d>> & external_polylines,
+                                        const std::vector<std::vector<vec3d>> & internal_polylines,
+                                        const std::vector<std::vector<vec3d>> & open_polylines,
+                                        const double                            thick_radius);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Out of core version of the slice processing done by SlicedObj, for prints with
+// many layers. Layers are read from the input CLI file in batches of batch_size,
+// each batch is processed in parallel (see slice_to_multipolygon), and the resulting
+// slices are appended to the output CLI file as closed polylines. At any time only
+// one batch of layers is kept in memory. Empty layers are skipped. The output file
+// can be loaded as a SlicedObj with no need to merge supports again (thick_radius=0)
+CINO_INLINE
+void stream_CLI_slices(const char   * filename_in,
+                       const char   * filename_out,
+                       const double   thick_radius = 0.01,
+                       const uint     batch_size   = 256);
+
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -36,6 +36,7 @@
 #include <cinolib/AFM/AFM.h>
 #include <cinolib/AFM/flip_checks.h>
 #include <cinolib/AFM/advance_move.h>
+#include <cinolib/AFM/hybrid_coords.h>
 #include <cinolib/geometry/n_sided_poygon.h>
 #include <cinolib/split_separating_simplices.h>
 #include <cinolib/how_many_seconds.h>
@@ -189,14 +190,18 @@ void AFM_init(AFM_data & data)
 
     data.m1.edge_mark_boundaries();
 
-    // initialize rational coordinates
+    // initialize rational coordinates (in hybrid mode they are created only when necessary)
     if(!rationals_are_working()) throw("Rational numbers are not working!");
+    data.exact_coords.clear();
     data.exact_coords.resize(data.m1.num_verts()*3);
-    for(uint vid=0; vid<data.m1.num_verts(); ++vid)
+    data.coords_type.assign(data.m1.num_verts(), AFM_DOUBLE);
+    if(!data.hybrid_coords)
     {
-        data.exact_coords[3*vid  ] = data.m1.vert(vid).x();
-        data.exact_coords[3*vid+1] = data.m1.vert(vid).y();
-        data.exact_coords[3*vid+2] = data.m1.vert(vid).z();
+        for(uint vid=0; vid<data.m1.num_verts(); ++vid)
+        {
+            CGAL_Q p[3] = { data.m1.vert(vid).x(), data.m1.vert(vid).y(), data.m1.vert(vid).z() };
+            set_rational_coords(data,vid,p);
+        }
     }
 }
 
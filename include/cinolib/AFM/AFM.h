@@ -45,6 +45,16 @@
 namespace cinolib
 {
 
+typedef MaybeDrawableTrimesh<> AFM_mesh;
+
+// numeric representation of the vertices of m1 (see hybrid_coords.h)
+enum
+{
+    AFM_DOUBLE,   // coordinates are exactly represented by m1.vert(vid)
+    AFM_CACHED,   // as above, and a rational copy of them is also stored in exact_coords
+    AFM_RATIONAL, // coordinates are stored in exact_coords only (m1.vert(vid) is their rounding)
+};
+
 /* Reference implementation of the article
  *
  * Advancing Front Surface Mapping
@@ -64,13 +74,15 @@ namespace cinolib
 
 struct AFM_data
 {
-    DrawableTrimesh<>   m0;                     // input mesh. May be refined during map generation
-    DrawableTrimesh<>   m1;                     // output mesh of the target domain, same connectivity as m0
+    AFM_mesh            m0;                     // input mesh. May be refined during map generation
+    AFM_mesh            m1;                     // output mesh of the target domain, same connectivity as m0
     std::deque<uint>    front;                  // serialized front edges
     int                 target_domain = CIRCLE; // CIRCLE, SQUARE, STAR
     uint                origin;                 // id of the vertex selected as the origin of the front
     bool                initialized = false;    // true if m1 has already been initialized
-    std::vector<CGAL_Q> exact_coords;           // rational coordinates for exact computation
+    std::vector<CGAL_Q> exact_coords;           // rational coordinates for exact computation (see coords_type)
+    std::vector<char>   coords_type;            // AFM_DOUBLE, AFM_CACHED or AFM_RATIONAL (see hybrid_coords.h)
+    bool                hybrid_coords = true;   // keep coordinates in double, and use rationals only when necessary
 
     // profiling / debugging / step-by-step execution
     Profiler p;
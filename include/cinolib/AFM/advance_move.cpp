@@ -35,6 +35,7 @@
 *********************************************************************************/
 #include <cinolib/AFM/advance_move.h>
 #include <cinolib/AFM/flip_checks.h>
+#include <cinolib/AFM/hybrid_coords.h>
 #include <cinolib/AFM/convexification.h>
 #include <cinolib/AFM/concavification.h>
 #include <cinolib/AFM/snap_rounding.h>
@@ -66,14 +67,15 @@ bool advance_by_triangle_split(      AFM_data & data,
 
     if(update_split_point_coords)
     {
-        CGAL_Q * O  = & data.exact_coords[3*data.origin];
-        CGAL_Q * V0 = & data.exact_coords[3*v0];
-        CGAL_Q * V1 = & data.exact_coords[3*v1];
-        CGAL_Q * V2 = & data.exact_coords[3*v2];
+        const CGAL_Q * O  = rational_coords(data,data.origin);
+        const CGAL_Q * V0 = rational_coords(data,v0);
+        const CGAL_Q * V1 = rational_coords(data,v1);
+              CGAL_Q   V2[3];
         //midpoint(V0,V1,O,V2);
         V2[0] = (V0[0]*99 + V1[0]*99 + O[0]*2)/200;
         V2[1] = (V0[1]*99 + V1[1]*99 + O[1]*2)/200;
         V2[2] = (V0[2]*99 + V1[2]*99 + O[2]*2)/200;
+        set_rational_coords(data,v2,V2);
         if(data.enable_sanity_checks)
         {
             assert(orient2d(V0,V1,V2)>0);
@@ -35,6 +35,7 @@
 *********************************************************************************/
 #include <cinolib/AFM/concavification.h>
 #include <cinolib/AFM/flip_checks.h>
+#include <cinolib/AFM/hybrid_coords.h>
 #include <cinolib/AFM/snap_rounding.h>
 #include <cinolib/geometry/segment_utils.h>
 
@@ -63,80 +64,80 @@ uint concavify_front(AFM_data & data,
     }
 
     // initialize split point
-    uint split_point_id = data.exact_coords.size()/3;
-    data.exact_coords.push_back(0);
-    data.exact_coords.push_back(0);
-    data.exact_coords.push_back(0);
+    uint   split_point_id = data.m1.num_verts();
+    CGAL_Q split_point[3] = { 0, 0, 0 };
 
     // if the next flip is concave, just focus on this one
     // (the next will be made valid by the convexification routine)
 
-    auto res = orient2d(&data.exact_coords[3*v0],
-                        &data.exact_coords[3*v2],
-                        &data.exact_coords[3*v3]);
+    auto res = orient2d(rational_coords(data,v0),
+                        rational_coords(data,v2),
+                        rational_coords(data,v3));
     if(res==0 || (res<0) == CCW || v3==data.origin)
     {
         CGAL_Q A[3] =
         {
-            (data.exact_coords[3*data.origin+0] + data.exact_coords[3*v2+0]*99)/100,
-            (data.exact_coords[3*data.origin+1] + data.exact_coords[3*v2+1]*99)/100,
-            (data.exact_coords[3*data.origin+2] + data.exact_coords[3*v2+2]*99)/100
+            (rational_coords(data,data.origin)[0] + rational_coords(data,v2)[0]*99)/100,
+            (rational_coords(data,data.origin)[1] + rational_coords(data,v2)[1]*99)/100,
+            (rational_coords(data,data.origin)[2] + rational_coords(data,v2)[2]*99)/100
         };
-        //midpoint(&data.exact_coords[3*data.origin],&data.exact_coords[3*v2],A);
+        //midpoint(rational_coords(data,data.origin),rational_coords(data,v2),A);
         //
         CGAL_Q B[3] = { 0, 0, 0 };
-        line_intersection2d(&data.exact_coords[3*v1], A, &data.exact_coords[3*v0], &data.exact_coords[3*v2], B);
+        line_intersection2d(rational_coords(data,v1), A, rational_coords(data,v0), rational_coords(data,v2), B);
         if(data.enable_sanity_checks)
         {
-            assert(orient2d(&data.exact_coords[3*v0],B,&data.exact_coords[3*data.origin]) *
-                   orient2d(B,&data.exact_coords[3*v2],&data.exact_coords[3*data.origin])>0);
+            assert(orient2d(rational_coords(data,v0),B,rational_coords(data,data.origin)) *
+                   orient2d(B,rational_coords(data,v2),rational_coords(data,data.origin))>0);
         }
         //
-        midpoint(A,B,&data.exact_coords[3*split_point_id]);
+        midpoint(A,B,split_point);
+        set_rational_coords(data,split_point_id,split_point);
     }
     // conversely, if the next flip is convex, make sure it's already doable,
     // (i.e.) the triangle it generates does not contain the front origin
     else
     {
         CGAL_Q A[3] = { 0, 0, 0 };
-        line_intersection2d(&data.exact_coords[3*v1],
-                            &data.exact_coords[3*data.origin],
-                            &data.exact_coords[3*v0],
-                            &data.exact_coords[3*v2], A);
+        line_intersection2d(rational_coords(data,v1),
+                            rational_coords(data,data.origin),
+                            rational_coords(data,v0),
+                            rational_coords(data,v2), A);
         // sanity checks
         // if O,v0,v1 are aligned, then A==v0, that's why >= and not >
         if(data.enable_sanity_checks)
         {
-            assert(orient2d(&data.exact_coords[3*v0],A,&data.exact_coords[3*data.origin]) *
-                   orient2d(A,&data.exact_coords[3*v2],&data.exact_coords[3*data.origin])>=0);
+            assert(orient2d(rational_coords(data,v0),A,rational_coords(data,data.origin)) *
+                   orient2d(A,rational_coords(data,v2),rational_coords(data,data.origin))>=0);
         }
 
         //
         CGAL_Q B[3] = { 0, 0, 0 };
-        line_intersection2d(&data.exact_coords[3*v3],
-                            &data.exact_coords[3*data.origin],
-                            &data.exact_coords[3*v0],
-                            &data.exact_coords[3*v2], B);
+        line_intersection2d(rational_coords(data,v3),
+                            rational_coords(data,data.origin),
+                            rational_coords(data,v0),
+                            rational_coords(data,v2), B);
         // if B does not lie in between v0 and v2, set B as v2
-        if(orient2d(&data.exact_coords[3*v0],B,&data.exact_coords[3*data.origin]) *
-           orient2d(B,&data.exact_coords[3*v2],&data.exact_coords[3*data.origin])<=0)
+        if(orient2d(rational_coords(data,v0),B,rational_coords(data,data.origin)) *
+           orient2d(B,rational_coords(data,v2),rational_coords(data,data.origin))<=0)
         {
-            B[0] = data.exact_coords[3*v2+0];
-            B[1] = data.exact_coords[3*v2+1];
-            B[2] = data.exact_coords[3*v2+2];
+            B[0] = rational_coords(data,v2)[0];
+            B[1] = rational_coords(data,v2)[1];
+            B[2] = rational_coords(data,v2)[2];
         }
 
         // make sure A comes "before" B in the segment v0-v2
         if(data.enable_sanity_checks)
         {
-            assert(orient2d(&data.exact_coords[3*v0],A,&data.exact_coords[3*data.origin]) *
-                   orient2d(A,B,&data.exact_coords[3*data.origin])>0);
+            assert(orient2d(rational_coords(data,v0),A,rational_coords(data,data.origin)) *
+                   orient2d(A,B,rational_coords(data,data.origin))>0);
         }
 
-        data.exact_coords[3*split_point_id+0] = (A[0]*49 + B[0]*49 + data.exact_coords[3*data.origin+0]*2)/100;
-        data.exact_coords[3*split_point_id+1] = (A[1]*49 + B[1]*49 + data.exact_coords[3*data.origin+1]*2)/100;
-        data.exact_coords[3*split_point_id+2] = (A[2]*49 + B[2]*49 + data.exact_coords[3*data.origin+2]*2)/100;
-        //midpoint(A,B,&data.exact_coords[3*data.origin],&data.exact_coords[3*split_point_id]);
+        split_point[0] = (A[0]*49 + B[0]*49 + rational_coords(data,data.origin)[0]*2)/100;
+        split_point[1] = (A[1]*49 + B[1]*49 + rational_coords(data,data.origin)[1]*2)/100;
+        split_point[2] = (A[2]*49 + B[2]*49 + rational_coords(data,data.origin)[2]*2)/100;
+        //midpoint(A,B,rational_coords(data,data.origin),split_point);
+        set_rational_coords(data,split_point_id,split_point);
 
         // sanity checks
         if(data.enable_sanity_checks)
@@ -156,9 +157,9 @@ uint concavify_front(AFM_data & data,
         assert(flipped(data,split_point_id,v1,data.origin) == flipped(data,v1,split_point_id,v2));
     }
 
-    data.m1.vert_add(vec3d(CGAL::to_double(data.exact_coords[3*split_point_id+0]),
-                           CGAL::to_double(data.exact_coords[3*split_point_id+1]),
-                           CGAL::to_double(data.exact_coords[3*split_point_id+2])));
+    data.m1.vert_add(vec3d(CGAL::to_double(split_point[0]),
+                           CGAL::to_double(split_point[1]),
+                           CGAL::to_double(split_point[2])));
 
     int eid = data.m0.edge_id(v0,v1);
     assert(eid>=0);
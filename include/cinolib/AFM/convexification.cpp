@@ -35,6 +35,7 @@
 *********************************************************************************/
 #include <cinolib/AFM/convexification.h>
 #include <cinolib/AFM/flip_checks.h>
+#include <cinolib/AFM/hybrid_coords.h>
 #include <cinolib/AFM/snap_rounding.h>
 #include <cinolib/geometry/segment_utils.h>
 
@@ -45,7 +46,7 @@ CINO_INLINE
 void update_vertex_pos(AFM_data & data, const uint vid, const CGAL_Q * p)
 {
     vertex_unlock(data,vid,p);
-    copy(p,&data.exact_coords[3*vid]);
+    set_rational_coords(data,vid,p);
     //snap_rounding(data,vid); // it is not safe to round it here, because there will be a flip after
                                // returning from convexify_front, hence the new triangles will not be tested
     data.m1.vert(vid) = vec3d(CGAL::to_double(p[0]),
@@ -65,10 +66,10 @@ void convexify_front(AFM_data & data,
     assert(!data.m1.vert_is_boundary(v0) || !data.m1.vert_is_boundary(v1));
 
     CGAL_Q v2_lift[3] = { 0, 0, 0 };
-    v2_lift[0] = (data.exact_coords[3*v2+0]*999 + data.exact_coords[3*data.origin+0])/1000;
-    v2_lift[1] = (data.exact_coords[3*v2+1]*999 + data.exact_coords[3*data.origin+1])/1000;
-    v2_lift[2] = (data.exact_coords[3*v2+2]*999 + data.exact_coords[3*data.origin+2])/1000;
-    //midpoint(&data.exact_coords[3*v2], &data.exact_coords[3*data.origin], v2_lift);
+    v2_lift[0] = (rational_coords(data,v2)[0]*999 + rational_coords(data,data.origin)[0])/1000;
+    v2_lift[1] = (rational_coords(data,v2)[1]*999 + rational_coords(data,data.origin)[1])/1000;
+    v2_lift[2] = (rational_coords(data,v2)[2]*999 + rational_coords(data,data.origin)[2])/1000;
+    //midpoint(rational_coords(data,v2), rational_coords(data,data.origin), v2_lift);
 
     CGAL_Q v0_new[3] = { 0, 0, 0 };
     CGAL_Q v1_new[3] = { 0, 0, 0 };
@@ -76,20 +77,20 @@ void convexify_front(AFM_data & data,
 
     if(!data.m1.vert_is_boundary(v0))
     {
-        line_intersection2d(&data.exact_coords[3*v0],
-                            &data.exact_coords[3*data.origin],
-                            &data.exact_coords[3*v1],
+        line_intersection2d(rational_coords(data,v0),
+                            rational_coords(data,data.origin),
+                            rational_coords(data,v1),
                             v2_lift, v0_new);
-        d0 = sqrd_distance2d(v0_new, &data.exact_coords[3*data.origin]);
+        d0 = sqrd_distance2d(v0_new, rational_coords(data,data.origin));
     }
 
     if(!data.m1.vert_is_boundary(v1))
     {
-        line_intersection2d(&data.exact_coords[3*v1],
-                            &data.exact_coords[3*data.origin],
-                            &data.exact_coords[3*v0],
+        line_intersection2d(rational_coords(data,v1),
+                            rational_coords(data,data.origin),
+                            rational_coords(data,v0),
                             v2_lift, v1_new);
-        d1 = sqrd_distance2d(v1_new, &data.exact_coords[3*data.origin]);
+        d1 = sqrd_distance2d(v1_new, rational_coords(data,data.origin));
     }
 
     if(data.m1.vert_is_boundary(v1) || (d0>d1 && !data.m1.vert_is_boundary(v0))) update_vertex_pos(data,v0,v0_new);
@@ -122,8 +123,8 @@ bool triangle_is_blocking(AFM_data & data,
 
     // it the positive half space of the edge opposite to front_vert
     // does not contain the new_pos, the triangle is blocking
-    if(orient2d(&data.exact_coords[3*v0],
-                &data.exact_coords[3*v1],
+    if(orient2d(rational_coords(data,v0),
+                rational_coords(data,v1),
                 p)<=0) return true;
     return false;
 }
@@ -178,15 +179,14 @@ void unlock_by_edge_split(AFM_data & data,
     uint l1[2] = { e[(off+1)%2], data.origin };
 
     CGAL_Q pp[3] = { 0, 0, 0 };
-    line_intersection2d(&data.exact_coords[3*l0[0]],
-                        &data.exact_coords[3*l0[1]],
-                        &data.exact_coords[3*l1[0]],
-                        &data.exact_coords[3*l1[1]], pp);
+    line_intersection2d(rational_coords(data,l0[0]),
+                        rational_coords(data,l0[1]),
+                        rational_coords(data,l1[0]),
+                        rational_coords(data,l1[1]), pp);
 
-    midpoint(&data.exact_coords[3*vid],pp,pp);
-    data.exact_coords.push_back(pp[0]);
-    data.exact_coords.push_back(pp[1]);
-    data.exact_coords.push_back(pp[2]);
+    midpoint(rational_coords(data,vid),pp,pp);
+    uint new_vid = data.m1.num_verts();
+    set_rational_coords(data,new_vid,pp);
 
     vec3d p = vec3d(CGAL::to_double(pp[0]),
                     CGAL::to_double(pp[1]),
@@ -194,7 +194,7 @@ void unlock_by_edge_split(AFM_data & data,
 
     data.m0.edge_split(data.m0.edge_id(vid,e[off]), 0.5); // just split at the midpoint in the input mesh...
     data.m1.edge_split(data.m1.edge_id(vid,e[off]), p);
-    snap_rounding(data,data.exact_coords.size()/3-1);
+    snap_rounding(data,new_vid);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/AFM/flip_checks.h>
+#include <cinolib/AFM/hybrid_coords.h>
 #include <cinolib/rationals.h>
 #include <cinolib/predicates.h>
 
@@ -46,9 +47,17 @@ bool flipped(AFM_data & data,
              const uint b,
              const uint c)
 {
-    return orient2d(&data.exact_coords[3*a],
-                    &data.exact_coords[3*b],
-                    &data.exact_coords[3*c]) <= 0;
+    // if no vertex needs rationals, try with floating point arithmetics first
+    if(!is_rational(data,a) && !is_rational(data,b) && !is_rational(data,c))
+    {
+        int sign = orient2d_filter(data.m1.vert(a).ptr(),
+                                   data.m1.vert(b).ptr(),
+                                   data.m1.vert(c).ptr());
+        if(sign!=0) return sign<0;
+    }
+    return orient2d(rational_coords(data,a),
+                    rational_coords(data,b),
+                    rational_coords(data,c)) <= 0;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -58,9 +67,9 @@ bool flipped(AFM_data & data, const uint pid, const bool use_rationals)
 {
     if(use_rationals)
     {
-        return orient2d(&data.exact_coords[3*data.m1.poly_vert_id(pid,0)],
-                        &data.exact_coords[3*data.m1.poly_vert_id(pid,1)],
-                        &data.exact_coords[3*data.m1.poly_vert_id(pid,2)]) <= 0;
+        return flipped(data, data.m1.poly_vert_id(pid,0),
+                             data.m1.poly_vert_id(pid,1),
+                             data.m1.poly_vert_id(pid,2));
     }
     return orient2d(data.m1.poly_vert(pid,0).ptr(),
                     data.m1.poly_vert(pid,1).ptr(),
@@ -0,0 +1,101 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/AFM/hybrid_coords.h>
+#include <cmath>
+
+namespace cinolib
+{
+
+CINO_INLINE
+const CGAL_Q * rational_coords(AFM_data & data, const uint vid)
+{
+    if(data.coords_type.at(vid)==AFM_DOUBLE)
+    {
+        data.exact_coords[3*vid+0] = data.m1.vert(vid).x();
+        data.exact_coords[3*vid+1] = data.m1.vert(vid).y();
+        data.exact_coords[3*vid+2] = data.m1.vert(vid).z();
+        data.coords_type.at(vid) = AFM_CACHED;
+    }
+    return &data.exact_coords[3*vid];
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void set_rational_coords(AFM_data & data, const uint vid, const CGAL_Q * p)
+{
+    assert(vid<=data.coords_type.size());
+    if(vid==data.coords_type.size())
+    {
+        data.exact_coords.resize(3*(vid+1));
+        data.coords_type.push_back(AFM_RATIONAL);
+    }
+    copy(p,&data.exact_coords[3*vid]);
+    data.coords_type.at(vid) = AFM_RATIONAL;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool is_rational(const AFM_data & data, const uint vid)
+{
+    return data.coords_type.at(vid)==AFM_RATIONAL;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+int orient2d_filter(const double * pa, const double * pb, const double * pc)
+{
+    static const double eps = 1.1102230246251565e-16; // 2^-53
+    static const double err = (3.0 + 16.0*eps)*eps;
+
+    double detleft  = (pa[0] - pc[0]) * (pb[1] - pc[1]);
+    double detright = (pa[1] - pc[1]) * (pb[0] - pc[0]);
+    double det      = detleft - detright;
+
+    // if the two terms have different signs there is no cancellation
+    if(detleft>0 && detright<=0) return  1;
+    if(detleft<0 && detright>=0) return -1;
+    if(detleft==0) return (detright>0) ? -1 : (detright<0) ? 1 : 0;
+
+    double bound = err * (std::fabs(detleft) + std::fabs(detright));
+    if(det >  bound) return  1;
+    if(det < -bound) return -1;
+    return 0;
+}
+
+}
@@ -0,0 +1,85 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_AFM_HYBRID_COORDS_H
+#define CINO_AFM_HYBRID_COORDS_H
+
+#include <cinolib/AFM/AFM.h>
+
+namespace cinolib
+{
+
+/* Most vertices of the output mesh can be positioned with double precision without
+ * generating flips. If data.hybrid_coords is true, these vertices do not have rational
+ * coordinates: their position is exactly represented by the double coordinates in m1,
+ * and orientation tests that involve only this kind of vertices are first answered
+ * with a floating point filter. Rational coordinates are created only for vertices
+ * whose position is computed with rational arithmetics, or for vertices involved in
+ * a test that the filter could not certify, and are released as soon as snap rounding
+ * succeeds. If data.hybrid_coords is false all vertices are handled with rationals.
+*/
+
+// rational coordinates of vid. Vertices that are exactly represented in double
+// are promoted on demand (i.e., their rational copy is created at the first use)
+CINO_INLINE
+const CGAL_Q * rational_coords(AFM_data & data, const uint vid);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// assigns rational coordinates to vid (new vertices are appended if vid is the next
+// available id). The position of vid in m1 must be updated by the caller
+CINO_INLINE
+void set_rational_coords(AFM_data & data, const uint vid, const CGAL_Q * p);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// true if the position of vid cannot be represented in double
+CINO_INLINE
+bool is_rational(const AFM_data & data, const uint vid);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// floating point filter for the 2D orientation test (stage A of Shewchuk's adaptive
+// orient2d). Returns the sign of the determinant if it can be certified, 0 otherwise
+CINO_INLINE
+int orient2d_filter(const double * pa, const double * pb, const double * pc);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "hybrid_coords.cpp"
+#endif
+
+#endif // CINO_AFM_HYBRID_COORDS_H
@@ -35,6 +35,7 @@
 *********************************************************************************/
 #include <cinolib/AFM/snap_rounding.h>
 #include <cinolib/AFM/flip_checks.h>
+#include <cinolib/AFM/hybrid_coords.h>
 
 namespace cinolib
 {
@@ -45,13 +46,22 @@ bool snap_rounding(AFM_data & data, const uint vid)
     if(!data.enable_snap_rounding) return true;
 
     // keep a safe copy of the exact coordinates
+    char   type = data.coords_type.at(vid);
     CGAL_Q tmp[3];
     copy(&data.exact_coords[3*vid],tmp);
 
-    // round them to the closest double
-    data.exact_coords[3*vid+0] = CGAL::to_double(tmp[0]);
-    data.exact_coords[3*vid+1] = CGAL::to_double(tmp[1]);
-    data.exact_coords[3*vid+2] = CGAL::to_double(tmp[2]);
+    // round them to the closest double. In hybrid mode the rounded coordinates
+    // are already in m1, it suffices to stop using rationals for vid
+    if(data.hybrid_coords)
+    {
+        if(type==AFM_RATIONAL) data.coords_type.at(vid) = AFM_DOUBLE;
+    }
+    else
+    {
+        data.exact_coords[3*vid+0] = CGAL::to_double(tmp[0]);
+        data.exact_coords[3*vid+1] = CGAL::to_double(tmp[1]);
+        data.exact_coords[3*vid+2] = CGAL::to_double(tmp[2]);
+    }
 
     // check for flips
     bool flips = false;
@@ -67,9 +77,17 @@ bool snap_rounding(AFM_data & data, const uint vid)
     if(flips) // rollback
     {
         copy(tmp, &data.exact_coords[3*vid]);
+        data.coords_type.at(vid) = type;
         ++data.snap_roundings_failed;
         return false;
     }
+    if(data.hybrid_coords && type==AFM_RATIONAL) // release rationals
+    {
+        data.coords_type.at(vid) = AFM_DOUBLE;
+        data.exact_coords[3*vid+0] = CGAL_Q();
+        data.exact_coords[3*vid+1] = CGAL_Q();
+        data.exact_coords[3*vid+2] = CGAL_Q();
+    }
     return true;
 }
 
@@ -56,10 +56,37 @@ void ARAP(AbstractMesh<M,V,E,P> & m, ARAP_data & data)
         data.xyz_ref = m.vector_verts();
 
         data.w.resize(m.num_edges());
-        for(uint eid=0; eid<m.num_edges(); ++eid)
+        PARALLEL_FOR(0, m.num_edges(), 1000, [&](uint eid)
         {
             data.w.at(eid) = m.edge_weight(eid,data.w_type);
+        });
+
+        // flatten the vertex one rings, so that neither the local nor the global
+        // step need to query the mesh connectivity (nor look for edge ids)
+        data.nbr_off.resize(m.num_verts()+1);
+        data.nbr_off.at(0) = 0;
+        for(uint vid=0; vid<m.num_verts(); ++vid)
+        {
+            data.nbr_off.at(vid+1) = data.nbr_off.at(vid) + uint(m.adj_v2e(vid).size());
         }
+        data.nbr.resize(data.nbr_off.back());
+        data.nbr_w.resize(data.nbr_off.back());
+        data.nbr_e_ref.resize(data.nbr_off.back());
+        PARALLEL_FOR(0, m.num_verts(), 1000, [&](uint vid)
+        {
+            uint i = data.nbr_off.at(vid);
+            for(uint eid : m.adj_v2e(vid))
+            {
+                uint nbr = m.vert_opposite_to(eid,vid);
+                data.nbr.at(i)       = nbr;
+                data.nbr_w.at(i)     = data.w.at(eid);
+                data.nbr_e_ref.at(i) = data.xyz_ref.at(vid) - data.xyz_ref.at(nbr);
+                ++i;
+            }
+        });
+        data.ref_edge_len = 0;
+        for(const vec3d & e : data.nbr_e_ref) data.ref_edge_len += e.norm();
+        if(!data.nbr_e_ref.empty()) data.ref_edge_len /= double(data.nbr_e_ref.size());
 
         // compute a map between matrix columns and mesh vertices
         // if hard constraints are used, boundary conditions will
@@ -85,16 +112,17 @@ void ARAP(AbstractMesh<M,V,E,P> & m, ARAP_data & data)
         uint nv = m.num_verts();
         uint nh = data.handles.size();
         std::vector<Eigen::Triplet<double>> entries;
+        entries.reserve(data.nbr.size() + nv + nh);
         for(uint vid=0; vid<m.num_verts(); ++vid)
         {
             if(data.col_map.at(vid)<0) continue;
             double diag = 0;
-            for(uint nbr : m.adj_v2v(vid))
+            for(uint i=data.nbr_off.at(vid); i<data.nbr_off.at(vid+1); ++i)
             {
-                int eid = m.edge_id(vid,nbr);
-                diag += data.w.at(eid);
+                uint nbr = data.nbr.at(i);
+                diag += data.nbr_w.at(i);
                 if(data.col_map.at(nbr)<0) continue;
-                entries.emplace_back(data.col_map.at(vid), data.col_map.at(nbr), -data.w.at(eid));
+                entries.emplace_back(data.col_map.at(vid), data.col_map.at(nbr), -data.nbr_w.at(i));
             }
             entries.emplace_back(data.col_map.at(vid), data.col_map.at(vid), diag);
         }
@@ -128,101 +156,94 @@ void ARAP(AbstractMesh<M,V,E,P> & m, ARAP_data & data)
         PARALLEL_FOR(0, m.num_verts(), 1000, [&](uint vid)
         {
             mat3d cov = mat3d::ZERO();
-            for(uint nbr : m.adj_v2v(vid))
+            for(uint i=data.nbr_off.at(vid); i<data.nbr_off.at(vid+1); ++i)
             {
-                int   eid   = m.edge_id(vid,nbr);
-                vec3d e_ref = (data.xyz_ref.at(vid) - data.xyz_ref.at(nbr));
-                vec3d e_cur = (m.vert(vid) - m.vert(nbr));
-
-                cov += data.w.at(eid) * (e_cur * e_ref.transpose());
+                vec3d e_cur = (m.vert(vid) - m.vert(data.nbr.at(i)));
+                cov += data.nbr_w.at(i) * (e_cur * data.nbr_e_ref.at(i).transpose());
             }
 
-            mat3d UU,VV;
-            vec3d S;
-            cov.SVD(UU,S,VV);
-            mat3d I = mat3d::DIAG(1);
-            I(2,2) = (UU*VV.transpose()).det();
-            data.R.at(vid) = UU*I*VV.transpose();
+            data.R.at(vid) = cov.closest_rotation();
         });
     };
 
     /////////////////////////////////////////////////////////////////////////
 
-    auto global_step = [&]()
-    {
-        uint nv   = m.num_verts();
-        uint nh   = data.handles.size();
-        uint size = (data.hard_constrain_handles) ? nv-nh : nv+nh;
+    // handles do not change within a call: their contribution to the rhs is computed once
+    uint nv   = m.num_verts();
+    uint nh   = data.handles.size();
+    uint size = (data.hard_constrain_handles) ? nv-nh : nv+nh;
+    Eigen::MatrixXd rhs_handles;
 
-        Eigen::VectorXd rhs_x(size);
-        Eigen::VectorXd rhs_y(size);
-        Eigen::VectorXd rhs_z(size);
-
-        for(uint vid=0; vid<m.num_verts(); ++vid)
+    auto init_rhs_handles = [&]()
+    {
+        rhs_handles = Eigen::MatrixXd::Zero(size,3);
+        if(data.hard_constrain_handles)
         {
-            if(data.col_map.at(vid)<0) continue;
-
-            vec3d rhs(0,0,0);
-            for(uint nbr : m.adj_v2v(vid))
+            PARALLEL_FOR(0, nv, 1000, [&](uint vid)
             {
-                mat3d Ravg = (data.R.at(vid)+data.R.at(nbr))/2.0;
-                vec3d e    = (data.xyz_ref.at(vid) - data.xyz_ref.at(nbr));
-                int eid    = m.edge_id(vid,nbr);
-
-                rhs += data.w.at(eid) * Ravg * e;
-
-                if(data.col_map.at(nbr)<0)
+                int col = data.col_map.at(vid);
+                if(col<0) return;
+                for(uint i=data.nbr_off.at(vid); i<data.nbr_off.at(vid+1); ++i)
                 {
-                    rhs += data.w.at(eid) * vec3d(data.handles_x.at(nbr),
-                                                  data.handles_y.at(nbr),
-                                                  data.handles_z.at(nbr));
+                    uint nbr = data.nbr.at(i);
+                    if(data.col_map.at(nbr)>=0) continue;
+                    rhs_handles(col,0) += data.nbr_w.at(i) * data.handles_x.at(nbr);
+                    rhs_handles(col,1) += data.nbr_w.at(i) * data.handles_y.at(nbr);
+                    rhs_handles(col,2) += data.nbr_w.at(i) * data.handles_z.at(nbr);
                 }
-            }
-            rhs_x[data.col_map.at(vid)] = rhs.x();
-            rhs_y[data.col_map.at(vid)] = rhs.y();
-            rhs_z[data.col_map.at(vid)] = rhs.z();
-        }
-
-        Eigen::VectorXd x,y,z;
-        if(data.hard_constrain_handles)
-        {
-            x = data.cache.solve(rhs_x).eval();
-            y = data.cache.solve(rhs_y).eval();
-            z = data.cache.solve(rhs_z).eval();
-
-            for(uint vid=0; vid<m.num_verts(); ++vid)
-            {
-                if(data.col_map.at(vid)<0) continue;
-                m.vert(vid) = vec3d(x[data.col_map.at(vid)],
-                                    y[data.col_map.at(vid)],
-                                    z[data.col_map.at(vid)]);
-            }
-            for(uint vid : data.handles)
-            {
-                m.vert(vid) = vec3d(data.handles_x.at(vid),
-                                    data.handles_y.at(vid),
-                                    data.handles_z.at(vid));
-            }
+            });
         }
         else
         {
             uint off = 0;
             for(uint vid : data.handles)
             {
-                rhs_x[nv+off] = data.handles_x.at(vid);
-                rhs_y[nv+off] = data.handles_y.at(vid);
-                rhs_z[nv+off] = data.handles_z.at(vid);
+                rhs_handles(nv+off,0) = data.handles_x.at(vid);
+                rhs_handles(nv+off,1) = data.handles_y.at(vid);
+                rhs_handles(nv+off,2) = data.handles_z.at(vid);
                 ++off;
             }
-            x = data.cache.solve(data.A.transpose()*rhs_x).eval();
-            y = data.cache.solve(data.A.transpose()*rhs_y).eval();
-            z = data.cache.solve(data.A.transpose()*rhs_z).eval();
+        }
+    };
+
+    /////////////////////////////////////////////////////////////////////////
+
+    // returns the maximum vertex displacement
+    auto global_step = [&]() -> double
+    {
+        Eigen::MatrixXd rhs = rhs_handles;
+        PARALLEL_FOR(0, nv, 1000, [&](uint vid)
+        {
+            int col = data.col_map.at(vid);
+            if(col<0) return;
 
-            for(uint vid=0; vid<m.num_verts(); ++vid)
+            vec3d b(0,0,0);
+            for(uint i=data.nbr_off.at(vid); i<data.nbr_off.at(vid+1); ++i)
             {
-                m.vert(vid) = vec3d(x[vid],y[vid],z[vid]);
+                mat3d Ravg = (data.R.at(vid)+data.R.at(data.nbr.at(i)))/2.0;
+                b += data.nbr_w.at(i) * Ravg * data.nbr_e_ref.at(i);
             }
+            rhs(col,0) += b.x();
+            rhs(col,1) += b.y();
+            rhs(col,2) += b.z();
+        });
+
+        // one back-substitution for the x,y,z columns altogether
+        Eigen::MatrixXd xyz;
+        if(data.hard_constrain_handles) xyz = data.cache.solve(rhs);
+        else                            xyz = data.cache.solve(data.A.transpose()*rhs);
+
+        double max_disp = 0;
+        for(uint vid=0; vid<nv; ++vid)
+        {
+            vec3d p;
+            int col = data.col_map.at(vid);
+            if(col<0) p = vec3d(data.handles_x.at(vid), data.handles_y.at(vid), data.handles_z.at(vid));
+            else      p = vec3d(xyz(col,0), xyz(col,1), xyz(col,2));
+            max_disp = std::max(max_disp, p.dist(m.vert(vid)));
+            m.vert(vid) = p;
         }
+        return max_disp;
     };
 
     //////////////////////////////////////////////////////////////////////////
@@ -230,11 +251,15 @@ void ARAP(AbstractMesh<M,V,E,P> & m, ARAP_data & data)
     //////////////////////////////////////////////////////////////////////////
 
     if(data.init) init();
+    init_rhs_handles();
 
+    data.iters_done = 0;
     for(uint i=0; i<data.n_iters; ++i)
     {
         local_step();
-        global_step();
+        double max_disp = global_step();
+        ++data.iters_done;
+        if(max_disp <= data.conv_thresh * data.ref_edge_len) break;
     }
     m.update_normals();
 }
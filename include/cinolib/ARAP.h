@@ -53,8 +53,10 @@ namespace cinolib
 
 struct ARAP_data
 {
-    uint n_iters = 4;
-    bool init = true; // initialize just once (useful for multiple calls, e.g. to make more iterations)
+    uint   n_iters     = 4;
+    bool   init        = true; // initialize just once (useful for multiple calls, e.g. to make more iterations)
+    double conv_thresh = 0;    // stop early if no vertex moved more than conv_thresh * (avg ref edge length) in the last iteration
+    uint   iters_done  = 0;    // number of iterations performed by the last call
 
     std::vector<mat3d> R;       // local (per vertex) rotation matrices
     std::vector<vec3d> xyz_ref; // reference (original) vertex positions
@@ -63,6 +65,15 @@ struct ARAP_data
     std::vector<double> w;
     int w_type = UNIFORM; // { UNIFORM, COTANGENT }
 
+    // per vertex adjacency in compressed form: the neighbors of vertex vid are
+    // nbr[nbr_off[vid]] ... nbr[nbr_off[vid+1]-1], with edge weights nbr_w and
+    // reference edge vectors nbr_e_ref (i.e. xyz_ref[vid] - xyz_ref[nbr])
+    std::vector<uint>   nbr_off;
+    std::vector<uint>   nbr;
+    std::vector<double> nbr_w;
+    std::vector<vec3d>  nbr_e_ref;
+    double              ref_edge_len = 0; // average length of reference edges
+
     Eigen::SimplicialLLT<Eigen::SparseMatrix<double>> cache; // factorized matrix
     Eigen::SparseMatrix<double> A; // a copy of the matrix (to be pre-multiplied to the rhs to form the normal equations)
 
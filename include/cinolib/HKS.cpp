@@ -39,6 +39,7 @@
 #include <cinolib/scalar_field.h>
 #include <cinolib/vertex_mass.h>
 #include <cinolib/sampling.h>
+#include <cinolib/parallel_for.h>
 
 namespace cinolib
 {
@@ -61,13 +62,7 @@ Eigen::MatrixXd HKS(      AbstractMesh<M,V,E,P> & m,
     Eigen::SparseMatrix<double> L  = laplacian(m, COTANGENT);
     Eigen::SparseMatrix<double> MM = mass_matrix(m);
 
-    // This is what Dorian Nogneng and Maks Ovsjanikov do in their reference code for the paper:
-    //
-    //      Informative Descriptor Preservation via Commutativity for Shape Matching
-    //      Eurographics 2017
-    //
-    std::vector<double> timesteps = sample_within_interval(log(0.005), log(0.2), n_timesteps);
-    for(uint i=0; i<n_timesteps; ++i) timesteps[i] = exp(timesteps[i]);
+    std::vector<double> timesteps = HKS_timesteps(n_timesteps);
 
     uint col = 0;
     for(auto t : timesteps)
@@ -90,4 +85,117 @@ Eigen::MatrixXd HKS(      AbstractMesh<M,V,E,P> & m,
     return A;
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+std::vector<double> HKS_timesteps(const uint n_timesteps)
+{
+    // This is what Dorian Nogneng and Maks Ovsjanikov do in their reference code for the paper:
+    //
+    //      Informative Descriptor Preservation via Commutativity for Shape Matching
+    //      Eurographics 2017
+    //
+    std::vector<double> timesteps = sample_within_interval(log(0.005), log(0.2), n_timesteps);
+    for(uint i=0; i<n_timesteps; ++i) timesteps[i] = exp(timesteps[i]);
+    return timesteps;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+Eigen::MatrixXd HKS_krylov(      AbstractMesh<M,V,E,P> & m,
+                           const std::vector<uint>     & landmarks,
+                           const uint                    n_timesteps,
+                           const bool                    normalize_mesh,
+                           const bool                    normalize_columns,
+                           const uint                    max_krylov_dim,
+                           const double                  tol,
+                           const bool                    verbose)
+{
+    if(normalize_mesh) m.normalize_bbox();
+
+    uint n_rows = m.num_verts();
+    uint n_cols = landmarks.size()*n_timesteps;
+    Eigen::MatrixXd A(n_rows,n_cols);
+    if(n_cols==0) return A; // no timesteps (or no landmarks): nothing to factorize nor project
+
+    Eigen::SparseMatrix<double> L  = laplacian(m, COTANGENT);
+    Eigen::SparseMatrix<double> MM = mass_matrix(m);
+
+    std::vector<double> timesteps = HKS_timesteps(n_timesteps);
+
+    // single factorization, with shift in the middle of the (log) range of timesteps
+    double s = std::sqrt(timesteps.front()*timesteps.back());
+    Eigen::SimplicialLLT<Eigen::SparseMatrix<double>> solver(MM - s*L);
+    assert(solver.info() == Eigen::Success);
+
+    uint max_k = std::max(1u, std::min(max_krylov_dim, n_rows));
+    Eigen::MatrixXd Q(n_rows, max_k+1);
+    Eigen::MatrixXd H = Eigen::MatrixXd::Zero(max_k+1, max_k);
+    Eigen::MatrixXd Y(max_k, n_timesteps);
+
+    // solves the projected systems (I + (s-t) H_k) y = beta e1 for all timesteps,
+    // and returns the largest residual
+    auto project = [&](const uint k, const double beta) -> double
+    {
+        std::vector<double> res(n_timesteps);
+        PARALLEL_FOR(0, n_timesteps, 8, [&](const uint i)
+        {
+            double d = s - timesteps.at(i);
+            Eigen::MatrixXd Hk = d * H.topLeftCorner(k,k);
+            Hk.diagonal().array() += 1.0;
+            Eigen::VectorXd rhs = Eigen::VectorXd::Zero(k);
+            rhs[0] = beta;
+            Y.col(i).head(k) = Hk.partialPivLu().solve(rhs);
+            res.at(i) = std::fabs(d * H(k,k-1) * Y(k-1,i));
+        });
+        return *std::max_element(res.begin(), res.end());
+    };
+
+    for(uint lid=0; lid<landmarks.size(); ++lid)
+    {
+        Eigen::VectorXd rhs = Eigen::VectorXd::Zero(n_rows);
+        rhs[landmarks.at(lid)] = 1.0;
+        Eigen::VectorXd q = solver.solve(rhs);
+        double beta = q.norm();
+        Q.col(0) = q/beta;
+
+        // Arnoldi iterations (with reorthogonalization)
+        uint k = 0;
+        while(k<max_k)
+        {
+            q = solver.solve(L*Q.col(k));
+            for(int pass=0; pass<2; ++pass)
+            for(uint j=0; j<=k; ++j)
+            {
+                double h = Q.col(j).dot(q);
+                H(j,k) += h;
+                q -= h*Q.col(j);
+            }
+            H(k+1,k) = q.norm();
+            ++k;
+            double res = project(k, beta);
+            if(res <= tol*beta || H(k,k-1) <= tol*beta) break;
+            Q.col(k) = q/H(k,k-1);
+        }
+        if(verbose) std::cout << "landmark " << landmarks.at(lid) << ": " << k << " Krylov iterations" << std::endl;
+
+        PARALLEL_FOR(0, n_timesteps, 8, [&](const uint i)
+        {
+            uint col = i*landmarks.size() + lid;
+            A.col(col) = Q.leftCols(k) * Y.col(i).head(k);
+            if(normalize_columns) // Useful for visualization but "physically wrong"...
+            {
+                double min = A.col(col).minCoeff();
+                double max = A.col(col).maxCoeff();
+                if(max-min>0) A.col(col) = (A.col(col).array()-min)/(max-min);
+            }
+        });
+
+        H.setZero();
+    }
+    return A;
+}
+
 }
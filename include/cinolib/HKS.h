@@ -52,6 +52,52 @@ Eigen::MatrixXd HKS(      AbstractMesh<M,V,E,P> & m,
                     const bool                    normalize_mesh = false,
                     const bool                    normalize_columns = false,
                     const bool                    verbose = false);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// timesteps used by HKS() and HKS_krylov(), log-uniformly sampled in [0.005,0.2]
+CINO_INLINE
+std::vector<double> HKS_timesteps(const uint n_timesteps);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Same output of HKS(), but computed with a single Cholesky factorization shared by
+ * all timesteps. HKS() solves (MM - t*L) x = e_v with a new factorization for each t.
+ * Writing K = MM - s*L for a fixed shift s, each system becomes
+ *
+ *     (I + (s-t) K^{-1} L) x = K^{-1} e_v
+ *
+ * which is a shifted linear system sharing the same Krylov subspace for every t.
+ * For each landmark a basis of such subspace is built with Arnoldi (one back
+ * substitution per iteration), and the solutions for all timesteps are extracted
+ * from it in parallel, with small dense solves and a single matrix product (shifted
+ * FOM). Iterations stop as soon as the residual of all timesteps drops below tol,
+ * or after max_krylov_dim iterations.
+ *
+ * This is the fallback of SpectralDescriptors (spectral_descriptors.h) for when a
+ * truncated eigenbasis is too lossy: results converge to HKS() up to tol, and no
+ * eigendecomposition is needed.
+ *
+ * References:
+ *
+ *     A. Frommer, U. Glassner
+ *     Restarted GMRES for Shifted Linear Systems
+ *     SIAM Journal on Scientific Computing, 1998
+ *
+ *     V. Simoncini
+ *     Restarted Full Orthogonalization Method for Shifted Linear Systems
+ *     BIT Numerical Mathematics, 2003
+*/
+template<class M, class V, class E, class P>
+CINO_INLINE
+Eigen::MatrixXd HKS_krylov(      AbstractMesh<M,V,E,P> & m,
+                           const std::vector<uint>     & landmarks,
+                           const uint                    n_timesteps,
+                           const bool                    normalize_mesh = false,
+                           const bool                    normalize_columns = false,
+                           const uint                    max_krylov_dim = 60,
+                           const double                  tol = 1e-10,
+                           const bool                    verbose = false);
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -37,7 +37,13 @@
 #include <cinolib/random_generator.h>
 #include <cinolib/serialize_index.h>
 #include <cinolib/min_max_inf.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/geometry/triangle_utils.h>
 #include <array>
+#include <queue>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace cinolib
 {
@@ -190,4 +196,447 @@ void Poisson_sampling(const double          radius,
     }
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// packs the integer coordinates of a grid cell into a key for a sparse (hash) grid.
+// Each coordinate gets 64/Dim bits, and is offset so that negative values are fine too
+template<uint Dim>
+CINO_INLINE
+uint64_t Poisson_cell_key(const std::array<int,Dim> & c)
+{
+    static_assert(Dim>0 && Dim<=4, "Poisson_cell_key: unsupported dimension");
+    const uint     bits = 64/Dim;
+    const uint64_t mask = (bits==64) ? ~uint64_t(0) : (uint64_t(1)<<bits)-1;
+    uint64_t key = 0;
+    for(uint i=0; i<Dim; ++i)
+    {
+        if(i>0) key <<= bits;
+        key |= uint64_t(int64_t(c[i]) + (int64_t(1)<<(bits-1))) & mask;
+    }
+    return key;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// calls func(c) for each cell c in the box [cmin,cmax]. Stops if func returns false
+template<uint Dim, class Func>
+CINO_INLINE
+bool Poisson_for_each_cell(const std::array<int,Dim> & cmin,
+                           const std::array<int,Dim> & cmax,
+                           const Func                & func)
+{
+    for(uint i=0; i<Dim; ++i) if(cmin[i]>cmax[i]) return true;
+    std::array<int,Dim> c = cmin;
+    for(;;)
+    {
+        if(!func(c)) return false;
+        for(uint i=0; i<Dim; ++i)
+        {
+            if(++c[i]<=cmax[i]) break;
+            if(i==Dim-1) return true;
+            c[i] = cmin[i];
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<uint Dim, class Point>
+CINO_INLINE
+void Poisson_sampling_parallel(const double          radius,
+                               const Point           min,
+                               const Point           max,
+                               std::vector<Point> &  samples,
+                               uint                  seed,
+                               const int             max_attempts)
+{
+    typedef std::array<int,Dim> Cell;
+
+    samples.clear();
+
+    // the domain is split into grid cells (at most one sample each) and tiles of tile_cells^Dim cells, with side >= 2*radius
+    const double step       = 0.999*radius/std::sqrt(static_cast<double>(Dim)); // a grid cell this size can have at most one sample in it
+    const double r2         = radius*radius;
+    const int    tile_cells = static_cast<int>(std::ceil(2*radius/step));
+    const int    box_cells  = 3*tile_cells; // a tile plus its one-ring of tiles
+    Cell n_cells, n_tiles;
+    uint64_t tot_tiles = 1;
+    uint     box_size  = 1;
+    for(uint i=0; i<Dim; ++i)
+    {
+        n_cells[i] = std::max(1, static_cast<int>(std::ceil((max[i]-min[i])/step)));
+        n_tiles[i] = (n_cells[i]+tile_cells-1)/tile_cells;
+        tot_tiles *= n_tiles[i];
+        box_size  *= box_cells;
+    }
+    std::unordered_map<uint64_t,std::vector<uint>> tile_samples; // sparse storage: tile => ids of the samples in it
+
+    auto cell_of = [&](const Point & x)
+    {
+        Cell c;
+        for(uint i=0; i<Dim; ++i) c[i] = std::min(std::max(static_cast<int>((x[i]-min[i])/step),0), n_cells[i]-1);
+        return c;
+    };
+
+    // runs Bridson's algorithm inside a tile, and returns the new samples. Samples of previous
+    // phases in the surrounding tiles are copied into a small dense grid (box) around the tile,
+    // which is then used for all proximity queries. Global data is only read
+    auto fill_tile = [&](const Cell & tile) -> std::vector<Point>
+    {
+        Cell lo, hi, box_lo;
+        for(uint i=0; i<Dim; ++i)
+        {
+            lo[i]     = tile[i]*tile_cells;
+            hi[i]     = std::min(lo[i]+tile_cells, n_cells[i])-1;
+            box_lo[i] = lo[i]-tile_cells;
+        }
+        auto box_index = [&](const Cell & c)
+        {
+            uint index = 0;
+            for(uint i=0; i<Dim; ++i) index = index*box_cells + uint(c[i]-box_lo[i]);
+            return index;
+        };
+
+        uint64_t key = Poisson_cell_key<Dim>(tile);
+        uint s = random_uint(seed + random_uint(uint(key) ^ random_uint(uint(key>>32))));
+
+        std::vector<Point> pool;            // samples that can spawn new ones (previous phases first, then new ones)
+        std::vector<uint>  active_list;
+        std::vector<int>   box(box_size,-1); // cell => position in pool of the sample in it
+
+        // samples of previous phases in the surrounding tiles. Those within 2*radius from the tile may spawn new samples
+        Cell t_lo, t_hi;
+        for(uint i=0; i<Dim; ++i) { t_lo[i] = tile[i]-1; t_hi[i] = tile[i]+1; }
+        Poisson_for_each_cell<Dim>(t_lo, t_hi, [&](const Cell & t)
+        {
+            auto it = tile_samples.find(Poisson_cell_key<Dim>(t));
+            if(it==tile_samples.end()) return true;
+            for(uint sid : it->second)
+            {
+                const Point & x = samples.at(sid);
+                double d2 = 0;
+                for(uint i=0; i<Dim; ++i)
+                {
+                    double t_min = min[i] + lo[i]*step;
+                    double t_max = min[i] + (hi[i]+1)*step;
+                    double d = std::max(std::max(t_min-x[i], x[i]-t_max), 0.0);
+                    d2 += d*d;
+                }
+                if(d2<4*r2) active_list.push_back(uint(pool.size()));
+                box.at(box_index(cell_of(x))) = int(pool.size());
+                pool.push_back(x);
+            }
+            return true;
+        });
+        const size_t n_parents = pool.size();
+
+        auto valid = [&](const Point & x)
+        {
+            for(uint i=0; i<Dim; ++i) if(x[i]<min[i] || x[i]>max[i]) return false;
+            Cell c = cell_of(x);
+            for(uint i=0; i<Dim; ++i) if(c[i]<lo[i] || c[i]>hi[i]) return false;
+
+            Cell jmin, jmax;
+            for(uint i=0; i<Dim; ++i)
+            {
+                jmin[i] = std::min(std::max(static_cast<int>((x[i]-radius-min[i])/step),0), n_cells[i]-1);
+                jmax[i] = std::min(std::max(static_cast<int>((x[i]+radius-min[i])/step),0), n_cells[i]-1);
+            }
+            return Poisson_for_each_cell<Dim>(jmin, jmax, [&](const Cell & j)
+            {
+                int id = box[box_index(j)];
+                return (id<0 || (x-pool[id]).norm_sqrd()>=r2);
+            });
+        };
+
+        auto add = [&](const Point & x)
+        {
+            box.at(box_index(cell_of(x))) = int(pool.size());
+            active_list.push_back(uint(pool.size()));
+            pool.push_back(x);
+        };
+
+        // random seed point inside the tile
+        for(int attempt=0; attempt<max_attempts; ++attempt)
+        {
+            Point x;
+            for(uint i=0; i<Dim; ++i)
+            {
+                double t_min = min[i] + lo[i]*step;
+                double t_max = std::min(min[i] + (hi[i]+1)*step, double(max[i]));
+                x[i] = (t_max-t_min)*(random_uint(s++)/static_cast<double>(max_uint)) + t_min;
+            }
+            if(valid(x))
+            {
+                add(x);
+                break;
+            }
+        }
+
+        while(!active_list.empty())
+        {
+            uint r = static_cast<int>(random_float(s++, 0, active_list.size()-0.0001f));
+            uint p = active_list[r];
+            bool found_sample = false;
+            Point x;
+            for(int attempt=0; attempt<max_attempts; ++attempt)
+            {
+                sample_annulus<Dim,Point>(radius, pool[p], s, x);
+                if(valid(x))
+                {
+                    found_sample = true;
+                    break;
+                }
+            }
+
+            if(found_sample) add(x);
+            else
+            {
+                // since we couldn't find a sample on p's disk, we remove p from the active list
+                active_list[r]=active_list.back();
+                active_list.pop_back();
+            }
+        }
+        return std::vector<Point>(pool.begin()+n_parents, pool.end());
+    };
+
+    for(uint phase=0; phase<(1u<<Dim); ++phase)
+    {
+        // tiles with coordinates having the parity encoded in the bits of phase
+        std::vector<Cell> tiles;
+        for(uint64_t t=0; t<tot_tiles; ++t)
+        {
+            Cell tile;
+            uint64_t tmp = t;
+            bool in_phase = true;
+            for(uint i=0; i<Dim; ++i)
+            {
+                tile[i] = static_cast<int>(tmp % n_tiles[i]);
+                tmp /= n_tiles[i];
+                if(uint(tile[i]&1) != ((phase>>i)&1)) in_phase = false;
+            }
+            if(in_phase) tiles.push_back(tile);
+        }
+
+        std::vector<std::vector<Point>> new_samples(tiles.size());
+        PARALLEL_FOR(0, uint(tiles.size()), 64, [&](uint t)
+        {
+            new_samples.at(t) = fill_tile(tiles.at(t));
+        });
+
+        for(uint t=0; t<tiles.size(); ++t)
+        {
+            if(new_samples.at(t).empty()) continue;
+            std::vector<uint> & ids = tile_samples[Poisson_cell_key<Dim>(tiles.at(t))];
+            for(const Point & x : new_samples.at(t))
+            {
+                ids.push_back(uint(samples.size()));
+                samples.push_back(x);
+            }
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// true if poly pid_end can be reached from poly pid_beg by walking on the surface,
+// without ever leaving the ball centered at center with the given radius
+template<class M, class V, class E, class P>
+CINO_INLINE
+bool Poisson_connected_within_ball(const AbstractPolygonMesh<M,V,E,P> & m,
+                                   const uint                           pid_beg,
+                                   const uint                           pid_end,
+                                   const vec3d                        & center,
+                                   const double                         radius)
+{
+    if(pid_beg==pid_end) return true;
+
+    auto intersects_ball = [&](const uint pid)
+    {
+        const std::vector<uint> & tess = m.poly_tessellation(pid);
+        for(uint i=0; i<tess.size(); i+=3)
+        {
+            if(point_to_triangle_dist_sqrd(center, m.vert(tess[i]), m.vert(tess[i+1]), m.vert(tess[i+2])) <= radius*radius) return true;
+        }
+        return false;
+    };
+
+    std::unordered_set<uint> visited = { pid_beg };
+    std::queue<uint> q;
+    q.push(pid_beg);
+    while(!q.empty())
+    {
+        uint pid = q.front();
+        q.pop();
+        for(uint nbr : m.adj_p2p(pid))
+        {
+            if(!visited.insert(nbr).second || !intersects_ball(nbr)) continue;
+            if(nbr==pid_end) return true;
+            q.push(nbr);
+        }
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void Poisson_sampling(const AbstractPolygonMesh<M,V,E,P> & m,
+                      const double                         radius,
+                      std::vector<vec3d>                 & samples,
+                      std::vector<uint>                  & polys,
+                      const bool                           geodesic,
+                      const std::vector<double>          & sizing,
+                      uint                                 seed,
+                      const uint                           candidates_per_disk)
+{
+    typedef std::array<int,3> Cell;
+
+    assert(sizing.empty() || sizing.size()==m.num_verts());
+    samples.clear();
+    polys.clear();
+    if(m.num_polys()==0) return;
+
+    auto vert_radius = [&](const uint vid) { return (sizing.empty()) ? radius : sizing.at(vid); };
+    auto poly_seed   = [&](const uint pid) { return random_uint(seed + random_uint(pid)); };
+
+    // 1) candidates, uniformly distributed by area. Each poly has its own random sequence,
+    //    therefore candidates are generated in parallel and independently of the thread count
+    std::vector<uint> offset(m.num_polys()+1,0);
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](uint pid)
+    {
+        const std::vector<uint> & tess = m.poly_tessellation(pid);
+        double n = 0;
+        for(uint i=0; i<tess.size(); i+=3)
+        {
+            double r = (vert_radius(tess[i]) + vert_radius(tess[i+1]) + vert_radius(tess[i+2]))/3.0;
+            n += candidates_per_disk * triangle_area(m.vert(tess[i]), m.vert(tess[i+1]), m.vert(tess[i+2])) / (M_PI*r*r);
+        }
+        // the fractional part becomes one more candidate, with the corresponding probability
+        uint n_whole = uint(n);
+        offset[pid+1] = n_whole + ((random_double(poly_seed(pid)) < n-n_whole) ? 1 : 0);
+    });
+    for(uint pid=0; pid<m.num_polys(); ++pid) offset[pid+1] += offset[pid];
+
+    std::vector<vec3d>  pos(offset.back());
+    std::vector<double> rad(offset.back());
+    std::vector<uint>   pid_of(offset.back());
+    std::vector<uint>   priority(offset.back()); // random visiting order
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](uint pid)
+    {
+        if(offset[pid]==offset[pid+1]) return;
+        uint s = poly_seed(pid)+1;
+        const std::vector<uint> & tess = m.poly_tessellation(pid);
+        std::vector<double> cumulative_area;
+        for(uint i=0; i<tess.size(); i+=3)
+        {
+            double a = triangle_area(m.vert(tess[i]), m.vert(tess[i+1]), m.vert(tess[i+2]));
+            cumulative_area.push_back((cumulative_area.empty()) ? a : cumulative_area.back()+a);
+        }
+        for(uint i=offset[pid]; i<offset[pid+1]; ++i)
+        {
+            uint t = 0;
+            if(cumulative_area.size()>1)
+            {
+                double a = random_double(s++, 0, cumulative_area.back());
+                t = uint(std::lower_bound(cumulative_area.begin(), cumulative_area.end(), a) - cumulative_area.begin());
+                t = std::min(t, uint(cumulative_area.size()-1));
+            }
+            uint v0 = tess[3*t], v1 = tess[3*t+1], v2 = tess[3*t+2];
+            double u = random_double(s++);
+            double v = random_double(s++);
+            if(u+v>1) { u = 1-u; v = 1-v; }
+            pos[i]      = m.vert(v0) + u*(m.vert(v1)-m.vert(v0)) + v*(m.vert(v2)-m.vert(v0));
+            rad[i]      = (1-u-v)*vert_radius(v0) + u*vert_radius(v1) + v*vert_radius(v2);
+            pid_of[i]   = pid;
+            priority[i] = random_uint(s++);
+        }
+    });
+    if(pos.empty()) return;
+
+    // 2) acceptance. Tiles have side 2*r_max and are visited in 8 phases (see Poisson_sampling_parallel).
+    //    The acceptance grid has cells of side r_max, and a cell may contain more than one sample
+    const double r_max  = *std::max_element(rad.begin(), rad.end());
+    const vec3d  origin = m.bbox().min;
+    auto cell_of = [&](const vec3d & p, const double size)
+    {
+        Cell c;
+        for(uint i=0; i<3; ++i) c[i] = static_cast<int>(std::floor((p[i]-origin[i])/size));
+        return c;
+    };
+    auto phase_of = [](const Cell & tile) { return uint(tile[0]&1) | uint(tile[1]&1)<<1 | uint(tile[2]&1)<<2; };
+
+    // sort candidates by phase, then tile, then visiting order
+    struct Entry { uint phase; uint64_t tile; uint priority; uint cid; };
+    std::vector<Entry> order(pos.size());
+    PARALLEL_FOR(0, uint(pos.size()), 10000, [&](uint cid)
+    {
+        Cell tile = cell_of(pos[cid], 2*r_max);
+        order[cid] = { phase_of(tile), Poisson_cell_key<3>(tile), priority[cid], cid };
+    });
+    std::sort(order.begin(), order.end(), [](const Entry & a, const Entry & b)
+    {
+        if(a.phase!=b.phase) return a.phase<b.phase;
+        if(a.tile !=b.tile ) return a.tile <b.tile;
+        if(a.priority!=b.priority) return a.priority<b.priority;
+        return a.cid<b.cid;
+    });
+
+    std::unordered_map<uint64_t,std::vector<uint>> grid; // cell => accepted candidates in it
+
+    auto conflicts = [&](const uint cid, const std::unordered_map<uint64_t,std::vector<uint>> & g)
+    {
+        Cell c = cell_of(pos[cid], r_max);
+        return !Poisson_for_each_cell<3>({c[0]-1,c[1]-1,c[2]-1}, {c[0]+1,c[1]+1,c[2]+1}, [&](const Cell & j)
+        {
+            auto it = g.find(Poisson_cell_key<3>(j));
+            if(it==g.end()) return true;
+            for(uint sid : it->second)
+            {
+                double r = std::max(rad[cid], rad[sid]);
+                if(pos[cid].dist_sqrd(pos[sid])>=r*r) continue;
+                if(!geodesic || Poisson_connected_within_ball(m, pid_of[cid], pid_of[sid], pos[cid], r)) return false;
+            }
+            return true;
+        });
+    };
+
+    uint beg = 0;
+    while(beg<order.size())
+    {
+        // tiles of the current phase: [tile_beg[i], tile_beg[i+1]) ranges in order
+        uint phase = order[beg].phase;
+        std::vector<uint> tile_beg;
+        uint end = beg;
+        for(; end<order.size() && order[end].phase==phase; ++end)
+        {
+            if(end==beg || order[end].tile!=order[end-1].tile) tile_beg.push_back(end);
+        }
+        tile_beg.push_back(end);
+
+        std::vector<std::vector<uint>> accepted(tile_beg.size()-1);
+        PARALLEL_FOR(0, uint(accepted.size()), 64, [&](uint t)
+        {
+            std::unordered_map<uint64_t,std::vector<uint>> local_grid;
+            for(uint i=tile_beg[t]; i<tile_beg[t+1]; ++i)
+            {
+                uint cid = order[i].cid;
+                if(conflicts(cid, grid) || conflicts(cid, local_grid)) continue;
+                local_grid[Poisson_cell_key<3>(cell_of(pos[cid], r_max))].push_back(cid);
+                accepted.at(t).push_back(cid);
+            }
+        });
+
+        for(const auto & tile_samples : accepted)
+        for(uint cid : tile_samples)
+        {
+            grid[Poisson_cell_key<3>(cell_of(pos[cid], r_max))].push_back(cid);
+            samples.push_back(pos[cid]);
+            polys.push_back(pid_of[cid]);
+        }
+        beg = end;
+    }
+}
+
 }
@@ -37,6 +37,7 @@
 #define CINO_POISSON_SAMPLING
 
 #include <cinolib/cino_inline.h>
+#include <cinolib/meshes/abstract_polygonmesh.h>
 #include <sys/types.h>
 
 namespace cinolib
@@ -59,6 +60,54 @@ void Poisson_sampling(const double         radius,
                       uint                 seed=0,
                       const int            max_attempts=30);
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Parallel variant of the function above. The domain is split into tiles with
+ * side >= 2*radius, and tiles are grouped in 2^Dim phases according to the parity
+ * of their coordinates. Tiles in the same phase are at least one tile apart, hence
+ * they can be filled concurrently without conflicts. Each tile runs Bridson's
+ * algorithm locally, growing from its own random seed point and from the samples
+ * generated by previous phases in nearby tiles. Samples are stored in a sparse hash
+ * grid, so memory is proportional to the number of samples, not to the volume of
+ * the domain. The output is deterministic for a given seed, regardless of the
+ * number of threads.
+*/
+template<uint Dim, class Point>
+CINO_INLINE
+void Poisson_sampling_parallel(const double         radius,
+                               const Point          min,
+                               const Point          max,
+                               std::vector<Point> & samples,
+                               uint                 seed=0,
+                               const int            max_attempts=30);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Poisson disk sampling of the surface of a polygon mesh. Candidate points are
+ * drawn uniformly by area (candidates_per_disk points per disk of radius r), in
+ * parallel. They are then visited in random order, and a candidate is accepted
+ * if there is no sample closer than max(r_candidate,r_sample). Acceptance uses the
+ * same tiled/phased parallel scheme of Poisson_sampling_parallel.
+ *
+ * The radius can be made spatially varying by providing a per vertex sizing field,
+ * which overrides the global radius and is linearly interpolated inside triangles.
+ * Distances are Euclidean by default. If geodesic is true, two points conflict only
+ * if they are also connected through the surface, without ever leaving the ball of
+ * radius r around the candidate (an approximation of the geodesic disk, which
+ * prevents close sheets, like the two sides of a thin wall, from suppressing each
+ * other's samples). For each sample, polys contains the id of the poly hosting it.
+*/
+template<class M, class V, class E, class P>
+CINO_INLINE
+void Poisson_sampling(const AbstractPolygonMesh<M,V,E,P> & m,
+                      const double                         radius,
+                      std::vector<vec3d>                 & samples,
+                      std::vector<uint>                  & polys,
+                      const bool                           geodesic = false,
+                      const std::vector<double>          & sizing = std::vector<double>(),
+                      uint                                 seed = 0,
+                      const uint                           candidates_per_disk = 20);
+
 }
 
 #ifndef  CINO_STATIC_LIB
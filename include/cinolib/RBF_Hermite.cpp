@@ -77,7 +77,10 @@ Hermite_RBF<RBF>::Hermite_RBF(const std::vector<vec3d> & points,
             double len=diff.norm();
             if(len==0)
             {
+                // limit for len->0 (all zeros for kernels such as x^3)
                 A.template block<4,4>(ii,jj).setZero();
+                A(ii,jj) = RBF::eval_f(0);
+                A.template block<3,3>(ii+1,jj+1).diagonal().array() += RBF::eval_ddf(0);
             }
             else
             {
@@ -129,6 +132,7 @@ double Hermite_RBF<RBF>::eval(const vec3d & p) const
             val += alpha(i) * RBF::eval_f(l);
             val += beta.col(i).dot(diff)*RBF::eval_df(l)/l;
         }
+        else val += alpha(i) * RBF::eval_f(0);
     }
     return val;
 }
@@ -163,6 +167,7 @@ vec3d Hermite_RBF<RBF>::eval_grad(const vec3d &p) const
             grad += alpha_dphi * diffNormalized;
             grad += bDotd_l * (ddphi*diffNormalized - diff*dphi/squared_l) + beta*dphi/len ;
         }
+        else grad += beta * RBF::eval_ddf(0);
     }
 
     return vec3d(grad[0], grad[1], grad[2]);
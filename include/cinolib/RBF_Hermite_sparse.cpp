@@ -0,0 +1,315 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/RBF_Hermite_sparse.h>
+#include <cinolib/parallel_for.h>
+#include <Eigen/Sparse>
+#include <algorithm>
+#include <numeric>
+
+namespace cinolib
+{
+
+template<class RBF>
+CINO_INLINE
+Sparse_Hermite_RBF<RBF>::Sparse_Hermite_RBF(const std::vector<vec3d> & points,
+                                            const std::vector<vec3d> & normals,
+                                            const double               support_radius,
+                                            const int                  solver)
+{
+    assert(points.size()==normals.size());
+
+    uint np = uint(points.size());
+    alpha.resize(np);
+    beta.resize(3, np);
+    center.resize(3, np);
+    if(np==0) return;
+
+    // copy the node centers
+    for(uint i=0; i<np; ++i)
+    {
+        center.col(i) = Eigen::Vector3d(points.at(i).x(), points.at(i).y(), points.at(i).z());
+    }
+
+    radius = support_radius;
+    if(radius<=0)
+    {
+        // estimate the sampling density assuming points are spread over a surface,
+        // and set the support to three times the average distance between closest points
+        AABB box(points);
+        radius = std::max(box.diag()/std::sqrt(double(np)), 1e-10);
+        build_grid(points);
+        std::vector<double> nn(np, inf_double);
+        PARALLEL_FOR(0, np, 1000, [&](const uint i)
+        {
+            for_each_center_within_support(points.at(i), [&](const uint j, const Eigen::Vector3d &, const double len)
+            {
+                if(j!=i) nn.at(i) = std::min(nn.at(i), len);
+            });
+        });
+        double sum = 0;
+        uint   cnt = 0;
+        for(double d : nn) if(d<inf_double) { sum += d; ++cnt; }
+        if(cnt>0 && sum>0) radius = 3.0*sum/cnt;
+        else               radius *= 3.0;
+    }
+    build_grid(points);
+
+    // assemble the system, one block row at a time. Gradient constraints are
+    // negated, so that the matrix is symmetric positive definite (it is congruent
+    // to the Hermite-Birkhoff interpolation matrix of the kernel)
+    std::vector<std::vector<Eigen::Triplet<double>>> rows(np);
+    Eigen::VectorXd f(4*np);
+    PARALLEL_FOR(0, np, 1000, [&](const uint i)
+    {
+        uint ii = 4*i;
+        f(ii) = 0;
+        f(ii+1) = -normals.at(i).x();
+        f(ii+2) = -normals.at(i).y();
+        f(ii+3) = -normals.at(i).z();
+
+        std::vector<Eigen::Triplet<double>> & row = rows.at(i);
+        for_each_center_within_support(points.at(i), [&](const uint j, const Eigen::Vector3d & diff, const double len)
+        {
+            uint jj = 4*j;
+            if(len==0)
+            {
+                // limit for len->0
+                row.emplace_back(ii, jj, RBF::eval_f(0));
+                for(uint k=1; k<4; ++k) row.emplace_back(ii+k, jj+k, -RBF::eval_ddf(0)/(radius*radius));
+                return;
+            }
+            double r    = len/radius;
+            double w    = RBF::eval_f(r);
+            double dw_l = RBF::eval_df(r)/(radius*len);
+            double ddw  = RBF::eval_ddf(r)/(radius*radius);
+            Eigen::Vector3d g = diff*dw_l;
+            Eigen::Matrix3d H = (ddw - dw_l)/(len*len) * (diff*diff.transpose());
+            H.diagonal().array() += dw_l;
+            row.emplace_back(ii, jj, w);
+            for(uint k=0; k<3; ++k)
+            {
+                row.emplace_back(ii,     jj+1+k,  g[k]);
+                row.emplace_back(ii+1+k, jj,     -g[k]);
+                for(uint l=0; l<3; ++l) row.emplace_back(ii+1+k, jj+1+l, -H(k,l));
+            }
+        });
+    });
+
+    std::vector<Eigen::Triplet<double>> entries;
+    entries.reserve(std::accumulate(rows.begin(), rows.end(), size_t(0), [](size_t s, const auto & r){ return s + r.size(); }));
+    for(auto & row : rows)
+    {
+        entries.insert(entries.end(), row.begin(), row.end());
+        std::vector<Eigen::Triplet<double>>().swap(row);
+    }
+    Eigen::SparseMatrix<double> A(4*np, 4*np);
+    A.setFromTriplets(entries.begin(), entries.end());
+    std::vector<Eigen::Triplet<double>>().swap(entries);
+
+    Eigen::VectorXd x;
+    solve_square_system(A, f, x, solver);
+    Eigen::Map<Eigen::Matrix4Xd> mx(x.data(), 4, np);
+
+    alpha = mx.row(0);
+    beta  = mx.template bottomRows<3>();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class RBF>
+CINO_INLINE
+ScalarField Sparse_Hermite_RBF<RBF>::eval(const std::vector<vec3d> & plist) const
+{
+    ScalarField f(uint(plist.size()));
+    PARALLEL_FOR(0, uint(plist.size()), 1000, [&](const uint i)
+    {
+        f[i] = eval(plist.at(i));
+    });
+    return f;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class RBF>
+CINO_INLINE
+double Sparse_Hermite_RBF<RBF>::eval(const vec3d & p) const
+{
+    double val = 0;
+    for_each_center_within_support(p, [&](const uint i, const Eigen::Vector3d & diff, const double len)
+    {
+        if(len>0)
+        {
+            double r = len/radius;
+            val += alpha(i) * RBF::eval_f(r);
+            val += beta.col(i).dot(diff) * RBF::eval_df(r)/(radius*len);
+        }
+        else val += alpha(i) * RBF::eval_f(0);
+    });
+    return val;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class RBF>
+CINO_INLINE
+std::vector<vec3d> Sparse_Hermite_RBF<RBF>::eval_grad(const std::vector<vec3d> & plist) const
+{
+    std::vector<vec3d> g(plist.size());
+    PARALLEL_FOR(0, uint(plist.size()), 1000, [&](const uint i)
+    {
+        g.at(i) = eval_grad(plist.at(i));
+    });
+    return g;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class RBF>
+CINO_INLINE
+vec3d Sparse_Hermite_RBF<RBF>::eval_grad(const vec3d & p) const
+{
+    Eigen::Vector3d grad = Eigen::Vector3d::Zero();
+    for_each_center_within_support(p, [&](const uint i, const Eigen::Vector3d & diff, const double len)
+    {
+        if(len>0)
+        {
+            double r    = len/radius;
+            double dw_l = RBF::eval_df(r)/(radius*len);
+            double ddw  = RBF::eval_ddf(r)/(radius*radius);
+            Eigen::Vector3d b = beta.col(i);
+            grad += alpha(i)*dw_l*diff;
+            grad += (ddw - dw_l)/(len*len) * b.dot(diff) * diff + dw_l*b;
+        }
+        else grad += beta.col(i) * RBF::eval_ddf(0)/(radius*radius);
+    });
+    return vec3d(grad[0], grad[1], grad[2]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class RBF>
+CINO_INLINE
+void Sparse_Hermite_RBF<RBF>::build_grid(const std::vector<vec3d> & points)
+{
+    grid_box = AABB(points);
+    assert(grid_box.delta().max_entry()/radius < double(1<<21));
+
+    std::vector<uint64_t> keys(points.size());
+    PARALLEL_FOR(0, uint(points.size()), 1000, [&](const uint i)
+    {
+        int64_t c[3];
+        cell_of(points.at(i), c);
+        keys.at(i) = (uint64_t(c[0])<<42) | (uint64_t(c[1])<<21) | uint64_t(c[2]);
+    });
+
+    ids.resize(points.size());
+    std::iota(ids.begin(), ids.end(), 0);
+    std::sort(ids.begin(), ids.end(), [&](const uint i, const uint j)
+    {
+        return keys.at(i)<keys.at(j) || (keys.at(i)==keys.at(j) && i<j);
+    });
+
+    cell_keys.clear();
+    cell_beg.clear();
+    for(uint i=0; i<ids.size(); ++i)
+    {
+        uint64_t k = keys.at(ids.at(i));
+        if(cell_keys.empty() || cell_keys.back()!=k)
+        {
+            cell_keys.push_back(k);
+            cell_beg.push_back(i);
+        }
+    }
+    cell_beg.push_back(uint(ids.size()));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class RBF>
+CINO_INLINE
+void Sparse_Hermite_RBF<RBF>::cell_of(const vec3d & p, int64_t c[3]) const
+{
+    for(uint i=0; i<3; ++i) c[i] = int64_t(std::floor((p[i]-grid_box.min[i])/radius));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class RBF>
+CINO_INLINE
+bool Sparse_Hermite_RBF<RBF>::cell_range(const int64_t c[3], uint & beg, uint & end) const
+{
+    for(uint i=0; i<3; ++i) if(c[i]<0 || c[i]>=(1<<21)) return false;
+    uint64_t k  = (uint64_t(c[0])<<42) | (uint64_t(c[1])<<21) | uint64_t(c[2]);
+    auto     it = std::lower_bound(cell_keys.begin(), cell_keys.end(), k);
+    if(it==cell_keys.end() || *it!=k) return false;
+    uint pos = uint(it - cell_keys.begin());
+    beg = cell_beg.at(pos);
+    end = cell_beg.at(pos+1);
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class RBF>
+template<typename F>
+CINO_INLINE
+void Sparse_Hermite_RBF<RBF>::for_each_center_within_support(const vec3d & p, F && func) const
+{
+    if(cell_keys.empty()) return;
+    // centers are visited in the same order regardless of the caller, so that
+    // results are deterministic
+    Eigen::Vector3d pp(p.x(), p.y(), p.z());
+    double r2 = radius*radius;
+    int64_t c[3];
+    cell_of(p, c);
+    int64_t n[3];
+    for(n[0]=c[0]-1; n[0]<=c[0]+1; ++n[0])
+    for(n[1]=c[1]-1; n[1]<=c[1]+1; ++n[1])
+    for(n[2]=c[2]-1; n[2]<=c[2]+1; ++n[2])
+    {
+        uint beg, end;
+        if(!cell_range(n, beg, end)) continue;
+        for(uint k=beg; k<end; ++k)
+        {
+            uint i = ids[k];
+            Eigen::Vector3d diff = pp - center.col(i);
+            double len2 = diff.squaredNorm();
+            if(len2<r2) func(i, diff, std::sqrt(len2));
+        }
+    }
+}
+
+}
@@ -0,0 +1,130 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_RBF_HERMITE_SPARSE_H
+#define CINO_RBF_HERMITE_SPARSE_H
+
+#include <cinolib/geometry/vec_mat.h>
+#include <cinolib/geometry/aabb.h>
+#include <cinolib/scalar_field.h>
+#include <cinolib/linear_solvers.h>
+#include <Eigen/Dense>
+
+namespace cinolib
+{
+
+/* Hermite RBF interpolation with compactly supported kernels (e.g. WendlandC2RBF
+ * and WendlandC4RBF in RBF_kernels.h), for large sets of oriented points (p_i,n_i).
+ *
+ * Contrary to Hermite_RBF, which assembles and factorizes a dense 4n x 4n system,
+ * each center only interacts with the centers falling within its support radius.
+ * The system is therefore sparse and, for positive definite kernels, symmetric positive
+ * definite. It is assembled in parallel and solved with any of the solvers available
+ * in linear_solvers.h (conjugate gradient by default). Centers are bucketed in a
+ * uniform grid with cell size equal to the support radius, so that evaluating the
+ * interpolant at a point only visits the 27 cells around it.
+ *
+ * If the support radius is not specified, it is set to a multiple of the average
+ * distance between each center and its closest neighbor. Note that the implicit
+ * function vanishes everywhere outside the union of the supports, hence the zero
+ * level set is meaningful only in a neighborhood of the input points.
+ *
+ * Reference academic resources are:
+ *
+ *     Hermite Radial Basis Functions Implicits
+ *     I. Macedo, J.P. Gois, L. Velho
+ *     Computer Graphics Forum (2011)
+ *
+ *     Interpolating Implicit Surfaces from Scattered Surface Data Using Compactly Supported Radial Basis Functions
+ *     B.S. Morse, T.S. Yoo, P. Rheingans, D.T. Chen, K.R. Subramanian
+ *     Shape Modeling International (2001)
+*/
+
+template<class RBF>
+class Sparse_Hermite_RBF
+{
+    public:
+
+        Sparse_Hermite_RBF(){}
+        Sparse_Hermite_RBF(const std::vector<vec3d> & points,
+                           const std::vector<vec3d> & normals,
+                           const double               support_radius = 0,          // 0 => automatic
+                           const int                  solver         = ConjugateGradient);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        ScalarField        eval     (const std::vector<vec3d> & plist) const; // evaluate RBF at points plist (in parallel)
+        double             eval     (const vec3d & p) const;                  // evaluate RBF at point p
+        std::vector<vec3d> eval_grad(const std::vector<vec3d> & plist) const; // evaluate nabla RBF at points plist (in parallel)
+        vec3d              eval_grad(const vec3d & p) const;                  // evaluate nabla RBF at point p
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        double support() const { return radius; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        Eigen::VectorXd  alpha;  // vector of scalar values alpha
+        Eigen::Matrix3Xd beta;   // each column represents beta_i: VectorX bi = beta.col(i);
+        Eigen::Matrix3Xd center; // each column represents p_i:    VectorX pi = centers.col(i);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    protected:
+
+        double radius = 0;
+
+        // uniform grid of buckets, sorted by cell key. Centers of the i-th
+        // non empty cell are ids[cell_beg[i]]...ids[cell_beg[i+1]-1]
+        AABB                  grid_box;
+        std::vector<uint64_t> cell_keys;
+        std::vector<uint>     cell_beg;
+        std::vector<uint>     ids;
+
+        void build_grid(const std::vector<vec3d> & points); // cells have size equal to radius
+        void cell_of   (const vec3d & p, int64_t c[3]) const;
+        bool cell_range(const int64_t c[3], uint & beg, uint & end) const;
+
+        template<typename F>
+        void for_each_center_within_support(const vec3d & p, F && func) const;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "RBF_Hermite_sparse.cpp"
+#endif
+
+#endif // CINO_RBF_HERMITE_SPARSE_H
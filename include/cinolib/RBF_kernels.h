@@ -47,6 +47,34 @@ class CubicRBF
     static inline double eval_ddf(const double x) { return 6*x;   } // second derivative
 };
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Wendland's compactly supported kernels (positive definite in R^3). They
+ * are defined over the unit support (i.e. they vanish for x>=1), and must be
+ * scaled to the desired support radius s as phi(x/s). See:
+ *
+ *     Piecewise polynomial, positive definite and compactly supported radial
+ *     functions of minimal degree
+ *     H. Wendland
+ *     Advances in Computational Mathematics (1995)
+*/
+
+class WendlandC2RBF
+{
+    public:
+    static inline double eval_f  (const double x) { if(x>=1) return 0; double t=1-x; return t*t*t*t*(4*x+1);  }
+    static inline double eval_df (const double x) { if(x>=1) return 0; double t=1-x; return -20*x*t*t*t;      } // first  derivative
+    static inline double eval_ddf(const double x) { if(x>=1) return 0; double t=1-x; return 20*t*t*(4*x-1);   } // second derivative
+};
+
+class WendlandC4RBF
+{
+    public:
+    static inline double eval_f  (const double x) { if(x>=1) return 0; double t=1-x, t2=t*t; return t2*t2*t2*(35*x*x+18*x+3);  }
+    static inline double eval_df (const double x) { if(x>=1) return 0; double t=1-x, t2=t*t; return -56*x*t2*t2*t*(5*x+1);      } // first  derivative
+    static inline double eval_ddf(const double x) { if(x>=1) return 0; double t=1-x, t2=t*t; return 56*t2*t2*(35*x*x-4*x-1);    } // second derivative
+};
+
 }
 
 #endif // CINO_RBF_KERNELS_H
@@ -37,6 +37,9 @@
 #include <cinolib/sphere_coverage.h>
 #include <cinolib/parallel_for.h>
 #include <cinolib/octree.h>
+#include <cinolib/random_generator.h>
+#include <cinolib/pi.h>
+#include <algorithm>
 
 namespace cinolib
 {
@@ -54,21 +57,18 @@ float ambient_occlusion(AbstractPolygonMesh<M,V,E,P> & m,
     uint  total  = 0;
     uint  shadow = 0;
     vec3d c      = m.poly_centroid(pid);
+    vec3d n      = m.poly_data(pid).normal;
+    // for numerical stability, discard intersections with the current element
+    std::function<bool(uint)> skip = [pid](uint id){ return id==pid; };
     for(const vec3d & d : dirs)
     {
-        std::set<std::pair<double,uint>> hits;
-        o.intersects_ray(c,d,hits);
-
-        // for numerical stability, discard intersections with the current element (if any)
-        while(!hits.empty() && hits.begin()->second==pid) hits.erase(hits.begin());
-
         // interior ray, discard
-        if(hits.size()%2!=0) continue;
+        if(d.dot(n)<=0) continue;
 
         ++total;
 
-        // first hit is beyond ray length, count as shadow
-        if(!hits.empty() && hits.begin()->first<len) ++shadow;
+        // any hit within ray length counts as shadow
+        if(o.any_hit(c,d,0,len,skip)) ++shadow;
     }
     if(shadow>0) return 1.f - float(shadow)/total;
     return 1.f;
@@ -152,4 +152,161 @@ void ambient_occlusion(AbstractPolyhedralMesh<M,V,E,F,P> & m, AO_data & data)
     }
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void ambient_occlusion_init(const AbstractPolygonMesh<M,V,E,P> & m, AO_progressive & ao)
+{
+    ao.octree = std::unique_ptr<Octree>(new Octree());
+    ao.octree->build_from_mesh_polys(m);
+    ao.len = ao.ray_length * m.bbox().diag();
+
+    uint np = m.num_polys();
+    ao.origins.resize(np);
+    ao.normals.resize(np);
+    ao.n_rays.assign(np,0);
+    ao.n_free.assign(np,0);
+    ao.poly_AO.assign(np,1.f);
+    ao.active.clear();
+    ao.updated.clear();
+    ao.cursor   = 0;
+    ao.tot_rays = 0;
+    for(uint pid=0; pid<np; ++pid)
+    {
+        ao.origins.at(pid) = m.poly_centroid(pid);
+        ao.normals.at(pid) = m.poly_data(pid).normal;
+        if(ao.normals.at(pid).norm()>0) ao.active.push_back(pid); // skip degenerate elements
+    }
+
+    uint nv = m.num_verts();
+    ao.v2p_offset.resize(nv+1);
+    ao.v2p.clear();
+    for(uint vid=0; vid<nv; ++vid)
+    {
+        ao.v2p_offset.at(vid) = uint(ao.v2p.size());
+        for(uint pid : m.adj_v2p(vid)) ao.v2p.push_back(pid);
+    }
+    ao.v2p_offset.at(nv) = uint(ao.v2p.size());
+    ao.vert_AO.assign(nv,1.f);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool ambient_occlusion_refine(AO_progressive & ao, const uint64_t ray_budget)
+{
+    auto radical_inverse = [](uint i, const uint base)
+    {
+        double inv = 1.0/base, f = inv, r = 0;
+        for(; i>0; i/=base, f*=inv) r += f*(i%base);
+        return r;
+    };
+
+    auto converged = [&](const uint pid)
+    {
+        uint n = ao.n_rays.at(pid);
+        if(n>=ao.max_rays) return true;
+        if(n<ao.min_rays) return false;
+        // Agresti-Coull like correction, so that a few unanimous rays do not yield a zero variance
+        double p = (ao.n_free.at(pid)+1.0)/(n+2.0);
+        return std::sqrt(p*(1-p)/n) < ao.tolerance;
+    };
+
+    std::vector<bool> touched(ao.n_rays.size(),false);
+    ao.updated.clear();
+    uint64_t budget = ray_budget;
+    while(budget>0)
+    {
+        if(ao.cursor>=ao.active.size())
+        {
+            // end of a round: drop converged elements
+            ao.active.erase(std::remove_if(ao.active.begin(), ao.active.end(), converged), ao.active.end());
+            ao.cursor = 0;
+            if(ao.active.empty()) break;
+        }
+
+        uint beg = ao.cursor;
+        uint end = uint(std::min<uint64_t>(ao.active.size(), beg + std::max<uint64_t>(1, budget/ao.rays_per_round)));
+        PARALLEL_FOR(beg, end, 64, [&](const uint i)
+        {
+            uint  pid = ao.active.at(i);
+            vec3d o   = ao.origins.at(pid);
+            vec3d n   = ao.normals.at(pid);
+
+            // orthonormal frame around the normal
+            // Ref: Building an Orthonormal Basis, Revisited (Duff et al. JCGT 2017)
+            double sign = std::copysign(1.0, n.z());
+            double a    = -1.0/(sign + n.z());
+            double b    = n.x()*n.y()*a;
+            vec3d  u(1.0 + sign*n.x()*n.x()*a, sign*b, -sign*n.x());
+            vec3d  v(b, sign + n.y()*n.y()*a, -n.y());
+
+            // per element rotation of the Halton sequence (Cranley-Patterson)
+            uint   s  = random_uint(ao.seed ^ random_uint(pid));
+            double r0 = random_uint(s  )/double(max_uint);
+            double r1 = random_uint(s+1)/double(max_uint);
+
+            // for numerical stability, discard intersections with the current element
+            std::function<bool(uint)> skip = [pid](uint id){ return id==pid; };
+
+            uint n_rays = std::min(ao.rays_per_round, ao.max_rays-ao.n_rays.at(pid));
+            for(uint j=0; j<n_rays; ++j)
+            {
+                uint   k  = ao.n_rays.at(pid)+j+1;
+                double s0 = radical_inverse(k,2) + r0; if(s0>=1) s0 -= 1;
+                double s1 = radical_inverse(k,3) + r1; if(s1>=1) s1 -= 1;
+                double z  = ao.cosine_weighted ? std::sqrt(1-s0) : s0;
+                double r  = std::sqrt(std::max(0.0, 1-z*z));
+                double phi = 2*M_PI*s1;
+                vec3d  d  = u*(r*std::cos(phi)) + v*(r*std::sin(phi)) + n*z;
+                if(!ao.octree->any_hit(o, d, 0, ao.len, skip)) ++ao.n_free.at(pid);
+            }
+            ao.n_rays.at(pid) += n_rays;
+        });
+
+        for(uint i=beg; i<end; ++i)
+        {
+            uint pid = ao.active.at(i);
+            ao.poly_AO.at(pid) = float(ao.n_free.at(pid))/ao.n_rays.at(pid);
+            if(!touched.at(pid)) ao.updated.push_back(pid);
+            touched.at(pid) = true;
+        }
+        uint64_t cost = uint64_t(end-beg)*ao.rays_per_round;
+        ao.tot_rays += cost;
+        budget      -= std::min(budget,cost);
+        ao.cursor    = end;
+    }
+
+    // per vertex AO, pooling the rays of the incident elements
+    PARALLEL_FOR(0, uint(ao.vert_AO.size()), 1000, [&](const uint vid)
+    {
+        uint64_t n = 0, n_free = 0;
+        bool     update = false;
+        for(uint i=ao.v2p_offset.at(vid); i<ao.v2p_offset.at(vid+1); ++i)
+        {
+            uint pid = ao.v2p.at(i);
+            n      += ao.n_rays.at(pid);
+            n_free += ao.n_free.at(pid);
+            update |= touched.at(pid);
+        }
+        if(update && n>0) ao.vert_AO.at(vid) = float(n_free)/n;
+    });
+
+    return ao.active.empty();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void ambient_occlusion_apply(AbstractPolygonMesh<M,V,E,P> & m, const AO_progressive & ao)
+{
+    assert(ao.poly_AO.size()==m.num_polys());
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    {
+        m.poly_data(pid).AO = ao.poly_AO.at(pid);
+    }
+}
+
 }
@@ -39,7 +39,10 @@
 
 #include <cinolib/meshes/abstract_polygonmesh.h>
 #include <cinolib/meshes/abstract_polyhedralmesh.h>
-#include <cinolib/meshes/drawable_trimesh.h>
+#include <cinolib/meshes/meshes.h>
+#include <cinolib/octree.h>
+#include <cstdint>
+#include <memory>
 
 namespace cinolib
 {
@@ -53,7 +56,7 @@ struct AO_data
     float contrast_floor = 2.5; // higher constrast for a more compact shadow
     float ray_length     = 1.0; // w.r.t. bbox diag
     bool  with_floor     = false;
-    DrawableTrimesh<> floor;
+    MaybeDrawableTrimesh<> floor;
 };
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -68,6 +71,75 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void ambient_occlusion(AbstractPolyhedralMesh<M,V,E,F,P> & m, AO_data & data);
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Progressive ambient occlusion. Rather than firing a fixed set of directions at once,
+ * rays are cast in rounds, so that the estimate can be refined over time (e.g. by a
+ * viewer, a little at each frame) and stopped at any point. Each element samples the
+ * hemisphere around its normal with its own randomly rotated Halton sequence, which
+ * is stratified and can be extended indefinitely. With cosine weighting the fraction
+ * of unoccluded rays directly estimates the cosine-weighted AO. Elements stop sampling
+ * as soon as the standard error of their estimate falls below the tolerance (after at
+ * least min_rays rays), so the ray budget goes where the estimate is still uncertain.
+ *
+ * Usage:
+ *
+ *   AO_progressive ao;
+ *   ambient_occlusion_init(m,ao);
+ *   while(!ambient_occlusion_refine(ao,100000)) { ambient_occlusion_apply(m,ao); ... }
+ *
+ * Per element AO is the ratio between unoccluded and cast rays. Per vertex AO pools
+ * the rays of all incident elements.
+*/
+
+struct AO_progressive
+{
+    float ray_length      = 1.0;   // w.r.t. bbox diag
+    uint  min_rays        = 16;    // per element, before testing convergence
+    uint  max_rays        = 256;   // per element
+    uint  rays_per_round  = 8;     // rays added to an active element each time it is visited
+    float tolerance       = 0.03f; // max standard error of a converged estimate
+    bool  cosine_weighted = true;  // cosine weighted or uniform hemisphere sampling
+    uint  seed            = 0;
+
+    // state (set by ambient_occlusion_init and advanced by ambient_occlusion_refine)
+    std::unique_ptr<Octree>  octree;
+    double                   len = 0;
+    std::vector<vec3d>       origins;       // per element
+    std::vector<vec3d>       normals;       // per element
+    std::vector<uint>        n_rays;        // per element, rays cast so far
+    std::vector<uint>        n_free;        // per element, rays that travelled ray_length unoccluded
+    std::vector<uint>        active;        // elements whose estimate has not converged yet
+    uint                     cursor   = 0;  // next active element to visit
+    uint64_t                 tot_rays = 0;
+    std::vector<uint>        v2p_offset;    // vertex to element adjacency (CSR), for per vertex AO
+    std::vector<uint>        v2p;
+    std::vector<float>       poly_AO;       // current estimates (1 = fully visible)
+    std::vector<float>       vert_AO;
+    std::vector<uint>        updated;       // elements refined by the last call to ambient_occlusion_refine
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// builds the octree and resets the state (parameters are kept)
+template<class M, class V, class E, class P>
+CINO_INLINE
+void ambient_occlusion_init(const AbstractPolygonMesh<M,V,E,P> & m, AO_progressive & ao);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// casts (approximately) ray_budget more rays and updates the estimates.
+// Returns true if all elements have converged
+CINO_INLINE
+bool ambient_occlusion_refine(AO_progressive & ao, const uint64_t ray_budget);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// copies the current per element estimates into the AO field of the mesh polygons
+template<class M, class V, class E, class P>
+CINO_INLINE
+void ambient_occlusion_apply(AbstractPolygonMesh<M,V,E,P> & m, const AO_progressive & ao);
+
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -141,6 +141,31 @@ BoostMultiPolygon polygon_union(const Poly0 & p0, const Poly1 & p1)
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<typename Poly>
+CINO_INLINE
+BoostMultiPolygon polygon_union(const std::vector<Poly> & polys)
+{
+    std::vector<BoostMultiPolygon> level;
+    level.reserve((polys.size()+1)/2);
+    for(uint i=0; i+1<polys.size(); i+=2) level.push_back(polygon_union(polys.at(i), polys.at(i+1)));
+    if(polys.size()%2==1)
+    {
+        BoostMultiPolygon mp;
+        boost::geometry::convert(polys.back(), mp);
+        level.push_back(mp);
+    }
+    while(level.size()>1)
+    {
+        uint n = level.size();
+        for(uint i=0; i+1<n; i+=2) level.at(i/2) = polygon_union(level.at(i), level.at(i+1));
+        if(n%2==1) level.at(n/2) = std::move(level.back());
+        level.resize((n+1)/2);
+    }
+    return level.empty() ? BoostMultiPolygon() : level.front();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<typename Poly0, typename Poly1>
 CINO_INLINE
 BoostMultiPolygon polygon_difference(const Poly0 & p0, const Poly1 & p1)
@@ -99,6 +99,16 @@ namespace cinolib
 
     //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+    // Union of a whole set of polygons. Rather than folding them one at a time
+    // (which costs O(n^2), as the accumulated result grows at each step), polygons
+    // are merged pairwise in a balanced tree, with O(log n) levels of unions
+    // between operands of similar size
+    template<typename Poly>
+    CINO_INLINE
+    BoostMultiPolygon polygon_union(const std::vector<Poly> & polys);
+
+    //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
     template<typename Poly0, typename Poly1>
     CINO_INLINE
     BoostMultiPolygon polygon_difference(const Poly0 & p0, const Poly1 & p1);
@@ -0,0 +1,218 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/cast_shadow_CPU.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/deg_rad.h>
+#include <cinolib/pi.h>
+#include <algorithm>
+
+namespace cinolib
+{
+
+// window coordinates of a vertex projected onto the image plane
+struct ShadowVert
+{
+    double x, y;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// top-left fill rule: pixel centers lying exactly on an edge are covered
+// only if the edge is a top or a left edge (assuming CCW triangles)
+CINO_INLINE
+bool shadow_edge_is_top_left(const ShadowVert & a, const ShadowVert & b)
+{
+    return (a.y==b.y && b.x<a.x) || (b.y<a.y);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// rasterizes triangle t within pixel range [x0,x1) x [y0,y1)
+CINO_INLINE
+void rasterize_shadow_triangle(const ShadowVert   t[3],
+                               const int          x0,
+                               const int          y0,
+                               const int          x1,
+                               const int          y1,
+                               const uint         w,
+                                     uint8_t    * data)
+{
+    // restrict the range to the triangle bbox
+    double min_x = std::min(t[0].x, std::min(t[1].x, t[2].x));
+    double max_x = std::max(t[0].x, std::max(t[1].x, t[2].x));
+    double min_y = std::min(t[0].y, std::min(t[1].y, t[2].y));
+    double max_y = std::max(t[0].y, std::max(t[1].y, t[2].y));
+    int bx0 = std::max(x0, int(std::floor(min_x-0.5)));
+    int bx1 = std::min(x1, int(std::ceil (max_x-0.5))+1);
+    int by0 = std::max(y0, int(std::floor(min_y-0.5)));
+    int by1 = std::min(y1, int(std::ceil (max_y-0.5))+1);
+    if(bx0>=bx1 || by0>=by1) return;
+
+    bool top_left[3];
+    for(int e=0; e<3; ++e) top_left[e] = shadow_edge_is_top_left(t[e], t[(e+1)%3]);
+
+    for(int j=by0; j<by1; ++j)
+    for(int i=bx0; i<bx1; ++i)
+    {
+        double px = i + 0.5;
+        double py = j + 0.5;
+        bool inside = true;
+        for(int e=0; e<3 && inside; ++e)
+        {
+            const ShadowVert & a = t[e];
+            const ShadowVert & b = t[(e+1)%3];
+            double f = (b.x-a.x)*(py-a.y) - (b.y-a.y)*(px-a.x);
+            inside = (f>0) || (f==0 && top_left[e]);
+        }
+        if(inside) data[j*w+i] = 0xFF;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+uint cast_shadow_CPU(const Mesh    & m,
+                     const vec3d   & dir,
+                     const uint      w,
+                     const uint      h,
+                           uint8_t * data,
+                     const bool      parallel,
+                     const uint      tile_size)
+{
+    assert(tile_size>0);
+    std::fill_n(data, w*h, 0x00);
+
+    // model-view transformation (same as cast_shadow): align the
+    // light direction with the Z axis, then fit the mesh into the
+    // [-1,1] box, and finally map it to the viewport
+    vec3d  Z(0,0,1);
+    vec3d  a = dir.cross(Z);
+    mat3d  R = mat3d::DIAG(vec3d(1,1,1));
+    if(a.norm()>0)
+    {
+        a.normalize();
+        R = mat3d::ROT_3D(a, to_rad(Z.angle_deg(dir)));
+    }
+    else if(dir.dot(Z)<0) // anti-parallel: any axis orthogonal to Z will do
+    {
+        R = mat3d::ROT_3D(vec3d(1,0,0), M_PI);
+    }
+    vec3d  c = m.centroid();
+    double s = 2.0/m.bbox().diag();
+
+    std::vector<ShadowVert> verts(m.num_verts());
+    for(uint vid=0; vid<m.num_verts(); ++vid)
+    {
+        vec3d p = R * ((m.vert(vid)-c)*s);
+        verts[vid].x = (p.x()+1.0)*0.5*w;
+        verts[vid].y = (p.y()+1.0)*0.5*h;
+    }
+
+    // collect projected triangles, in CCW order. Degenerate
+    // ones (e.g. triangles parallel to dir) are discarded
+    std::vector<ShadowVert> tris;
+    tris.reserve(3*m.num_polys());
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    {
+        const std::vector<uint> & tess = m.poly_tessellation(pid);
+        for(uint i=0; i+2<tess.size(); i+=3)
+        {
+            ShadowVert t[3] = { verts[tess[i]], verts[tess[i+1]], verts[tess[i+2]] };
+            double area = (t[1].x-t[0].x)*(t[2].y-t[0].y) - (t[1].y-t[0].y)*(t[2].x-t[0].x);
+            if(area==0) continue;
+            if(area<0) std::swap(t[1],t[2]);
+            tris.insert(tris.end(), t, t+3);
+        }
+    }
+    uint n_tris = tris.size()/3;
+
+    if(!parallel)
+    {
+        for(uint tid=0; tid<n_tris; ++tid)
+        {
+            rasterize_shadow_triangle(&tris[3*tid], 0, 0, int(w), int(h), w, data);
+        }
+        return uint(std::count(data, data+w*h, 0xFF));
+    }
+
+    // bin triangles into tiles
+    uint n_tiles_x = (w+tile_size-1)/tile_size;
+    uint n_tiles_y = (h+tile_size-1)/tile_size;
+    std::vector<std::vector<uint>> bins(n_tiles_x*n_tiles_y);
+    for(uint tid=0; tid<n_tris; ++tid)
+    {
+        const ShadowVert * t = &tris[3*tid];
+        double min_x = std::min(t[0].x, std::min(t[1].x, t[2].x));
+        double max_x = std::max(t[0].x, std::max(t[1].x, t[2].x));
+        double min_y = std::min(t[0].y, std::min(t[1].y, t[2].y));
+        double max_y = std::max(t[0].y, std::max(t[1].y, t[2].y));
+        if(max_x<0 || max_y<0 || min_x>=w || min_y>=h) continue;
+        uint tx0 = uint(std::max(0.0, min_x))/tile_size;
+        uint ty0 = uint(std::max(0.0, min_y))/tile_size;
+        uint tx1 = std::min(uint(max_x)/tile_size, n_tiles_x-1);
+        uint ty1 = std::min(uint(max_y)/tile_size, n_tiles_y-1);
+        for(uint ty=ty0; ty<=ty1; ++ty)
+        for(uint tx=tx0; tx<=tx1; ++tx)
+        {
+            bins[ty*n_tiles_x+tx].push_back(tid);
+        }
+    }
+
+    // rasterize tiles in parallel. Tiles are disjoint, hence no synchronization is needed
+    std::vector<uint> count(bins.size(),0);
+    PARALLEL_FOR(0, bins.size(), 4, [&](uint bid)
+    {
+        int x0 = (bid%n_tiles_x)*tile_size;
+        int y0 = (bid/n_tiles_x)*tile_size;
+        int x1 = std::min(x0+tile_size, w);
+        int y1 = std::min(y0+tile_size, h);
+        for(uint tid : bins[bid])
+        {
+            rasterize_shadow_triangle(&tris[3*tid], x0, y0, x1, y1, w, data);
+        }
+        for(int j=y0; j<y1; ++j)
+        {
+            count[bid] += uint(std::count(data+j*w+x0, data+j*w+x1, 0xFF));
+        }
+    });
+
+    uint n_pixels = 0;
+    for(uint n : count) n_pixels += n;
+    return n_pixels;
+}
+
+}
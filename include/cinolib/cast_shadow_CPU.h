@@ -0,0 +1,76 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_CAST_SHADOW_CPU_H
+#define CINO_CAST_SHADOW_CPU_H
+
+#include <cinolib/geometry/vec_mat.h>
+
+namespace cinolib
+{
+
+/* Software counterpart of cast_shadow, which does not need any GL context
+ * (nor a display), hence can run headless on compute nodes. The mesh is
+ * transformed with the same model-view-projection used by cast_shadow, and
+ * its triangles are rasterized on a w x h buffer, marking with 0xFF all the
+ * pixels having their center inside some triangle (top-left fill rule, as
+ * in OpenGL) and with 0x00 the background. Rows are stored bottom to top,
+ * as returned by glReadPixels. Differently from the GL version, geometry is
+ * not clipped along the projection direction.
+ *
+ * The image is split into tiles of tile_size x tile_size pixels, triangles
+ * are binned per tile, and tiles are rasterized in parallel. If the function
+ * is called from within a parallel loop, set parallel to false so as to use
+ * a single thread (and skip binning altogether).
+ *
+ * The method returns the exact number of pixels covered by the shadow.
+*/
+
+template<class Mesh>
+CINO_INLINE
+uint cast_shadow_CPU(const Mesh    & m,                 // mesh to be rendered
+                     const vec3d   & dir,               // light direction
+                     const uint      w,                 // width
+                     const uint      h,                 // height
+                           uint8_t * data,              // w x h buffer, 8 bits per pixel
+                     const bool      parallel  = true,  // rasterize tiles in parallel
+                     const uint      tile_size = 32);   // tile size (in pixels)
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "cast_shadow_CPU.cpp"
+#endif
+
+#endif // CINO_CAST_SHADOW_CPU_H
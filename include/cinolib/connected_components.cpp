@@ -35,6 +35,8 @@
 *********************************************************************************/
 #include <cinolib/connected_components.h>
 #include <cinolib/bfs.h>
+#include <cinolib/parallel_for.h>
+#include <atomic>
 
 namespace cinolib
 {
@@ -54,24 +56,194 @@ CINO_INLINE
 uint connected_components(const AbstractMesh<M,V,E,P> & m,
                           std::vector<std::unordered_set<uint>> & ccs)
 {
+    std::vector<uint> vert_cc;
+    uint n_ccs = connected_components(m, vert_cc);
+
     ccs.clear();
-    uint seed = 0;
-    std::vector<bool> visited(m.num_verts(), false);
+    ccs.resize(n_ccs);
+    for(uint vid=0; vid<m.num_verts(); ++vid) ccs.at(vert_cc.at(vid)).insert(vid);
+
+    return uint(ccs.size());
+}
 
-    do
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Lock-free union-find. Each root is the smallest id in its set and parent ids only
+// decrease over time, so that concurrent finds and merges can safely interleave
+CINO_INLINE
+uint union_find_root(std::vector<std::atomic<uint>> & parent, uint x)
+{
+    while(true)
+    {
+        uint p = parent[x].load();
+        if(p==x) return x;
+        uint gp = parent[p].load();
+        if(gp!=p) parent[x].compare_exchange_weak(p,gp); // path halving
+        x = gp;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void union_find_merge(std::vector<std::atomic<uint>> & parent, uint a, uint b)
+{
+    while(true)
     {
-        std::unordered_set<uint> cc;
-        bfs(m, seed, cc);
+        a = union_find_root(parent,a);
+        b = union_find_root(parent,b);
+        if(a==b) return;
+        if(a<b) std::swap(a,b);
+        // hook the larger root below the smaller one. Fails if a
+        // is no longer a root, in which case we just try again
+        uint expected = a;
+        if(parent[a].compare_exchange_strong(expected,b)) return;
+    }
+}
 
-        ccs.push_back(cc);
-        for(uint vid : cc) visited.at(vid) = true;
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        seed = 0;
-        while (seed < m.num_verts() && visited.at(seed)) ++seed;
+// flattens the union-find into component labels, numbered in order of their lowest element id
+CINO_INLINE
+uint union_find_labels(std::vector<std::atomic<uint>> & parent, std::vector<uint> & labels)
+{
+    uint n = uint(parent.size());
+    labels.resize(n);
+    PARALLEL_FOR(0, n, 10000, [&](const uint i)
+    {
+        labels[i] = union_find_root(parent,i);
+    });
+    uint n_ccs = 0;
+    for(uint i=0; i<n; ++i)
+    {
+        // roots come before the other elements in their set, hence they are already labeled
+        labels[i] = (labels[i]==i) ? n_ccs++ : labels[labels[i]];
     }
-    while (seed < m.num_verts());
+    return n_ccs;
+}
 
-    return uint(ccs.size());
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+uint connected_components(const AbstractMesh<M,V,E,P>     & m,
+                                std::vector<uint>         & vert_cc,
+                          const std::function<bool(uint)> & edge_barrier)
+{
+    std::vector<std::atomic<uint>> parent(m.num_verts());
+    PARALLEL_FOR(0, m.num_verts(), 10000, [&](const uint vid)
+    {
+        parent[vid] = vid;
+    });
+    PARALLEL_FOR(0, m.num_edges(), 10000, [&](const uint eid)
+    {
+        if(edge_barrier && edge_barrier(eid)) return;
+        union_find_merge(parent, m.edge_vert_id(eid,0), m.edge_vert_id(eid,1));
+    });
+    return union_find_labels(parent, vert_cc);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+uint connected_components_dual(const AbstractPolygonMesh<M,V,E,P> & m,
+                                     std::vector<uint>            & poly_cc,
+                                     std::vector<CC_stats>        & stats,
+                               const std::function<bool(uint)>    & edge_barrier)
+{
+    std::vector<std::atomic<uint>> parent(m.num_polys());
+    PARALLEL_FOR(0, m.num_polys(), 10000, [&](const uint pid)
+    {
+        parent[pid] = pid;
+    });
+    PARALLEL_FOR(0, m.num_edges(), 10000, [&](const uint eid)
+    {
+        if(edge_barrier && edge_barrier(eid)) return;
+        const std::vector<uint> & polys = m.adj_e2p(eid);
+        for(uint i=1; i<polys.size(); ++i) union_find_merge(parent, polys.front(), polys.at(i));
+    });
+    uint n_ccs = union_find_labels(parent, poly_cc);
+
+    // per element contributions (the enclosed volume is computed with the divergence theorem)
+    std::vector<double> area(m.num_polys());
+    std::vector<double> volume(m.num_polys());
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](const uint pid)
+    {
+        area[pid]   = m.poly_area(pid);
+        volume[pid] = 0;
+        const std::vector<uint> & tris = m.poly_tessellation(pid);
+        for(uint i=0; i<tris.size(); i+=3)
+        {
+            volume[pid] += m.vert(tris.at(i)).dot(m.vert(tris.at(i+1)).cross(m.vert(tris.at(i+2))))/6.0;
+        }
+    });
+
+    stats.clear();
+    stats.resize(n_ccs);
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    {
+        CC_stats & cc = stats.at(poly_cc.at(pid));
+        cc.size++;
+        cc.area   += area[pid];
+        cc.volume += volume[pid];
+        for(uint vid : m.adj_p2v(pid)) cc.bbox.push(m.vert(vid));
+    }
+    return n_ccs;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+uint connected_components_dual(const AbstractPolyhedralMesh<M,V,E,F,P> & m,
+                                     std::vector<uint>                 & poly_cc,
+                                     std::vector<CC_stats>             & stats,
+                               const std::function<bool(uint)>         & face_barrier)
+{
+    std::vector<std::atomic<uint>> parent(m.num_polys());
+    PARALLEL_FOR(0, m.num_polys(), 10000, [&](const uint pid)
+    {
+        parent[pid] = pid;
+    });
+    PARALLEL_FOR(0, m.num_faces(), 10000, [&](const uint fid)
+    {
+        if(face_barrier && face_barrier(fid)) return;
+        const std::vector<uint> & polys = m.adj_f2p(fid);
+        for(uint i=1; i<polys.size(); ++i) union_find_merge(parent, polys.front(), polys.at(i));
+    });
+    uint n_ccs = union_find_labels(parent, poly_cc);
+
+    // per element contributions. A face is on the boundary of a component
+    // if it is on the surface or if the polyhedron beyond it is elsewhere
+    std::vector<double> area(m.num_polys());
+    std::vector<double> volume(m.num_polys());
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](const uint pid)
+    {
+        volume[pid] = m.poly_volume(pid);
+        area[pid]   = 0;
+        for(uint fid : m.adj_p2f(pid))
+        {
+            bool on_boundary = true;
+            for(uint nbr : m.adj_f2p(fid))
+            {
+                if(nbr!=pid && poly_cc[nbr]==poly_cc[pid]) on_boundary = false;
+            }
+            if(on_boundary) area[pid] += m.face_area(fid);
+        }
+    });
+
+    stats.clear();
+    stats.resize(n_ccs);
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    {
+        CC_stats & cc = stats.at(poly_cc.at(pid));
+        cc.size++;
+        cc.area   += area[pid];
+        cc.volume += volume[pid];
+        for(uint vid : m.adj_p2v(pid)) cc.bbox.push(m.vert(vid));
+    }
+    return n_ccs;
 }
 
 }
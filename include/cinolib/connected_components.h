@@ -37,9 +37,13 @@
 #define CINO_CONNECTED_COMPONENTS_H
 
 #include <vector>
+#include <functional>
 #include <sys/types.h>
 #include <cinolib/cino_inline.h>
 #include <cinolib/meshes/abstract_mesh.h>
+#include <cinolib/meshes/abstract_polygonmesh.h>
+#include <cinolib/meshes/abstract_polyhedralmesh.h>
+#include <cinolib/geometry/aabb.h>
 
 namespace cinolib
 {
@@ -55,6 +59,53 @@ CINO_INLINE
 uint connected_components(const AbstractMesh<M,V,E,P> & m,
                           std::vector<std::unordered_set<uint>> & ccs);
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* The functions below compute all components at once with a parallel (lock-free) union-find,
+ * and return them as a flat array of labels, with components numbered in order of their
+ * lowest element id. Barrier predicates (if any) tell which edges/faces cannot be crossed,
+ * e.g. to flood-fill the regions bounded by CREASE or MARKED edges:
+ *
+ *   connected_components_dual(m, poly_cc, stats, [&](uint eid){ return m.edge_data(eid).flags[CREASE]; });
+*/
+
+struct CC_stats
+{
+    uint   size   = 0; // number of elements (verts or polys) in the component
+    AABB   bbox;
+    double area   = 0; // surface meshes: total area. Volume meshes: area of the boundary of the component
+    double volume = 0; // surface meshes: enclosed (signed) volume, meaningful for closed components. Volume meshes: total volume
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// vertex components: vertices are connected by edges for which edge_barrier is false
+template<class M, class V, class E, class P>
+CINO_INLINE
+uint connected_components(const AbstractMesh<M,V,E,P>     & m,
+                                std::vector<uint>         & vert_cc,
+                          const std::function<bool(uint)> & edge_barrier = nullptr);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// polygon components: polygons are connected by edges for which edge_barrier is false
+template<class M, class V, class E, class P>
+CINO_INLINE
+uint connected_components_dual(const AbstractPolygonMesh<M,V,E,P> & m,
+                                     std::vector<uint>            & poly_cc,
+                                     std::vector<CC_stats>        & stats,
+                               const std::function<bool(uint)>    & edge_barrier = nullptr);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// polyhedron components: polyhedra are connected by faces for which face_barrier is false
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+uint connected_components_dual(const AbstractPolyhedralMesh<M,V,E,F,P> & m,
+                                     std::vector<uint>                 & poly_cc,
+                                     std::vector<CC_stats>             & stats,
+                               const std::function<bool(uint)>         & face_barrier = nullptr);
+
 }
 
 #ifndef  CINO_STATIC_LIB
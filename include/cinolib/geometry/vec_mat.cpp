@@ -373,6 +373,18 @@ mat<r,c,T> mat<r,c,T>::closest_orthogonal_matrix(const bool force_positive_det)
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<uint r, uint c, class T>
+CINO_INLINE
+mat<r,c,T> mat<r,c,T>::closest_rotation() const
+{
+    static_assert(r==3 && c==3, "closest_rotation is defined for 3x3 matrices only");
+    mat<r,c,T> res;
+    mat_closest_rot_33<T>(_mat, res._mat);
+    return res;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<uint r, uint c, class T>
 CINO_INLINE
 mat<r,1,T> mat<r,c,T>::solve(const mat<c,1,T> & b)
@@ -113,6 +113,7 @@ class mat
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         mat<r,c,T> closest_orthogonal_matrix(const bool force_positve_det) const;
+        mat<r,c,T> closest_rotation         () const; // 3x3 only
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
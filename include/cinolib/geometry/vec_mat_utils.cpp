@@ -38,6 +38,7 @@
 #include <cinolib/deg_rad.h>
 #include <iostream>
 #include <cmath>
+#include <limits>
 #include <assert.h>
 #include <Eigen/Dense>
 
@@ -968,6 +969,138 @@ void mat_closest_orth_mat(const T m[][d], T n[][d], const bool force_pos_det)
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// Rotation R that maximizes trace(R^T * m), i.e. the rotational part of the polar
+// decomposition of m (also equal to U*diag(1,1,det(U*V^T))*V^T, with m = U*S*V^T).
+// This is a specialized (and much faster) alternative to a generic SVD, along the
+// lines of:
+//
+//   Computing the Singular Value Decomposition of 3x3 matrices with minimal branching and elementary floating point operations
+//   Aleka McAdams, Andrew Selle, Rasmus Tamstorf, Joseph Teran, Eftychios Sifakis
+//   University of Wisconsin - Madison technical report TR1690 (2011)
+//
+// V is obtained with a fixed number of cyclic Jacobi sweeps on m^T*m, then U is
+// obtained as the QR decomposition (Givens rotations) of m*V, with columns sorted
+// by decreasing norm. Both U and V are rotations, hence any reflection ends up in
+// the sign of the smallest singular value, as needed for the closest proper rotation.
+// As in the paper, there is no data dependent control flow: the number of sweeps is
+// fixed, and degenerate rotations and column swaps are resolved with selects, so that
+// the kernel can be inlined and vectorized across many matrices (e.g. the per vertex
+// rotations of ARAP). Differently from the paper, Jacobi rotations are computed exactly
+// (one square root and one division each) rather than with the approximate quaternion
+// Givens, and in the precision of T. Four sweeps (as in the paper) reach double precision
+// on the inputs tested (see tests/mat_closest_rotation.cpp). The kernel is plain scalar
+// code without intrinsics: vectorization across matrices is left to the compiler, and
+// a scalar call is ~10% slower than a Jacobi loop that stops as soon as it converges
+template<typename T>
+CINO_INLINE
+void mat_closest_rot_33(const T m[][3], T R[][3])
+{
+    const T tiny = std::numeric_limits<T>::min();
+
+    // S = m^T * m
+    T S[3][3];
+    for(uint i=0; i<3; ++i)
+    for(uint j=i; j<3; ++j)
+    {
+        S[i][j] = m[0][i]*m[0][j] + m[1][i]*m[1][j] + m[2][i]*m[2][j];
+        S[j][i] = S[i][j];
+    }
+
+    // Jacobi eigen decomposition S = V * D * V^T
+    T V[3][3] = {{1,0,0},{0,1,0},{0,0,1}};
+    const uint pairs[3][2] = {{0,1},{0,2},{1,2}};
+    for(uint sweep=0; sweep<4; ++sweep)
+    for(uint k=0; k<3; ++k)
+    {
+        uint p = pairs[k][0];
+        uint q = pairs[k][1];
+        // rotation angle in [-pi/4,pi/4] that zeroes S[p][q]: tan(2*theta) = 2*S[p][q]/(S[q][q]-S[p][p]).
+        // tan(theta) is computed without cancellation, and is zero if S[p][q] is already zero
+        T tau = S[q][q] - S[p][p];
+        T two = 2*S[p][q];
+        T t   = std::copysign(T(1),tau) * two / (std::fabs(tau) + std::sqrt(tau*tau + two*two) + tiny); // tan(theta)
+        T c   = 1/std::sqrt(t*t + 1);
+        T s   = t*c;
+        // S = J^T * S * J
+        for(uint i=0; i<3; ++i)
+        {
+            T sp = S[i][p], sq = S[i][q];
+            S[i][p] = c*sp - s*sq;
+            S[i][q] = s*sp + c*sq;
+        }
+        for(uint j=0; j<3; ++j)
+        {
+            T sp = S[p][j], sq = S[q][j];
+            S[p][j] = c*sp - s*sq;
+            S[q][j] = s*sp + c*sq;
+        }
+        // V = V * J
+        for(uint i=0; i<3; ++i)
+        {
+            T vp = V[i][p], vq = V[i][q];
+            V[i][p] = c*vp - s*vq;
+            V[i][q] = s*vp + c*vq;
+        }
+    }
+
+    // B = m * V, with columns sorted by decreasing norm (a swap of columns of V
+    // is paired with a sign flip, so that V stays a rotation). Swaps are selects
+    T B[3][3];
+    mat_times<3,3,3,T>(m, V, B);
+    auto col_norm = [&](const uint j) { return B[0][j]*B[0][j] + B[1][j]*B[1][j] + B[2][j]*B[2][j]; };
+    auto sort_cols = [&](const uint a, const uint b)
+    {
+        bool swap = col_norm(a) < col_norm(b);
+        for(uint i=0; i<3; ++i)
+        {
+            T ba = B[i][a], bb = B[i][b];
+            T va = V[i][a], vb = V[i][b];
+            B[i][a] = swap ? bb : ba;   B[i][b] = swap ? -ba : bb;
+            V[i][a] = swap ? vb : va;   V[i][b] = swap ? -va : vb;
+        }
+    };
+    sort_cols(0,1);
+    sort_cols(0,2);
+    sort_cols(1,2);
+
+    // QR decomposition of B with Givens rotations: B = U * upper_triangular.
+    // If both entries are zero the rotation is the identity
+    T U[3][3] = {{1,0,0},{0,1,0},{0,0,1}};
+    auto givens = [&](const uint p, const uint q, const uint col)
+    {
+        T a    = B[p][col];
+        T b    = B[q][col];
+        T r2   = a*a + b*b;
+        T rinv = 1/std::sqrt(r2 + tiny);
+        T c    = (r2>0) ? a*rinv : T(1);
+        T s    = (r2>0) ? b*rinv : T(0);
+        for(uint j=0; j<3; ++j)
+        {
+            T bp = B[p][j], bq = B[q][j];
+            B[p][j] =  c*bp + s*bq;
+            B[q][j] = -s*bp + c*bq;
+        }
+        for(uint i=0; i<3; ++i) // U = U * G^T
+        {
+            T up = U[i][p], uq = U[i][q];
+            U[i][p] =  c*up + s*uq;
+            U[i][q] = -s*up + c*uq;
+        }
+    };
+    givens(0,1,0);
+    givens(0,2,0);
+    givens(1,2,1);
+
+    // R = U * V^T
+    for(uint i=0; i<3; ++i)
+    for(uint j=0; j<3; ++j)
+    {
+        R[i][j] = U[i][0]*V[j][0] + U[i][1]*V[j][1] + U[i][2]*V[j][2];
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<uint d, typename T>
 CINO_INLINE
 void mat_solve_Cramer(const T m[][d], const T b[], T x[])
@@ -119,6 +119,7 @@ template<uint r, uint c, typename T> CINO_INLINE void mat_eigenvec        (const
 template<uint r, uint c, typename T> CINO_INLINE void mat_svd             (const T m[][c], T U[][r], T S[], T V[][c]);
 template<uint r, uint c, typename T> CINO_INLINE void mat_qr              (const T m[][c], T Q[][r], T R[][c]);
 template<uint d,         typename T> CINO_INLINE void mat_closest_orth_mat(const T m[][d], T n[][d], const bool force_pos_det);
+template<                typename T> CINO_INLINE void mat_closest_rot_33  (const T m[][3], T R[][3]);
 template<uint d,         typename T> CINO_INLINE void mat_solve_Cramer    (const T m[][d], const T b[], T x[]);
 template<uint r, uint c, typename T> CINO_INLINE void mat_copy            (const T m[][c], T n[][c]);
 template<uint r, uint c, typename T> CINO_INLINE void mat_print           (const T m[][c]);
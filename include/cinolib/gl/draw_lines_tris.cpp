@@ -34,10 +34,131 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/gl/draw_lines_tris.h>
+#include <cinolib/parallel_for.h>
 
 namespace cinolib
 {
 
+CINO_INLINE
+void RenderData::mark_dirty(const int attributes, const uint beg, const uint end)
+{
+    auto mark = [beg,end](GLBuffer & buf, const size_t n_comp)
+    {
+        size_t e = (end==max_uint) ? max_uint : size_t(end)*n_comp;
+        buf.mark_dirty(size_t(beg)*n_comp, e);
+    };
+    size_t nv_tri = tri_coords.size()/3;
+    size_t nv_seg = seg_coords.size()/3;
+    if(attributes & RENDER_TRI_COORDS)  mark(tri_coords_buf,   3);
+    if(attributes & RENDER_TRI_NORMS)   mark(tri_v_norms_buf,  3);
+    if(attributes & RENDER_TRI_COLORS)  mark(tri_v_colors_buf, 4);
+    if(attributes & RENDER_TRI_TEXT && nv_tri>0) mark(tri_text_buf, tri_text.size()/nv_tri);
+    if(attributes & RENDER_TRI_INDICES) mark(tris_buf,         1);
+    if(attributes & RENDER_SEG_COORDS)  mark(seg_coords_buf,   3);
+    if(attributes & RENDER_SEG_COLORS && nv_seg>0) mark(seg_colors_buf, seg_colors.size()/nv_seg);
+    if(attributes & RENDER_SEG_INDICES) mark(segs_buf,         1);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void RenderData::alloc_unindexed(const uint n_tri_verts, const uint n_seg_verts)
+{
+    uint n_norm = (draw_mode & (DRAW_TRI_SMOOTH | DRAW_TRI_FLAT)) ? 3 : 0;
+    uint n_text = (draw_mode & DRAW_TRI_TEXTURE1D) ? 1 : ((draw_mode & DRAW_TRI_TEXTURE2D) ? 2 : 0);
+    uint n_rgba = (draw_mode & (DRAW_TRI_FACECOLOR | DRAW_TRI_VERTCOLOR | DRAW_TRI_QUALITY)) ? 4 : 0;
+
+    tri_coords.resize  (n_tri_verts*3);
+    tri_v_norms.resize (n_tri_verts*n_norm);
+    tri_v_colors.resize(n_tri_verts*n_rgba);
+    tri_text.resize    (n_tri_verts*n_text);
+    seg_coords.resize  (n_seg_verts*3);
+    seg_colors.resize  (n_seg_verts*4);
+
+    // index arrays are rewritten only if their size changed
+    if(tris.size()!=n_tri_verts)
+    {
+        tris.resize(n_tri_verts);
+        for(uint i=0; i<n_tri_verts; ++i) tris[i] = i;
+    }
+    if(segs.size()!=n_seg_verts)
+    {
+        segs.resize(n_seg_verts);
+        for(uint i=0; i<n_seg_verts; ++i) segs[i] = i;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool RenderData::has_unindexed_layout(const uint n_tri_verts, const uint n_seg_verts) const
+{
+    uint n_norm = (draw_mode & (DRAW_TRI_SMOOTH | DRAW_TRI_FLAT)) ? 3 : 0;
+    uint n_text = (draw_mode & DRAW_TRI_TEXTURE1D) ? 1 : ((draw_mode & DRAW_TRI_TEXTURE2D) ? 2 : 0);
+    uint n_rgba = (draw_mode & (DRAW_TRI_FACECOLOR | DRAW_TRI_VERTCOLOR | DRAW_TRI_QUALITY)) ? 4 : 0;
+
+    return tris.size()         == n_tri_verts        &&
+           tri_coords.size()   == n_tri_verts*3      &&
+           tri_v_norms.size()  == n_tri_verts*n_norm &&
+           tri_v_colors.size() == n_tri_verts*n_rgba &&
+           tri_text.size()     == n_tri_verts*n_text &&
+           segs.size()         == n_seg_verts        &&
+           seg_coords.size()   == n_seg_verts*3      &&
+           seg_colors.size()   == n_seg_verts*4;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void RenderData::relayout_unindexed(const std::vector<uint> & old_tri_off, const std::vector<uint> & tri_off,
+                                    const std::vector<uint> & old_seg_off, const std::vector<uint> & seg_off)
+{
+    assert(old_tri_off.size()==tri_off.size());
+    assert(old_seg_off.size()==seg_off.size());
+
+    auto move = [](std::vector<float> & v, const std::vector<uint> & old_off, const std::vector<uint> & off)
+    {
+        if(old_off.back()==0) { v.clear(); return; }
+        size_t stride = v.size()/old_off.back();
+        std::vector<float> tmp(off.back()*stride);
+        PARALLEL_FOR(0, (uint)off.size()-1, 10000, [&](const uint i)
+        {
+            uint n = off.at(i+1) - off.at(i);
+            if(n>0 && n==old_off.at(i+1)-old_off.at(i))
+            {
+                std::copy(v.begin()   + old_off.at(i)*stride,
+                          v.begin()   + old_off.at(i+1)*stride,
+                          tmp.begin() + off.at(i)*stride);
+            }
+        });
+        v.swap(tmp);
+    };
+    move(tri_coords,   old_tri_off, tri_off);
+    move(tri_v_norms,  old_tri_off, tri_off);
+    move(tri_v_colors, old_tri_off, tri_off);
+    move(tri_text,     old_tri_off, tri_off);
+    move(seg_coords,   old_seg_off, seg_off);
+    move(seg_colors,   old_seg_off, seg_off);
+
+    // optional arrays that were empty (e.g. because the old layout was empty) get their proper size
+    alloc_unindexed(tri_off.back(), seg_off.back());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// binds the GPU copy of v to target and returns the (null) offset to be passed
+// to gl*Pointer/glDrawElements. If buffers are not in use, unbinds target and
+// returns the client side pointer instead
+template<typename T>
+CINO_INLINE
+const void * render_data_ptr(const RenderData & data, GLBuffer & buf, const GLenum target, const std::vector<T> & v)
+{
+    if(data.use_buffers && buf.sync(target, v.data(), v.size(), sizeof(T))) return nullptr;
+    const GLBufferAPI * gl = gl_buffer_API();
+    if(gl!=nullptr) gl->BindBuffer(target, 0);
+    return v.data();
+}
+
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
@@ -46,9 +167,9 @@ void render_tris(const RenderData & data)
     if(data.draw_mode & DRAW_TRI_POINTS)
     {
         glEnableClientState(GL_COLOR_ARRAY);
-        glColorPointer(4, GL_FLOAT, 0, data.tri_v_colors.data());
+        glColorPointer(4, GL_FLOAT, 0, render_data_ptr(data, data.tri_v_colors_buf, GL_ARRAY_BUFFER, data.tri_v_colors));
         glEnableClientState(GL_VERTEX_ARRAY);
-        glVertexPointer(3, GL_FLOAT, 0, data.tri_coords.data());
+        glVertexPointer(3, GL_FLOAT, 0, render_data_ptr(data, data.tri_coords_buf, GL_ARRAY_BUFFER, data.tri_coords));
         glPointSize(data.seg_width);
         glDrawArrays(GL_POINTS, 0, (GLsizei)(data.tri_coords.size()/3));
         glDisableClientState(GL_VERTEX_ARRAY);
@@ -60,7 +181,7 @@ void render_tris(const RenderData & data)
         {
             glBindTexture(GL_TEXTURE_1D, data.texture.id);
             glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-            glTexCoordPointer(1, GL_FLOAT, 0, data.tri_text.data());
+            glTexCoordPointer(1, GL_FLOAT, 0, render_data_ptr(data, data.tri_text_buf, GL_ARRAY_BUFFER, data.tri_text));
             glColor3f(1,1,1);
             glEnable(GL_COLOR_MATERIAL);
             glEnable(GL_TEXTURE_1D);
@@ -69,7 +190,7 @@ void render_tris(const RenderData & data)
         {
             glBindTexture(GL_TEXTURE_2D, data.texture.id);
             glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-            glTexCoordPointer(2, GL_FLOAT, 0, data.tri_text.data());
+            glTexCoordPointer(2, GL_FLOAT, 0, render_data_ptr(data, data.tri_text_buf, GL_ARRAY_BUFFER, data.tri_text));
             glColor3f(1,1,1);
             glEnable(GL_COLOR_MATERIAL);
             glEnable(GL_TEXTURE_2D);
@@ -78,13 +199,13 @@ void render_tris(const RenderData & data)
         {
             glEnable(GL_COLOR_MATERIAL);
             glEnableClientState(GL_COLOR_ARRAY);
-            glColorPointer(4, GL_FLOAT, 0, data.tri_v_colors.data());
+            glColorPointer(4, GL_FLOAT, 0, render_data_ptr(data, data.tri_v_colors_buf, GL_ARRAY_BUFFER, data.tri_v_colors));
         }
         glEnableClientState(GL_VERTEX_ARRAY);
-        glVertexPointer(3, GL_FLOAT, 0, data.tri_coords.data());
+        glVertexPointer(3, GL_FLOAT, 0, render_data_ptr(data, data.tri_coords_buf, GL_ARRAY_BUFFER, data.tri_coords));
         glEnableClientState(GL_NORMAL_ARRAY);
-        glNormalPointer(GL_FLOAT, 0, data.tri_v_norms.data());
-        glDrawElements(GL_TRIANGLES, (GLsizei)data.tris.size(), GL_UNSIGNED_INT, data.tris.data());
+        glNormalPointer(GL_FLOAT, 0, render_data_ptr(data, data.tri_v_norms_buf, GL_ARRAY_BUFFER, data.tri_v_norms));
+        glDrawElements(GL_TRIANGLES, (GLsizei)data.tris.size(), GL_UNSIGNED_INT, render_data_ptr(data, data.tris_buf, GL_ELEMENT_ARRAY_BUFFER, data.tris));
         glDisableClientState(GL_VERTEX_ARRAY);
         glDisableClientState(GL_NORMAL_ARRAY);
         if(data.draw_mode & DRAW_TRI_TEXTURE1D)
@@ -118,11 +239,11 @@ void render_segs(const RenderData & data)
         glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);        
         glDisable(GL_LIGHTING);
         glEnableClientState(GL_VERTEX_ARRAY);
-        glVertexPointer(3, GL_FLOAT, 0, data.seg_coords.data());
+        glVertexPointer(3, GL_FLOAT, 0, render_data_ptr(data, data.seg_coords_buf, GL_ARRAY_BUFFER, data.seg_coords));
         glLineWidth(data.seg_width);
         glEnableClientState(GL_COLOR_ARRAY);
-        glColorPointer(4, GL_FLOAT, 0, data.seg_colors.data());
-        glDrawElements(GL_LINES, (GLsizei)data.segs.size(), GL_UNSIGNED_INT, data.segs.data());
+        glColorPointer(4, GL_FLOAT, 0, render_data_ptr(data, data.seg_colors_buf, GL_ARRAY_BUFFER, data.seg_colors));
+        glDrawElements(GL_LINES, (GLsizei)data.segs.size(), GL_UNSIGNED_INT, render_data_ptr(data, data.segs_buf, GL_ELEMENT_ARRAY_BUFFER, data.segs));
         glDisableClientState(GL_COLOR_ARRAY);
         glDisableClientState(GL_VERTEX_ARRAY);
         glEnable(GL_LIGHTING);
@@ -176,6 +297,17 @@ void render(const RenderData & data)
             glEnable(GL_POLYGON_OFFSET_FILL);
         }
     }
+
+    // leave no buffer bound (e.g. ImGui draws from client side arrays)
+    if(data.use_buffers)
+    {
+        const GLBufferAPI * gl = gl_buffer_API();
+        if(gl!=nullptr)
+        {
+            gl->BindBuffer(GL_ARRAY_BUFFER, 0);
+            gl->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+    }
 }
 
 }
@@ -46,6 +46,8 @@
 #include <cinolib/color.h>
 #include <cinolib/gl/gl_glfw.h>
 #include <cinolib/gl/load_texture.h>
+#include <cinolib/gl/gl_buffer.h>
+#include <cinolib/min_max_inf.h>
 
 namespace cinolib
 {
@@ -64,6 +66,22 @@ enum
     DRAW_SEGS                 = 0x00000200,
 };
 
+// attributes of a RenderData (used to mark GPU buffers as outdated)
+enum
+{
+    RENDER_TRI_COORDS  = 0x00000001,
+    RENDER_TRI_NORMS   = 0x00000002,
+    RENDER_TRI_COLORS  = 0x00000004,
+    RENDER_TRI_TEXT    = 0x00000008,
+    RENDER_TRI_INDICES = 0x00000010,
+    RENDER_SEG_COORDS  = 0x00000020,
+    RENDER_SEG_COLORS  = 0x00000040,
+    RENDER_SEG_INDICES = 0x00000080,
+    RENDER_TRI_ALL     = 0x0000001F,
+    RENDER_SEG_ALL     = 0x000000E0,
+    RENDER_ALL         = 0x000000FF,
+};
+
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 // https://www.khronos.org/registry/OpenGL-Refpages/es1.1/xhtml/glMaterial.xml
@@ -108,6 +126,39 @@ struct RenderData
     std::vector<float> seg_colors; // rgba
     GLfloat            seg_width = 1;
     //
+    // if true, arrays are stored in GPU buffers and only the ranges flagged
+    // with mark_dirty() are re-uploaded at rendering time. If false (or if
+    // buffer objects are not supported), arrays are streamed at each frame
+    bool               use_buffers = false;
+    mutable GLBuffer   tris_buf;
+    mutable GLBuffer   tri_coords_buf;
+    mutable GLBuffer   tri_v_norms_buf;
+    mutable GLBuffer   tri_v_colors_buf;
+    mutable GLBuffer   tri_text_buf;
+    mutable GLBuffer   segs_buf;
+    mutable GLBuffer   seg_coords_buf;
+    mutable GLBuffer   seg_colors_buf;
+    //
+    // flags the given attributes as outdated in the range [beg,end). For per
+    // vertex attributes the range refers to vertices (i.e. entries of the
+    // coordinate arrays divided by three), for index attributes it refers to
+    // entries of tris/segs. Changes in array sizes are detected automatically
+    void mark_dirty(const int attributes, const uint beg = 0, const uint end = max_uint);
+    //
+    // allocates arrays for n_tri_verts triangle corners and n_seg_verts segment
+    // endpoints, without vertex sharing (tris/segs are set to the identity).
+    // Optional arrays (normals, colors, texture coordinates) are sized according
+    // to the current draw_mode. has_unindexed_layout() tells whether the arrays
+    // still have the size this function would give them
+    void alloc_unindexed(const uint n_tri_verts, const uint n_seg_verts);
+    bool has_unindexed_layout(const uint n_tri_verts, const uint n_seg_verts) const;
+    //
+    // moves from an unindexed layout to another, where element i owns the triangle
+    // corners [tri_off[i],tri_off[i+1]) and the segment endpoints [seg_off[i],seg_off[i+1]).
+    // Data of elements that have the same size in the old and new layouts is copied
+    // to its new position, the other elements are left for the caller to fill
+    void relayout_unindexed(const std::vector<uint> & old_tri_off, const std::vector<uint> & tri_off,
+                            const std::vector<uint> & old_seg_off, const std::vector<uint> & seg_off);
 };
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
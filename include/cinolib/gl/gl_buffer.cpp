@@ -0,0 +1,132 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/gl/gl_buffer.h>
+#include <algorithm>
+
+namespace cinolib
+{
+
+CINO_INLINE
+const GLBufferAPI * gl_buffer_API()
+{
+    static GLBufferAPI api;
+    if(!api.loaded && glfwGetCurrentContext()!=nullptr)
+    {
+        api.GenBuffers    = reinterpret_cast<decltype(api.GenBuffers)>   (glfwGetProcAddress("glGenBuffers"));
+        api.DeleteBuffers = reinterpret_cast<decltype(api.DeleteBuffers)>(glfwGetProcAddress("glDeleteBuffers"));
+        api.BindBuffer    = reinterpret_cast<decltype(api.BindBuffer)>   (glfwGetProcAddress("glBindBuffer"));
+        api.BufferData    = reinterpret_cast<decltype(api.BufferData)>   (glfwGetProcAddress("glBufferData"));
+        api.BufferSubData = reinterpret_cast<decltype(api.BufferSubData)>(glfwGetProcAddress("glBufferSubData"));
+        api.loaded = true;
+    }
+    if(api.GenBuffers    == nullptr ||
+       api.DeleteBuffers == nullptr ||
+       api.BindBuffer    == nullptr ||
+       api.BufferData    == nullptr ||
+       api.BufferSubData == nullptr) return nullptr;
+    return &api;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+GLBuffer::~GLBuffer()
+{
+    // GPU memory can be released only if there is a current context
+    if(id>0 && glfwGetCurrentContext()!=nullptr)
+    {
+        const GLBufferAPI * gl = gl_buffer_API();
+        if(gl!=nullptr) gl->DeleteBuffers(1, &id);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void GLBuffer::mark_dirty(const size_t beg, const size_t end)
+{
+    if(beg<end) dirty.push_back(std::make_pair(beg,end));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool GLBuffer::sync(const GLenum target, const void * data, const size_t n_entries, const size_t entry_bytes)
+{
+    const GLBufferAPI * gl = gl_buffer_API();
+    if(gl==nullptr) return false;
+
+    if(id==0) gl->GenBuffers(1, &id);
+    gl->BindBuffer(target, id);
+
+    if(gpu_size!=n_entries) // (re)allocate and upload everything
+    {
+        gl->BufferData(target, std::ptrdiff_t(n_entries*entry_bytes), data, GL_DYNAMIC_DRAW);
+        gpu_size = n_entries;
+        dirty.clear();
+        return true;
+    }
+
+    if(dirty.empty()) return true;
+
+    // merge overlapping/adjacent ranges. If ranges are too many, many small
+    // transfers cost more than a single big one: upload their union instead
+    std::sort(dirty.begin(), dirty.end());
+    std::vector<std::pair<size_t,size_t>> merged;
+    for(auto r : dirty)
+    {
+        r.second = std::min(r.second, n_entries);
+        if(r.first>=r.second) continue;
+        if(!merged.empty() && r.first<=merged.back().second)
+        {
+            merged.back().second = std::max(merged.back().second, r.second);
+        }
+        else merged.push_back(r);
+    }
+    if(merged.size()>32)
+    {
+        merged = { std::make_pair(merged.front().first, merged.back().second) };
+    }
+    for(auto r : merged)
+    {
+        const char * ptr = static_cast<const char*>(data) + r.first*entry_bytes;
+        gl->BufferSubData(target, std::ptrdiff_t(r.first*entry_bytes), std::ptrdiff_t((r.second-r.first)*entry_bytes), ptr);
+    }
+    dirty.clear();
+    return true;
+}
+
+}
@@ -0,0 +1,121 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_GL_BUFFER_H
+#define CINO_GL_BUFFER_H
+
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
+
+#include <vector>
+#include <cstddef>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+#include <cinolib/gl/gl_glfw.h>
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER         0x8892
+#endif
+#ifndef GL_ELEMENT_ARRAY_BUFFER
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#endif
+#ifndef GL_DYNAMIC_DRAW
+#define GL_DYNAMIC_DRAW         0x88E8
+#endif
+
+namespace cinolib
+{
+
+/* Buffer objects are part of OpenGL since version 1.5, but some platforms
+ * (e.g. Windows) only export the OpenGL 1.1 API, hence the entry points are
+ * loaded at runtime through GLFW. Loading requires a current GL context.
+*/
+
+#ifdef _WIN32
+#define CINO_GL_APIENTRY __stdcall
+#else
+#define CINO_GL_APIENTRY
+#endif
+
+struct GLBufferAPI
+{
+    void (CINO_GL_APIENTRY *GenBuffers)   (GLsizei, GLuint*)                            = nullptr;
+    void (CINO_GL_APIENTRY *DeleteBuffers)(GLsizei, const GLuint*)                      = nullptr;
+    void (CINO_GL_APIENTRY *BindBuffer)   (GLenum, GLuint)                              = nullptr;
+    void (CINO_GL_APIENTRY *BufferData)   (GLenum, std::ptrdiff_t, const void*, GLenum) = nullptr;
+    void (CINO_GL_APIENTRY *BufferSubData)(GLenum, std::ptrdiff_t, std::ptrdiff_t, const void*) = nullptr;
+    bool loaded = false;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// returns the buffer object entry points, or nullptr if they are not available
+CINO_INLINE
+const GLBufferAPI * gl_buffer_API();
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* GPU side copy of a CPU array, which keeps track of the ranges of entries
+ * modified since the last upload, so that only those are transferred. If the
+ * size of the CPU array changes, the whole buffer is re-allocated. Buffers are
+ * never shared: copies of a GLBuffer allocate their own GPU memory.
+*/
+struct GLBuffer
+{
+    GLuint id       = 0;
+    size_t gpu_size = 0; // number of entries currently allocated on the GPU
+    std::vector<std::pair<size_t,size_t>> dirty; // [beg,end) ranges of entries to be uploaded
+
+     GLBuffer() {}
+     GLBuffer(const GLBuffer &) {}
+     GLBuffer & operator=(const GLBuffer &) { gpu_size = 0; dirty.clear(); return *this; }
+    ~GLBuffer();
+
+    void mark_dirty(const size_t beg, const size_t end);
+    void mark_all_dirty() { gpu_size = 0; dirty.clear(); }
+
+    // binds the buffer to target (e.g. GL_ARRAY_BUFFER) and uploads dirty entries.
+    // Returns false if buffer objects are not supported
+    bool sync(const GLenum target, const void * data, const size_t n_entries, const size_t entry_bytes);
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "gl_buffer.cpp"
+#endif
+
+#endif // #ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
+
+#endif // CINO_GL_BUFFER_H
@@ -287,6 +287,8 @@ CINO_INLINE
 void GLcanvas::draw()
 {
     glfwMakeContextCurrent(window);
+    if(callback_frame!=nullptr) callback_frame();
+
     glClearColor(color_background.r,
                  color_background.g,
                  color_background.b,
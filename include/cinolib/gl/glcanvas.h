@@ -216,6 +216,7 @@ class GLcanvas
         std::function<bool(double x_pos,    double y_pos    )> callback_mouse_moved        = nullptr;
         std::function<bool(double x_offset, double y_offset )> callback_mouse_scroll       = nullptr;
         std::function<void(void                             )> callback_app_controls       = nullptr; // useful to insert app-dependent visual controls (with ImGui)
+        std::function<void(void                             )> callback_frame              = nullptr; // called at each frame before drawing (e.g. for progressive computations)
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 };
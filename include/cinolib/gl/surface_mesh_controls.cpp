@@ -405,8 +405,10 @@ void SurfaceMeshControls<Mesh>::header_slicing(const bool open)
         refresh |= ImGui::Checkbox   ("##l", &slicer.L_is);
         if(refresh)
         {
-            slicer.slice(*m);
-            m->updateGL();
+            std::vector<uint> changed_pids;
+            slicer.slice(*m, changed_pids);
+            m->updateGL_polys(changed_pids);
+            m->updateGL_marked();
         }
         ImGui::TreePop();
     }
@@ -589,15 +591,18 @@ void SurfaceMeshControls<Mesh>::header_manual_digging(const bool open)
     {
         if(modifiers & GLFW_MOD_SHIFT)
         {
-            vec3d p;
+            vec3d p, eye;
             vec2d click = gui->cursor_pos();
             if(gui->unproject(click, p)) // transform click in a 3d point
             {
-                uint pid = m->pick_poly(p);
+                // pick the poly hit by the ray through the click (closest centroid as fallback)
+                uint pid;
+                if(!gui->unproject(click, 0.0, eye) || !m->ray_pick_poly(eye, p-eye, pid)) pid = m->pick_poly(p);
                 if(m->poly_data(pid).flags[HIDDEN] == false)
                 {
                     m->poly_data(pid).flags[HIDDEN] = true;
                 }
+                slicer.invalidate(); // HIDDEN flags changed outside of the slicer
                 m->updateGL();
             }
         }
@@ -622,6 +627,7 @@ void SurfaceMeshControls<Mesh>::header_manual_digging(const bool open)
                         m->poly_data(pid).flags[HIDDEN] = false;
                     }
                 }
+                slicer.invalidate(); // HIDDEN flags changed outside of the slicer
                 m->updateGL();
             }
         }
@@ -634,11 +640,13 @@ void SurfaceMeshControls<Mesh>::header_manual_digging(const bool open)
     {
         if(modifiers & GLFW_MOD_SHIFT)
         {
-            vec3d p;
+            vec3d p, eye;
             vec2d click = gui->cursor_pos();
             if(gui->unproject(click, p)) // transform click in a 3d point
             {
-                uint pid = m->pick_poly(p);
+                // pick the poly hit by the ray through the click (closest centroid as fallback)
+                uint pid;
+                if(!gui->unproject(click, 0.0, eye) || !m->ray_pick_poly(eye, p-eye, pid)) pid = m->pick_poly(p);
                 for(uint vid : m->adj_p2v(pid))
                 for(uint pid : m->adj_v2p(vid))
                 {
@@ -648,6 +656,7 @@ void SurfaceMeshControls<Mesh>::header_manual_digging(const bool open)
                     }
                 }
                 m->poly_data(pid).flags[HIDDEN] = false;
+                slicer.invalidate(); // HIDDEN flags changed outside of the slicer
                 m->updateGL();
             }
         }
@@ -662,7 +671,7 @@ void SurfaceMeshControls<Mesh>::header_manual_digging(const bool open)
         if(ImGui::RadioButton("Dig    ", &dig_choice, DIG    )) gui->callback_mouse_left_click = func_dig;
         if(ImGui::RadioButton("Undig  ", &dig_choice, UNDIG  )) gui->callback_mouse_left_click = func_undig;
         if(ImGui::RadioButton("Isolate", &dig_choice, ISOLATE)) gui->callback_mouse_left_click = func_isolate;
-        if(ImGui::RadioButton("Reset  ", &dig_choice, RESET  )) { m->poly_set_flag(HIDDEN,false); m->updateGL(); }
+        if(ImGui::RadioButton("Reset  ", &dig_choice, RESET  )) { m->poly_set_flag(HIDDEN,false); slicer.invalidate(); m->updateGL(); }
         ImGui::TreePop();
     }
 }
@@ -781,6 +790,7 @@ void SurfaceMeshControls<Mesh>::header_actions(const bool open)
         if(ImGui::SmallButton("Label wrt Color"))
         {
             m->poly_label_wrt_color();
+            slicer.invalidate();
             refresh = true;
         }
         if(ImGui::SmallButton("Mark Color Discontinuities"))
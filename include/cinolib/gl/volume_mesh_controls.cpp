@@ -513,8 +513,10 @@ void VolumeMeshControls<Mesh>::header_slicing(const bool open)
         refresh |= ImGui::Checkbox   ("##l", &slicer.L_is);
         if(refresh)
         {
-            slicer.slice(*m);
-            m->updateGL();
+            std::vector<uint> changed_pids;
+            slicer.slice(*m, changed_pids);
+            m->updateGL_polys(changed_pids);
+            m->updateGL_marked();
         }
         ImGui::TreePop();
     }
@@ -719,11 +721,13 @@ void VolumeMeshControls<Mesh>::header_manual_digging(const bool open)
     {
         if(modifiers & GLFW_MOD_SHIFT)
         {
-            vec3d p;
+            vec3d p, eye;
             vec2d click = gui->cursor_pos();
             if(gui->unproject(click, p)) // transform click in a 3d point
             {
-                uint fid = m->pick_face(p);
+                // pick the face hit by the ray through the click (closest centroid as fallback)
+                uint fid;
+                if(!gui->unproject(click, 0.0, eye) || !m->ray_pick_face(eye, p-eye, fid)) fid = m->pick_face(p);
                 for(uint pid : m->adj_f2p(fid))
                 {
                     if(m->poly_data(pid).flags[HIDDEN] == false)
@@ -731,6 +735,7 @@ void VolumeMeshControls<Mesh>::header_manual_digging(const bool open)
                         m->poly_data(pid).flags[HIDDEN] = true;
                     }
                 }
+                slicer.invalidate(); // HIDDEN flags changed outside of the slicer
                 m->updateGL();
             }
         }
@@ -755,6 +760,7 @@ void VolumeMeshControls<Mesh>::header_manual_digging(const bool open)
                         m->poly_data(pid).flags[HIDDEN] = false;
                     }
                 }
+                slicer.invalidate(); // HIDDEN flags changed outside of the slicer
                 m->updateGL();
             }
         }
@@ -767,11 +773,13 @@ void VolumeMeshControls<Mesh>::header_manual_digging(const bool open)
     {
         if(modifiers & GLFW_MOD_SHIFT)
         {
-            vec3d p;
+            vec3d p, eye;
             vec2d click = gui->cursor_pos();
             if(gui->unproject(click, p)) // transform click in a 3d point
             {
-                uint fid = m->pick_face(p);
+                // pick the face hit by the ray through the click (closest centroid as fallback)
+                uint fid;
+                if(!gui->unproject(click, 0.0, eye) || !m->ray_pick_face(eye, p-eye, fid)) fid = m->pick_face(p);
                 uint pid_beneath;
                 if(!m->face_is_visible(fid,pid_beneath))
                 {
@@ -787,6 +795,7 @@ void VolumeMeshControls<Mesh>::header_manual_digging(const bool open)
                     }
                 }
                 m->poly_data(pid_beneath).flags[HIDDEN] = false;
+                slicer.invalidate(); // HIDDEN flags changed outside of the slicer
                 m->updateGL();
             }
         }
@@ -801,7 +810,7 @@ void VolumeMeshControls<Mesh>::header_manual_digging(const bool open)
         if(ImGui::RadioButton("Dig    ", &dig_choice, DIG    )) gui->callback_mouse_left_click = func_dig;
         if(ImGui::RadioButton("Undig  ", &dig_choice, UNDIG  )) gui->callback_mouse_left_click = func_undig;
         if(ImGui::RadioButton("Isolate", &dig_choice, ISOLATE)) gui->callback_mouse_left_click = func_isolate;
-        if(ImGui::RadioButton("Reset  ", &dig_choice, RESET  )) { m->poly_set_flag(HIDDEN,false); m->updateGL(); }
+        if(ImGui::RadioButton("Reset  ", &dig_choice, RESET  )) { m->poly_set_flag(HIDDEN,false); slicer.invalidate(); m->updateGL(); }
         ImGui::TreePop();
     }
 }
@@ -927,6 +936,7 @@ void VolumeMeshControls<Mesh>::header_actions(const bool open)
         if(ImGui::SmallButton("Label wrt Color"))
         {
             m->poly_label_wrt_color();
+            slicer.invalidate();
             refresh = true;
         }
         if(ImGui::SmallButton("Mark color discontinuities"))
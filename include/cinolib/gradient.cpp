@@ -42,6 +42,8 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/gradient.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
 
 namespace cinolib
 {
@@ -56,36 +58,9 @@ Eigen::SparseMatrix<double> gradient_matrix(const AbstractPolygonMesh<M,V,E,P> &
 {
     if(per_poly)
     {
-        Eigen::SparseMatrix<double> G(m.num_polys()*3, m.num_verts());
-        std::vector<Entry> entries;
-
-        for(uint pid=0; pid<m.num_polys(); ++pid)
-        {
-            double area = std::max(m.poly_area(pid), 1e-5) * 2.0; // (2 is the average term : two verts for each edge)
-            vec3d n     = m.poly_data(pid).normal;
-
-            for(uint off=0; off<m.verts_per_poly(pid); ++off)
-            {
-                uint  prev = m.poly_vert_id(pid,off);
-                uint  curr = m.poly_vert_id(pid,(off+1)%m.verts_per_poly(pid));
-                uint  next = m.poly_vert_id(pid,(off+2)%m.verts_per_poly(pid));
-                vec3d u    = m.vert(next) - m.vert(curr);
-                vec3d v    = m.vert(curr) - m.vert(prev);
-                vec3d u_90 = u.cross(n); u_90.normalize();
-                vec3d v_90 = v.cross(n); v_90.normalize();
-
-                vec3d per_vert_sum_over_edge_normals = u_90 * u.norm() + v_90 * v.norm();
-                per_vert_sum_over_edge_normals /= area;
-
-                uint row = 3 * pid;
-                entries.push_back(Entry(row, curr, per_vert_sum_over_edge_normals.x())); ++row;
-                entries.push_back(Entry(row, curr, per_vert_sum_over_edge_normals.y())); ++row;
-                entries.push_back(Entry(row, curr, per_vert_sum_over_edge_normals.z()));
-            }
-        }
-
-        G.setFromTriplets(entries.begin(), entries.end());
-        return G;
+        GradientCache cache;
+        gradient_matrix(m, cache);
+        return std::move(cache.G);
     }
     else // per vertex
     {
@@ -137,70 +112,17 @@ Eigen::SparseMatrix<double> gradient_matrix(const AbstractPolyhedralMesh<M,V,E,F
 {
     if(per_poly)
     {
-        Eigen::SparseMatrix<double> G(m.num_polys()*3, m.num_verts());
-        std::vector<Entry> entries;
-
-        for(uint pid=0; pid<m.num_polys(); ++pid)
-        {
-            double vol = std::max(m.poly_volume(pid), 1e-5);
-
-            for(uint vid : m.adj_p2v(pid))
-            {
-                vec3d per_vert_sum_over_f_normals(0,0,0);
-                for(uint fid : m.adj_p2f(pid))
-                {
-                    if (m.face_contains_vert(fid,vid))
-                    {
-                        vec3d  n   = m.poly_face_normal(pid,fid);
-                        double a   = m.face_area(fid);
-                        double avg = static_cast<double>(m.verts_per_face(fid));
-                        per_vert_sum_over_f_normals += (n*a)/avg;
-                    }
-                }
-                per_vert_sum_over_f_normals /= vol;
-                uint row = 3 * pid;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.x())); ++row;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.y())); ++row;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.z()));
-            }
-        }
-
-        G.setFromTriplets(entries.begin(), entries.end());
-        return G;
+        GradientCache cache;
+        gradient_matrix(m, cache);
+        return std::move(cache.G);
     }
     else // per vert
     {
-        Eigen::SparseMatrix<double> G(m.num_polys()*3, m.num_verts());
-        std::vector<Entry> entries;
-
-        for(uint pid=0; pid<m.num_polys(); ++pid)
-        {
-            double vol = std::max(m.poly_volume(pid), 1e-5);
-
-            for(uint vid : m.adj_p2v(pid))
-            {
-                vec3d per_vert_sum_over_f_normals(0,0,0);
-                for(uint fid : m.adj_p2f(pid))
-                {
-                    if (m.face_contains_vert(fid,vid))
-                    {
-                        vec3d  n   = m.poly_face_normal(pid,fid);
-                        double a   = m.face_area(fid);
-                        double avg = static_cast<double>(m.verts_per_face(fid));
-                        per_vert_sum_over_f_normals += (n*a)/avg;
-                    }
-                }
-                per_vert_sum_over_f_normals /= vol;
-                uint row = 3 * pid;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.x())); ++row;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.y())); ++row;
-                entries.push_back(Entry(row, vid, per_vert_sum_over_f_normals.z()));
-            }
-        }
-        G.setFromTriplets(entries.begin(), entries.end());
+        GradientCache cache;
+        const Eigen::SparseMatrix<double> & G = gradient_matrix(m, cache);
 
         Eigen::SparseMatrix<double> A(m.num_verts()*3, m.num_polys()*3);
-        entries.clear();
+        std::vector<Entry> entries;
 
         for(uint vid=0;vid<m.num_verts();++vid)
         {
@@ -223,4 +145,133 @@ Eigen::SparseMatrix<double> gradient_matrix(const AbstractPolyhedralMesh<M,V,E,F
     }
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void gradient_matrix_pattern(const AbstractMesh<M,V,E,P> & m, GradientCache & cache)
+{
+    uint nv = m.num_verts();
+    uint np = m.num_polys();
+    if(cache.nv==nv && cache.np==np) return;
+
+    // column vid has three consecutive entries (x,y,z) for each incident element
+    std::vector<int> outer(nv+1);
+    outer[0] = 0;
+    for(uint vid=0; vid<nv; ++vid) outer[vid+1] = outer[vid] + 3*int(m.adj_v2p(vid).size());
+
+    std::vector<int> inner(outer[nv]);
+    PARALLEL_FOR(0, nv, 1000, [&](const uint vid)
+    {
+        std::vector<uint> pids = m.adj_v2p(vid);
+        std::sort(pids.begin(), pids.end());
+        uint pos = outer[vid];
+        for(uint pid : pids)
+        {
+            inner[pos++] = int(3*pid  );
+            inner[pos++] = int(3*pid+1);
+            inner[pos++] = int(3*pid+2);
+        }
+    });
+
+    cache.poly_off.resize(np+1);
+    cache.poly_off[0] = 0;
+    for(uint pid=0; pid<np; ++pid) cache.poly_off[pid+1] = cache.poly_off[pid] + uint(m.adj_p2v(pid).size());
+
+    cache.pos.resize(cache.poly_off[np]);
+    PARALLEL_FOR(0, np, 1000, [&](const uint pid)
+    {
+        uint i = cache.poly_off[pid];
+        for(uint vid : m.adj_p2v(pid))
+        {
+            // rank of pid among the (sorted) elements incident to vid
+            uint rank = 0;
+            for(uint nbr : m.adj_v2p(vid)) if(nbr<pid) ++rank;
+            cache.pos[i++] = outer[vid] + 3*rank;
+        }
+    });
+
+    std::vector<double> vals(outer[nv], 0.0);
+    cache.G  = Eigen::Map<const Eigen::SparseMatrix<double>>(3*np, nv, outer[nv], outer.data(), inner.data(), vals.data());
+    cache.nv = nv;
+    cache.np = np;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+const Eigen::SparseMatrix<double> & gradient_matrix(const AbstractPolygonMesh<M,V,E,P> & m, GradientCache & cache)
+{
+    gradient_matrix_pattern(m, cache);
+
+    double *vals = cache.G.valuePtr();
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](const uint pid)
+    {
+        double area = std::max(m.poly_area(pid), 1e-5) * 2.0; // (2 is the average term : two verts for each edge)
+        vec3d  n    = m.poly_data(pid).normal;
+        uint   nv   = m.verts_per_poly(pid);
+
+        for(uint off=0; off<nv; ++off)
+        {
+            uint  prev = m.poly_vert_id(pid,(off+nv-1)%nv);
+            uint  curr = m.poly_vert_id(pid,off);
+            uint  next = m.poly_vert_id(pid,(off+1)%nv);
+            vec3d u    = m.vert(next) - m.vert(curr);
+            vec3d v    = m.vert(curr) - m.vert(prev);
+            vec3d u_90 = u.cross(n); u_90.normalize();
+            vec3d v_90 = v.cross(n); v_90.normalize();
+
+            vec3d per_vert_sum_over_edge_normals = u_90 * u.norm() + v_90 * v.norm();
+            per_vert_sum_over_edge_normals /= area;
+
+            uint pos = cache.pos[cache.poly_off[pid] + off];
+            vals[pos  ] = per_vert_sum_over_edge_normals.x();
+            vals[pos+1] = per_vert_sum_over_edge_normals.y();
+            vals[pos+2] = per_vert_sum_over_edge_normals.z();
+        }
+    });
+
+    return cache.G;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+const Eigen::SparseMatrix<double> & gradient_matrix(const AbstractPolyhedralMesh<M,V,E,F,P> & m, GradientCache & cache)
+{
+    gradient_matrix_pattern(m, cache);
+
+    double *vals = cache.G.valuePtr();
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](const uint pid)
+    {
+        double vol = std::max(m.poly_volume(pid), 1e-5);
+
+        uint i = cache.poly_off[pid];
+        for(uint vid : m.adj_p2v(pid))
+        {
+            vec3d per_vert_sum_over_f_normals(0,0,0);
+            for(uint fid : m.adj_p2f(pid))
+            {
+                if (m.face_contains_vert(fid,vid))
+                {
+                    vec3d  n   = m.poly_face_normal(pid,fid);
+                    double a   = m.face_area(fid);
+                    double avg = static_cast<double>(m.verts_per_face(fid));
+                    per_vert_sum_over_f_normals += (n*a)/avg;
+                }
+            }
+            per_vert_sum_over_f_normals /= vol;
+
+            uint pos = cache.pos[i++];
+            vals[pos  ] = per_vert_sum_over_f_normals.x();
+            vals[pos+1] = per_vert_sum_over_f_normals.y();
+            vals[pos+2] = per_vert_sum_over_f_normals.z();
+        }
+    });
+
+    return cache.G;
+}
+
 }
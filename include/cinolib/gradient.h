@@ -87,6 +87,42 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 Eigen::SparseMatrix<double> gradient_matrix(const AbstractPolyhedralMesh<M,V,E,F,P> & m, const bool per_poly = true);
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Per element gradient assembly with cached sparsity pattern (see LaplacianCache
+ * in laplacian.h). The first call builds the compressed structure of the matrix
+ * and the position of each (element,vertex) entry in its value array. Subsequent
+ * calls only refill the values, processing elements in parallel. If connectivity
+ * changes but element counts do not, reset the cache (cache = GradientCache())
+*/
+struct GradientCache
+{
+    Eigen::SparseMatrix<double> G;
+    std::vector<uint>           poly_off; // entries of element pid are pos[poly_off[pid]...poly_off[pid+1]-1]
+    std::vector<uint>           pos;      // position in G.valuePtr() of the x component of each (element,vertex) entry
+    uint                        nv = 0;
+    uint                        np = 0;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+const Eigen::SparseMatrix<double> & gradient_matrix(const AbstractPolygonMesh<M,V,E,P> & m, GradientCache & cache);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+const Eigen::SparseMatrix<double> & gradient_matrix(const AbstractPolyhedralMesh<M,V,E,F,P> & m, GradientCache & cache);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// builds the sparsity pattern of a per element gradient matrix (if needed)
+template<class M, class V, class E, class P>
+CINO_INLINE
+void gradient_matrix_pattern(const AbstractMesh<M,V,E,P> & m, GradientCache & cache);
+
 }
 
 #ifndef  CINO_STATIC_LIB
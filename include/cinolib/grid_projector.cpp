@@ -107,40 +107,49 @@ double grid_projector(      Hexmesh<M1,V1,E1,F1,P1> & m,
     //:::::::::::::::::::::::::   LAMBDA UTILITIES   :::::::::::::::::::::::::
     //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+    // pre smoothing of the surface: surface vertices are averaged with their neighbors
+    // on the surface, inner vertices with all their neighbors (favoring surface ones)
+    std::vector<std::vector<uint>> srf_nbrs(m.num_verts());
+    std::vector<uint> srf_verts, in_verts;
+    for(uint vid=0; vid<m.num_verts(); ++vid)
+    {
+        if(m.vert_is_on_srf(vid))
+        {
+            srf_nbrs.at(vid) = m.vert_adj_srf_verts(vid);
+            srf_verts.push_back(vid);
+        }
+        else in_verts.push_back(vid);
+    }
+    SmoothingEngine smoother(m, opt.smooth_mode);
+    smoother.add_class(srf_verts, [&](const uint vid, const std::vector<vec3d> & verts) -> vec3d
+    {
+        vec3d p(0,0,0);
+        for(uint nbr : srf_nbrs.at(vid)) p += verts.at(nbr);
+        return p / static_cast<double>(srf_nbrs.at(vid).size());
+    });
+    smoother.add_class(in_verts, [&](const uint vid, const std::vector<vec3d> & verts) -> vec3d
+    {
+        vec3d  p(0,0,0);
+        double sum = 0.0;
+        for(uint nbr : m.adj_v2v(vid))
+        {
+            double w = (m.vert_is_on_srf(nbr)) ? 2.0 : 0.5;
+            p   += w * verts.at(nbr);
+            sum += w;
+        }
+        return p / sum;
+    });
+
     // for each surface point, find the closest point on srf
     auto update_targets = [&](const uint smooth_iters, const bool sort_by_dist)
     {
-        // pre smooth the surface
         std::vector<vec3d> verts = m.vector_verts();
-        for(uint i=0; i<smooth_iters; ++i)
-        {
-            PARALLEL_FOR(0, m.num_verts(), 1000,[&](const uint vid)
-            {
-                vec3d p;
-                if(m.vert_is_on_srf(vid))
-                {
-                    for(uint nbr : m.vert_adj_srf_verts(vid)) p += verts.at(nbr);
-                    p /= static_cast<double>(m.vert_adj_srf_verts(vid).size());
-                }
-                else
-                {
-                    double sum = 0.0;
-                    for(uint nbr : m.adj_v2v(vid))
-                    {
-                        double w = (m.vert_is_on_srf(nbr)) ? 2.0 : 0.5;
-                        p   += w * verts.at(nbr);
-                        sum += w;
-                    }
-                    p /= sum;
-                }
-                verts.at(vid) = p;
-            });
-        }
+        smoother.smooth(verts, smooth_iters);
 
-        targets.clear();
-        for(uint vid=0; vid<m.num_verts(); ++vid)
+        targets.resize(m.num_verts());
+        PARALLEL_FOR(0, m.num_verts(), 1000, [&](const uint vid)
         {
-            Proj proj;
+            Proj & proj = targets.at(vid);
             proj.vid    = vid;
             switch(m.vert_data(vid).label)
             {
@@ -149,8 +158,7 @@ double grid_projector(      Hexmesh<M1,V1,E1,F1,P1> & m,
                 case LINE    : proj.target = o_lines.closest_point(verts.at(vid)); break;
             }
             proj.dist   = (m.vert_is_on_srf(vid)) ? 1/verts.at(vid).dist(proj.target) : -verts.at(vid).dist(proj.target);
-            targets.push_back(proj);
-        }
+        });
 
         if(sort_by_dist)
         {
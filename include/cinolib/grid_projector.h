@@ -37,6 +37,7 @@
 #define CINO_GRID_PROJECTOR_H
 
 #include <cinolib/meshes/meshes.h>
+#include <cinolib/smoothing_engine.h>
 
 namespace cinolib
 {
@@ -45,10 +46,11 @@ namespace cinolib
 
 struct GridProjectorOptions
 {
-    double conv_thresh = 1e-4;  // convergence threshold (either H or mean distance from target)
-    uint   max_iter    = 10;    // force convergence after a maximum number of iterations
-    bool   use_H_dist  = false; // uses Hausdorff distance if true. Average distance otherwise
-    double SJ_thresh   = 0;     // minimum threshold for SJ (elements must be strictly above the thresh...)
+    double conv_thresh = 1e-4;          // convergence threshold (either H or mean distance from target)
+    uint   max_iter    = 10;            // force convergence after a maximum number of iterations
+    bool   use_H_dist  = false;         // uses Hausdorff distance if true. Average distance otherwise
+    double SJ_thresh   = 0;             // minimum threshold for SJ (elements must be strictly above the thresh...)
+    int    smooth_mode = SMOOTH_JACOBI; // pre smoothing of the surface (SMOOTH_JACOBI or SMOOTH_GAUSS_SEIDEL)
 };
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -0,0 +1,196 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/buffered_writer.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+
+namespace cinolib
+{
+
+CINO_INLINE
+void append_double(std::string & buf, const double d)
+{
+    char tmp[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    char *end = std::to_chars(tmp, tmp+sizeof(tmp), d).ptr;
+    buf.append(tmp, end);
+#else
+    // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
+    //
+    int len = snprintf(tmp, sizeof(tmp), "%.17g", d);
+    buf.append(tmp, len);
+#endif
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void append_uint(std::string & buf, uint64_t i)
+{
+    char tmp[24];
+    char *end = tmp + sizeof(tmp);
+    char *beg = end;
+    do
+    {
+        *--beg = char('0' + i%10);
+        i /= 10;
+    }
+    while(i>0);
+    buf.append(beg, end);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void append_int(std::string & buf, const int64_t i)
+{
+    if(i<0)
+    {
+        buf.push_back('-');
+        append_uint(buf, uint64_t(0)-uint64_t(i));
+    }
+    else append_uint(buf, uint64_t(i));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename Func>
+CINO_INLINE
+void write_records(FILE         * fp,
+                   const size_t   n,
+                   const Func   & encode,
+                   const size_t   chunk_size)
+{
+    const static unsigned n_threads_hint = std::thread::hardware_concurrency();
+    const static unsigned n_threads      = (n_threads_hint==0u) ? 8u : n_threads_hint;
+
+    size_t n_chunks = (n + chunk_size - 1)/chunk_size;
+    size_t n_bufs   = std::min(n_chunks, size_t(4*n_threads));
+    std::vector<std::string> bufs(n_bufs);
+
+    for(size_t first=0; first<n_chunks; first+=n_bufs)
+    {
+        size_t count = std::min(n_bufs, n_chunks-first);
+        PARALLEL_FOR(0, uint(count), 4, [&](uint i)
+        {
+            std::string & buf = bufs.at(i);
+            buf.clear(); // keeps the capacity, so buffers are allocated only once
+            size_t beg = (first+i)*chunk_size;
+            size_t end = std::min(beg+chunk_size, n);
+            for(size_t j=beg; j<end; ++j) encode(j,buf);
+        });
+        for(size_t i=0; i<count; ++i) fwrite(bufs.at(i).data(), 1, bufs.at(i).size(), fp);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+void write_with_byte_order(FILE * fp, const T * data, const size_t n, const bool little_endian)
+{
+    const uint16_t probe = 1;
+    const bool host_is_little_endian = (*reinterpret_cast<const unsigned char*>(&probe)==1);
+
+    if(host_is_little_endian==little_endian || sizeof(T)==1)
+    {
+        fwrite(data, sizeof(T), n, fp);
+        return;
+    }
+
+    // swap bytes in blocks, so that large arrays are not duplicated in memory
+    const size_t block = 65536;
+    std::vector<unsigned char> buf(std::min(n,block)*sizeof(T));
+    for(size_t beg=0; beg<n; beg+=block)
+    {
+        size_t count = std::min(block, n-beg);
+        const unsigned char *src = reinterpret_cast<const unsigned char*>(data+beg);
+        for(size_t i=0; i<count; ++i)
+        for(size_t b=0; b<sizeof(T); ++b)
+        {
+            buf[i*sizeof(T)+b] = src[i*sizeof(T)+sizeof(T)-1-b];
+        }
+        fwrite(buf.data(), sizeof(T), count, fp);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+void write_little_endian(FILE * fp, const T * data, const size_t n)
+{
+    write_with_byte_order(fp, data, n, true);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+void write_big_endian(FILE * fp, const T * data, const size_t n)
+{
+    write_with_byte_order(fp, data, n, false);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T, typename Func>
+CINO_INLINE
+void write_binary_records(FILE         * fp,
+                          const size_t   n,
+                          const Func   & encode,
+                          const bool     little_endian)
+{
+    const size_t block = 65536;
+    std::vector<T> buf;
+    buf.reserve(block);
+    for(size_t i=0; i<n; ++i)
+    {
+        encode(i,buf);
+        if(buf.size()>=block || i+1==n)
+        {
+            write_with_byte_order(fp, buf.data(), buf.size(), little_endian);
+            buf.clear();
+        }
+    }
+}
+
+}
@@ -0,0 +1,115 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_BUFFERED_WRITER_H
+#define CINO_BUFFERED_WRITER_H
+
+#include <sys/types.h>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Building blocks for fast mesh writers. Text records (e.g. the vertices or the
+ * elements of a mesh) are encoded in large chunks, in parallel, and then written
+ * to file in order with a single fwrite per chunk. Binary blocks are written raw,
+ * with explicit byte order.
+*/
+
+// Appends to buf the shortest decimal representation of d that reads back as d.
+// Uses std::to_chars when available (C++17). Otherwise it falls back to %.17g,
+// which also round-trips, though it is not always the shortest
+//
+CINO_INLINE
+void append_double(std::string & buf, const double d);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void append_uint(std::string & buf, uint64_t i);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void append_int(std::string & buf, const int64_t i);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Writes n text records to fp, preserving their order. Records are split into
+// chunks of chunk_size, which are encoded in parallel. encode(i,buf) must append
+// the text of the i-th record to buf. At most a few chunks per thread are kept in
+// memory at any time, regardless of n
+//
+template<typename Func>
+CINO_INLINE
+void write_records(FILE         * fp,
+                   const size_t   n,
+                   const Func   & encode,
+                   const size_t   chunk_size = 65536);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Write n values as raw binary data, with the given byte order (regardless of the host's)
+//
+template<typename T>
+CINO_INLINE
+void write_little_endian(FILE * fp, const T * data, const size_t n);
+
+template<typename T>
+CINO_INLINE
+void write_big_endian(FILE * fp, const T * data, const size_t n);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Binary counterpart of write_records. encode(i,buf) must push the values of the
+// i-th record in buf, which is flushed to file (with the given byte order) in blocks
+//
+template<typename T, typename Func>
+CINO_INLINE
+void write_binary_records(FILE         * fp,
+                          const size_t   n,
+                          const Func   & encode,
+                          const bool     little_endian);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "buffered_writer.cpp"
+#endif
+
+#endif // CINO_BUFFERED_WRITER_H
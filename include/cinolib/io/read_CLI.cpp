@@ -91,53 +91,93 @@ void read_CLI(const char                                   * filename,
               std::vector<std::vector<std::vector<vec3d>>> & open_polylines,     // support structures
               std::vector<std::vector<std::vector<vec3d>>> & hatches)            // supports/infills
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+    CLIReader reader(filename);
+
+    uint n_layers = reader.num_layers();
+    internal_polylines.assign(n_layers, {});
+    external_polylines.assign(n_layers, {});
+    open_polylines.assign(n_layers, {});
+    hatches.assign(n_layers, {});
+
+    uint   layer = 0;
+    double z;
+    std::vector<std::vector<vec3d>> internal, external, open;
+    while(reader.next_layer(z, internal, external, open))
+    {
+        internal_polylines.at(layer) = std::move(internal);
+        external_polylines.at(layer) = std::move(external);
+        open_polylines.at(layer)     = std::move(open);
+        ++layer;
+    }
+}
 
-    internal_polylines.clear();
-    external_polylines.clear();
-    open_polylines.clear();
-    hatches.clear();
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    std::ifstream f(filename);
-    std::string   line;
-    uint          n_layers, type;
-    int           layer = -1;
-    double        z;
+CINO_INLINE
+CLIReader::CLIReader(const char * filename)
+{
+    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
+    f.open(filename);
     if(!f.is_open())
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_CLI() : couldn't open input file " << filename << std::endl;
         exit(-1);
     }
 
+    // parse the header, up to the first layer
+    std::string line;
     while(getline(f, line, '\n'))
     {
-        if(sscanf(line.c_str(), "$$LAYERS/%d", &n_layers) == 1)
+        if(sscanf(line.c_str(), "$$LAYERS/%u", &n_layers) == 1) continue;
+        if(sscanf(line.c_str(), "$$LAYER/%lf", &next_z) == 1)
         {
-            internal_polylines.resize(n_layers);
-            external_polylines.resize(n_layers);
-            open_polylines.resize(n_layers);
-            hatches.resize(n_layers);
+            has_layer = true;
+            break;
         }
-        else if(sscanf(line.c_str(), "$$LAYER/%lf", &z) == 1)
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool CLIReader::next_layer(double                          & z,
+                           std::vector<std::vector<vec3d>> & internal_polylines,
+                           std::vector<std::vector<vec3d>> & external_polylines,
+                           std::vector<std::vector<vec3d>> & open_polylines)
+{
+    internal_polylines.clear();
+    external_polylines.clear();
+    open_polylines.clear();
+
+    if(!has_layer) return false;
+    has_layer = false;
+    z = next_z;
+
+    std::string line;
+    uint        type;
+    while(getline(f, line, '\n'))
+    {
+        if(sscanf(line.c_str(), "$$LAYER/%lf", &next_z) == 1)
         {
-            ++layer;
+            has_layer = true;
+            break;
         }
-        else if(sscanf(line.c_str(), "$$POLYLINE/%*d,%d,%*d,%*s", &type) == 1)
+        else if(sscanf(line.c_str(), "$$POLYLINE/%*d,%u,%*d,%*s", &type) == 1)
         {
             // NOTE: for INTERNAL and EXTERNAL, the last point is a duplication of the first one
             std::vector<vec3d> pl = read_polyline(line, z);
 
             switch(type)
             {
-                case EXTERNAL : pl.pop_back(); external_polylines.at(layer).push_back(pl); break;
-                case INTERNAL : pl.pop_back(); internal_polylines.at(layer).push_back(pl); break;
-                case OPEN     : open_polylines.at(layer).push_back(pl); break;
+                case EXTERNAL : pl.pop_back(); external_polylines.push_back(pl); break;
+                case INTERNAL : pl.pop_back(); internal_polylines.push_back(pl); break;
+                case OPEN     : open_polylines.push_back(pl); break;
                 default       : std::cerr << "WARNING! Unknown polyline type: discarded." << std::endl;
-            }            
+            }
         }
     }
-    f.close();
+    return true;
 }
 
 }
@@ -37,6 +37,7 @@
 #define CINO_READ_CLI_H
 
 #include <vector>
+#include <fstream>
 #include <cinolib/cino_inline.h>
 #include <cinolib/geometry/vec_mat.h>
 
@@ -58,6 +59,34 @@ void read_CLI(const char                                   * filename,
               std::vector<std::vector<std::vector<vec3d>>> & external_polylines, // inner holes
               std::vector<std::vector<std::vector<vec3d>>> & open_polylines,     // support structures
               std::vector<std::vector<std::vector<vec3d>>> & hatches);           // supports/infills
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Streaming CLI reader. Layers are parsed one at a time, so that files with
+// many layers can be processed without loading all of them in memory
+//
+class CLIReader
+{
+    public:
+
+        explicit CLIReader(const char * filename);
+
+        // number of layers declared in the header of the file
+        uint num_layers() const { return n_layers; }
+
+        // parses the next layer. Returns false if there are no more layers
+        bool next_layer(double                          & z,
+                        std::vector<std::vector<vec3d>> & internal_polylines,  // outer slice boundary
+                        std::vector<std::vector<vec3d>> & external_polylines,  // inner holes
+                        std::vector<std::vector<vec3d>> & open_polylines);     // support structures
+
+    protected:
+
+        std::ifstream f;
+        uint          n_layers  = 0;
+        bool          has_layer = false; // true if a "$$LAYER" line has been read, but not its content
+        double        next_z    = 0;
+};
 }
 
 #ifndef  CINO_STATIC_LIB
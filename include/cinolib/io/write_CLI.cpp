@@ -0,0 +1,132 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/write_CLI.h>
+#include <iostream>
+
+namespace cinolib
+{
+
+CINO_INLINE
+void write_CLI(const char                                         * filename,
+               const std::vector<std::vector<std::vector<vec3d>>> & internal_polylines,
+               const std::vector<std::vector<std::vector<vec3d>>> & external_polylines,
+               const std::vector<std::vector<std::vector<vec3d>>> & open_polylines)
+{
+    assert(internal_polylines.size()==external_polylines.size());
+    assert(internal_polylines.size()==open_polylines.size());
+
+    CLIWriter writer(filename);
+    for(uint sid=0; sid<internal_polylines.size(); ++sid)
+    {
+        double z = 0;
+        if(!external_polylines.at(sid).empty()) z = external_polylines.at(sid).front().front().z(); else
+        if(!internal_polylines.at(sid).empty()) z = internal_polylines.at(sid).front().front().z(); else
+        if(!open_polylines.at(sid).empty())     z = open_polylines.at(sid).front().front().z();
+        writer.write_layer(z, internal_polylines.at(sid), external_polylines.at(sid), open_polylines.at(sid));
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+CLIWriter::CLIWriter(const char * filename)
+{
+    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+
+    fp = fopen(filename, "w");
+
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_CLI() : couldn't save file " << filename << std::endl;
+        exit(-1);
+    }
+
+    fprintf(fp, "$$HEADERSTART\n$$ASCII\n$$UNITS/1\n$$LAYERS/");
+    layers_pos = ftell(fp);
+    fprintf(fp, "%010u\n$$HEADEREND\n$$GEOMETRYSTART\n", 0u); // fixed width, patched by close()
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+CLIWriter::~CLIWriter()
+{
+    close();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void CLIWriter::write_layer(const double                            z,
+                            const std::vector<std::vector<vec3d>> & internal_polylines,
+                            const std::vector<std::vector<vec3d>> & external_polylines,
+                            const std::vector<std::vector<vec3d>> & open_polylines)
+{
+    assert(fp!=nullptr);
+    fprintf(fp, "$$LAYER/%.17g\n", z);
+    for(const auto & pl : external_polylines) write_polyline(pl, 1);
+    for(const auto & pl : internal_polylines) write_polyline(pl, 0);
+    for(const auto & pl : open_polylines)     write_polyline(pl, 2);
+    ++n_layers;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void CLIWriter::write_polyline(const std::vector<vec3d> & pl, const uint type)
+{
+    // closed polylines (types 0 and 1) repeat the first point at the end
+    bool closed = (type!=2);
+    fprintf(fp, "$$POLYLINE/0,%u,%zu", type, pl.size() + (closed ? 1 : 0));
+    for(const vec3d & p : pl) fprintf(fp, ",%.17g,%.17g", p.x(), p.y());
+    if(closed && !pl.empty()) fprintf(fp, ",%.17g,%.17g", pl.front().x(), pl.front().y());
+    fprintf(fp, "\n");
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void CLIWriter::close()
+{
+    if(fp==nullptr) return;
+    fprintf(fp, "$$GEOMETRYEND\n");
+    fseek(fp, layers_pos, SEEK_SET);
+    fprintf(fp, "%010u", n_layers);
+    fclose(fp);
+    fp = nullptr;
+}
+
+}
@@ -0,0 +1,102 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_WRITE_CLI_H
+#define CINO_WRITE_CLI_H
+
+#include <vector>
+#include <cstdio>
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec_mat.h>
+
+namespace cinolib
+{
+
+// Reference for COMMON LAYER INTERFACE (CLI) file format:
+// http://www.hmilch.net/downloads/cli_format.html
+//
+// Writes an ASCII CLI file. Input vectors have as many entries as the number of
+// slices, with the same layout produced by read_CLI. Closed polylines (internal
+// and external) are given without duplicating the first point at the end. The z
+// coordinate of each slice is taken from its first point
+//
+CINO_INLINE
+void write_CLI(const char                                         * filename,
+               const std::vector<std::vector<std::vector<vec3d>>> & internal_polylines, // outer slice boundary
+               const std::vector<std::vector<std::vector<vec3d>>> & external_polylines, // inner holes
+               const std::vector<std::vector<std::vector<vec3d>>> & open_polylines);    // support structures
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Streaming CLI writer. Layers are appended one at a time, so that files with
+// many layers can be produced without keeping all of them in memory. The number
+// of layers in the header is filled when the file is closed
+//
+class CLIWriter
+{
+    public:
+
+        explicit CLIWriter(const char * filename);
+                ~CLIWriter();
+
+        CLIWriter(const CLIWriter &) = delete;
+        CLIWriter & operator=(const CLIWriter &) = delete;
+
+        void write_layer(const double                            z,
+                         const std::vector<std::vector<vec3d>> & internal_polylines,
+                         const std::vector<std::vector<vec3d>> & external_polylines,
+                         const std::vector<std::vector<vec3d>> & open_polylines);
+
+        // completes the file (called by the destructor, if not done before)
+        void close();
+
+        uint num_layers() const { return n_layers; }
+
+    protected:
+
+        void write_polyline(const std::vector<vec3d> & pl, const uint type);
+
+        FILE * fp         = nullptr;
+        long   layers_pos = 0; // position of the layer count in the header
+        uint   n_layers   = 0;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "write_CLI.cpp"
+#endif
+
+#endif // CINO_WRITE_CLI_H
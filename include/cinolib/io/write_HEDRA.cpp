@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_HEDRA.h>
+#include <cinolib/io/buffered_writer.h>
 #include <iostream>
 
 namespace cinolib
@@ -62,28 +63,37 @@ void write_HEDRA(const char                           * filename,
 
     fprintf(fp, "%d %d %d\n", nv, nf, np);
 
-    // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-    //
-    for(const vec3d & v : verts) fprintf(fp, "%.17g %.17g %.17g\n", v.x(), v.y(), v.z());
-
-    for(const std::vector<uint> & f : faces)
+    write_records(fp, nv, [&](size_t vid, std::string & buf)
     {
-        fprintf(fp, "%d ", static_cast<int>(f.size()));
-        for(uint vid : f) fprintf(fp, "%d ", vid+1);
-        fprintf(fp, "\n");
-    }
+        append_double(buf, verts[vid].x()); buf += ' ';
+        append_double(buf, verts[vid].y()); buf += ' ';
+        append_double(buf, verts[vid].z()); buf += '\n';
+    });
 
-    for(uint pid=0; pid<np; ++pid)
+    write_records(fp, nf, [&](size_t fid, std::string & buf)
     {
-        fprintf(fp, "%d ", int(polys.at(pid).size()));
+        append_uint(buf, faces[fid].size());
+        buf += ' ';
+        for(uint vid : faces[fid])
+        {
+            append_uint(buf, vid+1);
+            buf += ' ';
+        }
+        buf += '\n';
+    });
 
+    write_records(fp, np, [&](size_t pid, std::string & buf)
+    {
+        append_uint(buf, polys.at(pid).size());
+        buf += ' ';
         for(uint off=0; off<polys.at(pid).size(); ++off)
         {
-            if (polys_winding.at(pid).at(off)) fprintf(fp, "%d ",  int(polys.at(pid).at(off)+1));
-            else                               fprintf(fp, "%d ", -int(polys.at(pid).at(off)+1));
+            int fid = int(polys.at(pid).at(off)+1);
+            append_int(buf, (polys_winding.at(pid).at(off)) ? fid : -fid);
+            buf += ' ';
         }
-        fprintf(fp, "\n");
-    }
+        buf += '\n';
+    });
 
     fclose(fp);
 }
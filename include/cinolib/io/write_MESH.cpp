@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_MESH.h>
+#include <cinolib/io/buffered_writer.h>
 
 #include <iostream>
 
@@ -68,7 +69,7 @@ void write_MESH(const char                           * filename,
     uint nh = 0;
     uint np = 0;
     uint nw = 0;
-    for(auto p : polys)
+    for(const auto & p : polys)
     {
         if (p.size() == 4) ++nt; else
         if (p.size() == 5) ++np; else
@@ -80,75 +81,39 @@ void write_MESH(const char                           * filename,
     {
         fprintf(fp, "Vertices\n" );
         fprintf(fp, "%d\n", nv);
-        for(uint vid=0; vid<nv; ++vid)
+        write_records(fp, nv, [&](size_t vid, std::string & buf)
         {
-            // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-            //
-            fprintf( fp, "%.17g %.17g %.17g %d\n", verts.at(vid).x(), verts.at(vid).y(), verts.at(vid).z(), vert_labels.at(vid));
-        }
+            append_double(buf, verts[vid].x()); buf += ' ';
+            append_double(buf, verts[vid].y()); buf += ' ';
+            append_double(buf, verts[vid].z()); buf += ' ';
+            append_int(buf, vert_labels[vid]);
+            buf += '\n';
+        });
     }
 
-    if (nt > 0)
+    // elements of each type are written in a separate section. Polys of other types encode nothing
+    auto write_elements = [&](const char *section, const uint count, const uint n_verts)
     {
-        fprintf(fp, "Tetrahedra\n" );
-        fprintf(fp, "%d\n", nt );
-        for(uint pid=0; pid<polys.size(); ++pid)
+        if(count==0) return;
+        fprintf(fp, "%s\n", section);
+        fprintf(fp, "%d\n", count);
+        write_records(fp, polys.size(), [&](size_t pid, std::string & buf)
         {
-            const std::vector<uint> & tet = polys.at(pid);
-            if (tet.size() == 4)
+            const std::vector<uint> & p = polys[pid];
+            if(p.size()!=n_verts) return;
+            for(uint vid : p)
             {
-                fprintf(fp, "%d %d %d %d %d\n", tet.at(0)+1, tet.at(1)+1, tet.at(2)+1, tet.at(3)+1, poly_labels.at(pid));
+                append_uint(buf, vid+1);
+                buf += ' ';
             }
-        }
-    }
-
-    if (nh > 0)
-    {
-        fprintf(fp, "Hexahedra\n" );
-        fprintf(fp, "%d\n", nh );
-        for(uint pid=0; pid<polys.size(); ++pid)
-        {
-            const std::vector<uint> & hex = polys.at(pid);
-            if (hex.size() == 8)
-            {
-                fprintf(fp, "%d %d %d %d %d %d %d %d %d\n", hex.at(0)+1, hex.at(1)+1, hex.at(2)+1, hex.at(3)+1,
-                                                            hex.at(4)+1, hex.at(5)+1, hex.at(6)+1, hex.at(7)+1,
-                                                            poly_labels.at(pid));
-            }
-        }
-    }
-
-    if(np > 0)
-    {
-        fprintf(fp, "Pyramids\n" );
-        fprintf(fp, "%d\n", np );
-        for(uint pid=0; pid<polys.size(); ++pid)
-        {
-            const std::vector<uint> & pyr = polys.at(pid);
-            if (pyr.size() == 5)
-            {
-                fprintf(fp, "%d %d %d %d %d %d\n", pyr.at(0)+1, pyr.at(1)+1, pyr.at(2)+1, pyr.at(3)+1, pyr.at(4)+1,
-                        poly_labels.at(pid));
-            }
-        }
-    }
-
-    if (nw > 0)
-    {
-        fprintf(fp, "Prisms\n" );
-        fprintf(fp, "%d\n", nw );
-        for(uint pid=0; pid<polys.size(); ++pid)
-        {
-            const std::vector<uint> & prism = polys.at(pid);
-            if (prism.size() == 6)
-            {
-                fprintf(fp, "%d %d %d %d %d %d %d\n", prism.at(0)+1, prism.at(1)+1, prism.at(2)+1,
-                        prism.at(3)+1, prism.at(4)+1, prism.at(5)+1,
-                        poly_labels.at(pid));
-            }
-        }
-    }
-
+            append_int(buf, poly_labels[pid]);
+            buf += '\n';
+        });
+    };
+    write_elements("Tetrahedra", nt, 4);
+    write_elements("Hexahedra",  nh, 8);
+    write_elements("Pyramids",   np, 5);
+    write_elements("Prisms",     nw, 6);
 
     fprintf(fp, "End\n\n");
     fclose(fp);
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_OBJ.h>
+#include <cinolib/io/buffered_writer.h>
 #include <cinolib/color.h>
 #include <cinolib/stl_container_utilities.h>
 #include <cinolib/string_utilities.h>
@@ -44,6 +45,60 @@
 namespace cinolib
 {
 
+// vertices and faces are the bulk of the file, and are encoded in parallel (see buffered_writer.h)
+CINO_INLINE
+void write_OBJ_verts(FILE * fp, const std::vector<double> & xyz)
+{
+    write_records(fp, xyz.size()/3, [&](size_t vid, std::string & buf)
+    {
+        buf += "v ";
+        append_double(buf, xyz[3*vid  ]); buf += ' ';
+        append_double(buf, xyz[3*vid+1]); buf += ' ';
+        append_double(buf, xyz[3*vid+2]); buf += '\n';
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// writes faces serialized with fixed size n. Function prefix(fid,buf) may add per face lines (e.g. usemtl)
+template<typename Func>
+CINO_INLINE
+void write_OBJ_faces(FILE * fp, const std::vector<uint> & faces, const uint n, const Func & prefix)
+{
+    write_records(fp, faces.size()/n, [&](size_t fid, std::string & buf)
+    {
+        prefix(fid,buf);
+        buf += 'f';
+        for(uint i=0; i<n; ++i)
+        {
+            buf += ' ';
+            append_uint(buf, faces[n*fid+i]+1);
+        }
+        buf += '\n';
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename Func>
+CINO_INLINE
+void write_OBJ_faces(FILE * fp, const std::vector<std::vector<uint>> & faces, const Func & prefix)
+{
+    write_records(fp, faces.size(), [&](size_t fid, std::string & buf)
+    {
+        prefix(fid,buf);
+        buf += "f ";
+        for(uint vid : faces[fid])
+        {
+            append_uint(buf, vid+1);
+            buf += ' ';
+        }
+        buf += '\n';
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 CINO_INLINE
 void write_OBJ(const char                * filename,
                const std::vector<double> & xyz,
@@ -60,22 +115,10 @@ void write_OBJ(const char                * filename,
         exit(-1);
     }
 
-    for(size_t i=0; i<xyz.size(); i+=3)
-    {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(fp, "v %.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-    }
-
-    for(size_t i=0; i<tri.size(); i+=3)
-    {
-        fprintf(fp, "f %d %d %d\n", tri[i] + 1, tri[i+1] + 1, tri[i+2] + 1);
-    }
+    write_OBJ_verts(fp, xyz);
 
-    for(size_t i=0; i<quad.size(); i+=4)
-    {
-        fprintf(fp, "f %d %d %d %d\n", quad[i] + 1, quad[i+1] + 1, quad[i+2] + 1, quad[i+3] + 1);
-    }
+    write_OBJ_faces(fp, tri, 3, [](size_t, std::string &){});
+    write_OBJ_faces(fp, quad, 4, [](size_t, std::string &){});
 
     fclose(fp);
 }
@@ -97,19 +140,9 @@ void write_OBJ(const char                           * filename,
         exit(-1);
     }
 
-    for(uint i=0; i<xyz.size(); i+=3)
-    {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(fp, "v %.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-    }
+    write_OBJ_verts(fp, xyz);
 
-    for(auto p : poly)
-    {
-        fprintf(fp, "f ");
-        for(uint vid : p) fprintf(fp, "%d ", vid+1);
-        fprintf(fp, "\n");
-    }
+    write_OBJ_faces(fp, poly, [](size_t, std::string &){});
 
     fclose(fp);
 }
@@ -154,24 +187,18 @@ void write_OBJ(const char                * filename,
 
     fprintf(f_obj, "mtllib %s\n", get_file_name(mtl_filename).c_str());
 
-    for(uint i=0; i<xyz.size(); i+=3)
-    {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(f_obj, "v %.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-    }
+    write_OBJ_verts(f_obj, xyz);
 
-    for(uint i=0; i<tri.size(); i+=3)
+    std::vector<uint> mtl(colors.size());
+    for(uint i=0; i<colors.size(); ++i) mtl.at(i) = color_map.at(colors.at(i));
+    auto usemtl = [&](size_t fid, std::string & buf)
     {
-        fprintf(f_obj, "usemtl color_%d\n", color_map[colors.at(i/3)]);
-        fprintf(f_obj, "f %d %d %d\n", tri[i] + 1, tri[i+1] + 1, tri[i+2] + 1);
-    }
-
-    for(uint i=0; i<quad.size(); i+=4)
-    {
-        fprintf(f_obj, "usemtl color_%d\n", color_map[colors.at(i/4)]);
-        fprintf(f_obj, "f %d %d %d %d\n", quad[i] + 1, quad[i+1] + 1, quad[i+2] + 1, quad[i+3] + 1);
-    }
+        buf += "usemtl color_";
+        append_uint(buf, mtl.at(fid));
+        buf += '\n';
+    };
+    write_OBJ_faces(f_obj, tri,  3, usemtl);
+    write_OBJ_faces(f_obj, quad, 4, usemtl);
 
     fclose(f_obj);
     fclose(f_mtl);
@@ -204,24 +231,11 @@ void write_OBJ(const char                * filename,
     fprintf(f_mtl, "newmtl color\nKd %f %f %f\n", color.r, color.g, color.b);
     fprintf(f_obj, "mtllib %s\n", get_file_name(mtl_filename).c_str());
 
-    for(uint i=0; i<xyz.size(); i+=3)
-    {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(f_obj, "v %.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-    }
-
-    for(uint i=0; i<tri.size(); i+=3)
-    {
-        fprintf(f_obj, "usemtl color\n");
-        fprintf(f_obj, "f %d %d %d\n", tri[i] + 1, tri[i+1] + 1, tri[i+2] + 1);
-    }
+    write_OBJ_verts(f_obj, xyz);
 
-    for(uint i=0; i<quad.size(); i+=4)
-    {
-        fprintf(f_obj, "usemtl color\n");
-        fprintf(f_obj, "f %d %d %d %d\n", quad[i] + 1, quad[i+1] + 1, quad[i+2] + 1, quad[i+3] + 1);
-    }
+    auto usemtl = [](size_t, std::string & buf) { buf += "usemtl color\n"; };
+    write_OBJ_faces(f_obj, tri,  3, usemtl);
+    write_OBJ_faces(f_obj, quad, 4, usemtl);
 
     fclose(f_obj);
     fclose(f_mtl);
@@ -266,20 +280,16 @@ void write_OBJ(const char                           * filename,
 
     fprintf(f_obj, "mtllib %s\n", get_file_name(mtl_filename).c_str());
 
-    for(uint i=0; i<xyz.size(); i+=3)
-    {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(f_obj, "v %.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-    }
+    write_OBJ_verts(f_obj, xyz);
 
-    for(uint fid=0; fid<poly.size(); ++fid)
+    std::vector<uint> mtl(colors.size());
+    for(uint i=0; i<colors.size(); ++i) mtl.at(i) = color_map.at(colors.at(i));
+    write_OBJ_faces(f_obj, poly, [&](size_t fid, std::string & buf)
     {
-        fprintf(f_obj, "usemtl color_%d\n", color_map.at(colors.at(fid)));
-        fprintf(f_obj, "f ");
-        for(uint vid : poly.at(fid)) fprintf(f_obj, "%d ", vid+1);
-        fprintf(f_obj, "\n");
-    }
+        buf += "usemtl color_";
+        append_uint(buf, mtl.at(fid));
+        buf += '\n';
+    });
 
     fclose(f_obj);
     fclose(f_mtl);
@@ -322,19 +332,14 @@ void write_OBJ(const char                           *filename,
 
     fprintf(f_obj, "mtllib %s\n", get_file_name(mtl_filename).c_str());
 
-    for(uint i = 0; i < xyz.size(); i += 3)
-    {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        fprintf(f_obj, "v %.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-    }
+    write_OBJ_verts(f_obj, xyz);
 
-    for(uint pid = 0; pid < poly.size(); ++pid)
+    write_OBJ_faces(f_obj, poly, [&](size_t pid, std::string & buf)
     {
-        fprintf(f_obj, "usemtl label_%d\n", labels[pid]);
-        fprintf(f_obj, "f ");
-        for(uint vid : poly.at(pid)) fprintf(f_obj, "%d ", vid+1);
-        fprintf(f_obj, "\n");
-    }
+        buf += "usemtl label_";
+        append_int(buf, labels[pid]);
+        buf += '\n';
+    });
 
     fclose(f_obj);
     fclose(f_mtl);
@@ -358,22 +363,16 @@ void write_OBJ(const char                * filename,
         exit(-1);
     }
 
-    for(size_t i=0; i<xyz.size(); i+=3)
-    {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(fp, "v %.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-    }
+    write_OBJ_verts(fp, xyz);
 
-    for(size_t i=0; i<uv.size(); i+=2)
+    write_records(fp, uv.size()/2, [&](size_t i, std::string & buf)
     {
-        fprintf(fp, "vt %.17g %.17g\n", uv[i], uv[i+1]);
-    }
+        buf += "vt ";
+        append_double(buf, uv[2*i  ]); buf += ' ';
+        append_double(buf, uv[2*i+1]); buf += '\n';
+    });
 
-    for(size_t i=0; i<tri.size(); i+=3)
-    {
-        fprintf(fp, "f %d %d %d\n", tri[i] + 1, tri[i+1] + 1, tri[i+2] + 1);
-    }
+    write_OBJ_faces(fp, tri, 3, [](size_t, std::string &){});
 
     fclose(fp);
 }
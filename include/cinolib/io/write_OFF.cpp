@@ -34,13 +34,44 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_OFF.h>
-
+#include <cinolib/io/buffered_writer.h>
 
 #include <iostream>
 
 namespace cinolib
 {
 
+// vertices are the bulk of the file, and are encoded in parallel (see buffered_writer.h)
+CINO_INLINE
+void write_OFF_verts(FILE * fp, const std::vector<double> & xyz)
+{
+    write_records(fp, xyz.size()/3, [&](size_t vid, std::string & buf)
+    {
+        append_double(buf, xyz[3*vid  ]); buf += ' ';
+        append_double(buf, xyz[3*vid+1]); buf += ' ';
+        append_double(buf, xyz[3*vid+2]); buf += '\n';
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_OFF_faces(FILE * fp, const std::vector<uint> & faces, const uint n)
+{
+    write_records(fp, faces.size()/n, [&](size_t fid, std::string & buf)
+    {
+        append_uint(buf, n);
+        for(uint i=0; i<n; ++i)
+        {
+            buf += ' ';
+            append_uint(buf, faces[n*fid+i]);
+        }
+        buf += '\n';
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 CINO_INLINE
 void write_OFF(const char                * filename,
               const std::vector<double> & xyz,
@@ -60,22 +91,9 @@ void write_OFF(const char                * filename,
     int n_poly = int(tri.size()/3 + quad.size()/4);
     fprintf (fp, "OFF\n%zu %d 0\n", xyz.size()/3, n_poly);
 
-    for(size_t i=0; i<xyz.size(); i+=3)
-    {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(fp, "%.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-    }
-
-    for(size_t i=0; i<tri.size(); i+=3)
-    {
-        fprintf(fp, "3 %d %d %d\n", tri[i], tri[i+1], tri[i+2]);
-    }
-
-    for(size_t i=0; i<quad.size(); i+=4)
-    {
-        fprintf(fp, "4 %d %d %d %d\n", quad[i], quad[i+1], quad[i+2], quad[i+3]);
-    }
+    write_OFF_verts(fp, xyz);
+    write_OFF_faces(fp, tri,  3);
+    write_OFF_faces(fp, quad, 4);
 
     fclose(fp);
 }
@@ -100,22 +118,18 @@ void write_OFF(const char                           * filename,
     uint n_faces = uint(faces.size());
     fprintf (fp, "OFF\n%zu %d 0\n", xyz.size()/3, n_faces);
 
-    for(uint i=0; i<xyz.size(); i+=3)
+    write_OFF_verts(fp, xyz);
+    write_records(fp, faces.size(), [&](size_t fid, std::string & buf)
     {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(fp, "%.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-    }
-
-    for(uint i=0; i<faces.size(); ++i)
-    {
-        fprintf(fp, "%d ", static_cast<int>(faces.at(i).size()));
-        for(uint j=0; j<faces.at(i).size(); ++j)
+        append_uint(buf, faces[fid].size());
+        buf += ' ';
+        for(uint vid : faces[fid])
         {
-            fprintf(fp, "%d ", faces.at(i).at(j));
+            append_uint(buf, vid);
+            buf += ' ';
         }
-        fprintf(fp, "\n");
-    }
+        buf += '\n';
+    });
 
     fclose(fp);
 }
@@ -33,7 +33,9 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_STL.h>
+#include <cinolib/io/buffered_writer.h>
 #include <iostream>
+#include <cstring>
 
 namespace cinolib
 {
@@ -42,29 +44,66 @@ CINO_INLINE
 void write_STL(const char                           * filename,
                const std::vector<double>            & xyz,
                const std::vector<std::vector<uint>> & poly,
-               const std::vector<double>            & normals)
+               const std::vector<double>            & normals,
+               const bool                             binary)
 {
     setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
-    FILE *fp = fopen(filename, "w");
+    FILE *fp = fopen(filename, (binary) ? "wb" : "w");
     if(!fp)
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : save_STL() : couldn't save file " << filename << std::endl;
         exit(-1);
     }
 
-    fprintf(fp, "solid cinolib_mesh\n");
-    for(uint pid=0; pid<poly.size(); ++pid)
+    if(binary)
     {
-        fprintf(fp, "facet normal %f %f %f\n", normals.at(pid*3+0), normals.at(pid*3+1), normals.at(pid*3+2));
-        fprintf(fp, "  outer loop\n");
-        fprintf(fp, "    vertex %f %f %f\n", xyz.at(poly.at(pid).at(0)*3+0), xyz.at(poly.at(pid).at(0)*3+1), xyz.at(poly.at(pid).at(0)*3+2));
-        fprintf(fp, "    vertex %f %f %f\n", xyz.at(poly.at(pid).at(1)*3+0), xyz.at(poly.at(pid).at(1)*3+1), xyz.at(poly.at(pid).at(1)*3+2));
-        fprintf(fp, "    vertex %f %f %f\n", xyz.at(poly.at(pid).at(2)*3+0), xyz.at(poly.at(pid).at(2)*3+1), xyz.at(poly.at(pid).at(2)*3+2));
-        fprintf(fp, "  endloop\n");
-        fprintf(fp, "endfacet\n");
+        // 80 bytes header, number of triangles, and then 50 bytes per triangle:
+        // normal and vertices as little-endian 32 bit floats + 16 bit attribute
+        char header[80];
+        memset(header, 0, 80);
+        strncpy(header, "cinolib_mesh", 80);
+        fwrite(header, 1, 80, fp);
+        uint32_t nt = uint32_t(poly.size());
+        write_little_endian(fp, &nt, 1);
+
+        auto append_float = [](std::string & buf, const double d)
+        {
+            float    f = float(d);
+            uint32_t u;
+            memcpy(&u, &f, 4);
+            for(int b=0; b<4; ++b) buf.push_back(char((u >> (8*b)) & 0xff));
+        };
+        write_records(fp, poly.size(), [&](size_t pid, std::string & buf)
+        {
+            for(uint i=0; i<3; ++i) append_float(buf, normals.at(pid*3+i));
+            for(uint j=0; j<3; ++j)
+            for(uint i=0; i<3; ++i) append_float(buf, xyz.at(poly.at(pid).at(j)*3+i));
+            buf.push_back(0);
+            buf.push_back(0);
+        });
+    }
+    else
+    {
+        fprintf(fp, "solid cinolib_mesh\n");
+        write_records(fp, poly.size(), [&](size_t pid, std::string & buf)
+        {
+            buf += "facet normal ";
+            append_double(buf, normals.at(pid*3+0)); buf += ' ';
+            append_double(buf, normals.at(pid*3+1)); buf += ' ';
+            append_double(buf, normals.at(pid*3+2)); buf += "\n  outer loop\n";
+            for(uint j=0; j<3; ++j)
+            {
+                uint vid = poly.at(pid).at(j);
+                buf += "    vertex ";
+                append_double(buf, xyz.at(vid*3+0)); buf += ' ';
+                append_double(buf, xyz.at(vid*3+1)); buf += ' ';
+                append_double(buf, xyz.at(vid*3+2)); buf += '\n';
+            }
+            buf += "  endloop\nendfacet\n";
+        });
+        fprintf(fp, "endsolid cinolib_mesh\n");
     }
-    fprintf(fp, "endsolid cinolib_mesh\n");
     fclose(fp);
 }
 
@@ -45,7 +45,8 @@ CINO_INLINE
 void write_STL(const char                           * filename,
                const std::vector<double>            & xyz,
                const std::vector<std::vector<uint>> & poly,
-               const std::vector<double>            & normals);
+               const std::vector<double>            & normals,
+               const bool                             binary = false);
 }
 
 #ifndef  CINO_STATIC_LIB
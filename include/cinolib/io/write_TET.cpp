@@ -34,7 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_TET.h>
-
+#include <cinolib/io/buffered_writer.h>
 
 #include <iostream>
 
@@ -59,17 +59,23 @@ void write_TET(const char                           * filename,
     fprintf(fp, "%d vertices\n", (int)verts.size());
     fprintf(fp, "%d tets\n",     (int)tets.size());
 
-    for(const vec3d & v : verts)
+    write_records(fp, verts.size(), [&](size_t vid, std::string & buf)
     {
-        // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-        //
-        fprintf(fp, "%.17g %.17g %.17g\n", v.x(), v.y(), v.z());
-    }
+        append_double(buf, verts[vid].x()); buf += ' ';
+        append_double(buf, verts[vid].y()); buf += ' ';
+        append_double(buf, verts[vid].z()); buf += '\n';
+    });
 
-    for(const std::vector<uint> & tet : tets)
+    write_records(fp, tets.size(), [&](size_t pid, std::string & buf)
     {
-        fprintf(fp, "4 %d %d %d %d\n", tet.at(0), tet.at(1), tet.at(2), tet.at(3));
-    }
+        buf += '4';
+        for(uint i=0; i<4; ++i)
+        {
+            buf += ' ';
+            append_uint(buf, tets[pid].at(i));
+        }
+        buf += '\n';
+    });
 
     fclose(fp);
 }
@@ -97,23 +103,21 @@ void write_TET(const char                * filename,
     fprintf(fp, "%d vertices\n", nv);
     fprintf(fp, "%d tets\n",     nt);
 
-    if (nv > 0)
+    write_records(fp, nv, [&](size_t vid, std::string & buf)
     {
-        for(size_t i=0; i<xyz.size(); i+=3)
-        {
-            // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-            //
-            fprintf(fp, "%.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
-        }
-    }
+        append_double(buf, xyz[3*vid  ]); buf += ' ';
+        append_double(buf, xyz[3*vid+1]); buf += ' ';
+        append_double(buf, xyz[3*vid+2]); buf += '\n';
+    });
 
-    if (nt > 0)
+    write_records(fp, nt, [&](size_t pid, std::string & buf)
     {
-        for(size_t i=0; i<tets.size(); i+=4)
-        {
-            fprintf(fp, "4 %d %d %d %d\n", tets[i+0], tets[i+3], tets[i+2], tets[i+1]);
-        }
-    }
+        buf += "4 ";
+        append_uint(buf, tets[4*pid+0]); buf += ' ';
+        append_uint(buf, tets[4*pid+3]); buf += ' ';
+        append_uint(buf, tets[4*pid+2]); buf += ' ';
+        append_uint(buf, tets[4*pid+1]); buf += '\n';
+    });
 
     fclose(fp);
 }
@@ -34,167 +34,110 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_VTK.h>
-
-
-#ifdef CINOLIB_USES_VTK
-#include <vtkSmartPointer.h>
-#include <vtkCell.h>
-#include <vtkCellData.h>
-#include <vtkIntArray.h>
-#include <vtkUnstructuredGrid.h>
-#include <vtkUnstructuredGridWriter.h>
-#endif
+#include <cinolib/io/buffered_writer.h>
+#include <cinolib/vector_serialization.h>
+#include <iostream>
 
 namespace cinolib
 {
 
-#ifdef CINOLIB_USES_VTK
-
+/* Files are written natively (no need for VTK), in the legacy VTK format with
+ * BINARY encoding. Note that the legacy format mandates big-endian binary data.
+ * cell(pid) returns a pointer to the vertices of the pid-th cell, and their number
+*/
+template<typename GetCell>
 CINO_INLINE
-void write_VTK(const char                           * filename,
-               const std::vector<vec3d>             & verts,
-               const std::vector<std::vector<uint>> & polys)
+void write_VTK(const char                * filename,
+               const std::vector<double> & xyz,
+               const uint                  n_cells,
+               const GetCell             & cell)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
-    vtkSmartPointer<vtkUnstructuredGridWriter> writer = vtkSmartPointer<vtkUnstructuredGridWriter>::New();
-    vtkSmartPointer<vtkUnstructuredGrid>       grid   = vtkSmartPointer<vtkUnstructuredGrid>::New();
-    vtkSmartPointer<vtkPoints>                 points = vtkSmartPointer<vtkPoints>::New();
-
-    points->SetDataTypeToDouble();
-
-    // generate some arrays that allow each element type to be viewed alone by thresholding
-    //
-    vtkSmartPointer<vtkIntArray> tetselector = vtkSmartPointer<vtkIntArray>::New();
-    vtkSmartPointer<vtkIntArray> hexselector = vtkSmartPointer<vtkIntArray>::New();
-    tetselector->SetName("tet_selector");
-    hexselector->SetName("hex_selector");
+    FILE *fp = fopen(filename, "wb");
 
-    for(const vec3d & v : verts)
+    if(!fp)
     {
-        points->InsertNextPoint(v.x(), v.y(), v.z());
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_VTK() : couldn't save file " << filename << std::endl;
+        exit(-1);
     }
 
-    bool has_tets = false;
-    bool has_hexa = false;
-
-    for(auto p : polys)
+    uint conn_size = 0;
+    bool has_tets  = false;
+    bool has_hexa  = false;
+    for(uint pid=0; pid<n_cells; ++pid)
     {
-        switch (p.size())
+        uint n = cell(pid).second;
+        switch(n)
         {
-            case 4:
-            {
-                vtkIdType pid[] = { p.at(0), p.at(1), p.at(2), p.at(3) };
-                grid->InsertNextCell(VTK_TETRA, 4, pid);
-                tetselector->InsertNextValue(1);
-                hexselector->InsertNextValue(0);
-                has_tets = true;
-                break;
-            }
-
-            case 8:
-            {
-                vtkIdType pid[] = { p.at(0), p.at(1), p.at(2), p.at(3),
-                                    p.at(4), p.at(5), p.at(6), p.at(7) };
-                grid->InsertNextCell(VTK_HEXAHEDRON, 8, pid);
-                tetselector->InsertNextValue(0);
-                hexselector->InsertNextValue(1);
-                has_hexa = true;
-                break;
-            }
-
+            case 4 : has_tets = true; break;
+            case 8 : has_hexa = true; break;
             default: assert(false && "Unsupported Polyhedron!");
         }
+        conn_size += n+1;
     }
 
-    grid->SetPoints(points);
-    if (has_tets) grid->GetCellData()->AddArray(tetselector);
-    if (has_hexa) grid->GetCellData()->AddArray(hexselector);
-
-#if VTK_MAJOR_VERSION < 6
-    writer->SetInput( grid );
-#else
-    writer->SetInputData(grid);
-#endif
-    writer->SetFileName(filename);
-    writer->Write();
-}
-
-//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-
-CINO_INLINE
-void write_VTK(const char                * filename,
-               const std::vector<double> & xyz,
-               const std::vector<uint>   & tets,
-               const std::vector<uint>   & hexa)
-{
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
-    vtkSmartPointer<vtkUnstructuredGridWriter> writer = vtkSmartPointer<vtkUnstructuredGridWriter>::New();
-    vtkSmartPointer<vtkUnstructuredGrid>       grid   = vtkSmartPointer<vtkUnstructuredGrid>::New();
-    vtkSmartPointer<vtkPoints>                 points = vtkSmartPointer<vtkPoints>::New();
+    fprintf(fp, "# vtk DataFile Version 3.0\ncinolib mesh\nBINARY\nDATASET UNSTRUCTURED_GRID\n");
+    fprintf(fp, "POINTS %zu double\n", xyz.size()/3);
+    write_big_endian(fp, xyz.data(), xyz.size());
 
-    // write the vertex coordinates
-    //
-    for(size_t i=0; i<xyz.size(); i+=3)
+    fprintf(fp, "\nCELLS %u %u\n", n_cells, conn_size);
+    write_binary_records<int32_t>(fp, n_cells, [&](size_t pid, std::vector<int32_t> & buf)
     {
-        points->InsertNextPoint(xyz[i+0], xyz[i+1], xyz[i+2]);
-    }
+        auto c = cell(uint(pid));
+        buf.push_back(int32_t(c.second));
+        for(uint i=0; i<c.second; ++i) buf.push_back(int32_t(c.first[i]));
+    }, false);
 
-    // write the tetrahedra
-    //
-    for(size_t i=0; i<tets.size(); i+=4)
+    fprintf(fp, "\nCELL_TYPES %u\n", n_cells);
+    write_binary_records<int32_t>(fp, n_cells, [&](size_t pid, std::vector<int32_t> & buf)
     {
-        vtkIdType pid[] = { tets[i+0], tets[i+1], tets[i+2], tets[i+3] };
-        grid->InsertNextCell(VTK_TETRA, 4, pid);
-    }
+        buf.push_back((cell(uint(pid)).second==4) ? 10 : 12); // VTK_TETRA, VTK_HEXAHEDRON
+    }, false);
 
-    // write the hexahedra
+    // generate some arrays that allow each element type to be viewed alone by thresholding
     //
-    for(size_t i=0; i<hexa.size(); i+=8 )
+    if(has_tets || has_hexa) fprintf(fp, "\nCELL_DATA %u", n_cells);
+    auto write_selector = [&](const char *name, const uint n)
     {
-        vtkIdType pid[] = { hexa[i+0], hexa[i+1], hexa[i+2], hexa[i+3],
-                            hexa[i+4], hexa[i+5], hexa[i+6], hexa[i+7] };
-        grid->InsertNextCell(VTK_HEXAHEDRON, 8, pid);
-    }
-
-    // create the output mesh
-    //
-    grid->SetPoints(points);
-
-#if VTK_MAJOR_VERSION < 6
-    writer->SetInput(grid);
-#else
-    writer->SetInputData(grid);
-#endif
-    writer->SetFileName(filename);
-    writer->Write();
+        fprintf(fp, "\nSCALARS %s int 1\nLOOKUP_TABLE default\n", name);
+        write_binary_records<int32_t>(fp, n_cells, [&](size_t pid, std::vector<int32_t> & buf)
+        {
+            buf.push_back((cell(uint(pid)).second==n) ? 1 : 0);
+        }, false);
+    };
+    if(has_tets) write_selector("tet_selector", 4);
+    if(has_hexa) write_selector("hex_selector", 8);
+
+    fprintf(fp, "\n");
+    fclose(fp);
 }
 
-#else
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void write_VTK(const char                *,
-               const std::vector<double> &,
-               const std::vector<uint>   &,
-               const std::vector<uint>   &)
+void write_VTK(const char                * filename,
+               const std::vector<double> & xyz,
+               const std::vector<uint>   & tets,
+               const std::vector<uint>   & hexa)
 {
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+    uint nt = uint(tets.size()/4);
+    uint nh = uint(hexa.size()/8);
+    write_VTK(filename, xyz, nt+nh, [&](const uint pid)
+    {
+        return (pid<nt) ? std::make_pair(&tets[4*pid], 4u) : std::make_pair(&hexa[8*(pid-nt)], 8u);
+    });
 }
 
-
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void write_VTK(const char                           *,
-               const std::vector<vec3d>             &,
-               const std::vector<std::vector<uint>> &)
+void write_VTK(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & polys)
 {
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+    write_VTK(filename, serialized_xyz_from_vec3d(verts), uint(polys.size()), [&](const uint pid)
+    {
+        return std::make_pair(polys[pid].data(), uint(polys[pid].size()));
+    });
 }
 
-#endif
-
 }
@@ -34,179 +34,153 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_VTU.h>
-
-
-#ifdef CINOLIB_USES_VTK
-#include <vtkSmartPointer.h>
-#include <vtkCell.h>
-#include <vtkCellData.h>
-#include <vtkIntArray.h>
-#include <vtkUnstructuredGrid.h>
-#include <vtkXMLUnstructuredGridWriter.h>
-#endif
+#include <cinolib/io/buffered_writer.h>
+#include <cinolib/vector_serialization.h>
+#include <iostream>
 
 namespace cinolib
 {
 
-#ifdef CINOLIB_USES_VTK
-
+/* Files are written natively (no need for VTK), in the XML VTU format. Arrays are
+ * stored in the appended section as raw little-endian blocks, each one preceded by
+ * its size in bytes (UInt64). cell(pid) returns a pointer to the vertices of the
+ * pid-th cell, and their number
+*/
+template<typename GetCell>
 CINO_INLINE
-void write_VTU(const char                           * filename,
-               const std::vector<vec3d>             & verts,
-               const std::vector<std::vector<uint>> & polys)
+void write_VTU(const char                * filename,
+               const std::vector<double> & xyz,
+               const uint                  n_cells,
+               const GetCell             & cell)
 {
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
-    vtkSmartPointer<vtkXMLUnstructuredGridWriter> writer = vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
-    vtkSmartPointer<vtkUnstructuredGrid>          grid   = vtkSmartPointer<vtkUnstructuredGrid>::New();
-    vtkSmartPointer<vtkPoints>                    points = vtkSmartPointer<vtkPoints>::New();
-
-    // generate some arrays that allow each element type to be viewed alone by thresholding
-    //
-    vtkSmartPointer<vtkIntArray> tetselector = vtkSmartPointer<vtkIntArray>::New();
-    vtkSmartPointer<vtkIntArray> hexselector = vtkSmartPointer<vtkIntArray>::New();
-    tetselector->SetName("tet_selector");
-    hexselector->SetName("hex_selector");
+    FILE *fp = fopen(filename, "wb");
 
-    for(const vec3d & v : verts)
+    if(!fp)
     {
-        points->InsertNextPoint(v.x(), v.y(), v.z());
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_VTU() : couldn't save file " << filename << std::endl;
+        exit(-1);
     }
 
-    bool has_tets = false;
-    bool has_hexa = false;
-
-    for(auto p : polys)
+    uint64_t conn_size = 0;
+    bool     has_tets  = false;
+    bool     has_hexa  = false;
+    for(uint pid=0; pid<n_cells; ++pid)
     {
-        switch (p.size())
+        uint n = cell(pid).second;
+        switch(n)
         {
-            case 4:
-            {
-                vtkIdType pid[] = { p.at(0), p.at(1), p.at(2), p.at(3) };
-                grid->InsertNextCell(VTK_TETRA, 4, pid);
-                tetselector->InsertNextValue(1);
-                hexselector->InsertNextValue(0);
-                has_tets = true;
-                break;
-            }
-
-            case 8:
-            {
-                vtkIdType pid[] = { p.at(0), p.at(1), p.at(2), p.at(3),
-                                    p.at(4), p.at(5), p.at(6), p.at(7) };
-                grid->InsertNextCell(VTK_HEXAHEDRON, 8, pid);
-                tetselector->InsertNextValue(0);
-                hexselector->InsertNextValue(1);
-                has_hexa = true;
-                break;
-            }
-
+            case 4 : has_tets = true; break;
+            case 8 : has_hexa = true; break;
             default: assert(false && "Unsupported Polyhedron!");
         }
+        conn_size += n;
     }
 
-    grid->SetPoints(points);
-    if (has_tets) grid->GetCellData()->AddArray(tetselector);
-    if (has_hexa) grid->GetCellData()->AddArray(hexselector);
-
-#if VTK_MAJOR_VERSION < 6
-    writer->SetInput( grid );
-#else
-    writer->SetInputData(grid);
-#endif
-    writer->SetFileName(filename);
-    writer->Write();
-}
-
-//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
-
-CINO_INLINE
-void write_VTU(const char                * filename,
-               const std::vector<double> & xyz,
-               const std::vector<uint>   & tets,
-               const std::vector<uint>   & hexa)
-{
-    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
-
-    vtkSmartPointer<vtkXMLUnstructuredGridWriter> writer = vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
-    vtkSmartPointer<vtkUnstructuredGrid>          grid   = vtkSmartPointer<vtkUnstructuredGrid>::New();
-    vtkSmartPointer<vtkPoints>                    points = vtkSmartPointer<vtkPoints>::New();
-
+    // sizes (in bytes) of the appended arrays, and their offsets in the appended section
+    uint64_t nv          = xyz.size()/3;
+    uint64_t bytes_xyz   = nv*3*sizeof(double);
+    uint64_t bytes_conn  = conn_size*sizeof(int64_t);
+    uint64_t bytes_offs  = uint64_t(n_cells)*sizeof(int64_t);
+    uint64_t bytes_types = uint64_t(n_cells)*sizeof(uint8_t);
+    uint64_t bytes_sel   = uint64_t(n_cells)*sizeof(int32_t);
+    uint64_t off_xyz     = 0;
+    uint64_t off_conn    = off_xyz   + sizeof(uint64_t) + bytes_xyz;
+    uint64_t off_offs    = off_conn  + sizeof(uint64_t) + bytes_conn;
+    uint64_t off_types   = off_offs  + sizeof(uint64_t) + bytes_offs;
+    uint64_t off_tets    = off_types + sizeof(uint64_t) + bytes_types;
+    uint64_t off_hexa    = off_tets  + ((has_tets) ? sizeof(uint64_t) + bytes_sel : 0);
+
+    fprintf(fp, "<?xml version=\"1.0\"?>\n");
+    fprintf(fp, "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n");
+    fprintf(fp, "  <UnstructuredGrid>\n");
+    fprintf(fp, "    <Piece NumberOfPoints=\"%llu\" NumberOfCells=\"%u\">\n", (unsigned long long)nv, n_cells);
+    fprintf(fp, "      <Points>\n");
+    fprintf(fp, "        <DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"appended\" offset=\"%llu\"/>\n", (unsigned long long)off_xyz);
+    fprintf(fp, "      </Points>\n");
+    fprintf(fp, "      <Cells>\n");
+    fprintf(fp, "        <DataArray type=\"Int64\" Name=\"connectivity\" format=\"appended\" offset=\"%llu\"/>\n", (unsigned long long)off_conn);
+    fprintf(fp, "        <DataArray type=\"Int64\" Name=\"offsets\" format=\"appended\" offset=\"%llu\"/>\n", (unsigned long long)off_offs);
+    fprintf(fp, "        <DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\"%llu\"/>\n", (unsigned long long)off_types);
+    fprintf(fp, "      </Cells>\n");
     // generate some arrays that allow each element type to be viewed alone by thresholding
     //
-    vtkSmartPointer<vtkIntArray> tetselector = vtkSmartPointer<vtkIntArray>::New();
-    vtkSmartPointer<vtkIntArray> hexselector = vtkSmartPointer<vtkIntArray>::New();
-    tetselector->SetName("tet_selector");
-    hexselector->SetName("hex_selector");
-
-    // write the vertex coordinates
-    //
-    for(size_t i=0; i<xyz.size(); i+=3)
+    if(has_tets || has_hexa)
     {
-        points->InsertNextPoint(xyz[i+0], xyz[i+1], xyz[i+2]);
+        fprintf(fp, "      <CellData>\n");
+        if(has_tets) fprintf(fp, "        <DataArray type=\"Int32\" Name=\"tet_selector\" format=\"appended\" offset=\"%llu\"/>\n", (unsigned long long)off_tets);
+        if(has_hexa) fprintf(fp, "        <DataArray type=\"Int32\" Name=\"hex_selector\" format=\"appended\" offset=\"%llu\"/>\n", (unsigned long long)off_hexa);
+        fprintf(fp, "      </CellData>\n");
     }
+    fprintf(fp, "    </Piece>\n");
+    fprintf(fp, "  </UnstructuredGrid>\n");
+    fprintf(fp, "  <AppendedData encoding=\"raw\">\n_");
 
-    // write the tetrahedra
-    //
-    for(size_t i=0; i<tets.size(); i+=4)
+    write_little_endian(fp, &bytes_xyz, 1);
+    write_little_endian(fp, xyz.data(), xyz.size());
+
+    write_little_endian(fp, &bytes_conn, 1);
+    write_binary_records<int64_t>(fp, n_cells, [&](size_t pid, std::vector<int64_t> & buf)
     {
-        vtkIdType pid[] = { tets[i+0], tets[i+1], tets[i+2], tets[i+3] };
-        grid->InsertNextCell(VTK_TETRA, 4, pid);
-        tetselector->InsertNextValue(1);
-        hexselector->InsertNextValue(0);
-    }
+        auto c = cell(uint(pid));
+        for(uint i=0; i<c.second; ++i) buf.push_back(int64_t(c.first[i]));
+    }, true);
 
-    // write the hexahedra
-    //
-    for(size_t i=0; i<hexa.size(); i+=8 )
+    write_little_endian(fp, &bytes_offs, 1);
+    int64_t offset = 0;
+    write_binary_records<int64_t>(fp, n_cells, [&](size_t pid, std::vector<int64_t> & buf)
     {
-        vtkIdType pid[] = { hexa[i+0], hexa[i+1], hexa[i+2], hexa[i+3],
-                            hexa[i+4], hexa[i+5], hexa[i+6], hexa[i+7] };
-        grid->InsertNextCell(VTK_HEXAHEDRON, 8, pid);
-        tetselector->InsertNextValue(0);
-        hexselector->InsertNextValue(1);
-    }
+        offset += cell(uint(pid)).second;
+        buf.push_back(offset);
+    }, true);
 
-    // create the output mesh
-    //
-    grid->SetPoints(points);
-
-    if (tets.size() > 0) grid->GetCellData()->AddArray(tetselector);
-    if (hexa.size() > 0) grid->GetCellData()->AddArray(hexselector);
-
-#if VTK_MAJOR_VERSION < 6
-    writer->SetInput( grid );
-#else
-    writer->SetInputData(grid);
-#endif
-    writer->SetFileName(filename);
-    writer->Write();
+    write_little_endian(fp, &bytes_types, 1);
+    write_binary_records<uint8_t>(fp, n_cells, [&](size_t pid, std::vector<uint8_t> & buf)
+    {
+        buf.push_back((cell(uint(pid)).second==4) ? 10 : 12); // VTK_TETRA, VTK_HEXAHEDRON
+    }, true);
+
+    auto write_selector = [&](const uint n)
+    {
+        write_little_endian(fp, &bytes_sel, 1);
+        write_binary_records<int32_t>(fp, n_cells, [&](size_t pid, std::vector<int32_t> & buf)
+        {
+            buf.push_back((cell(uint(pid)).second==n) ? 1 : 0);
+        }, true);
+    };
+    if(has_tets) write_selector(4);
+    if(has_hexa) write_selector(8);
+
+    fprintf(fp, "\n  </AppendedData>\n</VTKFile>\n");
+    fclose(fp);
 }
 
-#else
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void write_VTU(const char                *,
-               const std::vector<double> &,
-               const std::vector<uint>   &,
-               const std::vector<uint>   &)
+void write_VTU(const char                * filename,
+               const std::vector<double> & xyz,
+               const std::vector<uint>   & tets,
+               const std::vector<uint>   & hexa)
 {
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+    uint nt = uint(tets.size()/4);
+    uint nh = uint(hexa.size()/8);
+    write_VTU(filename, xyz, nt+nh, [&](const uint pid)
+    {
+        return (pid<nt) ? std::make_pair(&tets[4*pid], 4u) : std::make_pair(&hexa[8*(pid-nt)], 8u);
+    });
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 CINO_INLINE
-void write_VTU(const char                           *,
-               const std::vector<vec3d>             &,
-               const std::vector<std::vector<uint>> &)
+void write_VTU(const char                           * filename,
+               const std::vector<vec3d>             & verts,
+               const std::vector<std::vector<uint>> & polys)
 {
-    std::cerr << "ERROR : VTK missing. Install VTK and recompile defining symbol CINOLIB_USES_VTK" << std::endl;
-    exit(-1);
+    write_VTU(filename, serialized_xyz_from_vec3d(verts), uint(polys.size()), [&](const uint pid)
+    {
+        return std::make_pair(polys[pid].data(), uint(polys[pid].size()));
+    });
 }
 
-
-#endif
-
 }
@@ -35,37 +35,58 @@
 *********************************************************************************/
 #include <cinolib/laplacian.h>
 #include <cinolib/symbols.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/min_max_inf.h>
 #include <Eigen/Sparse>
+#include <atomic>
+#include <algorithm>
 
 namespace cinolib
 {
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+std::vector<double> laplacian_edge_weights(const AbstractMesh<M,V,E,P> & m,
+                                           const int                     mode)
+{
+    std::vector<double> w(m.num_edges());
+    PARALLEL_FOR(0, m.num_edges(), 1000, [&](const uint eid)
+    {
+        w[eid] = m.edge_weight(eid, mode);
+    });
+    return w;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 std::vector<Eigen::Triplet<double>> laplacian_matrix_entries(const AbstractMesh<M,V,E,P> & m,
                                                              const int mode,
                                                              const int n) // diagonally replicate n times
 {
-    std::vector<Entry> entries;
+    std::vector<double> w = laplacian_edge_weights(m, mode);
 
     uint nv = m.num_verts();
     std::vector<uint> base(n);
     for(int i=0; i<n; ++i) base[i] = nv*i;
 
+    std::vector<Entry> entries;
+    entries.reserve(n*(2*m.num_edges() + nv));
+
     for(uint vid=0; vid<m.num_verts(); ++vid)
     {
-        std::vector<std::pair<uint,double>> wgts;
-        m.vert_weights(vid, mode, wgts);
         double sum = 0.0;
-        for(auto item : wgts)
+        for(uint eid : m.adj_v2e(vid))
         {
+            uint nbr = m.vert_opposite_to(eid, vid);
             for(int i=0; i<n; ++i)
             {
-                entries.push_back(Entry(base[i] + vid, base[i] + item.first, item.second));
+                entries.push_back(Entry(base[i] + vid, base[i] + nbr, w[eid]));
             }
-            sum -= item.second;
+            sum -= w[eid];
         }
         if(sum == 0.0)
         {
@@ -85,15 +106,94 @@ std::vector<Eigen::Triplet<double>> laplacian_matrix_entries(const AbstractMesh<
 
 template<class M, class V, class E, class P>
 CINO_INLINE
-Eigen::SparseMatrix<double> laplacian(const AbstractMesh<M,V,E,P> & m, const int mode, const int n)
+const Eigen::SparseMatrix<double> & laplacian(const AbstractMesh<M,V,E,P> & m,
+                                                    LaplacianCache        & cache,
+                                              const int                     mode,
+                                              const int                     n)
 {
-    std::vector<Entry> entries = laplacian_matrix_entries(m, mode, n);
+    uint nv = m.num_verts();
+    uint ne = m.num_edges();
+
+    if(cache.nv!=nv || cache.ne!=ne || cache.n!=n) // (re)build the sparsity pattern
+    {
+        // column vid contains the diagonal entry plus one entry per incident edge.
+        // The matrix is symmetric, hence the same layout holds for rows
+        std::vector<int> outer(n*nv+1);
+        outer[0] = 0;
+        for(uint vid=0; vid<nv; ++vid) outer[vid+1] = outer[vid] + int(m.adj_v2e(vid).size()) + 1;
+        uint nnz = outer[nv];
+        for(int i=1; i<n; ++i)
+        for(uint vid=0; vid<nv; ++vid)
+        {
+            outer[i*nv+vid+1] = i*nnz + outer[vid+1];
+        }
+
+        std::vector<int> inner(n*nnz);
+        cache.edge_pos.resize(2*ne);
+        cache.diag_pos.resize(nv);
+        PARALLEL_FOR(0, nv, 1000, [&](const uint vid)
+        {
+            std::vector<std::pair<uint,uint>> col; // (row, eid), with eid=max_uint for the diagonal
+            col.push_back(std::make_pair(vid, max_uint));
+            for(uint eid : m.adj_v2e(vid)) col.push_back(std::make_pair(m.vert_opposite_to(eid,vid), eid));
+            std::sort(col.begin(), col.end());
 
-    uint nv = n*m.num_verts();
-    Eigen::SparseMatrix<double> L(nv,nv);
-    L.setFromTriplets(entries.begin(), entries.end());
+            uint pos = outer[vid];
+            for(auto e : col)
+            {
+                for(int i=0; i<n; ++i) inner[i*nnz + pos] = int(i*nv + e.first);
+                if(e.second==max_uint) cache.diag_pos[vid] = pos;
+                else cache.edge_pos[2*e.second + (m.edge_vert_id(e.second,0)==vid ? 0 : 1)] = pos;
+                ++pos;
+            }
+        });
 
-    return L;
+        std::vector<double> vals(n*nnz, 0.0);
+        cache.L = Eigen::Map<const Eigen::SparseMatrix<double>>(n*nv, n*nv, n*nnz, outer.data(), inner.data(), vals.data());
+        cache.nv = nv;
+        cache.ne = ne;
+        cache.n  = n;
+    }
+
+    // refill the values of the first block, then replicate it
+    std::vector<double> w = laplacian_edge_weights(m, mode);
+    double *vals = cache.L.valuePtr();
+    PARALLEL_FOR(0, ne, 1000, [&](const uint eid)
+    {
+        vals[cache.edge_pos[2*eid  ]] = w[eid];
+        vals[cache.edge_pos[2*eid+1]] = w[eid];
+    });
+    std::atomic<uint> null_rows(0);
+    PARALLEL_FOR(0, nv, 1000, [&](const uint vid)
+    {
+        double sum = 0.0;
+        for(uint eid : m.adj_v2e(vid)) sum -= w[eid];
+        if(sum == 0.0)
+        {
+            ++null_rows;
+            sum = 1.0;
+        }
+        vals[cache.diag_pos[vid]] = sum;
+    });
+    if(null_rows>0)
+    {
+        std::cerr << "WARNING: " << null_rows << " null row(s) in the matrix! (disconnected vertex? I put 1 in the diagonal)" << std::endl;
+    }
+    uint nnz = uint(cache.L.nonZeros())/n;
+    for(int i=1; i<n; ++i) std::copy(vals, vals+nnz, vals+i*nnz);
+
+    return cache.L;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+Eigen::SparseMatrix<double> laplacian(const AbstractMesh<M,V,E,P> & m, const int mode, const int n)
+{
+    LaplacianCache cache;
+    laplacian(m, cache, mode, n);
+    return std::move(cache.L);
 }
 
 }
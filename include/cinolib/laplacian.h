@@ -60,6 +60,43 @@ Eigen::SparseMatrix<double> laplacian(const AbstractMesh<M,V,E,P> & m,
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+/* Laplacian assembly with cached sparsity pattern. The first call (and any call
+ * where the number of verts/edges or replicas changed) builds the compressed
+ * structure of the matrix and the position of each edge/vertex entry in its
+ * value array. Subsequent calls only refill the values, computing each edge
+ * weight once and in parallel. This is meant for algorithms that reassemble
+ * the matrix after each geometry update (e.g. MCF, ARAP). If the connectivity
+ * changes but element counts do not, reset the cache (cache = LaplacianCache())
+*/
+struct LaplacianCache
+{
+    Eigen::SparseMatrix<double> L;
+    std::vector<uint>           edge_pos; // positions of entries (v0,v1) and (v1,v0) of each edge in L.valuePtr()
+    std::vector<uint>           diag_pos; // position of the diagonal entry of each vertex in L.valuePtr()
+    uint                        nv = 0;
+    uint                        ne = 0;
+    int                         n  = 0;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+const Eigen::SparseMatrix<double> & laplacian(const AbstractMesh<M,V,E,P> & m,
+                                                    LaplacianCache        & cache,
+                                              const int                     mode,
+                                              const int                     n = 1);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// computes all the edge weights at once (in parallel)
+template<class M, class V, class E, class P>
+CINO_INLINE
+std::vector<double> laplacian_edge_weights(const AbstractMesh<M,V,E,P> & m,
+                                           const int                     mode);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 std::vector<Eigen::Triplet<double>> laplacian_matrix_entries(const AbstractMesh<M,V,E,P> & m,
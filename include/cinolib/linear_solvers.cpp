@@ -80,6 +80,16 @@ void solve_square_system(const Eigen::SparseMatrix<double> & A,
             break;
         }
 
+        case ConjugateGradient:
+        {
+            Eigen::ConjugateGradient< Eigen::SparseMatrix<double>, Eigen::Lower|Eigen::Upper > solver;
+            solver.setTolerance(1e-8);
+            solver.compute(A);
+            assert(solver.info() == Eigen::Success);
+            x = solver.solve(b).eval();
+            break;
+        }
+
         case SparseLU:
         {
             Eigen::SparseMatrix<double> Ac = A;
@@ -56,6 +56,9 @@ namespace cinolib
  * --------------------------------------------------------------
  * BiCGSTAB     none
  * (iterative)
+ * --------------------------------------------------------------
+ * CG           positive definite           +++         +
+ * (iterative)  (Jacobi preconditioner)
  */
 
 enum
@@ -64,16 +67,18 @@ enum
     SIMPLICIAL_LDLT,
     SparseLU,
     BiCGSTAB,
+    ConjugateGradient,
 };
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-static const std::string txt[4] =
+static const std::string txt[5] =
 {
     "SIMPLICIAL_LLT"  ,
     "SIMPLICIAL_LDLT" ,
     "SparseLU",
     "BiCGSTAB",
+    "ConjugateGradient",
 };
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -43,6 +43,8 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/marching_tets.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/min_max_inf.h>
 #include <array>
 
 namespace cinolib
@@ -65,48 +67,191 @@ enum // Look-up Table
     C_1100 = 0xC,
     C_0100 = 0x4,
     C_1000 = 0x8,
-    C_0000 = 0x0
+    C_0000 = 0x0,
+    C_SWAP = 0x10  // extra bit, set if the configuration was obtained using "<="
 };
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+/* FIXME: for all configurations where two verts >= isoval
+ * and the other two are < isoval, this method will try to
+ * make a quad (2 triangles).
+ * Indeed, if one vertx has exactly isoval, the surface cuts
+ * a triangle and not a quad inside the tet, and therefore
+ * one of the two triangles will be degenerate.
+ * To avoid confusion and excessive code specialization for corner
+ * cases, maybe it is better to have three possible states for a
+ * vertex (<,>,=). In this case each configuration will be 100% correct
+*/
+CINO_INLINE
+unsigned char marching_tets_classify(const double func[],
+                                     const double isovalue)
+{
+    unsigned char c = 0x0;
+    if (isovalue >= func[0]) c |= C_1000;
+    if (isovalue >= func[1]) c |= C_0100;
+    if (isovalue >= func[2]) c |= C_0010;
+    if (isovalue >= func[3]) c |= C_0001;
+
+    /* If the isosurface does not intersect the tet,
+     * one should get C_1111 using ">=", and C_0000
+     * inverting to "<=".
+     *
+     * This does not happen if the isosurface passes
+     * exhactly through one face. In this case one will
+     * get C_1111 using ">=", and something like
+     * C_0111 using "<=".
+     *
+     * Normally this does not create any trouble, as the
+     * face-adjacent tet will trigger the generation of
+     * that triangle. But if the tet is exposed on the
+     * surface, then that triangle will be missing in the
+     * final iso-surface.
+     *
+     * To avoid these missing triangles, whenever I get
+     * a C_1111 I invert the sign, and assign to the tet
+     * the configuration produced using "<="
+    */
+    if (c == C_1111)
+    {
+        c = C_SWAP;
+        if (isovalue <= func[0]) c |= C_1000;
+        if (isovalue <= func[1]) c |= C_0100;
+        if (isovalue <= func[2]) c |= C_0010;
+        if (isovalue <= func[3]) c |= C_0001;
+    }
+    return c;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Returns the number of triangles (at most two) generated by tet pid, and
+// fills tri_edges with their vertices, expressed as local tet edges (see
+// TET_EDGES). Array c contains the classification of all the mesh tets
+//
 template<class M, class V, class E, class F, class P>
 CINO_INLINE
-void make_triangle(const Tetmesh<M,V,E,F,P> & m,
-                   const double               isovalue,
-                   const uint                 vids[],
-                   const double               func[],
-                   const std::array<uint,3> & e,
-                   std::map<ipair,uint>     & e2v_map,
-                   std::vector<vec3d>       & verts,
-                   std::vector<uint>        & tris,
-                   std::vector<vec3d>       & norms);
+uint marching_tets_triangles(const Tetmesh<M,V,E,F,P> & m,
+                             const uint                 pid,
+                             const double               isovalue,
+                             const unsigned char        c[],
+                             std::array<uint,3>         tri_edges[2])
+{
+    unsigned char conf    = c[pid] & 0xF;
+    bool          swapped = c[pid] & C_SWAP;
+
+    bool v_on_iso[] =
+    {
+        m.vert_data(m.poly_vert_id(pid,0)).uvw[0] == isovalue,
+        m.vert_data(m.poly_vert_id(pid,1)).uvw[0] == isovalue,
+        m.vert_data(m.poly_vert_id(pid,2)).uvw[0] == isovalue,
+        m.vert_data(m.poly_vert_id(pid,3)).uvw[0] == isovalue
+    };
+
+    // not uint because it may be -1 if there is no adjacent tet!
+    auto adj_tet = [&](const uint off) -> int
+    {
+        return m.poly_adj_through_face(pid, m.poly_face_id(pid,off));
+    };
+    auto adj_conf = [&](const uint off) -> unsigned char
+    {
+        return c[adj_tet(off)] & 0xF;
+    };
+
+    // Avoid triangle duplication and collapsed triangle generation when the iso-surface
+    // passes EXACTLY through a vertex/edge/face shared between many tetrahedra.
+    //
+    switch (conf)
+    {
+        // iso-surface passes on a face : make sure only one tet (MUST BE the one with higher id) triggers triangle generation...
+        // Notice that if the adjacent tet is collapsed (C_1111), then it make sense to use the current one regardless the tid order
+        case C_1110 : if (v_on_iso[0] && v_on_iso[1] && v_on_iso[2] && (int)pid < adj_tet(0) && adj_conf(0) != C_1111) conf = C_0000; break;
+        case C_1101 : if (v_on_iso[0] && v_on_iso[1] && v_on_iso[3] && (int)pid < adj_tet(1) && adj_conf(1) != C_1111) conf = C_0000; break;
+        case C_1011 : if (v_on_iso[0] && v_on_iso[2] && v_on_iso[3] && (int)pid < adj_tet(2) && adj_conf(2) != C_1111) conf = C_0000; break;
+        case C_0111 : if (v_on_iso[1] && v_on_iso[2] && v_on_iso[3] && (int)pid < adj_tet(3) && adj_conf(3) != C_1111) conf = C_0000; break;
+
+        // iso-surface passes on a edge : do nothing
+        case C_0101 : if (v_on_iso[1] && v_on_iso[3]) conf = C_0000; break;
+        case C_1010 : if (v_on_iso[0] && v_on_iso[2]) conf = C_0000; break;
+        case C_0011 : if (v_on_iso[2] && v_on_iso[3]) conf = C_0000; break;
+        case C_1100 : if (v_on_iso[0] && v_on_iso[1]) conf = C_0000; break;
+        case C_1001 : if (v_on_iso[0] && v_on_iso[3]) conf = C_0000; break;
+        case C_0110 : if (v_on_iso[1] && v_on_iso[2]) conf = C_0000; break;
+
+        // iso-surface passes on a vertex : do nothing
+        case C_1000 : if (v_on_iso[0]) conf = C_0000; break;
+        case C_0100 : if (v_on_iso[1]) conf = C_0000; break;
+        case C_0010 : if (v_on_iso[2]) conf = C_0000; break;
+        case C_0001 : if (v_on_iso[3]) conf = C_0000; break;
+
+        default : break;
+    }
+
+    // triangle generation
+    switch (conf)
+    {
+        case C_1000 : { tri_edges[0] = {2,0,4}; return 1; }
+        case C_0111 : { tri_edges[0] = swapped ? std::array<uint,3>{2,0,4} : std::array<uint,3>{0,2,4}; return 1; }
+        case C_1011 : { tri_edges[0] = swapped ? std::array<uint,3>{1,2,3} : std::array<uint,3>{2,1,3}; return 1; }
+        case C_0100 : { tri_edges[0] = {1,2,3}; return 1; }
+        case C_1101 : { tri_edges[0] = swapped ? std::array<uint,3>{0,1,5} : std::array<uint,3>{1,0,5}; return 1; }
+        case C_0010 : { tri_edges[0] = {0,1,5}; return 1; }
+        case C_0001 : { tri_edges[0] = {5,3,4}; return 1; }
+        case C_1110 : { tri_edges[0] = swapped ? std::array<uint,3>{5,3,4} : std::array<uint,3>{3,5,4}; return 1; }
+        case C_0101 : { tri_edges[0] = {5,2,4}; tri_edges[1] = {2,5,1}; return 2; }
+        case C_1010 : { tri_edges[0] = {2,5,4}; tri_edges[1] = {5,2,1}; return 2; }
+        case C_0011 : { tri_edges[0] = {3,4,1}; tri_edges[1] = {1,4,0}; return 2; }
+        case C_1100 : { tri_edges[0] = {4,3,1}; tri_edges[1] = {4,1,0}; return 2; }
+        case C_1001 : { tri_edges[0] = {3,2,0}; tri_edges[1] = {5,3,0}; return 2; }
+        case C_0110 : { tri_edges[0] = {2,3,0}; tri_edges[1] = {3,5,0}; return 2; }
+        default : return 0;
+    }
+}
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// Point where the level set crosses edge eid
+//
 template<class M, class V, class E, class F, class P>
 CINO_INLINE
-void marching_tets(const Tetmesh<M,V,E,F,P> & m,
-                   const double               isovalue,
-                   std::vector<vec3d>       & verts,
-                   std::vector<uint>        & tris,
-                   std::vector<vec3d>       & norms)
+vec3d marching_tets_edge_point(const Tetmesh<M,V,E,F,P> & m,
+                               const uint                 eid,
+                               const double               isovalue)
 {
-    /* FIXME: for all configurations where two verts >= isoval
-     * and the other two are < isoval, this method will try to
-     * make a quad (2 triangles).
-     * Indeed, if one vertx has exactly isoval, the surface cuts
-     * a triangle and not a quad inside the tet, and therefore
-     * one of the two triangles will be degenerate.
-     * To avoid confusion and excessive code specialization for corner
-     * cases, maybe it is better to have three possible states for a
-     * vertex (<,>,=). In this case each configuration will be 100% correct
-    */
+    uint   v_a = m.edge_vert_id(eid,0);
+    uint   v_b = m.edge_vert_id(eid,1);
+    double f_a = m.vert_data(v_a).uvw[0];
+    double f_b = m.vert_data(v_b).uvw[0];
+
+    if (f_a < f_b)
+    {
+        std::swap(v_a, v_b);
+        std::swap(f_a, f_b);
+    }
 
-    std::vector<unsigned char> c(m.num_polys(),0x0);
-    std::vector<bool> swapped(m.num_polys(), false);
+    double alpha = (isovalue - f_a) / (f_b - f_a);
 
-    for(uint pid=0; pid<m.num_polys(); ++pid)
+    return (1.0 - alpha) * m.vert(v_a) + alpha * m.vert(v_b);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P, class Writer>
+CINO_INLINE
+void marching_tets_stream(const Tetmesh<M,V,E,F,P> & m,
+                          const std::vector<double> & isovalues,
+                          Writer                    & writer,
+                          const uint                  chunk_size)
+{
+    assert(chunk_size>0);
+    uint n_iso   = isovalues.size();
+    uint n_polys = m.num_polys();
+
+    // classify all tets w.r.t. all isovalues, fetching vertex values only once.
+    // Classification is global because the filtering of degenerate configurations
+    // looks at the adjacent tets, which may belong to other chunks
+    std::vector<unsigned char> c(n_iso*n_polys);
+    PARALLEL_FOR(0, n_polys, 1000, [&](uint pid)
     {
         double func[] =
         {
@@ -115,139 +260,98 @@ void marching_tets(const Tetmesh<M,V,E,F,P> & m,
             m.vert_data(m.poly_vert_id(pid,2)).uvw[0],
             m.vert_data(m.poly_vert_id(pid,3)).uvw[0]
         };
-
-        if (isovalue >= func[0]) c.at(pid) |= C_1000;
-        if (isovalue >= func[1]) c.at(pid) |= C_0100;
-        if (isovalue >= func[2]) c.at(pid) |= C_0010;
-        if (isovalue >= func[3]) c.at(pid) |= C_0001;
-
-        /* If the isosurface does not intersect the tet,
-         * one should get C_1111 using ">=", and C_0000
-         * inverting to "<=".
-         *
-         * This does not happen if the isosurface passes
-         * exhactly through one face. In this case one will
-         * get C_1111 using ">=", and something like
-         * C_0111 using "<=".
-         *
-         * Normally this does not create any trouble, as the
-         * face-adjacent tet will trigger the generation of
-         * that triangle. But if the tet is exposed on the
-         * surface, then that triangle will be missing in the
-         * final iso-surface.
-         *
-         * To avoid these missing triangles, whenever I get
-         * a C_1111 I invert the sign, and assign to the tet
-         * the configuration produced using "<="
-        */
-        if (c.at(pid) == C_1111)
+        for(uint i=0; i<n_iso; ++i)
         {
-            swapped.at(pid) = true;
-            c.at(pid) = 0x0;
-            if (isovalue <= func[0]) c.at(pid) |= C_1000;
-            if (isovalue <= func[1]) c.at(pid) |= C_0100;
-            if (isovalue <= func[2]) c.at(pid) |= C_0010;
-            if (isovalue <= func[3]) c.at(pid) |= C_0001;
+            c[i*n_polys+pid] = marching_tets_classify(func, isovalues.at(i));
         }
-    }
+    });
 
-    std::map<ipair,uint> e2v_map;
+    // per isovalue edge to vertex map (max_uint means no vertex yet)
+    std::vector<std::vector<uint>> e2v(n_iso, std::vector<uint>(m.num_edges(), max_uint));
+    std::vector<uint> n_verts(n_iso, 0);
 
-    for(uint pid=0; pid<m.num_polys(); ++pid)
-    {
-        uint vids[] =
-        {
-            m.poly_vert_id(pid,0),
-            m.poly_vert_id(pid,1),
-            m.poly_vert_id(pid,2),
-            m.poly_vert_id(pid,3)
-        };
+    std::vector<uint>  offset;
+    std::vector<uint>  tri_eids;
+    std::vector<uint>  fresh_eids;
+    std::vector<vec3d> verts;
+    std::vector<uint>  tris;
+    std::vector<vec3d> norms;
 
-        double func[] =
-        {
-            m.vert_data(vids[0]).uvw[0],
-            m.vert_data(vids[1]).uvw[0],
-            m.vert_data(vids[2]).uvw[0],
-            m.vert_data(vids[3]).uvw[0]
-        };
+    for(uint beg=0; beg<n_polys; beg+=chunk_size)
+    {
+        uint end  = std::min(beg+chunk_size, n_polys);
+        uint size = end-beg;
 
-        bool v_on_iso[] =
+        for(uint i=0; i<n_iso; ++i)
         {
-            func[0] == isovalue,
-            func[1] == isovalue,
-            func[2] == isovalue,
-            func[3] == isovalue
-        };
+            const unsigned char * ci  = c.data() + i*n_polys;
+            const double          iso = isovalues.at(i);
 
-        int adj_tet[] // not uint because it may be -1 if there is no adjacent tet!
-        {
-            m.poly_adj_through_face(pid, m.poly_face_id(pid,0)),
-            m.poly_adj_through_face(pid, m.poly_face_id(pid,1)),
-            m.poly_adj_through_face(pid, m.poly_face_id(pid,2)),
-            m.poly_adj_through_face(pid, m.poly_face_id(pid,3)),
-        };
+            // pass 1: count the triangles generated by each tet...
+            offset.assign(size+1, 0);
+            PARALLEL_FOR(beg, end, 1000, [&](uint pid)
+            {
+                std::array<uint,3> tri_edges[2];
+                offset[pid-beg+1] = marching_tets_triangles(m, pid, iso, ci, tri_edges);
+            });
+
+            // ...and make room for them
+            for(uint j=0; j<size; ++j) offset[j+1] += offset[j];
+            uint n_tris = offset.back();
+            if(n_tris==0) continue;
+
+            // pass 2: emit triangles, as triplets of mesh edges
+            tri_eids.resize(3*n_tris);
+            PARALLEL_FOR(beg, end, 1000, [&](uint pid)
+            {
+                std::array<uint,3> tri_edges[2];
+                uint n = marching_tets_triangles(m, pid, iso, ci, tri_edges);
+                for(uint t=0; t<n; ++t)
+                for(uint k=0; k<3; ++k)
+                {
+                    uint v_a = m.poly_vert_id(pid, TET_EDGES[tri_edges[t][k]][0]);
+                    uint v_b = m.poly_vert_id(pid, TET_EDGES[tri_edges[t][k]][1]);
+                    tri_eids[3*(offset[pid-beg]+t)+k] = m.poly_edge_id(pid, v_a, v_b);
+                }
+            });
+
+            // assign fresh ids to edges crossed for the first time. This is done
+            // serially and in triangle order, so that vertex ids are deterministic
+            fresh_eids.clear();
+            for(uint eid : tri_eids)
+            {
+                if(e2v[i][eid]==max_uint)
+                {
+                    e2v[i][eid] = n_verts[i]++;
+                    fresh_eids.push_back(eid);
+                }
+            }
 
-        // Avoid triangle duplication and collapsed triangle generation when the iso-surface
-        // passes EXACTLY through a vertex/edge/face shared between many tetrahedra.
-        //
-        switch (c.at(pid))
-        {
-            // iso-surface passes on a face : make sure only one tet (MUST BE the one with higher id) triggers triangle generation...
-            // Notice that if the adjacent tet is collapsed (C_1111), then it make sense to use the current one regardless the tid order
-            case C_1110 : if (v_on_iso[0] && v_on_iso[1] && v_on_iso[2] && (int)pid < adj_tet[0] && c.at(adj_tet[0]) != C_1111) c.at(pid) = C_0000; break;
-            case C_1101 : if (v_on_iso[0] && v_on_iso[1] && v_on_iso[3] && (int)pid < adj_tet[1] && c.at(adj_tet[1]) != C_1111) c.at(pid) = C_0000; break;
-            case C_1011 : if (v_on_iso[0] && v_on_iso[2] && v_on_iso[3] && (int)pid < adj_tet[2] && c.at(adj_tet[2]) != C_1111) c.at(pid) = C_0000; break;
-            case C_0111 : if (v_on_iso[1] && v_on_iso[2] && v_on_iso[3] && (int)pid < adj_tet[3] && c.at(adj_tet[3]) != C_1111) c.at(pid) = C_0000; break;
-
-            // iso-surface passes on a edge : do nothing
-            case C_0101 : if (v_on_iso[1] && v_on_iso[3]) c.at(pid) = C_0000; break;
-            case C_1010 : if (v_on_iso[0] && v_on_iso[2]) c.at(pid) = C_0000; break;
-            case C_0011 : if (v_on_iso[2] && v_on_iso[3]) c.at(pid) = C_0000; break;
-            case C_1100 : if (v_on_iso[0] && v_on_iso[1]) c.at(pid) = C_0000; break;
-            case C_1001 : if (v_on_iso[0] && v_on_iso[3]) c.at(pid) = C_0000; break;
-            case C_0110 : if (v_on_iso[1] && v_on_iso[2]) c.at(pid) = C_0000; break;
-
-            // iso-surface passes on a vertex : do nothing
-            case C_1000 : if (v_on_iso[0]) c.at(pid) = C_0000; break;
-            case C_0100 : if (v_on_iso[1]) c.at(pid) = C_0000; break;
-            case C_0010 : if (v_on_iso[2]) c.at(pid) = C_0000; break;
-            case C_0001 : if (v_on_iso[3]) c.at(pid) = C_0000; break;
-
-            default : break;
-        }
+            verts.resize(fresh_eids.size());
+            PARALLEL_FOR(0, fresh_eids.size(), 1000, [&](uint j)
+            {
+                verts[j] = marching_tets_edge_point(m, fresh_eids[j], iso);
+            });
 
-        // triangle generation
-        switch (c.at(pid))
-        {
-            case C_1000 : { make_triangle(m, isovalue, vids, func, {2,0,4}, e2v_map, verts, tris, norms); break; }
-            case C_0111 : { swapped.at(pid)?
-                            make_triangle(m, isovalue, vids, func, {2,0,4}, e2v_map, verts, tris, norms) :
-                            make_triangle(m, isovalue, vids, func, {0,2,4}, e2v_map, verts, tris, norms); break; }
-            case C_1011 : { swapped.at(pid)?
-                            make_triangle(m, isovalue, vids, func, {1,2,3}, e2v_map, verts, tris, norms) :
-                            make_triangle(m, isovalue, vids, func, {2,1,3}, e2v_map, verts, tris, norms); break; }
-            case C_0100 : { make_triangle(m, isovalue, vids, func, {1,2,3}, e2v_map, verts, tris, norms); break; }
-            case C_1101 : { swapped.at(pid)?
-                            make_triangle(m, isovalue, vids, func, {0,1,5}, e2v_map, verts, tris, norms) :
-                            make_triangle(m, isovalue, vids, func, {1,0,5}, e2v_map, verts, tris, norms); break; }
-            case C_0010 : { make_triangle(m, isovalue, vids, func, {0,1,5}, e2v_map, verts, tris, norms); break; }
-            case C_0001 : { make_triangle(m, isovalue, vids, func, {5,3,4}, e2v_map, verts, tris, norms); break; }
-            case C_1110 : { swapped.at(pid)?
-                            make_triangle(m, isovalue, vids, func, {5,3,4}, e2v_map, verts, tris, norms) :
-                            make_triangle(m, isovalue, vids, func, {3,5,4}, e2v_map, verts, tris, norms); break; }
-            case C_0101 : { make_triangle(m, isovalue, vids, func, {5,2,4}, e2v_map, verts, tris, norms);
-                            make_triangle(m, isovalue, vids, func, {2,5,1}, e2v_map, verts, tris, norms); break; }
-            case C_1010 : { make_triangle(m, isovalue, vids, func, {2,5,4}, e2v_map, verts, tris, norms);
-                            make_triangle(m, isovalue, vids, func, {5,2,1}, e2v_map, verts, tris, norms); break; }
-            case C_0011 : { make_triangle(m, isovalue, vids, func, {3,4,1}, e2v_map, verts, tris, norms);
-                            make_triangle(m, isovalue, vids, func, {1,4,0}, e2v_map, verts, tris, norms); break; }
-            case C_1100 : { make_triangle(m, isovalue, vids, func, {4,3,1}, e2v_map, verts, tris, norms);
-                            make_triangle(m, isovalue, vids, func, {4,1,0}, e2v_map, verts, tris, norms); break; }
-            case C_1001 : { make_triangle(m, isovalue, vids, func, {3,2,0}, e2v_map, verts, tris, norms);
-                            make_triangle(m, isovalue, vids, func, {5,3,0}, e2v_map, verts, tris, norms); break; }
-            case C_0110 : { make_triangle(m, isovalue, vids, func, {2,3,0}, e2v_map, verts, tris, norms);
-                            make_triangle(m, isovalue, vids, func, {3,5,0}, e2v_map, verts, tris, norms); break; }
-            default : break;
+            tris.resize(3*n_tris);
+            norms.resize(n_tris);
+            PARALLEL_FOR(0, n_tris, 1000, [&](uint tid)
+            {
+                vec3d tri_verts[3];
+                for(uint k=0; k<3; ++k)
+                {
+                    uint eid = tri_eids[3*tid+k];
+                    tris[3*tid+k] = e2v[i][eid];
+                    tri_verts[k]  = marching_tets_edge_point(m, eid, iso);
+                }
+                vec3d u  = tri_verts[1] - tri_verts[0]; u.normalize();
+                vec3d w  = tri_verts[2] - tri_verts[0]; w.normalize();
+                vec3d n = u.cross(w);
+                n.normalize();
+                norms[tid] = n;
+            });
+
+            writer(i, verts, tris, norms);
         }
     }
 }
@@ -256,66 +360,54 @@ void marching_tets(const Tetmesh<M,V,E,F,P> & m,
 
 template<class M, class V, class E, class F, class P>
 CINO_INLINE
-void make_triangle(const Tetmesh<M,V,E,F,P> & m,
-                   const double               isovalue,
-                   const uint                 vids[],
-                   const double               func[],
-                   const std::array<uint,3> & e,
-                   std::map<ipair,uint>     & e2v_map,
-                   std::vector<vec3d>       & verts,
-                   std::vector<uint>        & tris,
-                   std::vector<vec3d>       & norms)
+void marching_tets(const Tetmesh<M,V,E,F,P>        & m,
+                   const std::vector<double>       & isovalues,
+                   std::vector<std::vector<vec3d>> & verts,
+                   std::vector<std::vector<uint>>  & tris,
+                   std::vector<std::vector<vec3d>> & norms)
 {
-    assert(isovalue >= *std::min_element(func, func+4));
-    assert(isovalue <= *std::max_element(func, func+4));
-
-    vec3d tri_verts[3];
-    uint  fresh_vid = uint(verts.size());
-
-    for(uint i=0; i<3; ++i)
+    verts.resize(isovalues.size());
+    tris.resize(isovalues.size());
+    norms.resize(isovalues.size());
+
+    // output is appended to the input buffers, hence vertex ids must be shifted by their initial size
+    std::vector<uint> base(isovalues.size());
+    for(uint i=0; i<isovalues.size(); ++i) base.at(i) = uint(verts.at(i).size());
+
+    auto writer = [&](const uint                 iso_id,
+                      const std::vector<vec3d> & chunk_verts,
+                      const std::vector<uint>  & chunk_tris,
+                      const std::vector<vec3d> & chunk_norms)
     {
-        uint v_a = vids[TET_EDGES[e[i]][0]];
-        uint v_b = vids[TET_EDGES[e[i]][1]];
+        verts.at(iso_id).insert(verts.at(iso_id).end(), chunk_verts.begin(), chunk_verts.end());
+        for(uint vid : chunk_tris) tris.at(iso_id).push_back(base.at(iso_id) + vid);
+        norms.at(iso_id).insert(norms.at(iso_id).end(), chunk_norms.begin(), chunk_norms.end());
+    };
 
-        // avoid duplicated vertices. If an edge has already
-        // been visited retrieve its id and coordinates
-        //
-        ipair pair  = unique_pair(v_a, v_b);
-        auto  query = e2v_map.find(pair);
-
-        if (query != e2v_map.end())
-        {
-            uint vid = query->second;
-            tri_verts[i] = vec3d(verts.at(vid));
-            tris.push_back(vid);
-        }
-        else
-        {
-            double f_a = func[TET_EDGES[e[i]][0]];
-            double f_b = func[TET_EDGES[e[i]][1]];
-
-            if (f_a < f_b)
-            {
-                std::swap(v_a, v_b);
-                std::swap(f_a, f_b);
-            }
-
-            double alpha = (isovalue - f_a) / (f_b - f_a);
-
-            tri_verts[i] = (1.0 - alpha) * m.vert(v_a) + alpha * m.vert(v_b);
-
-            verts.push_back(tri_verts[i]);
+    // the whole mesh is processed as a single chunk
+    marching_tets_stream(m, isovalues, writer, std::max(m.num_polys(),uint(1)));
+}
 
-            tris.push_back(fresh_vid);
-            e2v_map[pair] = fresh_vid++;
-        }
-    }
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    vec3d u  = tri_verts[1] - tri_verts[0]; u.normalize();
-    vec3d w  = tri_verts[2] - tri_verts[0]; w.normalize();
-    vec3d n = u.cross(w);
-    n.normalize();
-    norms.push_back(n);
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void marching_tets(const Tetmesh<M,V,E,F,P> & m,
+                   const double               isovalue,
+                   std::vector<vec3d>       & verts,
+                   std::vector<uint>        & tris,
+                   std::vector<vec3d>       & norms)
+{
+    std::vector<std::vector<vec3d>> v;
+    std::vector<std::vector<uint>>  t;
+    std::vector<std::vector<vec3d>> n;
+    marching_tets(m, std::vector<double>{isovalue}, v, t, n);
+
+    // output is appended to the input buffers
+    verts.insert(verts.end(), v.front().begin(), v.front().end());
+    norms.insert(norms.end(), n.front().begin(), n.front().end());
+    uint base = verts.size() - v.front().size();
+    for(uint vid : t.front()) tris.push_back(base + vid);
 }
 
 }
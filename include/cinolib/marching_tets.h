@@ -37,7 +37,6 @@
 #define CINO_MARCHING_TETS_H
 
 #include <vector>
-#include <map>
 #include <sys/types.h>
 #include <cinolib/cino_inline.h>
 #include <cinolib/ipair.h>
@@ -46,6 +45,14 @@
 namespace cinolib
 {
 
+/* Extracts the level set of the scalar field stored in the uvw[0] field
+ * of the mesh vertices. The extraction runs in parallel, in two passes:
+ * first each tet is classified and its number of triangles is counted,
+ * then a prefix sum assigns to each tet its slot in the output buffers,
+ * and triangles are emitted concurrently. Duplicated vertices are avoided
+ * by keying crossing points with the mesh edge ids (see edge_id), using a
+ * flat array rather than a map.
+*/
 template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void marching_tets(const Tetmesh<M,V,E,F,P> & m,
@@ -53,6 +60,41 @@ void marching_tets(const Tetmesh<M,V,E,F,P> & m,
                    std::vector<vec3d>       & verts,
                    std::vector<uint>        & tris,
                    std::vector<vec3d>       & norms);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Extracts multiple level sets at once. Output is one mesh per isovalue,
+// appended to the corresponding buffers as in the single isovalue version
+//
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void marching_tets(const Tetmesh<M,V,E,F,P>        & m,
+                   const std::vector<double>       & isovalues,
+                   std::vector<std::vector<vec3d>> & verts,
+                   std::vector<std::vector<uint>>  & tris,
+                   std::vector<std::vector<vec3d>> & norms);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Streaming version of the above. Tets are processed in chunks of chunk_size
+ * elements, and the level sets are handed to a writer chunk by chunk, without
+ * ever storing the whole output in memory. For each chunk and for each isovalue
+ * the writer is called as
+ *
+ *     writer(iso_id, verts, tris, norms)
+ *
+ * where verts are the vertices generated in the current chunk, and tris are the
+ * triangles generated in the current chunk, indexed w.r.t. the list of all the
+ * vertices streamed so far for iso_id (i.e., new vertices are always appended).
+ * Since vertices and triangles are emitted in tet order, concatenating the streams
+ * gives exactly the output of the in-memory extraction.
+*/
+template<class M, class V, class E, class F, class P, class Writer>
+CINO_INLINE
+void marching_tets_stream(const Tetmesh<M,V,E,F,P> & m,
+                          const std::vector<double> & isovalues,
+                          Writer                    & writer,
+                          const uint                  chunk_size = 1000000);
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -57,8 +57,15 @@ void MCF(AbstractPolygonMesh<M,V,E,P> & m,
     time *= time;
     time *= time_scalar;
 
-    Eigen::SparseMatrix<double> L  = laplacian(m, COTANGENT);
-    Eigen::SparseMatrix<double> MM = mass_matrix(m);
+    // matrices are refilled in place at each iteration (the sparsity pattern never changes)
+    LaplacianCache  L_cache;
+    MassMatrixCache MM_cache;
+    Eigen::SparseMatrix<double> L  = laplacian(m, L_cache, COTANGENT);
+    Eigen::SparseMatrix<double> MM = mass_matrix(m, MM_cache);
+
+    // the symbolic factorization is the same for all iterations
+    Eigen::SimplicialLLT<Eigen::SparseMatrix<double>> LLT;
+    LLT.analyzePattern(MM - time_scalar * L);
 
     for(uint i=1; i<=n_iters; ++i)
     {
@@ -67,7 +74,7 @@ void MCF(AbstractPolygonMesh<M,V,E,P> & m,
         m.center_bbox();        
 
         // backward euler time integration of heat flow equation
-        Eigen::SimplicialLLT<Eigen::SparseMatrix<double>> LLT(MM - time_scalar * L);
+        LLT.factorize(MM - time_scalar * L);
 
         uint nv = m.num_verts();
         Eigen::VectorXd x(nv);
@@ -98,8 +105,8 @@ void MCF(AbstractPolygonMesh<M,V,E,P> & m,
 
         if (i<n_iters) // update matrices for the next iteration
         {
-            MM = mass_matrix(m);
-            if (!conformalized) L = laplacian(m, COTANGENT);
+            MM = mass_matrix(m, MM_cache);
+            if (!conformalized) L = laplacian(m, L_cache, COTANGENT);
         }
     }
 
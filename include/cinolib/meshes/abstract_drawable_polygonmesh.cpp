@@ -38,6 +38,9 @@
 #include <cinolib/gl/draw_lines_tris.h>
 #include <cinolib/gl/load_texture.h>
 #include <cinolib/color.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/stl_container_utilities.h>
+#include <numeric>
 
 namespace cinolib
 {
@@ -53,6 +56,7 @@ void AbstractDrawablePolygonMesh<Mesh>::init_drawable_stuff()
     slice_marked_edges        = true;
     marked_edges.use_gl_lines = true;
     marked_edges.thickness    = 3.f;    
+    drawlist.use_buffers      = true;
     updateGL();
 }
 
@@ -76,6 +80,7 @@ template<class Mesh>
 CINO_INLINE
 void AbstractDrawablePolygonMesh<Mesh>::updateGL()
 {
+    this->pick_invalidate();
     updateGL_mesh();
     updateGL_marked();
 }
@@ -118,218 +123,436 @@ CINO_INLINE
 void AbstractDrawablePolygonMesh<Mesh>::updateGL_mesh()
 {
     drawlist.material = material_;
-    drawlist.tri_coords.clear();
-    drawlist.tris.clear();
-    drawlist.tri_v_norms.clear();
-    drawlist.tri_v_colors.clear();
-    drawlist.tri_text.clear();
-    drawlist.segs.clear();
-    drawlist.seg_coords.clear();
-    drawlist.seg_colors.clear();
 
     if(this->num_polys() == 0) // for point clouds
     {
-        drawlist.tri_coords.reserve(this->num_verts()*3);
-        drawlist.tri_v_colors.reserve(this->num_verts()*4);
-        for(uint vid=0; vid<this->num_verts(); ++vid)
+        drawlist_poly_offset.clear();
+        drawlist_edge_offset.clear();
+        drawlist.tris.clear();
+        drawlist.tri_v_norms.clear();
+        drawlist.tri_text.clear();
+        drawlist.segs.clear();
+        drawlist.seg_coords.clear();
+        drawlist.seg_colors.clear();
+        drawlist.tri_coords.resize(this->num_verts()*3);
+        drawlist.tri_v_colors.resize(this->num_verts()*4);
+        PARALLEL_FOR(0, this->num_verts(), 1000, [&](const uint vid)
         {
-            drawlist.tri_coords.push_back(float(this->vert(vid).x()));
-            drawlist.tri_coords.push_back(float(this->vert(vid).y()));
-            drawlist.tri_coords.push_back(float(this->vert(vid).z()));
-
-            drawlist.tri_v_colors.push_back(this->vert_data(vid).color.r);
-            drawlist.tri_v_colors.push_back(this->vert_data(vid).color.g);
-            drawlist.tri_v_colors.push_back(this->vert_data(vid).color.b);
-            drawlist.tri_v_colors.push_back(this->vert_data(vid).color.a);
+            drawlist_fill_point(vid, RENDER_TRI_ALL);
+        });
+        drawlist.mark_dirty(RENDER_ALL);
+        return;
+    }
+
+    // each visible poly (resp. edge) owns a contiguous range of drawlist vertices,
+    // so that it can be re-generated in place by updateGL_polys/updateGL_verts
+    drawlist_offsets(drawlist_poly_offset, drawlist_edge_offset);
+
+    drawlist.alloc_unindexed(drawlist_poly_offset.back(), drawlist_edge_offset.back());
+
+    PARALLEL_FOR(0, this->num_polys(), 1000, [&](const uint pid)
+    {
+        drawlist_fill_poly(pid, RENDER_TRI_ALL);
+    });
+    PARALLEL_FOR(0, this->num_edges(), 1000, [&](const uint eid)
+    {
+        drawlist_fill_edge(eid, RENDER_SEG_ALL);
+    });
+
+    drawlist.mark_dirty(RENDER_ALL);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::updateGL_verts(const std::vector<uint> & vids, const int attributes)
+{
+    if(attributes & RENDER_TRI_COORDS) this->pick_invalidate();
+    if(this->num_polys() == 0) // for point clouds
+    {
+        if(drawlist.tri_coords.size()!=this->num_verts()*3) { updateGL_mesh(); return; }
+        for(uint vid : vids)
+        {
+            drawlist_fill_point(vid, attributes);
+            drawlist.mark_dirty(attributes & (RENDER_TRI_COORDS | RENDER_TRI_COLORS), vid, vid+1);
         }
+        return;
     }
-    else
+
+    // normals and AO of a drawlist vertex are averaged over the polys incident
+    // to the vertex, hence they depend on the geometry of the second ring
+    std::vector<uint> pids;
+    std::vector<uint> eids;
+    for(uint vid : vids)
     {
-        for(uint pid=0; pid<this->num_polys(); ++pid)
+        for(uint pid : this->adj_v2p(vid)) pids.push_back(pid);
+        for(uint eid : this->adj_v2e(vid)) eids.push_back(eid);
+    }
+    if(attributes & (RENDER_TRI_NORMS | RENDER_TRI_COLORS))
+    {
+        REMOVE_DUPLICATES_FROM_VEC(pids);
+        std::vector<uint> ring = pids;
+        for(uint pid : ring)
+        for(uint vid : this->adj_p2v(pid))
+        for(uint nbr : this->adj_v2p(vid))
         {
-            if (this->poly_data(pid).flags[HIDDEN]) continue;
+            pids.push_back(nbr);
+        }
+    }
+    REMOVE_DUPLICATES_FROM_VEC(pids);
+    REMOVE_DUPLICATES_FROM_VEC(eids);
+    updateGL_elements(pids, eids, attributes);
+}
 
-            vec3d n = this->poly_data(pid).normal;
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-            for(uint i=0; i<this->poly_tessellation(pid).size()/3; ++i)
-            {
-                uint vid0 = this->poly_tessellation(pid).at(3*i+0);
-                uint vid1 = this->poly_tessellation(pid).at(3*i+1);
-                uint vid2 = this->poly_tessellation(pid).at(3*i+2);
-
-                // average AO with adjacent visible faces having dihedral angle lower than 60 degrees
-                auto  vid0_vis_pids = this->vert_adj_visible_polys(vid0, n, 60.0);
-                auto  vid1_vis_pids = this->vert_adj_visible_polys(vid1, n, 60.0);
-                auto  vid2_vis_pids = this->vert_adj_visible_polys(vid2, n, 60.0);
-                float AO_vid0 = 0.f;
-                float AO_vid1 = 0.f;
-                float AO_vid2 = 0.f;
-                for(uint pid : vid0_vis_pids) AO_vid0 += this->poly_data(pid).AO*AO_alpha + (1.f - AO_alpha);
-                for(uint pid : vid1_vis_pids) AO_vid1 += this->poly_data(pid).AO*AO_alpha + (1.f - AO_alpha);
-                for(uint pid : vid2_vis_pids) AO_vid2 += this->poly_data(pid).AO*AO_alpha + (1.f - AO_alpha);
-                AO_vid0 /= static_cast<float>(vid0_vis_pids.size());
-                AO_vid1 /= static_cast<float>(vid1_vis_pids.size());
-                AO_vid2 /= static_cast<float>(vid2_vis_pids.size());
-
-                uint base_addr = uint(drawlist.tri_coords.size()/3);
-
-                drawlist.tris.push_back(base_addr    );
-                drawlist.tris.push_back(base_addr + 1);
-                drawlist.tris.push_back(base_addr + 2);
-
-                drawlist.tri_coords.push_back(float(this->vert(vid0).x()));
-                drawlist.tri_coords.push_back(float(this->vert(vid0).y()));
-                drawlist.tri_coords.push_back(float(this->vert(vid0).z()));
-                drawlist.tri_coords.push_back(float(this->vert(vid1).x()));
-                drawlist.tri_coords.push_back(float(this->vert(vid1).y()));
-                drawlist.tri_coords.push_back(float(this->vert(vid1).z()));
-                drawlist.tri_coords.push_back(float(this->vert(vid2).x()));
-                drawlist.tri_coords.push_back(float(this->vert(vid2).y()));
-                drawlist.tri_coords.push_back(float(this->vert(vid2).z()));
-
-                if (drawlist.draw_mode & DRAW_TRI_SMOOTH)
-                {
-                    // average normals with adjacent visible faces having dihedral angle lower than 60 degrees
-                    vec3d n_vid0(0,0,0);
-                    vec3d n_vid1(0,0,0);
-                    vec3d n_vid2(0,0,0);
-                    for(uint pid : vid0_vis_pids) n_vid0 += this->poly_data(pid).normal;
-                    for(uint pid : vid1_vis_pids) n_vid1 += this->poly_data(pid).normal;
-                    for(uint pid : vid2_vis_pids) n_vid2 += this->poly_data(pid).normal;
-                    n_vid0 /= static_cast<double>(vid0_vis_pids.size());
-                    n_vid1 /= static_cast<double>(vid1_vis_pids.size());
-                    n_vid2 /= static_cast<double>(vid2_vis_pids.size());
-
-                    drawlist.tri_v_norms.push_back(float(n_vid0.x()));
-                    drawlist.tri_v_norms.push_back(float(n_vid0.y()));
-                    drawlist.tri_v_norms.push_back(float(n_vid0.z()));
-                    drawlist.tri_v_norms.push_back(float(n_vid1.x()));
-                    drawlist.tri_v_norms.push_back(float(n_vid1.y()));
-                    drawlist.tri_v_norms.push_back(float(n_vid1.z()));
-                    drawlist.tri_v_norms.push_back(float(n_vid2.x()));
-                    drawlist.tri_v_norms.push_back(float(n_vid2.y()));
-                    drawlist.tri_v_norms.push_back(float(n_vid2.z()));
-                }
-                else if (drawlist.draw_mode & DRAW_TRI_FLAT)
-                {
-                    drawlist.tri_v_norms.push_back(float(n.x()));
-                    drawlist.tri_v_norms.push_back(float(n.y()));
-                    drawlist.tri_v_norms.push_back(float(n.z()));
-                    drawlist.tri_v_norms.push_back(float(n.x()));
-                    drawlist.tri_v_norms.push_back(float(n.y()));
-                    drawlist.tri_v_norms.push_back(float(n.z()));
-                    drawlist.tri_v_norms.push_back(float(n.x()));
-                    drawlist.tri_v_norms.push_back(float(n.y()));
-                    drawlist.tri_v_norms.push_back(float(n.z()));
-                }
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::updateGL_polys(const std::vector<uint> & pids, const int attributes)
+{
+    std::vector<uint> eids;
+    if(attributes & RENDER_SEG_ALL)
+    {
+        for(uint pid : pids)
+        for(uint eid : this->adj_p2e(pid))
+        {
+            eids.push_back(eid);
+        }
+        REMOVE_DUPLICATES_FROM_VEC(eids);
+    }
+    updateGL_elements(pids, eids, attributes);
+}
 
-                if (drawlist.draw_mode & DRAW_TRI_TEXTURE1D)
-                {
-                    drawlist.tri_text.push_back(float(this->vert_data(vid0).uvw[0]));
-                    drawlist.tri_text.push_back(float(this->vert_data(vid1).uvw[0]));
-                    drawlist.tri_text.push_back(float(this->vert_data(vid2).uvw[0]));
-                }
-                else if (drawlist.draw_mode & DRAW_TRI_TEXTURE2D)
-                {
-                    drawlist.tri_text.push_back(float(this->vert_data(vid0).uvw[0]*drawlist.texture.scaling_factor));
-                    drawlist.tri_text.push_back(float(this->vert_data(vid0).uvw[1]*drawlist.texture.scaling_factor));
-                    drawlist.tri_text.push_back(float(this->vert_data(vid1).uvw[0]*drawlist.texture.scaling_factor));
-                    drawlist.tri_text.push_back(float(this->vert_data(vid1).uvw[1]*drawlist.texture.scaling_factor));
-                    drawlist.tri_text.push_back(float(this->vert_data(vid2).uvw[0]*drawlist.texture.scaling_factor));
-                    drawlist.tri_text.push_back(float(this->vert_data(vid2).uvw[1]*drawlist.texture.scaling_factor));
-                }
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-                if (drawlist.draw_mode & DRAW_TRI_FACECOLOR) // replicate f color on each vertex
-                {
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.r*AO_vid0);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.g*AO_vid0);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.b*AO_vid0);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.a);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.r*AO_vid1);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.g*AO_vid1);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.b*AO_vid1);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.a);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.r*AO_vid2);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.g*AO_vid2);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.b*AO_vid2);
-                    drawlist.tri_v_colors.push_back(this->poly_data(pid).color.a);
-                }
-                else if (drawlist.draw_mode & DRAW_TRI_VERTCOLOR)
-                {
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid0).color.r*AO_vid0);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid0).color.g*AO_vid0);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid0).color.b*AO_vid0);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid0).color.a);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid1).color.r*AO_vid1);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid1).color.g*AO_vid1);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid1).color.b*AO_vid1);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid1).color.a);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid2).color.r*AO_vid2);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid2).color.g*AO_vid2);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid2).color.b*AO_vid2);
-                    drawlist.tri_v_colors.push_back(this->vert_data(vid2).color.a);
-                }
-                else if (drawlist.draw_mode & DRAW_TRI_QUALITY)
-                {
-                    float q = this->poly_data(pid).quality;
-                    Color c = Color::red_white_blue_ramp_01(q);
-                    drawlist.tri_v_colors.push_back(c.r*AO_vid0);
-                    drawlist.tri_v_colors.push_back(c.g*AO_vid0);
-                    drawlist.tri_v_colors.push_back(c.b*AO_vid0);
-                    drawlist.tri_v_colors.push_back(c.a);
-                    drawlist.tri_v_colors.push_back(c.r*AO_vid1);
-                    drawlist.tri_v_colors.push_back(c.g*AO_vid1);
-                    drawlist.tri_v_colors.push_back(c.b*AO_vid1);
-                    drawlist.tri_v_colors.push_back(c.a);
-                    drawlist.tri_v_colors.push_back(c.r*AO_vid2);
-                    drawlist.tri_v_colors.push_back(c.g*AO_vid2);
-                    drawlist.tri_v_colors.push_back(c.b*AO_vid2);
-                    drawlist.tri_v_colors.push_back(c.a);
-                }
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::updateGL_edges(const std::vector<uint> & eids, const int attributes)
+{
+    updateGL_elements(std::vector<uint>(), eids, attributes & RENDER_SEG_ALL);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::updateGL_elements(const std::vector<uint> & pids,
+                                                          const std::vector<uint> & eids,
+                                                          const int                 attributes)
+{
+    // if elements were added or removed the drawlist must be regenerated from scratch
+    bool valid = (this->num_polys()>0                                        &&
+                  drawlist_poly_offset.size()==this->num_polys()+1           &&
+                  drawlist_edge_offset.size()==this->num_edges()+1           &&
+                  drawlist.has_unindexed_layout(drawlist_poly_offset.back(),
+                                                drawlist_edge_offset.back()));
+    if(!valid)
+    {
+        updateGL_mesh();
+        return;
+    }
+
+    // if the size of some element changed (e.g. because it was hidden or its tessellation
+    // changed) in place update is not possible, and the drawlist must be re-arranged
+    bool same_layout = true;
+    for(uint i=0; same_layout && i<pids.size(); ++i)
+    {
+        uint pid = pids.at(i);
+        same_layout = (drawlist_poly_offset.at(pid+1)-drawlist_poly_offset.at(pid) == drawlist_poly_size(pid));
+    }
+    for(uint i=0; same_layout && i<eids.size(); ++i)
+    {
+        uint eid = eids.at(i);
+        same_layout = (drawlist_edge_offset.at(eid+1)-drawlist_edge_offset.at(eid) == drawlist_edge_size(eid));
+    }
+    if(!same_layout)
+    {
+        updateGL_relayout(pids, eids);
+        return;
+    }
+
+    drawlist.material = material_;
+
+    // index arrays never change for in place updates
+    int tri_attr = attributes & RENDER_TRI_ALL & ~RENDER_TRI_INDICES;
+    int seg_attr = attributes & RENDER_SEG_ALL & ~RENDER_SEG_INDICES;
+
+    if(tri_attr)
+    {
+        PARALLEL_FOR(0, (uint)pids.size(), 1000, [&](const uint i)
+        {
+            drawlist_fill_poly(pids.at(i), tri_attr);
+        });
+        for(uint pid : pids) drawlist.mark_dirty(tri_attr, drawlist_poly_offset.at(pid), drawlist_poly_offset.at(pid+1));
+    }
+    if(seg_attr)
+    {
+        PARALLEL_FOR(0, (uint)eids.size(), 1000, [&](const uint i)
+        {
+            drawlist_fill_edge(eids.at(i), seg_attr);
+        });
+        for(uint eid : eids) drawlist.mark_dirty(seg_attr, drawlist_edge_offset.at(eid), drawlist_edge_offset.at(eid+1));
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::updateGL_relayout(const std::vector<uint> & pids,
+                                                          const std::vector<uint> & eids)
+{
+    drawlist.material = material_;
+
+    // only the given polys, the given edges and the edges incident to the given
+    // polys may have changed size. The offsets of all other elements are shifted
+    std::vector<uint> cand_eids = eids;
+    for(uint pid : pids)
+    for(uint eid : this->adj_p2e(pid))
+    {
+        cand_eids.push_back(eid);
+    }
+    REMOVE_DUPLICATES_FROM_VEC(cand_eids);
+
+    // elements to be regenerated: the ones given by the caller, the ones that changed
+    // size and, since normals and AO are averaged over the visible polys around each
+    // vertex, the polys incident to the vertices of the given polys
+    std::vector<bool> fill_p(this->num_polys(), false);
+    std::vector<bool> fill_e(this->num_edges(), false);
+    std::vector<bool> ring_v(this->num_verts(), false);
+    for(uint pid : pids)
+    for(uint vid : this->adj_p2v(pid))
+    {
+        if(ring_v.at(vid)) continue;
+        ring_v.at(vid) = true;
+        for(uint nbr : this->adj_v2p(vid)) fill_p.at(nbr) = true;
+    }
+    for(uint eid : eids) fill_e.at(eid) = true;
+
+    std::vector<uint> poly_off(drawlist_poly_offset.size());
+    std::vector<uint> edge_off(drawlist_edge_offset.size());
+    std::adjacent_difference(drawlist_poly_offset.begin(), drawlist_poly_offset.end(), poly_off.begin());
+    std::adjacent_difference(drawlist_edge_offset.begin(), drawlist_edge_offset.end(), edge_off.begin());
+    for(uint pid : pids) poly_off.at(pid+1) = drawlist_poly_size(pid);
+    for(uint eid : cand_eids)
+    {
+        edge_off.at(eid+1) = drawlist_edge_size(eid);
+        if(edge_off.at(eid+1) != drawlist_edge_offset.at(eid+1)-drawlist_edge_offset.at(eid)) fill_e.at(eid) = true;
+    }
+    std::partial_sum(poly_off.begin(), poly_off.end(), poly_off.begin());
+    std::partial_sum(edge_off.begin(), edge_off.end(), edge_off.begin());
+
+    std::vector<uint> fill_pids;
+    std::vector<uint> fill_eids;
+    for(uint pid=0; pid<this->num_polys(); ++pid) if(fill_p.at(pid)) fill_pids.push_back(pid);
+    for(uint eid=0; eid<this->num_edges(); ++eid) if(fill_e.at(eid)) fill_eids.push_back(eid);
+
+    drawlist.relayout_unindexed(drawlist_poly_offset, poly_off, drawlist_edge_offset, edge_off);
+    drawlist_poly_offset.swap(poly_off);
+    drawlist_edge_offset.swap(edge_off);
+
+    PARALLEL_FOR(0, (uint)fill_pids.size(), 1000, [&](const uint i)
+    {
+        drawlist_fill_poly(fill_pids.at(i), RENDER_TRI_ALL);
+    });
+    PARALLEL_FOR(0, (uint)fill_eids.size(), 1000, [&](const uint i)
+    {
+        drawlist_fill_edge(fill_eids.at(i), RENDER_SEG_ALL);
+    });
+
+    drawlist.mark_dirty(RENDER_ALL);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::drawlist_offsets(std::vector<uint> & poly_off, std::vector<uint> & edge_off) const
+{
+    poly_off.resize(this->num_polys()+1);
+    edge_off.resize(this->num_edges()+1);
+    poly_off.front() = 0;
+    edge_off.front() = 0;
+    PARALLEL_FOR(0, this->num_polys(), 1000, [&](const uint pid)
+    {
+        poly_off.at(pid+1) = drawlist_poly_size(pid);
+    });
+    PARALLEL_FOR(0, this->num_edges(), 1000, [&](const uint eid)
+    {
+        edge_off.at(eid+1) = drawlist_edge_size(eid);
+    });
+    for(uint pid=0; pid<this->num_polys(); ++pid) poly_off.at(pid+1) += poly_off.at(pid);
+    for(uint eid=0; eid<this->num_edges(); ++eid) edge_off.at(eid+1) += edge_off.at(eid);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+uint AbstractDrawablePolygonMesh<Mesh>::drawlist_poly_size(const uint pid) const
+{
+    if(this->poly_data(pid).flags[HIDDEN]) return 0;
+    return (uint)this->poly_tessellation(pid).size();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+uint AbstractDrawablePolygonMesh<Mesh>::drawlist_edge_size(const uint eid) const
+{
+    for(uint pid : this->adj_e2p(eid))
+    {
+        if(!this->poly_data(pid).flags[HIDDEN]) return 2;
+    }
+    return 0;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::drawlist_fill_point(const uint vid, const int attributes)
+{
+    if(attributes & RENDER_TRI_COORDS)
+    {
+        drawlist.tri_coords.at(3*vid+0) = float(this->vert(vid).x());
+        drawlist.tri_coords.at(3*vid+1) = float(this->vert(vid).y());
+        drawlist.tri_coords.at(3*vid+2) = float(this->vert(vid).z());
+    }
+    if(attributes & RENDER_TRI_COLORS)
+    {
+        drawlist.tri_v_colors.at(4*vid+0) = this->vert_data(vid).color.r;
+        drawlist.tri_v_colors.at(4*vid+1) = this->vert_data(vid).color.g;
+        drawlist.tri_v_colors.at(4*vid+2) = this->vert_data(vid).color.b;
+        drawlist.tri_v_colors.at(4*vid+3) = this->vert_data(vid).color.a;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::drawlist_fill_poly(const uint pid, const int attributes)
+{
+    if(this->poly_data(pid).flags[HIDDEN]) return;
+
+    const std::vector<uint> & tess = this->poly_tessellation(pid);
+    const vec3d n = this->poly_data(pid).normal;
+    const uint  base_addr = drawlist_poly_offset.at(pid);
+
+    bool need_nbrs = (attributes & RENDER_TRI_COLORS) ||
+                     ((attributes & RENDER_TRI_NORMS) && (drawlist.draw_mode & DRAW_TRI_SMOOTH));
+
+    for(uint i=0; i<tess.size(); ++i)
+    {
+        uint vid  = tess.at(i);
+        uint addr = base_addr + i;
+
+        // average AO and normals with adjacent visible faces having dihedral angle lower than 60 degrees
+        std::vector<uint> vis_pids;
+        if(need_nbrs) vis_pids = this->vert_adj_visible_polys(vid, n, 60.0);
+
+        if(attributes & RENDER_TRI_COORDS)
+        {
+            drawlist.tri_coords.at(3*addr+0) = float(this->vert(vid).x());
+            drawlist.tri_coords.at(3*addr+1) = float(this->vert(vid).y());
+            drawlist.tri_coords.at(3*addr+2) = float(this->vert(vid).z());
+        }
+
+        if(attributes & RENDER_TRI_NORMS)
+        {
+            if (drawlist.draw_mode & DRAW_TRI_SMOOTH)
+            {
+                vec3d n_vid(0,0,0);
+                for(uint nbr : vis_pids) n_vid += this->poly_data(nbr).normal;
+                n_vid /= static_cast<double>(vis_pids.size());
+                drawlist.tri_v_norms.at(3*addr+0) = float(n_vid.x());
+                drawlist.tri_v_norms.at(3*addr+1) = float(n_vid.y());
+                drawlist.tri_v_norms.at(3*addr+2) = float(n_vid.z());
+            }
+            else if (drawlist.draw_mode & DRAW_TRI_FLAT)
+            {
+                drawlist.tri_v_norms.at(3*addr+0) = float(n.x());
+                drawlist.tri_v_norms.at(3*addr+1) = float(n.y());
+                drawlist.tri_v_norms.at(3*addr+2) = float(n.z());
             }
         }
 
-        for(uint eid=0; eid<this->num_edges(); ++eid)
+        if(attributes & RENDER_TRI_TEXT)
         {
-            bool hidden = true;
-            for(uint pid : this->adj_e2p(eid))
+            if (drawlist.draw_mode & DRAW_TRI_TEXTURE1D)
             {
-                if(!this->poly_data(pid).flags[HIDDEN])
-                {
-                    hidden = false;
-                    break;
-                }
+                drawlist.tri_text.at(addr) = float(this->vert_data(vid).uvw[0]);
             }
-            if(hidden) continue;
+            else if (drawlist.draw_mode & DRAW_TRI_TEXTURE2D)
+            {
+                drawlist.tri_text.at(2*addr+0) = float(this->vert_data(vid).uvw[0]*drawlist.texture.scaling_factor);
+                drawlist.tri_text.at(2*addr+1) = float(this->vert_data(vid).uvw[1]*drawlist.texture.scaling_factor);
+            }
+        }
 
-            uint base_addr = uint(drawlist.seg_coords.size()/3);
-            drawlist.segs.push_back(base_addr    );
-            drawlist.segs.push_back(base_addr + 1);
-
-            vec3d vid0 = this->edge_vert(eid,0);
-            vec3d vid1 = this->edge_vert(eid,1);
-
-            drawlist.seg_coords.push_back(float(vid0.x()));
-            drawlist.seg_coords.push_back(float(vid0.y()));
-            drawlist.seg_coords.push_back(float(vid0.z()));
-            drawlist.seg_coords.push_back(float(vid1.x()));
-            drawlist.seg_coords.push_back(float(vid1.y()));
-            drawlist.seg_coords.push_back(float(vid1.z()));
-
-            drawlist.seg_colors.push_back(this->edge_data(eid).color.r);
-            drawlist.seg_colors.push_back(this->edge_data(eid).color.g);
-            drawlist.seg_colors.push_back(this->edge_data(eid).color.b);
-            drawlist.seg_colors.push_back(this->edge_data(eid).color.a);
-            drawlist.seg_colors.push_back(this->edge_data(eid).color.r);
-            drawlist.seg_colors.push_back(this->edge_data(eid).color.g);
-            drawlist.seg_colors.push_back(this->edge_data(eid).color.b);
-            drawlist.seg_colors.push_back(this->edge_data(eid).color.a);
+        if(attributes & RENDER_TRI_COLORS)
+        {
+            float AO = 0.f;
+            for(uint nbr : vis_pids) AO += this->poly_data(nbr).AO*AO_alpha + (1.f - AO_alpha);
+            AO /= static_cast<float>(vis_pids.size());
+
+            Color c;
+            bool  has_color = true;
+            if      (drawlist.draw_mode & DRAW_TRI_FACECOLOR) c = this->poly_data(pid).color; // replicate f color on each vertex
+            else if (drawlist.draw_mode & DRAW_TRI_VERTCOLOR) c = this->vert_data(vid).color;
+            else if (drawlist.draw_mode & DRAW_TRI_QUALITY)   c = Color::red_white_blue_ramp_01(this->poly_data(pid).quality);
+            else has_color = false;
+
+            if(has_color)
+            {
+                drawlist.tri_v_colors.at(4*addr+0) = c.r*AO;
+                drawlist.tri_v_colors.at(4*addr+1) = c.g*AO;
+                drawlist.tri_v_colors.at(4*addr+2) = c.b*AO;
+                drawlist.tri_v_colors.at(4*addr+3) = c.a;
+            }
         }
     }
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolygonMesh<Mesh>::drawlist_fill_edge(const uint eid, const int attributes)
+{
+    uint addr = drawlist_edge_offset.at(eid);
+    if(drawlist_edge_offset.at(eid+1)==addr) return; // hidden edge
+
+    if(attributes & RENDER_SEG_COORDS)
+    {
+        vec3d v0 = this->edge_vert(eid,0);
+        vec3d v1 = this->edge_vert(eid,1);
+        drawlist.seg_coords.at(3*addr+0) = float(v0.x());
+        drawlist.seg_coords.at(3*addr+1) = float(v0.y());
+        drawlist.seg_coords.at(3*addr+2) = float(v0.z());
+        drawlist.seg_coords.at(3*addr+3) = float(v1.x());
+        drawlist.seg_coords.at(3*addr+4) = float(v1.y());
+        drawlist.seg_coords.at(3*addr+5) = float(v1.z());
+    }
+    if(attributes & RENDER_SEG_COLORS)
+    {
+        const Color & c = this->edge_data(eid).color;
+        drawlist.seg_colors.at(4*addr+0) = c.r;
+        drawlist.seg_colors.at(4*addr+1) = c.g;
+        drawlist.seg_colors.at(4*addr+2) = c.b;
+        drawlist.seg_colors.at(4*addr+3) = c.a;
+        drawlist.seg_colors.at(4*addr+4) = c.r;
+        drawlist.seg_colors.at(4*addr+5) = c.g;
+        drawlist.seg_colors.at(4*addr+6) = c.b;
+        drawlist.seg_colors.at(4*addr+7) = c.a;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class Mesh>
 CINO_INLINE
 void AbstractDrawablePolygonMesh<Mesh>::show_mesh(const bool b)
@@ -94,6 +94,15 @@ class AbstractDrawablePolygonMesh : public virtual Mesh, public DrawableObject
         void updateGL_mesh();   // regenerates rendering data for mesh elements
         void updateGL_marked(); // regenerates rendering data for marked mesh elements
 
+        // in place update of the rendering data of a subset of mesh elements. Only the
+        // given attributes (see RENDER_* flags in draw_lines_tris.h) are regenerated and
+        // re-uploaded to the GPU. Changes to the tessellation or the HIDDEN flags of the
+        // elements involved are detected: the drawlist is re-arranged, re-using the data
+        // of unaffected elements. Changes to the connectivity trigger updateGL_mesh()
+        void updateGL_verts(const std::vector<uint> & vids, const int attributes = RENDER_ALL);
+        void updateGL_polys(const std::vector<uint> & pids, const int attributes = RENDER_ALL);
+        void updateGL_edges(const std::vector<uint> & eids, const int attributes = RENDER_SEG_ALL);
+
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         const Material & material() const { return material_; }
@@ -119,6 +128,22 @@ class AbstractDrawablePolygonMesh : public virtual Mesh, public DrawableObject
         void show_marked_edge_color(const Color & c);
         void show_marked_edge_width(const float width);
         void show_marked_edge_transparency(const float alpha);
+
+    protected:
+
+        // each visible poly (resp. edge) owns the drawlist vertices in the range
+        // [drawlist_poly_offset[pid], drawlist_poly_offset[pid+1])
+        std::vector<uint> drawlist_poly_offset;
+        std::vector<uint> drawlist_edge_offset;
+
+        uint drawlist_poly_size (const uint pid) const;
+        void drawlist_offsets   (std::vector<uint> & poly_off, std::vector<uint> & edge_off) const;
+        uint drawlist_edge_size (const uint eid) const;
+        void drawlist_fill_point(const uint vid, const int attributes);
+        void drawlist_fill_poly (const uint pid, const int attributes);
+        void drawlist_fill_edge (const uint eid, const int attributes);
+        void updateGL_elements  (const std::vector<uint> & pids, const std::vector<uint> & eids, const int attributes);
+        void updateGL_relayout  (const std::vector<uint> & pids, const std::vector<uint> & eids);
 };
 
 }
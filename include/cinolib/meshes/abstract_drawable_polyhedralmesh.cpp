@@ -38,7 +38,9 @@
 #include <cinolib/gl/draw_lines_tris.h>
 #include <cinolib/gl/load_texture.h>
 #include <cinolib/color.h>
-#include <unordered_set>
+#include <cinolib/parallel_for.h>
+#include <cinolib/stl_container_utilities.h>
+#include <numeric>
 
 namespace cinolib
 {
@@ -56,6 +58,8 @@ void AbstractDrawablePolyhedralMesh<Mesh>::init_drawable_stuff()
     slice_marked_edges        = true;
     marked_edges.use_gl_lines = true;
     marked_edges.thickness    = 3.f;
+    drawlist_in.use_buffers   = true;
+    drawlist_out.use_buffers  = true;
     updateGL();
 }
 
@@ -81,6 +85,7 @@ template<class Mesh>
 CINO_INLINE
 void AbstractDrawablePolyhedralMesh<Mesh>::updateGL()
 {
+    this->pick_invalidate();
     updateGL_marked();
     updateGL_in();
     updateGL_out();
@@ -172,203 +177,292 @@ template<class Mesh>
 CINO_INLINE
 void AbstractDrawablePolyhedralMesh<Mesh>::updateGL_out()
 {
-    drawlist_out.material = material_;
-    drawlist_out.tris.clear();
-    drawlist_out.tri_coords.clear();
-    drawlist_out.tri_v_norms.clear();
-    drawlist_out.tri_v_colors.clear();
-    drawlist_out.tri_text.clear();
-    drawlist_out.segs.clear();
-    drawlist_out.seg_coords.clear();
-    drawlist_out.seg_colors.clear();
+    updateGL_drawlist(false);
+}
 
-    for(uint fid=0; fid<this->num_faces(); ++fid)
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolyhedralMesh<Mesh>::updateGL_in()
+{
+    updateGL_drawlist(true);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolyhedralMesh<Mesh>::updateGL_drawlist(const bool in)
+{
+    RenderData        & dl       = in ? drawlist_in             : drawlist_out;
+    std::vector<uint> & face_off = in ? drawlist_in_face_offset : drawlist_out_face_offset;
+    std::vector<uint> & edge_off = in ? drawlist_in_edge_offset : drawlist_out_edge_offset;
+
+    dl.material = material_;
+
+    // each visible face (resp. edge) owns a contiguous range of drawlist vertices,
+    // so that it can be re-generated in place by updateGL_faces/updateGL_verts...
+    drawlist_offsets(in, face_off, edge_off);
+
+    dl.alloc_unindexed(face_off.back(), edge_off.back());
+
+    PARALLEL_FOR(0, this->num_faces(), 1000, [&](const uint fid)
+    {
+        drawlist_fill_face(in, fid, RENDER_TRI_ALL);
+    });
+    PARALLEL_FOR(0, this->num_edges(), 1000, [&](const uint eid)
     {
-        if (!this->face_is_on_srf(fid)) continue;
+        drawlist_fill_edge(in, eid, RENDER_SEG_ALL);
+    });
 
-        uint pid_beneath;
-        if(!this->face_is_visible(fid,pid_beneath)) continue;
+    dl.mark_dirty(RENDER_ALL);
+}
 
-        bool is_CW = this->poly_face_is_CW(pid_beneath, fid);
-        vec3d n = this->poly_face_normal(pid_beneath, fid);
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        for(uint i=0; i<this->face_tessellation(fid).size()/3; ++i)
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolyhedralMesh<Mesh>::updateGL_verts(const std::vector<uint> & vids, const int attributes)
+{
+    if(attributes & RENDER_TRI_COORDS) this->pick_invalidate();
+    // normals and AO of a drawlist vertex are averaged over the faces incident
+    // to the vertex, hence they depend on the geometry of the second ring
+    std::vector<uint> fids;
+    std::vector<uint> eids;
+    for(uint vid : vids)
+    {
+        for(uint fid : this->adj_v2f(vid)) fids.push_back(fid);
+        for(uint eid : this->adj_v2e(vid)) eids.push_back(eid);
+    }
+    if(attributes & (RENDER_TRI_NORMS | RENDER_TRI_COLORS))
+    {
+        REMOVE_DUPLICATES_FROM_VEC(fids);
+        std::vector<uint> ring = fids;
+        for(uint fid : ring)
+        for(uint vid : this->adj_f2v(fid))
+        for(uint nbr : this->adj_v2f(vid))
         {
-            uint vid0 = this->face_tessellation(fid).at(3*i+0);
-            uint vid1 = this->face_tessellation(fid).at(3*i+1);
-            uint vid2 = this->face_tessellation(fid).at(3*i+2);
-            if(is_CW) std::swap(vid1,vid2); // flip triangle orientation
-
-            // average AO with adjacent visible faces having dihedral angle lower than 60 degrees
-            auto  vid0_vis_fids = this->vert_adj_visible_faces(vid0, n, 60.0);
-            auto  vid1_vis_fids = this->vert_adj_visible_faces(vid1, n, 60.0);
-            auto  vid2_vis_fids = this->vert_adj_visible_faces(vid2, n, 60.0);
-            float AO_vid0 = 0.f;
-            float AO_vid1 = 0.f;
-            float AO_vid2 = 0.f;
-            for(auto fp : vid0_vis_fids) AO_vid0 += this->face_data(fp.first).AO*AO_alpha + (1.f - AO_alpha);
-            for(auto fp : vid1_vis_fids) AO_vid1 += this->face_data(fp.first).AO*AO_alpha + (1.f - AO_alpha);
-            for(auto fp : vid2_vis_fids) AO_vid2 += this->face_data(fp.first).AO*AO_alpha + (1.f - AO_alpha);
-            AO_vid0 /= static_cast<float>(vid0_vis_fids.size());
-            AO_vid1 /= static_cast<float>(vid1_vis_fids.size());
-            AO_vid2 /= static_cast<float>(vid2_vis_fids.size());
-
-            uint base_addr = uint(drawlist_out.tri_coords.size()/3);
-
-            drawlist_out.tris.push_back(base_addr    );
-            drawlist_out.tris.push_back(base_addr + 1);
-            drawlist_out.tris.push_back(base_addr + 2);
-
-            drawlist_out.tri_coords.push_back(float(this->vert(vid0).x()));
-            drawlist_out.tri_coords.push_back(float(this->vert(vid0).y()));
-            drawlist_out.tri_coords.push_back(float(this->vert(vid0).z()));
-            drawlist_out.tri_coords.push_back(float(this->vert(vid1).x()));
-            drawlist_out.tri_coords.push_back(float(this->vert(vid1).y()));
-            drawlist_out.tri_coords.push_back(float(this->vert(vid1).z()));
-            drawlist_out.tri_coords.push_back(float(this->vert(vid2).x()));
-            drawlist_out.tri_coords.push_back(float(this->vert(vid2).y()));
-            drawlist_out.tri_coords.push_back(float(this->vert(vid2).z()));
-
-            if (drawlist_out.draw_mode & DRAW_TRI_SMOOTH)
-            {
-                // average normals with adjacent visible faces having dihedral angle lower than 60 degrees
-                vec3d n_vid0(0,0,0);
-                vec3d n_vid1(0,0,0);
-                vec3d n_vid2(0,0,0);
-                for(auto fp : vid0_vis_fids) n_vid0 += this->poly_face_normal(fp.second, fp.first);
-                for(auto fp : vid1_vis_fids) n_vid1 += this->poly_face_normal(fp.second, fp.first);
-                for(auto fp : vid2_vis_fids) n_vid2 += this->poly_face_normal(fp.second, fp.first);
-                n_vid0 /= static_cast<double>(vid0_vis_fids.size());
-                n_vid1 /= static_cast<double>(vid1_vis_fids.size());
-                n_vid2 /= static_cast<double>(vid2_vis_fids.size());
-
-                drawlist_out.tri_v_norms.push_back(float(n_vid0.x()));
-                drawlist_out.tri_v_norms.push_back(float(n_vid0.y()));
-                drawlist_out.tri_v_norms.push_back(float(n_vid0.z()));
-                drawlist_out.tri_v_norms.push_back(float(n_vid1.x()));
-                drawlist_out.tri_v_norms.push_back(float(n_vid1.y()));
-                drawlist_out.tri_v_norms.push_back(float(n_vid1.z()));
-                drawlist_out.tri_v_norms.push_back(float(n_vid2.x()));
-                drawlist_out.tri_v_norms.push_back(float(n_vid2.y()));
-                drawlist_out.tri_v_norms.push_back(float(n_vid2.z()));
-            }
-            else if (drawlist_out.draw_mode & DRAW_TRI_FLAT)
-            {
-                drawlist_out.tri_v_norms.push_back(float(n.x()));
-                drawlist_out.tri_v_norms.push_back(float(n.y()));
-                drawlist_out.tri_v_norms.push_back(float(n.z()));
-                drawlist_out.tri_v_norms.push_back(float(n.x()));
-                drawlist_out.tri_v_norms.push_back(float(n.y()));
-                drawlist_out.tri_v_norms.push_back(float(n.z()));
-                drawlist_out.tri_v_norms.push_back(float(n.x()));
-                drawlist_out.tri_v_norms.push_back(float(n.y()));
-                drawlist_out.tri_v_norms.push_back(float(n.z()));
-            }
+            fids.push_back(nbr);
+        }
+    }
+    REMOVE_DUPLICATES_FROM_VEC(fids);
+    REMOVE_DUPLICATES_FROM_VEC(eids);
+    updateGL_elements(fids, eids, attributes);
+}
 
-            if (drawlist_out.draw_mode & DRAW_TRI_TEXTURE1D)
-            {
-                drawlist_out.tri_text.push_back(float(this->vert_data(vid0).uvw[0]));
-                drawlist_out.tri_text.push_back(float(this->vert_data(vid1).uvw[0]));
-                drawlist_out.tri_text.push_back(float(this->vert_data(vid2).uvw[0]));
-            }
-            else if (drawlist_out.draw_mode & DRAW_TRI_TEXTURE2D)
-            {
-                drawlist_out.tri_text.push_back(float(this->vert_data(vid0).uvw[0]*drawlist_out.texture.scaling_factor));
-                drawlist_out.tri_text.push_back(float(this->vert_data(vid0).uvw[1]*drawlist_out.texture.scaling_factor));
-                drawlist_out.tri_text.push_back(float(this->vert_data(vid1).uvw[0]*drawlist_out.texture.scaling_factor));
-                drawlist_out.tri_text.push_back(float(this->vert_data(vid1).uvw[1]*drawlist_out.texture.scaling_factor));
-                drawlist_out.tri_text.push_back(float(this->vert_data(vid2).uvw[0]*drawlist_out.texture.scaling_factor));
-                drawlist_out.tri_text.push_back(float(this->vert_data(vid2).uvw[1]*drawlist_out.texture.scaling_factor));
-            }
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-            if (drawlist_out.draw_mode & DRAW_TRI_FACECOLOR) // replicate f color on each vertex
-            {
-                drawlist_out.tri_v_colors.push_back(this->poly_data(pid_beneath).color.r*AO_vid0);
-                drawlist_out.tri_v_colors.push_back(this->poly_data(pid_beneath).color.g*AO_vid0);
-                drawlist_out.tri_v_colors.push_back(this->poly_data(pid_beneath).color.b*AO_vid0);
-                drawlist_out.tri_v_colors.push_back(this->poly_data(pid_beneath).color.a);
-                drawlist_out.tri_v_colors.push_back(this->poly_data(pid_beneath).color.r*AO_vid1);
-                drawlist_out.tri_v_colors.push_back(this->poly_data(pid_beneath).color.g*AO_vid1);
-                drawlist_out.tri_v_colors.push_back(this->poly_data(pid_beneath).color.b*AO_vid1);
-                drawlist_out.tri_v_colors.push_back(this->poly_data(pid_beneath).color.a);
-                drawlist_out.tri_v_colors.push_back(this->poly_data(pid_beneath).color.r*AO_vid2);
-                drawlist_out.tri_v_colors.push_back(this->poly_data(pid_beneath).color.g*AO_vid2);
-                drawlist_out.tri_v_colors.push_back(this->poly_data(pid_beneath).color.b*AO_vid2);
-                drawlist_out.tri_v_colors.push_back(this->poly_data(pid_beneath).color.a);
-            }
-            else if (drawlist_out.draw_mode & DRAW_TRI_VERTCOLOR)
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolyhedralMesh<Mesh>::updateGL_faces(const std::vector<uint> & fids, const int attributes)
+{
+    std::vector<uint> eids;
+    if(attributes & RENDER_SEG_ALL)
+    {
+        for(uint fid : fids)
+        for(uint eid : this->adj_f2e(fid))
+        {
+            eids.push_back(eid);
+        }
+        REMOVE_DUPLICATES_FROM_VEC(eids);
+    }
+    updateGL_elements(fids, eids, attributes);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolyhedralMesh<Mesh>::updateGL_polys(const std::vector<uint> & pids, const int attributes)
+{
+    std::vector<uint> fids;
+    std::vector<uint> eids;
+    for(uint pid : pids)
+    {
+        for(uint fid : this->adj_p2f(pid)) fids.push_back(fid);
+        if(attributes & RENDER_SEG_ALL)
+        {
+            for(uint eid : this->adj_p2e(pid)) eids.push_back(eid);
+        }
+    }
+    REMOVE_DUPLICATES_FROM_VEC(fids);
+    REMOVE_DUPLICATES_FROM_VEC(eids);
+    updateGL_elements(fids, eids, attributes);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolyhedralMesh<Mesh>::updateGL_edges(const std::vector<uint> & eids, const int attributes)
+{
+    updateGL_elements(std::vector<uint>(), eids, attributes & RENDER_SEG_ALL);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolyhedralMesh<Mesh>::updateGL_elements(const std::vector<uint> & fids,
+                                                             const std::vector<uint> & eids,
+                                                             const int                 attributes)
+{
+    // if elements were added or removed the drawlists must be regenerated from scratch
+    for(bool in : {false, true})
+    {
+        const RenderData        & dl       = in ? drawlist_in             : drawlist_out;
+        const std::vector<uint> & face_off = in ? drawlist_in_face_offset : drawlist_out_face_offset;
+        const std::vector<uint> & edge_off = in ? drawlist_in_edge_offset : drawlist_out_edge_offset;
+
+        if(face_off.size()!=this->num_faces()+1 ||
+           edge_off.size()!=this->num_edges()+1 ||
+           !dl.has_unindexed_layout(face_off.back(), edge_off.back()))
+        {
+            updateGL_drawlist(false);
+            updateGL_drawlist(true);
+            return;
+        }
+    }
+
+    // if the size of some element changed (e.g. because it was hidden or its tessellation
+    // changed) in place update is not possible, and the drawlists must be re-arranged
+    for(bool in : {false, true})
+    {
+        const std::vector<uint> & face_off = in ? drawlist_in_face_offset : drawlist_out_face_offset;
+        const std::vector<uint> & edge_off = in ? drawlist_in_edge_offset : drawlist_out_edge_offset;
+
+        bool same_layout = true;
+        for(uint i=0; same_layout && i<fids.size(); ++i)
+        {
+            uint fid = fids.at(i);
+            same_layout = (face_off.at(fid+1)-face_off.at(fid) == drawlist_face_size(fid, in));
+        }
+        for(uint i=0; same_layout && i<eids.size(); ++i)
+        {
+            uint eid = eids.at(i);
+            same_layout = (edge_off.at(eid+1)-edge_off.at(eid) == drawlist_edge_size(eid, in));
+        }
+        if(!same_layout)
+        {
+            updateGL_relayout(fids, eids);
+            return;
+        }
+    }
+
+    for(bool in : {false, true})
+    {
+        RenderData              & dl       = in ? drawlist_in             : drawlist_out;
+        const std::vector<uint> & face_off = in ? drawlist_in_face_offset : drawlist_out_face_offset;
+        const std::vector<uint> & edge_off = in ? drawlist_in_edge_offset : drawlist_out_edge_offset;
+
+        dl.material = material_;
+
+        // index arrays never change for in place updates
+        int tri_attr = attributes & RENDER_TRI_ALL & ~RENDER_TRI_INDICES;
+        int seg_attr = attributes & RENDER_SEG_ALL & ~RENDER_SEG_INDICES;
+
+        if(tri_attr)
+        {
+            PARALLEL_FOR(0, (uint)fids.size(), 1000, [&](const uint i)
             {
-                drawlist_out.tri_v_colors.push_back(this->vert_data(vid0).color.r*AO_vid0);
-                drawlist_out.tri_v_colors.push_back(this->vert_data(vid0).color.g*AO_vid0);
-                drawlist_out.tri_v_colors.push_back(this->vert_data(vid0).color.b*AO_vid0);
-                drawlist_out.tri_v_colors.push_back(this->vert_data(vid0).color.a);
-                drawlist_out.tri_v_colors.push_back(this->vert_data(vid1).color.r*AO_vid1);
-                drawlist_out.tri_v_colors.push_back(this->vert_data(vid1).color.g*AO_vid1);
-                drawlist_out.tri_v_colors.push_back(this->vert_data(vid1).color.b*AO_vid1);
-                drawlist_out.tri_v_colors.push_back(this->vert_data(vid1).color.a);
-                drawlist_out.tri_v_colors.push_back(this->vert_data(vid2).color.r*AO_vid2);
-                drawlist_out.tri_v_colors.push_back(this->vert_data(vid2).color.g*AO_vid2);
-                drawlist_out.tri_v_colors.push_back(this->vert_data(vid2).color.b*AO_vid2);
-                drawlist_out.tri_v_colors.push_back(this->vert_data(vid2).color.a);
-            }
-            else if (drawlist_out.draw_mode & DRAW_TRI_QUALITY)
+                drawlist_fill_face(in, fids.at(i), tri_attr);
+            });
+            for(uint fid : fids) dl.mark_dirty(tri_attr, face_off.at(fid), face_off.at(fid+1));
+        }
+        if(seg_attr)
+        {
+            PARALLEL_FOR(0, (uint)eids.size(), 1000, [&](const uint i)
             {
-                float q = this->poly_data(pid_beneath).quality;
-                Color c = Color::red_white_blue_ramp_01(q);
-                drawlist_out.tri_v_colors.push_back(c.r*AO_vid0);
-                drawlist_out.tri_v_colors.push_back(c.g*AO_vid0);
-                drawlist_out.tri_v_colors.push_back(c.b*AO_vid0);
-                drawlist_out.tri_v_colors.push_back(c.a);
-                drawlist_out.tri_v_colors.push_back(c.r*AO_vid1);
-                drawlist_out.tri_v_colors.push_back(c.g*AO_vid1);
-                drawlist_out.tri_v_colors.push_back(c.b*AO_vid1);
-                drawlist_out.tri_v_colors.push_back(c.a);
-                drawlist_out.tri_v_colors.push_back(c.r*AO_vid2);
-                drawlist_out.tri_v_colors.push_back(c.g*AO_vid2);
-                drawlist_out.tri_v_colors.push_back(c.b*AO_vid2);
-                drawlist_out.tri_v_colors.push_back(c.a);
-            }
+                drawlist_fill_edge(in, eids.at(i), seg_attr);
+            });
+            for(uint eid : eids) dl.mark_dirty(seg_attr, edge_off.at(eid), edge_off.at(eid+1));
         }
     }
+}
 
-    for(uint eid=0; eid<this->num_edges(); ++eid)
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolyhedralMesh<Mesh>::updateGL_relayout(const std::vector<uint> & fids,
+                                                             const std::vector<uint> & eids)
+{
+    // only the given faces, the given edges and the edges incident to the given
+    // faces may have changed size. The offsets of all other elements are shifted
+    std::vector<uint> cand_eids = eids;
+    for(uint fid : fids)
+    for(uint eid : this->adj_f2e(fid))
     {
-        vec3d vid0 = this->edge_vert(eid,0);
-        vec3d vid1 = this->edge_vert(eid,1);
+        cand_eids.push_back(eid);
+    }
+    REMOVE_DUPLICATES_FROM_VEC(cand_eids);
+
+    // elements to be regenerated: the ones given by the caller, the ones that changed
+    // size and, since normals and AO are averaged over the visible faces around each
+    // vertex (either inner or on the surface), the faces incident to the vertices of
+    // the given faces
+    std::vector<bool> fill_f(this->num_faces(), false);
+    std::vector<bool> fill_e(this->num_edges(), false);
+    std::vector<bool> ring_v(this->num_verts(), false);
+    for(uint fid : fids)
+    for(uint vid : this->adj_f2v(fid))
+    {
+        if(ring_v.at(vid)) continue;
+        ring_v.at(vid) = true;
+        for(uint nbr : this->adj_v2f(vid)) fill_f.at(nbr) = true;
+    }
+    for(uint eid : eids) fill_e.at(eid) = true;
 
-        if (this->edge_is_on_srf(eid))
+    std::vector<uint> face_off[2];
+    std::vector<uint> edge_off[2];
+    for(bool in : {false, true})
+    {
+        const std::vector<uint> & old_face_off = in ? drawlist_in_face_offset : drawlist_out_face_offset;
+        const std::vector<uint> & old_edge_off = in ? drawlist_in_edge_offset : drawlist_out_edge_offset;
+
+        std::vector<uint> & f_off = face_off[in];
+        std::vector<uint> & e_off = edge_off[in];
+        f_off.resize(old_face_off.size());
+        e_off.resize(old_edge_off.size());
+        std::adjacent_difference(old_face_off.begin(), old_face_off.end(), f_off.begin());
+        std::adjacent_difference(old_edge_off.begin(), old_edge_off.end(), e_off.begin());
+        for(uint fid : fids) f_off.at(fid+1) = drawlist_face_size(fid, in);
+        for(uint eid : cand_eids)
         {
-            bool hidden = true;
-            for(uint pid : this->adj_e2p(eid))
-            {
-                if(!this->poly_data(pid).flags[HIDDEN])
-                {
-                    hidden = false;
-                    break;
-                }
-            }
-            if(hidden) continue;
-
-            uint base_addr = uint(drawlist_out.seg_coords.size()/3);
-            drawlist_out.segs.push_back(base_addr    );
-            drawlist_out.segs.push_back(base_addr + 1);
-
-            drawlist_out.seg_coords.push_back(float(vid0.x()));
-            drawlist_out.seg_coords.push_back(float(vid0.y()));
-            drawlist_out.seg_coords.push_back(float(vid0.z()));
-            drawlist_out.seg_coords.push_back(float(vid1.x()));
-            drawlist_out.seg_coords.push_back(float(vid1.y()));
-            drawlist_out.seg_coords.push_back(float(vid1.z()));
-
-            drawlist_out.seg_colors.push_back(this->edge_data(eid).color.r);
-            drawlist_out.seg_colors.push_back(this->edge_data(eid).color.g);
-            drawlist_out.seg_colors.push_back(this->edge_data(eid).color.b);
-            drawlist_out.seg_colors.push_back(this->edge_data(eid).color.a);
-            drawlist_out.seg_colors.push_back(this->edge_data(eid).color.r);
-            drawlist_out.seg_colors.push_back(this->edge_data(eid).color.g);
-            drawlist_out.seg_colors.push_back(this->edge_data(eid).color.b);
-            drawlist_out.seg_colors.push_back(this->edge_data(eid).color.a);
+            e_off.at(eid+1) = drawlist_edge_size(eid, in);
+            if(e_off.at(eid+1) != old_edge_off.at(eid+1)-old_edge_off.at(eid)) fill_e.at(eid) = true;
         }
+        std::partial_sum(f_off.begin(), f_off.end(), f_off.begin());
+        std::partial_sum(e_off.begin(), e_off.end(), e_off.begin());
+    }
+
+    std::vector<uint> fill_fids;
+    std::vector<uint> fill_eids;
+    for(uint fid=0; fid<this->num_faces(); ++fid) if(fill_f.at(fid)) fill_fids.push_back(fid);
+    for(uint eid=0; eid<this->num_edges(); ++eid) if(fill_e.at(eid)) fill_eids.push_back(eid);
+
+    for(bool in : {false, true})
+    {
+        RenderData        & dl           = in ? drawlist_in             : drawlist_out;
+        std::vector<uint> & old_face_off = in ? drawlist_in_face_offset : drawlist_out_face_offset;
+        std::vector<uint> & old_edge_off = in ? drawlist_in_edge_offset : drawlist_out_edge_offset;
+
+        dl.material = material_;
+        dl.relayout_unindexed(old_face_off, face_off[in], old_edge_off, edge_off[in]);
+        old_face_off.swap(face_off[in]);
+        old_edge_off.swap(edge_off[in]);
+
+        PARALLEL_FOR(0, (uint)fill_fids.size(), 1000, [&](const uint i)
+        {
+            drawlist_fill_face(in, fill_fids.at(i), RENDER_TRI_ALL);
+        });
+        PARALLEL_FOR(0, (uint)fill_eids.size(), 1000, [&](const uint i)
+        {
+            drawlist_fill_edge(in, fill_eids.at(i), RENDER_SEG_ALL);
+        });
+
+        dl.mark_dirty(RENDER_ALL);
     }
 }
 
@@ -376,214 +470,189 @@ void AbstractDrawablePolyhedralMesh<Mesh>::updateGL_out()
 
 template<class Mesh>
 CINO_INLINE
-void AbstractDrawablePolyhedralMesh<Mesh>::updateGL_in()
+void AbstractDrawablePolyhedralMesh<Mesh>::drawlist_offsets(const bool in, std::vector<uint> & face_off, std::vector<uint> & edge_off) const
 {
-    drawlist_in.material = material_;
-    drawlist_in.tris.clear();
-    drawlist_in.tri_coords.clear();
-    drawlist_in.tri_v_norms.clear();
-    drawlist_in.tri_v_colors.clear();
-    drawlist_in.tri_text.clear();
-    drawlist_in.segs.clear();
-    drawlist_in.seg_coords.clear();
-    drawlist_in.seg_colors.clear();
-
-    std::unordered_set<uint> edges_to_render;
+    face_off.resize(this->num_faces()+1);
+    edge_off.resize(this->num_edges()+1);
+    face_off.front() = 0;
+    edge_off.front() = 0;
+    PARALLEL_FOR(0, this->num_faces(), 1000, [&](const uint fid)
+    {
+        face_off.at(fid+1) = drawlist_face_size(fid, in);
+    });
+    PARALLEL_FOR(0, this->num_edges(), 1000, [&](const uint eid)
+    {
+        edge_off.at(eid+1) = drawlist_edge_size(eid, in);
+    });
+    for(uint fid=0; fid<this->num_faces(); ++fid) face_off.at(fid+1) += face_off.at(fid);
+    for(uint eid=0; eid<this->num_edges(); ++eid) edge_off.at(eid+1) += edge_off.at(eid);
+}
 
-    for(uint fid=0; fid<this->num_faces(); ++fid)
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+uint AbstractDrawablePolyhedralMesh<Mesh>::drawlist_face_size(const uint fid, const bool in) const
+{
+    // surface faces go to drawlist_out, inner faces go to drawlist_in
+    if(this->face_is_on_srf(fid) == in) return 0;
+    uint pid_beneath;
+    if(!this->face_is_visible(fid, pid_beneath)) return 0;
+    return (uint)this->face_tessellation(fid).size();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+uint AbstractDrawablePolyhedralMesh<Mesh>::drawlist_edge_size(const uint eid, const bool in) const
+{
+    if(this->edge_is_on_srf(eid))
+    {
+        if(in) return 0; // drawlist_out will consider it
+        for(uint pid : this->adj_e2p(eid))
+        {
+            if(!this->poly_data(pid).flags[HIDDEN]) return 2;
+        }
+        return 0;
+    }
+    if(!in) return 0;
+    for(uint fid : this->adj_e2f(eid))
     {
-        if(this->face_is_on_srf(fid)) continue;
+        if(drawlist_face_size(fid, true)>0) return 2;
+    }
+    return 0;
+}
 
-        uint pid_beneath;
-        if(!this->face_is_visible(fid, pid_beneath)) continue;
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        bool is_CW = this->poly_face_is_CW(pid_beneath, fid);
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolyhedralMesh<Mesh>::drawlist_fill_face(const bool in, const uint fid, const int attributes)
+{
+    RenderData              & dl       = in ? drawlist_in             : drawlist_out;
+    const std::vector<uint> & face_off = in ? drawlist_in_face_offset : drawlist_out_face_offset;
 
-        vec3d n = this->poly_face_normal(pid_beneath, fid);
+    uint base_addr = face_off.at(fid);
+    if(face_off.at(fid+1)==base_addr) return; // face not rendered in this drawlist
 
-        for(uint eid : this->adj_f2e(fid))
+    uint pid_beneath;
+    this->face_is_visible(fid, pid_beneath);
+    bool  is_CW = this->poly_face_is_CW(pid_beneath, fid);
+    vec3d n     = this->poly_face_normal(pid_beneath, fid);
+
+    bool need_nbrs = (attributes & RENDER_TRI_COLORS) ||
+                     ((attributes & RENDER_TRI_NORMS) && (dl.draw_mode & DRAW_TRI_SMOOTH));
+
+    const std::vector<uint> & tess = this->face_tessellation(fid);
+    for(uint i=0; i<tess.size(); ++i)
+    {
+        uint addr = base_addr + i;
+        uint off  = i%3;
+        if(is_CW && off>0) off = 3-off; // flip triangle orientation
+        uint vid  = tess.at(i - i%3 + off);
+
+        // average AO and normals with adjacent visible faces having dihedral angle lower than 60 degrees
+        std::vector<ipair> vis_fids;
+        if(need_nbrs) vis_fids = this->vert_adj_visible_faces(vid, n, 60.0);
+
+        if(attributes & RENDER_TRI_COORDS)
         {
-            if(this->edge_is_on_srf(eid)) continue; // updateGL_out() will consider it
-            edges_to_render.insert(eid);
+            dl.tri_coords.at(3*addr+0) = float(this->vert(vid).x());
+            dl.tri_coords.at(3*addr+1) = float(this->vert(vid).y());
+            dl.tri_coords.at(3*addr+2) = float(this->vert(vid).z());
         }
 
-        for(uint i=0; i<this->face_tessellation(fid).size()/3; ++i)
+        if(attributes & RENDER_TRI_NORMS)
         {
-            uint vid0 = this->face_tessellation(fid).at(3*i+0);
-            uint vid1 = this->face_tessellation(fid).at(3*i+1);
-            uint vid2 = this->face_tessellation(fid).at(3*i+2);
-            if (is_CW) std::swap(vid1,vid2); // flip triangle orientation
-
-            // average AO with adjacent visible faces having dihedral angle lower than 60 degrees
-            auto  vid0_vis_fids = this->vert_adj_visible_faces(vid0, n, 60.0);
-            auto  vid1_vis_fids = this->vert_adj_visible_faces(vid1, n, 60.0);
-            auto  vid2_vis_fids = this->vert_adj_visible_faces(vid2, n, 60.0);
-            float AO_vid0 = 0.f;
-            float AO_vid1 = 0.f;
-            float AO_vid2 = 0.f;
-            for(auto fp : vid0_vis_fids) AO_vid0 += this->face_data(fp.first).AO*AO_alpha + (1.f - AO_alpha);
-            for(auto fp : vid1_vis_fids) AO_vid1 += this->face_data(fp.first).AO*AO_alpha + (1.f - AO_alpha);
-            for(auto fp : vid2_vis_fids) AO_vid2 += this->face_data(fp.first).AO*AO_alpha + (1.f - AO_alpha);
-            AO_vid0 /= static_cast<float>(vid0_vis_fids.size());
-            AO_vid1 /= static_cast<float>(vid1_vis_fids.size());
-            AO_vid2 /= static_cast<float>(vid2_vis_fids.size());
-
-            uint base_addr = uint(drawlist_in.tri_coords.size()/3);
-
-            drawlist_in.tris.push_back(base_addr    );
-            drawlist_in.tris.push_back(base_addr + 1);
-            drawlist_in.tris.push_back(base_addr + 2);
-
-            drawlist_in.tri_coords.push_back(float(this->vert(vid0).x()));
-            drawlist_in.tri_coords.push_back(float(this->vert(vid0).y()));
-            drawlist_in.tri_coords.push_back(float(this->vert(vid0).z()));
-            drawlist_in.tri_coords.push_back(float(this->vert(vid1).x()));
-            drawlist_in.tri_coords.push_back(float(this->vert(vid1).y()));
-            drawlist_in.tri_coords.push_back(float(this->vert(vid1).z()));
-            drawlist_in.tri_coords.push_back(float(this->vert(vid2).x()));
-            drawlist_in.tri_coords.push_back(float(this->vert(vid2).y()));
-            drawlist_in.tri_coords.push_back(float(this->vert(vid2).z()));
-
-            if (drawlist_in.draw_mode & DRAW_TRI_SMOOTH)
+            if (dl.draw_mode & DRAW_TRI_SMOOTH)
             {
-                // average normals with adjacent visible faces having dihedral angle lower than 60 degrees
-                vec3d n_vid0(0,0,0);
-                vec3d n_vid1(0,0,0);
-                vec3d n_vid2(0,0,0);
-                for(auto fp : vid0_vis_fids) n_vid0 += this->poly_face_normal(fp.second, fp.first);
-                for(auto fp : vid1_vis_fids) n_vid1 += this->poly_face_normal(fp.second, fp.first);
-                for(auto fp : vid2_vis_fids) n_vid2 += this->poly_face_normal(fp.second, fp.first);
-                n_vid0 /= static_cast<double>(vid0_vis_fids.size());
-                n_vid1 /= static_cast<double>(vid1_vis_fids.size());
-                n_vid2 /= static_cast<double>(vid2_vis_fids.size());
-
-                drawlist_in.tri_v_norms.push_back(float(n_vid0.x()));
-                drawlist_in.tri_v_norms.push_back(float(n_vid0.y()));
-                drawlist_in.tri_v_norms.push_back(float(n_vid0.z()));
-                drawlist_in.tri_v_norms.push_back(float(n_vid1.x()));
-                drawlist_in.tri_v_norms.push_back(float(n_vid1.y()));
-                drawlist_in.tri_v_norms.push_back(float(n_vid1.z()));
-                drawlist_in.tri_v_norms.push_back(float(n_vid2.x()));
-                drawlist_in.tri_v_norms.push_back(float(n_vid2.y()));
-                drawlist_in.tri_v_norms.push_back(float(n_vid2.z()));
+                vec3d n_vid(0,0,0);
+                for(auto fp : vis_fids) n_vid += this->poly_face_normal(fp.second, fp.first);
+                n_vid /= static_cast<double>(vis_fids.size());
+                dl.tri_v_norms.at(3*addr+0) = float(n_vid.x());
+                dl.tri_v_norms.at(3*addr+1) = float(n_vid.y());
+                dl.tri_v_norms.at(3*addr+2) = float(n_vid.z());
             }
-            else if (drawlist_in.draw_mode & DRAW_TRI_FLAT)
+            else if (dl.draw_mode & DRAW_TRI_FLAT)
             {
-                drawlist_in.tri_v_norms.push_back(float(n.x()));
-                drawlist_in.tri_v_norms.push_back(float(n.y()));
-                drawlist_in.tri_v_norms.push_back(float(n.z()));
-                drawlist_in.tri_v_norms.push_back(float(n.x()));
-                drawlist_in.tri_v_norms.push_back(float(n.y()));
-                drawlist_in.tri_v_norms.push_back(float(n.z()));
-                drawlist_in.tri_v_norms.push_back(float(n.x()));
-                drawlist_in.tri_v_norms.push_back(float(n.y()));
-                drawlist_in.tri_v_norms.push_back(float(n.z()));
+                dl.tri_v_norms.at(3*addr+0) = float(n.x());
+                dl.tri_v_norms.at(3*addr+1) = float(n.y());
+                dl.tri_v_norms.at(3*addr+2) = float(n.z());
             }
+        }
 
-            if (drawlist_in.draw_mode & DRAW_TRI_TEXTURE1D)
+        if(attributes & RENDER_TRI_TEXT)
+        {
+            if (dl.draw_mode & DRAW_TRI_TEXTURE1D)
             {
-                drawlist_in.tri_text.push_back(float(this->vert_data(vid0).uvw[0]));
-                drawlist_in.tri_text.push_back(float(this->vert_data(vid1).uvw[0]));
-                drawlist_in.tri_text.push_back(float(this->vert_data(vid2).uvw[0]));
+                dl.tri_text.at(addr) = float(this->vert_data(vid).uvw[0]);
             }
-            else if (drawlist_in.draw_mode & DRAW_TRI_TEXTURE2D)
+            else if (dl.draw_mode & DRAW_TRI_TEXTURE2D)
             {
-                drawlist_in.tri_text.push_back(float(this->vert_data(vid0).uvw[0]*drawlist_in.texture.scaling_factor));
-                drawlist_in.tri_text.push_back(float(this->vert_data(vid0).uvw[1]*drawlist_in.texture.scaling_factor));
-                drawlist_in.tri_text.push_back(float(this->vert_data(vid1).uvw[0]*drawlist_in.texture.scaling_factor));
-                drawlist_in.tri_text.push_back(float(this->vert_data(vid1).uvw[1]*drawlist_in.texture.scaling_factor));
-                drawlist_in.tri_text.push_back(float(this->vert_data(vid2).uvw[0]*drawlist_in.texture.scaling_factor));
-                drawlist_in.tri_text.push_back(float(this->vert_data(vid2).uvw[1]*drawlist_in.texture.scaling_factor));
+                dl.tri_text.at(2*addr+0) = float(this->vert_data(vid).uvw[0]*dl.texture.scaling_factor);
+                dl.tri_text.at(2*addr+1) = float(this->vert_data(vid).uvw[1]*dl.texture.scaling_factor);
             }
+        }
 
-            if (drawlist_in.draw_mode & DRAW_TRI_FACECOLOR) // replicate f color on each vertex
-            {
-                drawlist_in.tri_v_colors.push_back(this->poly_data(pid_beneath).color.r*AO_vid0);
-                drawlist_in.tri_v_colors.push_back(this->poly_data(pid_beneath).color.g*AO_vid0);
-                drawlist_in.tri_v_colors.push_back(this->poly_data(pid_beneath).color.b*AO_vid0);
-                drawlist_in.tri_v_colors.push_back(this->poly_data(pid_beneath).color.a);
-                drawlist_in.tri_v_colors.push_back(this->poly_data(pid_beneath).color.r*AO_vid1);
-                drawlist_in.tri_v_colors.push_back(this->poly_data(pid_beneath).color.g*AO_vid1);
-                drawlist_in.tri_v_colors.push_back(this->poly_data(pid_beneath).color.b*AO_vid1);
-                drawlist_in.tri_v_colors.push_back(this->poly_data(pid_beneath).color.a);
-                drawlist_in.tri_v_colors.push_back(this->poly_data(pid_beneath).color.r*AO_vid2);
-                drawlist_in.tri_v_colors.push_back(this->poly_data(pid_beneath).color.g*AO_vid2);
-                drawlist_in.tri_v_colors.push_back(this->poly_data(pid_beneath).color.b*AO_vid2);
-                drawlist_in.tri_v_colors.push_back(this->poly_data(pid_beneath).color.a);
-            }
-            else if (drawlist_in.draw_mode & DRAW_TRI_VERTCOLOR)
-            {
-                drawlist_in.tri_v_colors.push_back(this->vert_data(vid0).color.r*AO_vid0);
-                drawlist_in.tri_v_colors.push_back(this->vert_data(vid0).color.g*AO_vid0);
-                drawlist_in.tri_v_colors.push_back(this->vert_data(vid0).color.b*AO_vid0);
-                drawlist_in.tri_v_colors.push_back(this->vert_data(vid0).color.a);
-                drawlist_in.tri_v_colors.push_back(this->vert_data(vid1).color.r*AO_vid1);
-                drawlist_in.tri_v_colors.push_back(this->vert_data(vid1).color.g*AO_vid1);
-                drawlist_in.tri_v_colors.push_back(this->vert_data(vid1).color.b*AO_vid1);
-                drawlist_in.tri_v_colors.push_back(this->vert_data(vid1).color.a);
-                drawlist_in.tri_v_colors.push_back(this->vert_data(vid2).color.r*AO_vid2);
-                drawlist_in.tri_v_colors.push_back(this->vert_data(vid2).color.g*AO_vid2);
-                drawlist_in.tri_v_colors.push_back(this->vert_data(vid2).color.b*AO_vid2);
-                drawlist_in.tri_v_colors.push_back(this->vert_data(vid2).color.a);
-            }
-            else if (drawlist_in.draw_mode & DRAW_TRI_QUALITY)
+        if(attributes & RENDER_TRI_COLORS)
+        {
+            float AO = 0.f;
+            for(auto fp : vis_fids) AO += this->face_data(fp.first).AO*AO_alpha + (1.f - AO_alpha);
+            AO /= static_cast<float>(vis_fids.size());
+
+            Color c;
+            bool  has_color = true;
+            if      (dl.draw_mode & DRAW_TRI_FACECOLOR) c = this->poly_data(pid_beneath).color; // replicate f color on each vertex
+            else if (dl.draw_mode & DRAW_TRI_VERTCOLOR) c = this->vert_data(vid).color;
+            else if (dl.draw_mode & DRAW_TRI_QUALITY)   c = Color::red_white_blue_ramp_01(this->poly_data(pid_beneath).quality);
+            else has_color = false;
+
+            if(has_color)
             {
-                float q = this->poly_data(pid_beneath).quality;
-                Color c = Color::red_white_blue_ramp_01(q);
-                drawlist_in.tri_v_colors.push_back(c.r*AO_vid0);
-                drawlist_in.tri_v_colors.push_back(c.g*AO_vid0);
-                drawlist_in.tri_v_colors.push_back(c.b*AO_vid0);
-                drawlist_in.tri_v_colors.push_back(c.a);
-                drawlist_in.tri_v_colors.push_back(c.r*AO_vid1);
-                drawlist_in.tri_v_colors.push_back(c.g*AO_vid1);
-                drawlist_in.tri_v_colors.push_back(c.b*AO_vid1);
-                drawlist_in.tri_v_colors.push_back(c.a);
-                drawlist_in.tri_v_colors.push_back(c.r*AO_vid2);
-                drawlist_in.tri_v_colors.push_back(c.g*AO_vid2);
-                drawlist_in.tri_v_colors.push_back(c.b*AO_vid2);
-                drawlist_in.tri_v_colors.push_back(c.a);
+                dl.tri_v_colors.at(4*addr+0) = c.r*AO;
+                dl.tri_v_colors.at(4*addr+1) = c.g*AO;
+                dl.tri_v_colors.at(4*addr+2) = c.b*AO;
+                dl.tri_v_colors.at(4*addr+3) = c.a;
             }
         }
     }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    for(uint eid : edges_to_render)
+template<class Mesh>
+CINO_INLINE
+void AbstractDrawablePolyhedralMesh<Mesh>::drawlist_fill_edge(const bool in, const uint eid, const int attributes)
+{
+    RenderData              & dl       = in ? drawlist_in             : drawlist_out;
+    const std::vector<uint> & edge_off = in ? drawlist_in_edge_offset : drawlist_out_edge_offset;
+
+    uint addr = edge_off.at(eid);
+    if(edge_off.at(eid+1)==addr) return; // edge not rendered in this drawlist
+
+    if(attributes & RENDER_SEG_COORDS)
+    {
+        vec3d v0 = this->edge_vert(eid,0);
+        vec3d v1 = this->edge_vert(eid,1);
+        dl.seg_coords.at(3*addr+0) = float(v0.x());
+        dl.seg_coords.at(3*addr+1) = float(v0.y());
+        dl.seg_coords.at(3*addr+2) = float(v0.z());
+        dl.seg_coords.at(3*addr+3) = float(v1.x());
+        dl.seg_coords.at(3*addr+4) = float(v1.y());
+        dl.seg_coords.at(3*addr+5) = float(v1.z());
+    }
+    if(attributes & RENDER_SEG_COLORS)
     {
-        uint base_addr = uint(drawlist_in.seg_coords.size()/3);
-        drawlist_in.segs.push_back(base_addr    );
-        drawlist_in.segs.push_back(base_addr + 1);
-
-        vec3d vid0 = this->edge_vert(eid,0);
-        vec3d vid1 = this->edge_vert(eid,1);
-
-        drawlist_in.seg_coords.push_back(float(vid0.x()));
-        drawlist_in.seg_coords.push_back(float(vid0.y()));
-        drawlist_in.seg_coords.push_back(float(vid0.z()));
-        drawlist_in.seg_coords.push_back(float(vid1.x()));
-        drawlist_in.seg_coords.push_back(float(vid1.y()));
-        drawlist_in.seg_coords.push_back(float(vid1.z()));
-
-        drawlist_in.seg_colors.push_back(this->edge_data(eid).color.r);
-        drawlist_in.seg_colors.push_back(this->edge_data(eid).color.g);
-        drawlist_in.seg_colors.push_back(this->edge_data(eid).color.b);
-        drawlist_in.seg_colors.push_back(this->edge_data(eid).color.a);
-        drawlist_in.seg_colors.push_back(this->edge_data(eid).color.r);
-        drawlist_in.seg_colors.push_back(this->edge_data(eid).color.g);
-        drawlist_in.seg_colors.push_back(this->edge_data(eid).color.b);
-        drawlist_in.seg_colors.push_back(this->edge_data(eid).color.a);
-
-//        if (this->edge_data(eid).flags[MARKED] && drawlist_in.draw_mode & DRAW_MARKED_SEGS)
-//        {
-//            uint base_addr = uint(drawlist_in.flags[MARKED]_seg_coords.size()/3);
-//            drawlist_in.flags[MARKED]_segs.push_back(base_addr    );
-//            drawlist_in.flags[MARKED]_segs.push_back(base_addr + 1);
-
-//            drawlist_in.flags[MARKED]_seg_coords.push_back(vid0.x());
-//            drawlist_in.flags[MARKED]_seg_coords.push_back(vid0.y());
-//            drawlist_in.flags[MARKED]_seg_coords.push_back(vid0.z());
-//            drawlist_in.flags[MARKED]_seg_coords.push_back(vid1.x());
-//            drawlist_in.flags[MARKED]_seg_coords.push_back(vid1.y());
-//            drawlist_in.flags[MARKED]_seg_coords.push_back(vid1.z());
-//        }
+        const Color & c = this->edge_data(eid).color;
+        dl.seg_colors.at(4*addr+0) = c.r;
+        dl.seg_colors.at(4*addr+1) = c.g;
+        dl.seg_colors.at(4*addr+2) = c.b;
+        dl.seg_colors.at(4*addr+3) = c.a;
+        dl.seg_colors.at(4*addr+4) = c.r;
+        dl.seg_colors.at(4*addr+5) = c.g;
+        dl.seg_colors.at(4*addr+6) = c.b;
+        dl.seg_colors.at(4*addr+7) = c.a;
     }
 }
 
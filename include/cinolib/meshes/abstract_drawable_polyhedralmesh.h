@@ -100,6 +100,16 @@ class AbstractDrawablePolyhedralMesh : public virtual Mesh, public DrawableObjec
         void updateGL_out();     // regenerates rendering data for mesh outside
         void updateGL_marked();  // regenerates rendering data for mesh marked elements
 
+        // in place update of the rendering data of a subset of mesh elements. Only the
+        // given attributes (see RENDER_* flags in draw_lines_tris.h) are regenerated and
+        // re-uploaded to the GPU. Changes to the tessellation or the visibility of the
+        // elements involved are detected: the drawlists are re-arranged, re-using the data
+        // of unaffected elements. Changes to the connectivity trigger a full update
+        void updateGL_verts(const std::vector<uint> & vids, const int attributes = RENDER_ALL);
+        void updateGL_faces(const std::vector<uint> & fids, const int attributes = RENDER_ALL);
+        void updateGL_polys(const std::vector<uint> & pids, const int attributes = RENDER_ALL);
+        void updateGL_edges(const std::vector<uint> & eids, const int attributes = RENDER_SEG_ALL);
+
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         const Material & material() const { return material_; }
@@ -143,6 +153,24 @@ class AbstractDrawablePolyhedralMesh : public virtual Mesh, public DrawableObjec
         void show_marked_face(const bool b);
         void show_marked_face_color(const Color & c);
         void show_marked_face_transparency(const float alpha);
+
+    protected:
+
+        // each visible face (resp. edge) owns the vertices in the range [off[fid], off[fid+1])
+        // of drawlist_out (if it is on the surface) or drawlist_in (if it is inside the volume)
+        std::vector<uint> drawlist_in_face_offset;
+        std::vector<uint> drawlist_in_edge_offset;
+        std::vector<uint> drawlist_out_face_offset;
+        std::vector<uint> drawlist_out_edge_offset;
+
+        uint drawlist_face_size(const uint fid, const bool in) const;
+        void drawlist_offsets  (const bool in, std::vector<uint> & face_off, std::vector<uint> & edge_off) const;
+        uint drawlist_edge_size(const uint eid, const bool in) const;
+        void drawlist_fill_face(const bool in, const uint fid, const int attributes);
+        void drawlist_fill_edge(const bool in, const uint eid, const int attributes);
+        void updateGL_drawlist (const bool in);
+        void updateGL_elements (const std::vector<uint> & fids, const std::vector<uint> & eids, const int attributes);
+        void updateGL_relayout (const std::vector<uint> & fids, const std::vector<uint> & eids);
 };
 
 }
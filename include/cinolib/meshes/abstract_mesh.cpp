@@ -37,6 +37,7 @@
 #include <cinolib/meshes/mesh_attributes.h>
 #include <cinolib/stl_container_utilities.h>
 #include <cinolib/min_max_inf.h>
+#include <cinolib/parallel_for.h>
 #include <map>
 #include <unordered_set>
 #include <unordered_map>
@@ -99,8 +100,12 @@ void AbstractMesh<M,V,E,P>::clear()
     M std_M_data;
     m_data = std_M_data;
     v_data.clear();
+    v_props.resize(0);
     e_data.clear();
+    e_props.resize(0);
     p_data.clear();
+    p_props.resize(0);
+    dirty_verts.clear();
     //
     v2v.clear();
     v2e.clear();
@@ -108,6 +113,8 @@ void AbstractMesh<M,V,E,P>::clear()
     e2p.clear();
     p2e.clear();
     p2p.clear();
+    //
+    pick_invalidate();
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -227,6 +234,16 @@ void AbstractMesh<M,V,E,P>::update_bbox()
 {
     bb.reset();
     bb.push(this->verts);
+    pick_invalidate();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractMesh<M,V,E,P>::verts_mark_dirty(const std::vector<uint> & vids)
+{
+    dirty_verts.insert(dirty_verts.end(), vids.begin(), vids.end());
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -1415,18 +1432,54 @@ void AbstractMesh<M,V,E,P>::edge_mark_sharp_creases(const float thresh)
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+const PickingIndex & AbstractMesh<M,V,E,P>::pick_index_verts() const
+{
+    if(pick_index_v.size()!=this->num_verts())
+    {
+        std::vector<AABB>  boxes(this->num_verts());
+        std::vector<vec3d> points(this->num_verts());
+        PARALLEL_FOR(0, this->num_verts(), 10000, [&](const uint vid)
+        {
+            points.at(vid) = this->vert(vid);
+            boxes.at(vid)  = AABB(points.at(vid), points.at(vid));
+        });
+        pick_index_v.build(boxes, points);
+    }
+    return pick_index_v;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 uint AbstractMesh<M,V,E,P>::pick_vert(const vec3d & p) const
 {
-    std::vector<std::pair<double,uint>> closest;
-    for(uint vid=0; vid<this->num_verts(); ++vid)
+    uint   id;
+    double dist;
+    if(!pick_index_verts().closest(p, [this](const uint vid){ return vert_is_visible(vid); }, id, dist)) return 0;
+    return id;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+const PickingIndex & AbstractMesh<M,V,E,P>::pick_index_edges() const
+{
+    if(pick_index_e.size()!=this->num_edges())
     {
-        if(vert_is_visible(vid)) closest.push_back(std::make_pair(this->vert(vid).dist(p),vid));
+        std::vector<AABB>  boxes(this->num_edges());
+        std::vector<vec3d> points(this->num_edges());
+        PARALLEL_FOR(0, this->num_edges(), 10000, [&](const uint eid)
+        {
+            points.at(eid) = this->edge_sample_at(eid, 0.5);
+            boxes.at(eid)  = AABB(this->edge_vert(eid,0), this->edge_vert(eid,1));
+        });
+        pick_index_e.build(boxes, points);
     }
-    if(closest.empty()) return 0;
-    std::sort(closest.begin(), closest.end());
-    return closest.front().second;
+    return pick_index_e;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -1435,14 +1488,30 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 uint AbstractMesh<M,V,E,P>::pick_edge(const vec3d & p) const
 {
-    std::vector<std::pair<double,uint>> closest;
-    for(uint eid=0; eid<this->num_edges(); ++eid)
+    uint   id;
+    double dist;
+    if(!pick_index_edges().closest(p, [this](const uint eid){ return edge_is_visible(eid); }, id, dist)) return 0;
+    return id;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+const PickingIndex & AbstractMesh<M,V,E,P>::pick_index_polys() const
+{
+    if(pick_index_p.size()!=this->num_polys())
     {
-        if(edge_is_visible(eid)) closest.push_back(std::make_pair(this->edge_sample_at(eid, 0.5).dist(p),eid));
+        std::vector<AABB>  boxes(this->num_polys());
+        std::vector<vec3d> points(this->num_polys());
+        PARALLEL_FOR(0, this->num_polys(), 10000, [&](const uint pid)
+        {
+            points.at(pid) = this->poly_centroid(pid);
+            boxes.at(pid)  = this->poly_aabb(pid);
+        });
+        pick_index_p.build(boxes, points);
     }
-    if(closest.empty()) return 0;
-    std::sort(closest.begin(), closest.end());
-    return closest.front().second;
+    return pick_index_p;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -1451,14 +1520,21 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 uint AbstractMesh<M,V,E,P>::pick_poly(const vec3d & p) const
 {
-    std::vector<std::pair<double,uint>> closest;
-    for(uint pid=0; pid<this->num_polys(); ++pid)
-    {
-        if(!this->poly_data(pid).flags[HIDDEN]) closest.push_back(std::make_pair(this->poly_centroid(pid).dist(p),pid));
-    }
-    if(closest.empty()) return 0;
-    std::sort(closest.begin(), closest.end());
-    return closest.front().second;
+    uint   id;
+    double dist;
+    if(!pick_index_polys().closest(p, [this](const uint pid){ return !this->poly_data(pid).flags[HIDDEN]; }, id, dist)) return 0;
+    return id;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractMesh<M,V,E,P>::pick_invalidate()
+{
+    pick_index_v.clear();
+    pick_index_e.clear();
+    pick_index_p.clear();
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
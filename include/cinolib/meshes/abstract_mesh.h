@@ -45,6 +45,8 @@
 #include <cinolib/color.h>
 #include <cinolib/symbols.h>
 #include <cinolib/ipair.h>
+#include <cinolib/picking_index.h>
+#include <cinolib/meshes/mesh_properties.h>
 
 typedef enum
 {
@@ -73,13 +75,22 @@ class AbstractMesh
 
         std::vector<vec3d>             verts;
         std::vector<uint>              edges;
-        std::vector<std::vector<uint>> polys; // either polygons or polyhedra
+        std::vector<std::vector<uint>> polys; // either polygons or polyhedra. Also for fixed arity elements
+                                              // (e.g. tets, hexes) each poly is a separate heap allocated
+                                              // vector, because adj_p2v and the other adjacency queries
+                                              // return references to std::vector<uint>
 
         M              m_data;
         std::vector<V> v_data;
         std::vector<E> e_data;
         std::vector<P> p_data;
 
+        PropertySet v_props; // opt-in per-element properties (see mesh_properties.h)
+        PropertySet e_props;
+        PropertySet p_props;
+
+        std::vector<uint> dirty_verts; // verts moved since the last call to update_dirty
+
         std::vector<std::vector<uint>> v2v; // vert to vert adjacency
         std::vector<std::vector<uint>> v2e; // vert to edge adjacency
         std::vector<std::vector<uint>> v2p; // vert to poly adjacency
@@ -87,6 +98,15 @@ class AbstractMesh
         std::vector<std::vector<uint>> p2e; // poly to edge adjacency
         std::vector<std::vector<uint>> p2p; // poly to poly adjacency
 
+        // spatial indices for mouse picking (lazily built, see pick_invalidate)
+        mutable PickingIndex pick_index_v;
+        mutable PickingIndex pick_index_e;
+        mutable PickingIndex pick_index_p;
+
+        const PickingIndex & pick_index_verts() const;
+        const PickingIndex & pick_index_edges() const;
+        const PickingIndex & pick_index_polys() const;
+
     public:
 
         typedef M M_type;
@@ -117,6 +137,15 @@ class AbstractMesh
                 void update_bbox();
         virtual void update_normals() = 0;
 
+        // incremental alternative to the full updates above. Verts that are moved
+        // with vert(vid) can be marked as dirty, and update_dirty will then refresh
+        // only the elements incident to them (bbox, normals and tessellations, as
+        // prescribed by the mesh attributes). Large updates are run in parallel
+                void vert_mark_dirty(const uint vid) { dirty_verts.push_back(vid); }
+                void verts_mark_dirty(const std::vector<uint> & vids);
+                bool has_dirty_verts() const { return !dirty_verts.empty(); }
+        virtual void update_dirty() = 0;
+
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         void  translate(const vec3d & delta);
@@ -208,10 +237,34 @@ class AbstractMesh
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        // useful for GUIs with mouse picking
-        uint pick_vert(const vec3d & p) const;
-        uint pick_edge(const vec3d & p) const;
-        uint pick_poly(const vec3d & p) const;
+        // named per-element attributes, stored as separate arrays (see mesh_properties.h)
+        template<typename T>       std::vector<T> & vert_add_property(const std::string & name, const T & def = T()) { return v_props.add<T>(name, num_verts(), def); }
+        template<typename T>       std::vector<T> & edge_add_property(const std::string & name, const T & def = T()) { return e_props.add<T>(name, num_edges(), def); }
+        template<typename T>       std::vector<T> & poly_add_property(const std::string & name, const T & def = T()) { return p_props.add<T>(name, num_polys(), def); }
+        template<typename T>       std::vector<T> & vert_property(const std::string & name)                         { return v_props.get<T>(name); }
+        template<typename T> const std::vector<T> & vert_property(const std::string & name) const                   { return v_props.get<T>(name); }
+        template<typename T>       std::vector<T> & edge_property(const std::string & name)                         { return e_props.get<T>(name); }
+        template<typename T> const std::vector<T> & edge_property(const std::string & name) const                   { return e_props.get<T>(name); }
+        template<typename T>       std::vector<T> & poly_property(const std::string & name)                         { return p_props.get<T>(name); }
+        template<typename T> const std::vector<T> & poly_property(const std::string & name) const                   { return p_props.get<T>(name); }
+                                   bool             vert_has_property(const std::string & name) const               { return v_props.has(name); }
+                                   bool             edge_has_property(const std::string & name) const               { return e_props.has(name); }
+                                   bool             poly_has_property(const std::string & name) const               { return p_props.has(name); }
+                                   void             vert_remove_property(const std::string & name)                  { v_props.remove(name); }
+                                   void             edge_remove_property(const std::string & name)                  { e_props.remove(name); }
+                                   void             poly_remove_property(const std::string & name)                  { p_props.remove(name); }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // useful for GUIs with mouse picking. Queries are answered with spatial indices
+        // that are built at the first call and re-used until they are invalidated. This
+        // happens automatically when the bbox is updated and when the drawables call
+        // updateGL, but pick_invalidate should be called if verts are moved otherwise.
+        // Visibility (i.e. the HIDDEN flag of polys) is evaluated at query time
+                uint pick_vert(const vec3d & p) const;
+                uint pick_edge(const vec3d & p) const;
+                uint pick_poly(const vec3d & p) const;
+        virtual void pick_invalidate();
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -42,8 +42,10 @@
 #include <cinolib/vector_serialization.h>
 #include <cinolib/how_many_seconds.h>
 #include <cinolib/deg_rad.h>
+#include <cinolib/Moller_Trumbore_intersection.h>
 #include <unordered_set>
 #include <cinolib/ANSI_color_codes.h>
+#include <cinolib/parallel_for.h>
 #include <queue>
 
 namespace cinolib
@@ -175,8 +177,11 @@ void AbstractPolygonMesh<M,V,E,P>::init(const std::vector<vec3d>             & v
     this->p2e.reserve(np);
     this->p2p.reserve(np);
     this->v_data.reserve(nv);
+    this->v_props.reserve(nv);
     this->e_data.reserve(ne);
+    this->e_props.reserve(ne);
     this->p_data.reserve(np);
+    this->p_props.reserve(np);
 
     // initialize mesh connectivity (and normals)
     for(auto v : verts) this->vert_add(v);
@@ -297,8 +302,12 @@ void AbstractPolygonMesh<M,V,E,P>::update_p_tessellation(const uint pid)
     // apply earcut algorithm to get a valid triangulation
 
     poly_triangles.at(pid).clear();
+    if(poly_is_own_tessellation(pid)) return;
+
+    uint nv = uint(this->polys.at(pid).size());
+    poly_triangles.at(pid).reserve(3*(nv-2));
     std::vector<vec3d> n;
-    for(uint i=2; i<this->verts_per_poly(pid); ++i)
+    for(uint i=2; i<nv; ++i)
     {
         uint vid0 = this->polys.at(pid).at( 0 );
         uint vid1 = this->polys.at(pid).at(i-1);
@@ -320,8 +329,8 @@ void AbstractPolygonMesh<M,V,E,P>::update_p_tessellation(const uint pid)
         // projecting the actual polygon onto the best fitting plane. Bad things
         // can still happen for highly non-planar polygons...
 
-        std::vector<vec3d> vlist(this->verts_per_poly(pid));
-        for (uint i=0; i<this->verts_per_poly(pid); ++i)
+        std::vector<vec3d> vlist(nv);
+        for (uint i=0; i<nv; ++i)
         {
             vlist.at(i) = this->poly_vert(pid,i);
         }
@@ -372,10 +381,10 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::update_p_normals()
 {
-    for(uint pid=0; pid<this->num_polys(); ++pid)
+    PARALLEL_FOR(0, this->num_polys(), 1000, [this](const uint pid)
     {
         update_p_normal(pid);
-    }
+    });
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -384,10 +393,10 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::update_p_tessellations()
 {
-    for(uint pid=0; pid<this->num_polys(); ++pid)
+    PARALLEL_FOR(0, this->num_polys(), 1000, [this](const uint pid)
     {
         update_p_tessellation(pid);
-    }
+    });
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -396,10 +405,10 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::update_v_normals()
 {
-    for(uint vid=0; vid<this->num_verts(); ++vid)
+    PARALLEL_FOR(0, this->num_verts(), 1000, [this](const uint vid)
     {
         update_v_normal(vid);
-    }
+    });
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -414,6 +423,45 @@ void AbstractPolygonMesh<M,V,E,P>::update_normals()
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::update_dirty()
+{
+    if(this->dirty_verts.empty()) return;
+
+    // polys incident to dirty verts, and verts whose normal depends on them
+    std::vector<uint> pids, vids;
+    for(uint vid : this->dirty_verts)
+    {
+        if(vid>=this->num_verts()) continue; // removed in the meanwhile
+        pids.insert(pids.end(), this->adj_v2p(vid).begin(), this->adj_v2p(vid).end());
+    }
+    REMOVE_DUPLICATES_FROM_VEC(pids);
+    for(uint pid : pids)
+    {
+        vids.insert(vids.end(), this->adj_p2v(pid).begin(), this->adj_p2v(pid).end());
+    }
+    REMOVE_DUPLICATES_FROM_VEC(vids);
+    this->dirty_verts.clear();
+
+    bool normals = this->mesh_data().update_normals;
+    PARALLEL_FOR(0, pids.size(), 1000, [&](const uint i)
+    {
+        update_p_tessellation(pids.at(i));
+        if(normals) update_p_normal(pids.at(i));
+    });
+    if(normals)
+    {
+        PARALLEL_FOR(0, vids.size(), 1000, [&](const uint i)
+        {
+            update_v_normal(vids.at(i));
+        });
+    }
+    if(this->mesh_data().update_bbox) this->update_bbox();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 int AbstractPolygonMesh<M,V,E,P>::Euler_characteristic() const
@@ -905,6 +953,7 @@ uint AbstractPolygonMesh<M,V,E,P>::vert_add(const vec3d & pos)
     //
     V data;
     this->v_data.push_back(data);
+    this->v_props.push_back();
     //
     this->v2v.push_back(std::vector<uint>());
     this->v2e.push_back(std::vector<uint>());
@@ -955,6 +1004,7 @@ void AbstractPolygonMesh<M,V,E,P>::vert_switch_id(const uint vid0, const uint vi
 
     std::swap(this->verts.at(vid0),  this->verts.at(vid1));
     std::swap(this->v_data.at(vid0), this->v_data.at(vid1));
+    this->v_props.swap(vid0,vid1);
     std::swap(this->v2v.at(vid0),    this->v2v.at(vid1));
     std::swap(this->v2e.at(vid0),    this->v2e.at(vid1));
     std::swap(this->v2p.at(vid0),    this->v2p.at(vid1));
@@ -1026,6 +1076,7 @@ void AbstractPolygonMesh<M,V,E,P>::vert_remove_unreferenced(const uint vid)
     vert_switch_id(vid, this->num_verts()-1);
     this->verts.pop_back();
     this->v_data.pop_back();
+    this->v_props.pop_back();
     this->v2v.pop_back();
     this->v2e.pop_back();
     this->v2p.pop_back();
@@ -1132,6 +1183,7 @@ uint AbstractPolygonMesh<M,V,E,P>::edge_add(const uint vid0, const uint vid1)
     //
     E data;
     this->e_data.push_back(data);
+    this->e_props.push_back();
     //
     this->v2v.at(vid1).push_back(vid0);
     this->v2v.at(vid0).push_back(vid1);
@@ -1156,6 +1208,7 @@ void AbstractPolygonMesh<M,V,E,P>::edge_switch_id(const uint eid0, const uint ei
 
     std::swap(this->e2p.at(eid0),    this->e2p.at(eid1));
     std::swap(this->e_data.at(eid0), this->e_data.at(eid1));
+    this->e_props.swap(eid0,eid1);
 
     std::unordered_set<uint> verts_to_update;
     verts_to_update.insert(this->edge_vert_id(eid0,0));
@@ -1205,6 +1258,7 @@ void AbstractPolygonMesh<M,V,E,P>::edge_remove_unreferenced(const uint eid)
     edge_switch_id(eid, this->num_edges()-1);
     this->edges.resize(this->edges.size()-2);
     this->e_data.pop_back();
+    this->e_props.pop_back();
     this->e2p.pop_back();
 }
 
@@ -1358,6 +1412,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 const std::vector<uint> & AbstractPolygonMesh<M,V,E,P>::poly_tessellation(const uint pid) const
 {
+    if(poly_is_own_tessellation(pid)) return this->polys.at(pid);
     return poly_triangles.at(pid);
 }
 
@@ -1425,6 +1480,7 @@ void AbstractPolygonMesh<M,V,E,P>::poly_switch_id(const uint pid0, const uint pi
 
     std::swap(this->polys.at(pid0),          this->polys.at(pid1));
     std::swap(this->p_data.at(pid0),         this->p_data.at(pid1));
+    this->p_props.swap(pid0,pid1);
     std::swap(this->p2e.at(pid0),            this->p2e.at(pid1));
     std::swap(this->p2p.at(pid0),            this->p2p.at(pid1));
     std::swap(this->poly_triangles.at(pid0), this->poly_triangles.at(pid1));
@@ -1489,6 +1545,7 @@ uint AbstractPolygonMesh<M,V,E,P>::poly_add(const std::vector<uint> & vlist)
 
     P data;
     this->p_data.push_back(data);
+    this->p_props.push_back();
 
     this->p2e.push_back(std::vector<uint>());
     this->p2p.push_back(std::vector<uint>());
@@ -1614,6 +1671,7 @@ void AbstractPolygonMesh<M,V,E,P>::poly_remove_unreferenced(const uint pid)
     poly_switch_id(pid, this->num_polys()-1);
     this->polys.pop_back();
     this->p_data.pop_back();
+    this->p_props.pop_back();
     this->p2e.pop_back();
     this->p2p.pop_back();
     this->poly_triangles.pop_back();
@@ -1730,7 +1788,7 @@ void AbstractPolygonMesh<M,V,E,P>::operator+=(const AbstractPolygonMesh<M,V,E,P>
         this->p2p.push_back(tmp);
 
         tmp.clear();
-        for(uint vid : m.poly_tessellation(pid)) tmp.push_back(nv + vid);
+        for(uint vid : m.poly_triangles.at(pid)) tmp.push_back(nv + vid);
         this->poly_triangles.push_back(tmp);
     }
     for(uint eid=0; eid<m.num_edges(); ++eid)
@@ -1762,6 +1820,10 @@ void AbstractPolygonMesh<M,V,E,P>::operator+=(const AbstractPolygonMesh<M,V,E,P>
         this->v2v.push_back(tmp);
     }
 
+    this->v_props.append(m.v_props, m.num_verts());
+    this->e_props.append(m.e_props, m.num_edges());
+    this->p_props.append(m.p_props, m.num_polys());
+
     if(this->mesh_data().update_bbox) this->update_bbox();
 
     std::cout << "Appended " << m.mesh_data().filename << " to mesh " << this->mesh_data().filename << std::endl;
@@ -1772,6 +1834,34 @@ void AbstractPolygonMesh<M,V,E,P>::operator+=(const AbstractPolygonMesh<M,V,E,P>
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+bool AbstractPolygonMesh<M,V,E,P>::ray_pick_poly(const vec3d & orig, const vec3d & dir, uint & pid) const
+{
+    double t;
+    return this->pick_index_polys().first_hit(orig, dir, [&](const uint id, double & t_hit)
+    {
+        if(this->poly_data(id).flags[HIDDEN]) return false;
+        const std::vector<uint> & tris = this->poly_tessellation(id);
+        bool found = false;
+        for(uint i=0; i+2<tris.size(); i+=3)
+        {
+            bool   backside, coplanar;
+            double t_tri;
+            vec3d  bary;
+            if(Moller_Trumbore_intersection(orig, dir, this->vert(tris.at(i)), this->vert(tris.at(i+1)), this->vert(tris.at(i+2)),
+                                            backside, coplanar, t_tri, bary) && (!found || t_tri<t_hit))
+            {
+                t_hit = t_tri;
+                found = true;
+            }
+        }
+        return found;
+    }, pid, t);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 std::vector<uint> AbstractPolygonMesh<M,V,E,P>::get_ordered_boundary_vertices() const
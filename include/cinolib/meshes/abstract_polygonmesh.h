@@ -53,7 +53,15 @@ class AbstractPolygonMesh : public AbstractMesh<M,V,E,P>
     protected:
 
         std::vector<std::vector<uint>> poly_triangles; // triangles covering each quad. Useful for
-                                                       // robust normal estimation and rendering
+                                                       // robust normal estimation and rendering.
+                                                       // Left empty for the triangles of a Trimesh,
+                                                       // which are their own tessellation (see poly_tessellation)
+
+        // note: Trimesh hardcodes verts_per_poly to 3, hence the actual poly size is checked
+        bool poly_is_own_tessellation(const uint pid) const
+        {
+            return this->mesh_type()==TRIMESH && this->polys.at(pid).size()==3;
+        }
 
     public:
 
@@ -88,6 +96,7 @@ class AbstractPolygonMesh : public AbstractMesh<M,V,E,P>
                 void update_p_tessellations();
                 void update_p_normals();
                 void update_v_normals();
+                void update_dirty() override;
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -109,6 +118,11 @@ class AbstractPolygonMesh : public AbstractMesh<M,V,E,P>
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+        // useful for GUIs with mouse picking: first non HIDDEN poly hit by the ray R(t) := orig + t * dir
+        bool ray_pick_poly(const vec3d & orig, const vec3d & dir, uint & pid) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
         std::vector<uint>  get_boundary_vertices()         const;
         std::vector<uint>  get_ordered_boundary_vertices() const;
         std::vector<ipair> get_boundary_edges()            const;
@@ -36,6 +36,9 @@
 #include <cinolib/meshes/abstract_polyhedralmesh.h>
 #include <cinolib/geometry/triangle.h>
 #include <cinolib/geometry/polygon_utils.h>
+#include <cinolib/Moller_Trumbore_intersection.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/stl_container_utilities.h>
 #include <cinolib/how_many_seconds.h>
 #include <unordered_set>
 #include <unordered_map>
@@ -56,6 +59,7 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::clear()
     polys_face_winding.clear();
     //
     f_data.clear();
+    f_props.resize(0);
     //
     v2f.clear();
     e2f.clear();
@@ -98,9 +102,13 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::init(const std::vector<vec3d>
     this->p2e.reserve(np);
     this->p2p.reserve(np);
     this->v_data.reserve(nv);
+    this->v_props.reserve(nv);
     this->e_data.reserve(ne);
+    this->e_props.reserve(ne);
     this->f_data.reserve(nf);
+    this->f_props.reserve(nf);
     this->p_data.reserve(np);
+    this->p_props.reserve(np);
     this->face_triangles.reserve(nf);
     this->polys_face_winding.reserve(np);
 
@@ -143,7 +151,9 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::init(const std::vector<vec3d>
     this->p2e.reserve(np);
     this->p2p.reserve(np);
     this->v_data.reserve(nv);
+    this->v_props.reserve(nv);
     this->p_data.reserve(np);
+    this->p_props.reserve(np);
     this->polys_face_winding.reserve(np);
 
     for(auto v : verts) vert_add(v);
@@ -355,10 +365,10 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::update_f_normals()
 {
-    for(uint fid=0; fid<num_faces(); ++fid)
+    PARALLEL_FOR(0, num_faces(), 1000, [this](const uint fid)
     {
         update_f_normal(fid);
-    }
+    });
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -368,10 +378,10 @@ CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::update_f_tessellation()
 {
     this->face_triangles.resize(this->num_faces());
-    for(uint fid=0; fid<this->num_faces(); ++fid)
+    PARALLEL_FOR(0, this->num_faces(), 1000, [this](const uint fid)
     {
         update_f_tessellation(fid);
-    }
+    });
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -383,6 +393,7 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::update_f_tessellation(const uint fid)
     // Assume convexity and try trivial tessellation first. If something flips
     // apply earcut algorithm to get a valid triangulation
 
+    face_triangles.at(fid).clear();
     std::vector<vec3d> n;
     for (uint i=2; i<this->verts_per_face(fid); ++i)
     {
@@ -427,10 +438,49 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::update_v_normals()
 {
-    for(uint vid=0; vid<this->num_verts(); ++vid)
+    PARALLEL_FOR(0, this->num_verts(), 1000, [this](const uint vid)
     {
         if(vert_is_on_srf(vid)) update_v_normal(vid);
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void AbstractPolyhedralMesh<M,V,E,F,P>::update_dirty()
+{
+    if(this->dirty_verts.empty()) return;
+
+    // faces incident to dirty verts, and surface verts whose normal depends on them
+    std::vector<uint> fids, vids;
+    for(uint vid : this->dirty_verts)
+    {
+        if(vid>=this->num_verts()) continue; // removed in the meanwhile
+        fids.insert(fids.end(), adj_v2f(vid).begin(), adj_v2f(vid).end());
     }
+    REMOVE_DUPLICATES_FROM_VEC(fids);
+    for(uint fid : fids)
+    {
+        if(face_is_on_srf(fid)) vids.insert(vids.end(), adj_f2v(fid).begin(), adj_f2v(fid).end());
+    }
+    REMOVE_DUPLICATES_FROM_VEC(vids);
+    this->dirty_verts.clear();
+
+    bool normals = this->mesh_data().update_normals;
+    PARALLEL_FOR(0, fids.size(), 1000, [&](const uint i)
+    {
+        update_f_tessellation(fids.at(i));
+        if(normals) update_f_normal(fids.at(i));
+    });
+    if(normals)
+    {
+        PARALLEL_FOR(0, vids.size(), 1000, [&](const uint i)
+        {
+            update_v_normal(vids.at(i));
+        });
+    }
+    if(this->mesh_data().update_bbox) this->update_bbox();
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -518,7 +568,7 @@ int AbstractPolyhedralMesh<M,V,E,F,P>::genus() const
 
 template<class M, class V, class E, class F, class P>
 CINO_INLINE
-std::vector<uint> AbstractPolyhedralMesh<M,V,E,F,P>::face_tessellation(const uint fid) const
+const std::vector<uint> & AbstractPolyhedralMesh<M,V,E,F,P>::face_tessellation(const uint fid) const
 {
     return face_triangles.at(fid);
 }
@@ -932,6 +982,7 @@ uint AbstractPolyhedralMesh<M,V,E,F,P>::edge_split(const uint eid, const vec3d &
         uint new_fid = this->face_add(f);
         fmap[fid] = new_fid;
         this->face_data(new_fid) = this->face_data(fid);
+        this->f_props.copy(fid,new_fid);
     }
 
     // update the polys incident to eid
@@ -945,6 +996,7 @@ uint AbstractPolyhedralMesh<M,V,E,F,P>::edge_split(const uint eid, const vec3d &
         }
         uint new_pid = this->poly_add(f,w);
         this->poly_data(new_pid) = this->poly_data(pid);
+        this->p_props.copy(pid,new_pid);
     }
 
     // remove the old elements
@@ -1978,6 +2030,7 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::vert_switch_id(const uint vid0, const ui
     std::swap(this->v2f.at(vid0),     this->v2f.at(vid1));
     std::swap(this->v2p.at(vid0),     this->v2p.at(vid1));
     std::swap(this->v_data.at(vid0),  this->v_data.at(vid1));
+    this->v_props.swap(vid0,vid1);
 
     std::unordered_set<uint> verts_to_update;
     verts_to_update.insert(this->adj_v2v(vid0).begin(), this->adj_v2v(vid0).end());
@@ -2060,6 +2113,7 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::vert_remove_unreferenced(const uint vid)
     vert_switch_id(vid, this->num_verts()-1);
     this->verts.pop_back();
     this->v_data.pop_back();
+    this->v_props.pop_back();
     this->v2v.pop_back();
     this->v2e.pop_back();
     this->v2f.pop_back();
@@ -2078,6 +2132,7 @@ uint AbstractPolyhedralMesh<M,V,E,F,P>::vert_add(const vec3d & pos)
     //
     V data;
     this->v_data.push_back(data);
+    this->v_props.push_back();
     assert(this->verts.size() == this->v_data.size());
     //
     this->v2v.push_back(std::vector<uint>());
@@ -2104,6 +2159,7 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::edge_switch_id(const uint eid0, const ui
     std::swap(this->e2f.at(eid0),     this->e2f.at(eid1));
     std::swap(this->e2p.at(eid0),     this->e2p.at(eid1));
     std::swap(this->e_data.at(eid0),  this->e_data.at(eid1));
+    this->e_props.swap(eid0,eid1);
 
     std::unordered_set<uint> verts_to_update;
     verts_to_update.insert(this->edge_vert_id(eid0,0));
@@ -2169,6 +2225,7 @@ uint AbstractPolyhedralMesh<M,V,E,F,P>::edge_add(const uint vid0, const uint vid
     //
     E data;
     this->e_data.push_back(data);
+    this->e_props.push_back();
     assert(this->edges.size()/2 == this->e_data.size());
     //
     this->v2v.at(vid1).push_back(vid0);
@@ -2200,6 +2257,7 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::edge_remove_unreferenced(const uint eid)
     edge_switch_id(eid, this->num_edges()-1);
     this->edges.resize(this->edges.size()-2);
     this->e_data.pop_back();
+    this->e_props.pop_back();
     this->e2f.pop_back();
     this->e2p.pop_back();
 }
@@ -2216,6 +2274,7 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::face_switch_id(const uint fid0, const ui
 
     std::swap(this->faces.at(fid0),          this->faces.at(fid1));
     std::swap(this->f_data.at(fid0),         this->f_data.at(fid1));
+    this->f_props.swap(fid0,fid1);
     std::swap(this->f2e.at(fid0),            this->f2e.at(fid1));
     std::swap(this->f2f.at(fid0),            this->f2f.at(fid1));
     std::swap(this->f2p.at(fid0),            this->f2p.at(fid1));
@@ -2294,6 +2353,7 @@ uint AbstractPolyhedralMesh<M,V,E,F,P>::face_add(const std::vector<uint> & f)
 
     F data;
     this->f_data.push_back(data);
+    this->f_props.push_back();
     assert(this->faces.size() == this->f_data.size());
 
     this->f2e.push_back(std::vector<uint>());
@@ -2364,6 +2424,7 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::face_remove_unreferenced(const uint fid)
     face_switch_id(fid, this->num_faces()-1);
     this->faces.pop_back();
     this->f_data.pop_back();
+    this->f_props.pop_back();
     this->f2e.pop_back();
     this->f2f.pop_back();
     this->f2p.pop_back();
@@ -2380,6 +2441,7 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::poly_switch_id(const uint pid0, const ui
 
     std::swap(this->polys.at(pid0),              this->polys.at(pid1));
     std::swap(this->p_data.at(pid0),             this->p_data.at(pid1));
+    this->p_props.swap(pid0,pid1);
     std::swap(this->p2v.at(pid0),                this->p2v.at(pid1));
     std::swap(this->p2e.at(pid0),                this->p2e.at(pid1));
     std::swap(this->p2p.at(pid0),                this->p2p.at(pid1));
@@ -2461,6 +2523,7 @@ uint AbstractPolyhedralMesh<M,V,E,F,P>::poly_add(const std::vector<uint> & flist
 
     P data;
     this->p_data.push_back(data);
+    this->p_props.push_back();
     assert(this->polys.size() == this->p_data.size());
 
     this->p2v.push_back(std::vector<uint>());
@@ -2772,6 +2835,7 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::poly_remove_unreferenced(const uint pid)
     poly_switch_id(pid, this->num_polys()-1);
     this->polys.pop_back();
     this->p_data.pop_back();
+    this->p_props.pop_back();
     this->p2v.pop_back();
     this->p2e.pop_back();
     this->p2p.pop_back();
@@ -3095,15 +3159,71 @@ std::vector<bool> AbstractPolyhedralMesh<M,V,E,F,P>::poly_faces_winding(const ui
 
 template<class M, class V, class E, class F, class P>
 CINO_INLINE
-uint AbstractPolyhedralMesh<M,V,E,F,P>::pick_face(const vec3d & p) const
+const PickingIndex & AbstractPolyhedralMesh<M,V,E,F,P>::pick_index_faces() const
 {
-    std::vector<std::pair<double,uint>> closest;
-    for(uint fid=0; fid<this->num_faces(); ++fid)
+    if(pick_index_f.size()!=this->num_faces())
     {
-        if(!this->face_data(fid).flags[HIDDEN]) closest.push_back(std::make_pair(this->face_centroid(fid).dist(p),fid));
+        std::vector<AABB>  boxes(this->num_faces());
+        std::vector<vec3d> points(this->num_faces());
+        PARALLEL_FOR(0, this->num_faces(), 10000, [&](const uint fid)
+        {
+            points.at(fid) = this->face_centroid(fid);
+            boxes.at(fid)  = AABB(this->face_verts(fid));
+        });
+        pick_index_f.build(boxes, points);
     }
-    std::sort(closest.begin(), closest.end());
-    return closest.front().second;
+    return pick_index_f;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+uint AbstractPolyhedralMesh<M,V,E,F,P>::pick_face(const vec3d & p) const
+{
+    uint   id;
+    double dist;
+    if(!pick_index_faces().closest(p, [this](const uint fid){ return !this->face_data(fid).flags[HIDDEN]; }, id, dist)) return 0;
+    return id;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+bool AbstractPolyhedralMesh<M,V,E,F,P>::ray_pick_face(const vec3d & orig, const vec3d & dir, uint & fid) const
+{
+    double t;
+    return pick_index_faces().first_hit(orig, dir, [&](const uint id, double & t_hit)
+    {
+        uint pid_beneath;
+        if(!this->face_is_visible(id, pid_beneath)) return false;
+        const std::vector<uint> & tris = this->face_triangles.at(id);
+        bool found = false;
+        for(uint i=0; i+2<tris.size(); i+=3)
+        {
+            bool   backside, coplanar;
+            double t_tri;
+            vec3d  bary;
+            if(Moller_Trumbore_intersection(orig, dir, this->vert(tris.at(i)), this->vert(tris.at(i+1)), this->vert(tris.at(i+2)),
+                                            backside, coplanar, t_tri, bary) && (!found || t_tri<t_hit))
+            {
+                t_hit = t_tri;
+                found = true;
+            }
+        }
+        return found;
+    }, fid, t);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+void AbstractPolyhedralMesh<M,V,E,F,P>::pick_invalidate()
+{
+    AbstractMesh<M,V,E,P>::pick_invalidate();
+    pick_index_f.clear();
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -56,6 +56,7 @@ class AbstractPolyhedralMesh : public AbstractMesh<M,V,E,P>
         std::vector<std::vector<bool>> polys_face_winding; // true if the face is CCW, false if it is CW
 
         std::vector<F> f_data;
+        PropertySet    f_props; // opt-in per-element properties (see mesh_properties.h)
 
         std::vector<std::vector<uint>> v2f; // vert to face adjacency
         std::vector<std::vector<uint>> e2f; // edge to face adjacency
@@ -66,6 +67,10 @@ class AbstractPolyhedralMesh : public AbstractMesh<M,V,E,P>
 
         std::vector<std::vector<uint>> face_triangles; // per face serialized triangulation (e.g., for rendering)
 
+        mutable PickingIndex pick_index_f; // spatial index for mouse picking (see AbstractMesh::pick_invalidate)
+
+        const PickingIndex & pick_index_faces() const;
+
     public:
 
         typedef F F_type;
@@ -115,6 +120,7 @@ class AbstractPolyhedralMesh : public AbstractMesh<M,V,E,P>
                 void update_v_normal(const uint vid);
                 void update_quality();
                 void update_p_quality(const uint pid);
+                void update_dirty() override;
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -169,10 +175,18 @@ class AbstractPolyhedralMesh : public AbstractMesh<M,V,E,P>
         const F & face_data(const uint fid) const { return f_data.at(fid); }
               F & face_data(const uint fid)       { return f_data.at(fid); }
 
+        template<typename T>       std::vector<T> & face_add_property(const std::string & name, const T & def = T()) { return f_props.add<T>(name, num_faces(), def); }
+        template<typename T>       std::vector<T> & face_property(const std::string & name)                         { return f_props.get<T>(name); }
+        template<typename T> const std::vector<T> & face_property(const std::string & name) const                   { return f_props.get<T>(name); }
+                                   bool             face_has_property(const std::string & name) const               { return f_props.has(name); }
+                                   void             face_remove_property(const std::string & name)                  { f_props.remove(name); }
+
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        // useful for GUIs with mouse picking
-        uint pick_face(const vec3d & p) const;
+        // useful for GUIs with mouse picking (ray picking returns the first visible face hit by the ray R(t) := orig + t * dir)
+        uint pick_face      (const vec3d & p) const;
+        bool ray_pick_face  (const vec3d & orig, const vec3d & dir, uint & fid) const;
+        void pick_invalidate() override;
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -254,7 +268,7 @@ class AbstractPolyhedralMesh : public AbstractMesh<M,V,E,P>
                 uint               face_add                   (const std::vector<uint> & f);
                 void               face_remove                (const uint fid);
                 void               face_remove_unreferenced   (const uint fid);
-                std::vector<uint>  face_tessellation          (const uint fid) const;
+          const std::vector<uint> & face_tessellation          (const uint fid) const;
                 bool               face_is_visible            (const uint fid, uint & pid_beneath) const;
                 void               face_apply_labels          (const std::vector<int> & labels);
                 void               face_apply_label           (const int label);
@@ -36,9 +36,10 @@
 #ifndef CINO_DRAWABLE_TRIMESH_H
 #define CINO_DRAWABLE_TRIMESH_H
 
+#include <cinolib/meshes/trimesh.h>
+
 #ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
 
-#include <cinolib/meshes/trimesh.h>
 #include <cinolib/meshes/abstract_drawable_polygonmesh.h>
 
 namespace cinolib
@@ -113,4 +114,21 @@ class DrawableTrimesh : public AbstractDrawablePolygonMesh<Trimesh<M,V,E,P>>
 
 #endif // #ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
 
+namespace cinolib
+{
+
+// a DrawableTrimesh if the GUI is enabled, a plain Trimesh otherwise. Algorithms
+// that store their meshes in this type can be visualized, but also run headless
+template<class M = Mesh_std_attributes,
+         class V = Vert_std_attributes,
+         class E = Edge_std_attributes,
+         class P = Polygon_std_attributes>
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
+using MaybeDrawableTrimesh = DrawableTrimesh<M,V,E,P>;
+#else
+using MaybeDrawableTrimesh = Trimesh<M,V,E,P>;
+#endif
+
+}
+
 #endif // CINO_DRAWABLE_TRIMESH_H
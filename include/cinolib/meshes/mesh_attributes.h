@@ -68,6 +68,10 @@ namespace cinolib
  * Tetmesh<M,V,E,F,P>        my_tetmesh;
  * Hexmesh<M,V,E,F,P>        my_hexmesh;
  * Polyhedralmesh<M,V,E,F,P> my_hexmesh;
+ *
+ * Attributes that are needed only by some algorithms can alternatively be
+ * added at runtime as named properties, which are stored in separate arrays
+ * and can be dropped when no longer needed (see mesh_properties.h)
 */
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
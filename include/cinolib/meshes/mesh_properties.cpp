@@ -0,0 +1,265 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/meshes/mesh_properties.h>
+#include <iostream>
+#include <cassert>
+
+namespace cinolib
+{
+
+template<typename T>
+CINO_INLINE
+void Property<T>::reserve(const uint n)
+{
+    data.reserve(n);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+void Property<T>::resize(const uint n)
+{
+    data.resize(n,def);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+void Property<T>::push_back()
+{
+    data.push_back(def);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+void Property<T>::pop_back()
+{
+    data.pop_back();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+void Property<T>::swap(const uint i, const uint j)
+{
+    // (not std::swap, as std::vector<bool> returns proxies)
+    T tmp = data.at(i);
+    data.at(i) = data.at(j);
+    data.at(j) = tmp;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+void Property<T>::copy(const uint from, const uint to)
+{
+    data.at(to) = data.at(from);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+void Property<T>::append(const AbstractProperty * src)
+{
+    assert(src==nullptr || src->type()==typeid(T));
+    if(src==nullptr) return;
+    const std::vector<T> & src_data = static_cast<const Property<T>*>(src)->data;
+    data.insert(data.end(), src_data.begin(), src_data.end());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+PropertySet::PropertySet(const PropertySet & ps)
+{
+    *this = ps;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+PropertySet & PropertySet::operator=(const PropertySet & ps)
+{
+    if(this == &ps) return *this;
+    props.clear();
+    for(const auto & p : ps.props) props[p.first].reset(p.second->clone());
+    return *this;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+std::vector<T> & PropertySet::add(const std::string & name, const uint n, const T & def)
+{
+    auto it = props.find(name);
+    if(it!=props.end())
+    {
+        if(it->second->type()!=typeid(T))
+        {
+            std::cerr << "ERROR : property " << name << " already exists with a different type" << std::endl;
+            exit(-1);
+        }
+        return static_cast<Property<T>*>(it->second.get())->data;
+    }
+    Property<T> *p = new Property<T>(n,def);
+    props[name].reset(p);
+    return p->data;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+std::vector<T> & PropertySet::get(const std::string & name)
+{
+    return static_cast<Property<T>*>(find(name, typeid(T)))->data;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+CINO_INLINE
+const std::vector<T> & PropertySet::get(const std::string & name) const
+{
+    return static_cast<const Property<T>*>(find(name, typeid(T)))->data;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+AbstractProperty * PropertySet::find(const std::string & name, const std::type_info & type) const
+{
+    auto it = props.find(name);
+    if(it==props.end())
+    {
+        std::cerr << "ERROR : property " << name << " does not exist" << std::endl;
+        exit(-1);
+    }
+    if(it->second->type()!=type)
+    {
+        std::cerr << "ERROR : property " << name << " has a different type" << std::endl;
+        exit(-1);
+    }
+    return it->second.get();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+std::vector<std::string> PropertySet::names() const
+{
+    std::vector<std::string> res;
+    for(const auto & p : props) res.push_back(p.first);
+    return res;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void PropertySet::reserve(const uint n)
+{
+    for(auto & p : props) p.second->reserve(n);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void PropertySet::resize(const uint n)
+{
+    for(auto & p : props) p.second->resize(n);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void PropertySet::push_back()
+{
+    for(auto & p : props) p.second->push_back();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void PropertySet::pop_back()
+{
+    for(auto & p : props) p.second->pop_back();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void PropertySet::swap(const uint i, const uint j)
+{
+    for(auto & p : props) p.second->swap(i,j);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void PropertySet::copy(const uint from, const uint to)
+{
+    for(auto & p : props) p.second->copy(from,to);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void PropertySet::append(const PropertySet & ps, const uint n)
+{
+    for(auto & p : props)
+    {
+        uint size = p.second->size();
+        auto it   = ps.props.find(p.first);
+        if(it!=ps.props.end() && it->second->type()==p.second->type())
+        {
+            assert(it->second->size()==n);
+            p.second->append(it->second.get());
+        }
+        else p.second->resize(size+n);
+    }
+}
+
+}
@@ -0,0 +1,170 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_MESH_PROPERTIES_H
+#define CINO_MESH_PROPERTIES_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <typeinfo>
+#include <sys/types.h>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Opt-in per-element properties: named and typed arrays that can be attached to
+ * a mesh at runtime, and dropped when no longer needed. Each property is a single
+ * contiguous array, convenient for algorithm-specific data that does not belong
+ * in the attribute structs (e.g. a partition id, a scalar field being computed).
+ *
+ * Meshes keep one PropertySet per element type, and update it every time an
+ * element is added, removed or re-indexed, so that properties always have as
+ * many entries as the elements they refer to. Example:
+ *
+ *    std::vector<int> & part = m.vert_add_property<int>("part", -1);
+ *    for(uint vid=0; vid<m.num_verts(); ++vid) part.at(vid) = ...;
+ *    ...
+ *    m.vert_remove_property("part");
+ *
+ * Properties do NOT replace the attribute structs in mesh_attributes.h, which are
+ * still stored as an array of structures and allocated for every element (e.g.
+ * m.vert_data(vid).label). A mesh with no properties only pays for the empty sets.
+*/
+
+class AbstractProperty
+{
+    public:
+
+        virtual ~AbstractProperty() {}
+
+        virtual const std::type_info & type() const = 0;
+        virtual uint size() const = 0;
+
+        virtual void reserve(const uint n) = 0;
+        virtual void resize(const uint n) = 0;
+        virtual void push_back() = 0;
+        virtual void pop_back() = 0;
+        virtual void swap(const uint i, const uint j) = 0;
+        virtual void copy(const uint from, const uint to) = 0;
+        virtual void append(const AbstractProperty * src) = 0; // src is either of the same type or null
+
+        virtual AbstractProperty * clone() const = 0;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T>
+class Property : public AbstractProperty
+{
+    public:
+
+        explicit Property(const uint n, const T & def) : data(n,def), def(def) {}
+
+        const std::type_info & type() const override { return typeid(T); }
+        uint size() const override { return (uint)data.size(); }
+
+        void reserve(const uint n) override;
+        void resize(const uint n) override;
+        void push_back() override;
+        void pop_back() override;
+        void swap(const uint i, const uint j) override;
+        void copy(const uint from, const uint to) override;
+        void append(const AbstractProperty * src) override;
+
+        AbstractProperty * clone() const override { return new Property<T>(*this); }
+
+        std::vector<T> data;
+        T              def; // value assigned to newly created elements
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class PropertySet
+{
+    public:
+
+        explicit PropertySet() {}
+
+        PropertySet(const PropertySet & ps);
+        PropertySet & operator=(const PropertySet & ps);
+        PropertySet(PropertySet &&) = default;
+        PropertySet & operator=(PropertySet &&) = default;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // adds a property with n entries initialized to def. If a property with
+        // the same name and type already exists it is returned as is
+        template<typename T>
+        std::vector<T> & add(const std::string & name, const uint n, const T & def = T());
+
+        template<typename T>       std::vector<T> & get(const std::string & name);
+        template<typename T> const std::vector<T> & get(const std::string & name) const;
+
+        bool has(const std::string & name) const { return props.count(name)>0; }
+        void remove(const std::string & name) { props.erase(name); }
+        std::vector<std::string> names() const;
+        bool empty() const { return props.empty(); }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // element bookkeeping (applied to all properties)
+        void reserve(const uint n);
+        void resize(const uint n);
+        void push_back();
+        void pop_back();
+        void swap(const uint i, const uint j);
+        void copy(const uint from, const uint to);
+
+        // appends the entries of another set (e.g. when two meshes are merged). Properties
+        // that are not in ps, or have different type in ps, are padded with their defaults
+        void append(const PropertySet & ps, const uint n);
+
+    protected:
+
+        AbstractProperty * find(const std::string & name, const std::type_info & type) const;
+
+        std::map<std::string,std::unique_ptr<AbstractProperty>> props;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "mesh_properties.cpp"
+#endif
+
+#endif // CINO_MESH_PROPERTIES_H
@@ -34,6 +34,10 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/meshes/mesh_slicer.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/stl_container_utilities.h>
+#include <algorithm>
+#include <numeric>
 #include <sstream>
 
 namespace cinolib
@@ -96,32 +100,175 @@ std::string MeshSlicer::serialize() const
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+CINO_INLINE
+void MeshSlicer::invalidate()
+{
+    cache_mesh = nullptr;
+    cache_np   = 0;
+    for(int i=0; i<4; ++i)
+    {
+        sorted_pids[i].clear();
+        sorted_vals[i].clear();
+    }
+    fail_mask.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 void MeshSlicer::slice(AbstractMesh<M,V,E,P> & m)
 {
-    double X_abs_thresh = m.bbox().min[0] + m.bbox().delta()[0] * (X_thresh);
-    double Y_abs_thresh = m.bbox().min[1] + m.bbox().delta()[1] * (Y_thresh);
-    double Z_abs_thresh = m.bbox().min[2] + m.bbox().delta()[2] * (Z_thresh);
+    std::vector<uint> changed_pids;
+    slice(m, changed_pids);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void MeshSlicer::slice(AbstractMesh<M,V,E,P> & m, std::vector<uint> & changed_pids)
+{
+    changed_pids.clear();
 
-    for(uint pid=0; pid<m.num_polys(); ++pid)
+    double thresh[4] =
     {
-        vec3d c = m.poly_centroid(pid);
-        float q = m.poly_data(pid).quality;
-        int   l = m.poly_data(pid).label;
+        m.bbox().min[0] + m.bbox().delta()[0] * (X_thresh),
+        m.bbox().min[1] + m.bbox().delta()[1] * (Y_thresh),
+        m.bbox().min[2] + m.bbox().delta()[2] * (Z_thresh),
+        Q_thresh
+    };
+    bool leq[4] = { X_leq, Y_leq, Z_leq, Q_leq };
 
-        bool pass_X = (X_leq) ? (c.x() <= X_abs_thresh) : (c.x() >= X_abs_thresh);
-        bool pass_Y = (Y_leq) ? (c.y() <= Y_abs_thresh) : (c.y() >= Y_abs_thresh);
-        bool pass_Z = (Z_leq) ? (c.z() <= Z_abs_thresh) : (c.z() >= Z_abs_thresh);
-        bool pass_Q = (Q_leq) ? (q     <= Q_thresh    ) : (q     >= Q_thresh);
-        bool pass_L = (L_is ) ? (L_filter==-1 || l == L_filter) : (L_filter == -1 || l != L_filter);
+    auto pass = [&](const int axis, const double val) -> bool
+    {
+        return (leq[axis]) ? (val <= thresh[axis]) : (val >= thresh[axis]);
+    };
+    auto pass_L = [&](const uint pid) -> bool
+    {
+        int l = m.poly_data(pid).label;
+        return (L_is) ? (L_filter==-1 || l == L_filter) : (L_filter == -1 || l != L_filter);
+    };
+
+    // polys whose tests must be re-evaluated (per axis) and polys whose HIDDEN flag may change
+    std::vector<uint> candidates;
+    bool all_candidates = false;
+
+    if(cache_mesh!=(const void*)&m || cache_np!=m.num_polys())
+    {
+        invalidate();
+        cache_mesh = (const void*)&m;
+        cache_np   = m.num_polys();
 
-        bool b = (mode_AND) ? ( pass_X &&  pass_Y &&  pass_Z &&  pass_L &&  pass_Q)
-                            : (!pass_X || !pass_Y || !pass_Z || !pass_L || !pass_Q);
+        std::vector<vec3d> centroids(m.num_polys());
+        PARALLEL_FOR(0, m.num_polys(), 1000, [&](const uint pid)
+        {
+            centroids.at(pid) = m.poly_centroid(pid);
+        });
+        PARALLEL_FOR(0, 4, 1, [&](const uint axis)
+        {
+            std::vector<uint> & pids = sorted_pids[axis];
+            std::vector<double> key(m.num_polys());
+            for(uint pid=0; pid<m.num_polys(); ++pid)
+            {
+                key.at(pid) = (axis<3) ? centroids.at(pid)[axis] : m.poly_data(pid).quality;
+            }
+            pids.resize(m.num_polys());
+            std::iota(pids.begin(), pids.end(), 0);
+            std::sort(pids.begin(), pids.end(), [&](const uint a, const uint b) { return key.at(a) < key.at(b); });
+            sorted_vals[axis].resize(m.num_polys());
+            for(uint i=0; i<m.num_polys(); ++i) sorted_vals[axis].at(i) = key.at(pids.at(i));
+        });
 
-        m.poly_data(pid).flags[HIDDEN] = !b;
+        fail_mask.assign(m.num_polys(), 0);
+        for(int axis=0; axis<4; ++axis)
+        {
+            for(uint i=0; i<m.num_polys(); ++i)
+            {
+                if(!pass(axis, sorted_vals[axis].at(i))) fail_mask.at(sorted_pids[axis].at(i)) |= (1<<axis);
+            }
+        }
+        for(uint pid=0; pid<m.num_polys(); ++pid)
+        {
+            if(!pass_L(pid)) fail_mask.at(pid) |= (1<<4);
+        }
+        all_candidates = true;
+    }
+    else
+    {
+        for(int axis=0; axis<4; ++axis)
+        {
+            const std::vector<double> & vals = sorted_vals[axis];
+            uint beg = 0, end = 0;
+            if(leq[axis]!=last_leq[axis])
+            {
+                end = (uint)vals.size(); // every poly must be tested
+            }
+            else if(thresh[axis]!=last_thresh[axis])
+            {
+                // only polys with value between the old and new thresholds may flip
+                double lo = std::min(thresh[axis], last_thresh[axis]);
+                double hi = std::max(thresh[axis], last_thresh[axis]);
+                if(leq[axis]) // test flips for vals in (lo,hi]
+                {
+                    beg = uint(std::upper_bound(vals.begin(), vals.end(), lo) - vals.begin());
+                    end = uint(std::upper_bound(vals.begin(), vals.end(), hi) - vals.begin());
+                }
+                else // test flips for vals in [lo,hi)
+                {
+                    beg = uint(std::lower_bound(vals.begin(), vals.end(), lo) - vals.begin());
+                    end = uint(std::lower_bound(vals.begin(), vals.end(), hi) - vals.begin());
+                }
+            }
+            for(uint i=beg; i<end; ++i)
+            {
+                uint    pid  = sorted_pids[axis].at(i);
+                uint8_t mask = fail_mask.at(pid);
+                if(pass(axis, vals.at(i))) fail_mask.at(pid) &= ~(1<<axis);
+                else                       fail_mask.at(pid) |=  (1<<axis);
+                if(mask!=fail_mask.at(pid)) candidates.push_back(pid);
+            }
+        }
+        if(L_filter!=last_L_filter || L_is!=last_L_is)
+        {
+            for(uint pid=0; pid<m.num_polys(); ++pid)
+            {
+                uint8_t mask = fail_mask.at(pid);
+                if(pass_L(pid)) fail_mask.at(pid) &= ~(1<<4);
+                else            fail_mask.at(pid) |=  (1<<4);
+                if(mask!=fail_mask.at(pid)) candidates.push_back(pid);
+            }
+        }
+        if(mode_AND!=last_mode_AND) all_candidates = true;
+    }
 
-        //std::cout << pass_X << " " << pass_Y << " " << pass_Z << " " << pass_Q << " " << pass_L << std::endl;
+    for(int axis=0; axis<4; ++axis)
+    {
+        last_thresh[axis] = thresh[axis];
+        last_leq[axis]    = leq[axis];
+    }
+    last_L_filter = L_filter;
+    last_L_is     = L_is;
+    last_mode_AND = mode_AND;
+
+    // AND: visible if all tests pass. OR: visible if at least one test fails
+    auto update_flag = [&](const uint pid)
+    {
+        bool hidden = (mode_AND) ? (fail_mask.at(pid)!=0) : (fail_mask.at(pid)==0);
+        if(m.poly_data(pid).flags[HIDDEN]!=hidden)
+        {
+            m.poly_data(pid).flags[HIDDEN] = hidden;
+            changed_pids.push_back(pid);
+        }
+    };
+    if(all_candidates)
+    {
+        for(uint pid=0; pid<m.num_polys(); ++pid) update_flag(pid);
+    }
+    else
+    {
+        REMOVE_DUPLICATES_FROM_VEC(candidates);
+        for(uint pid : candidates) update_flag(pid);
     }
 }
 
@@ -37,6 +37,7 @@
 #define CINO_MESH_SLICER_H
 
 #include <cinolib/meshes/abstract_mesh.h>
+#include <cstdint>
 
 namespace cinolib
 {
@@ -73,8 +74,35 @@ class MeshSlicer
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+        // sets the HIDDEN flag of mesh polys according to the current thresholds.
+        // Slicing is incremental: polys are kept sorted by centroid coordinates and
+        // quality, and when a threshold moves only the polys between the old and the
+        // new cut are visited. The second version also returns the list of polys that
+        // changed visibility (e.g. to update rendering data with updateGL_polys).
+        // Polys are re-evaluated from scratch at the first call on a mesh, or if the
+        // number of polys changed; call invalidate() if the mesh geometry, quality or
+        // labels change, or if the HIDDEN flags are modified by someone else
         template<class M, class V, class E, class P>
         void slice(AbstractMesh<M,V,E,P> & m);
+
+        template<class M, class V, class E, class P>
+        void slice(AbstractMesh<M,V,E,P> & m, std::vector<uint> & changed_pids);
+
+        void invalidate();
+
+    protected:
+
+        // cached data for incremental slicing
+        const void          *cache_mesh = nullptr;
+        uint                 cache_np   = 0;
+        std::vector<uint>    sorted_pids[4]; // polys sorted by X,Y,Z centroid coordinates and quality
+        std::vector<double>  sorted_vals[4]; // the sorted values
+        std::vector<uint8_t> fail_mask;      // per poly bitmask of the tests that fail (X,Y,Z,Q,L)
+        double               last_thresh[4]; // last thresholds (X,Y,Z in absolute coordinates)
+        bool                 last_leq[4];
+        int                  last_L_filter;
+        bool                 last_L_is;
+        bool                 last_mode_AND;
 };
 
 }
@@ -246,6 +246,7 @@ uint Tetmesh<M,V,E,F,P>::edge_split(const uint eid, const uint split_point)
             if(this->poly_face_is_CCW(pid,fid)) std::swap(tet[1],tet[2]);
             uint new_pid = this->poly_add(tet);
             this->poly_data(new_pid) = this->poly_data(pid);
+            this->p_props.copy(pid,new_pid);
         }
     }
 
@@ -255,14 +256,18 @@ uint Tetmesh<M,V,E,F,P>::edge_split(const uint eid, const uint split_point)
     int  e0   = this->edge_id(vid0, split_point); assert(e0>=0);
     int  e1   = this->edge_id(vid1, split_point); assert(e1>=0);
     this->edge_data(e0) = this->edge_data(eid);
+    this->e_props.copy(eid,e0);
     this->edge_data(e1) = this->edge_data(eid);
+    this->e_props.copy(eid,e1);
     for(uint fid : this->adj_e2f(eid))
     {
         uint vopp = this->face_vert_opposite_to(fid,eid);
          int f0   = this->face_id({vid0,split_point,vopp}); assert(f0>=0);
          int f1   = this->face_id({vid1,split_point,vopp}); assert(f1>=0);
          this->face_data(f0) = this->face_data(fid);
+         this->f_props.copy(fid,f0);
          this->face_data(f1) = this->face_data(fid);
+         this->f_props.copy(fid,f1);
     }
 
     if(this->mesh_data().update_normals && this->vert_is_on_srf(split_point)) this->update_v_normal(split_point);
@@ -430,6 +435,7 @@ int Tetmesh<M,V,E,F,P>::edge_collapse(const uint eid, const vec3d & p, const dou
         vlist.at(off) = vert_to_keep;
         uint new_pid = this->poly_add(vlist);
         this->poly_data(new_pid) = this->poly_data(pid);
+        this->p_props.copy(pid,new_pid);
 
         if(this->mesh_data().update_normals)
         {
@@ -667,6 +673,7 @@ uint Tetmesh<M,V,E,F,P>::face_split(const uint fid, const vec3d & p)
             if(flip_face) std::swap(tet[1],tet[2]);
             uint new_pid = this->poly_add(tet);
             this->poly_data(new_pid) = this->poly_data(pid);
+            this->p_props.copy(pid,new_pid);
         }
     }
 
@@ -1057,6 +1064,7 @@ uint Tetmesh<M,V,E,F,P>::poly_split(const uint pid, const uint vid)
         if(this->poly_face_is_CCW(pid,fid)) std::swap(tet[1],tet[2]);
         uint new_pid = this->poly_add(tet);
         this->poly_data(new_pid) = this->poly_data(pid);
+        this->p_props.copy(pid,new_pid);
         this->update_p_quality(new_pid);
     }
 
@@ -251,6 +251,7 @@ uint Trimesh<M,V,E,P>::vert_split(const uint eid0, const uint eid1)
         for(uint & v : v_list) if(v==v0) v = v1;
         uint new_pid = this->poly_add(v_list);
         this->poly_data(new_pid) = this->poly_data(pid);
+        this->p_props.copy(pid,new_pid);
         if(this->mesh_data().update_normals) this->update_p_normal(new_pid);
     }
     if(this->mesh_data().update_normals) this->update_v_normal(v0);
@@ -300,6 +301,7 @@ int Trimesh<M,V,E,P>::edge_collapse(const uint eid, const double lambda, const b
         uint new_pid = this->poly_add(vlist);
 
         this->poly_data(new_pid) = this->poly_data(pid);
+        this->p_props.copy(pid,new_pid);
         if(this->mesh_data().update_normals) this->update_p_normal(new_pid);
     }
     if(this->mesh_data().update_normals) this->update_v_normal(vert_to_keep);
@@ -353,7 +355,9 @@ uint Trimesh<M,V,E,P>::edge_split(const uint eid, const uint v_split)
         uint new_pid1 = this->poly_add(v_opp, vid0, v_split);
         uint new_pid2 = this->poly_add(v_opp, v_split, vid1);
         this->poly_data(new_pid1) = this->poly_data(pid);
+        this->p_props.copy(pid,new_pid1);
         this->poly_data(new_pid2) = this->poly_data(pid);
+        this->p_props.copy(pid,new_pid2);
         if(this->mesh_data().update_normals) this->update_p_normal(new_pid1);
         if(this->mesh_data().update_normals) this->update_p_normal(new_pid2);
     }
@@ -363,7 +367,9 @@ uint Trimesh<M,V,E,P>::edge_split(const uint eid, const uint v_split)
     int eid0 = this->edge_id(vid0,v_split); assert(eid0>=0);
     int eid1 = this->edge_id(vid1,v_split); assert(eid1>=0);
     this->edge_data(eid0) = this->edge_data(eid);
+    this->e_props.copy(eid,eid0);
     this->edge_data(eid1) = this->edge_data(eid);
+    this->e_props.copy(eid,eid1);
 
     this->polys_remove(this->adj_e2p(eid));
     return v_split;
@@ -454,6 +460,7 @@ int Trimesh<M,V,E,P>::edge_flip(const uint eid, const bool geometric_check)
     // copy edge data
     int new_eid = this->edge_id(opp0,opp1); assert(new_eid>=0);
     this->edge_data(new_eid) = this->edge_data(eid);
+    this->e_props.copy(eid,new_eid);
 
     return new_eid;
 }
@@ -515,9 +522,9 @@ uint Trimesh<M,V,E,P>::poly_split(const uint pid, const vec3d & p)
         this->vert_add(p)
     };
     uint new_pid;
-    new_pid = poly_add(vids[0], vids[1], vids[3]); this->poly_data(new_pid) = this->poly_data(pid);
-    new_pid = poly_add(vids[1], vids[2], vids[3]); this->poly_data(new_pid) = this->poly_data(pid);
-    new_pid = poly_add(vids[2], vids[0], vids[3]); this->poly_data(new_pid) = this->poly_data(pid);
+    new_pid = poly_add(vids[0], vids[1], vids[3]); this->poly_data(new_pid) = this->poly_data(pid); this->p_props.copy(pid,new_pid);
+    new_pid = poly_add(vids[1], vids[2], vids[3]); this->poly_data(new_pid) = this->poly_data(pid); this->p_props.copy(pid,new_pid);
+    new_pid = poly_add(vids[2], vids[0], vids[3]); this->poly_data(new_pid) = this->poly_data(pid); this->p_props.copy(pid,new_pid);
     this->poly_remove(pid);
     return vids[3];
 }
@@ -478,50 +478,7 @@ bool Octree::intersects_ray(const vec3d & p, const vec3d & dir, double & min_t,
     typedef std::chrono::steady_clock Time;
     Time::time_point t0 = Time::now();
 
-    vec3d  pos;
-    double t=0.0;
-    if(root && !root->bbox.intersects_ray(p, dir, t, pos)) return false;
-    Obj obj;
-    obj.node = root;
-    obj.dist = t;
-
-    PrioQueue q;
-    q.push(obj);
-
-    while(!q.empty() && q.top().node->is_inner())
-    {
-        Obj obj = q.top();
-        q.pop();
-
-        for(int i=0; i<8; ++i)
-        {
-            OctreeNode *child = obj.node->children[i];
-            if(child->bbox.intersects_ray(p, dir, t, pos))
-            {
-                if(child->is_inner())
-                {
-                    Obj obj;
-                    obj.node = child;
-                    obj.dist = t;
-                    q.push(obj);
-                }
-                else
-                {
-                    for(uint i : child->item_indices)
-                    {
-                        if(items.at(i)->intersects_ray(p, dir, t, pos))
-                        {
-                            Obj obj;
-                            obj.node  = child;
-                            obj.index = items.at(i)->id;
-                            obj.dist  = t;
-                            q.push(obj);
-                        }
-                    }
-                }
-            }
-        }
-    }
+    bool found = first_hit(p, dir, 0, inf_double, nullptr, min_t, id);
 
     if(print_debug_info)
     {
@@ -529,11 +486,7 @@ bool Octree::intersects_ray(const vec3d & p, const vec3d & dir, double & min_t,
         std::cout << "Intersects ray\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
     }
 
-    if(q.empty()) return false;
-    assert(q.top().index>=0);
-    id    = items.at(q.top().index)->id;
-    min_t = q.top().dist;
-    return true;
+    return found;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -598,6 +551,174 @@ bool Octree::intersects_ray(const vec3d & p, const vec3d & dir, std::set<std::pa
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class LeafVisitor>
+CINO_INLINE
+void Octree::ray_traversal(const vec3d & p, const vec3d & dir, const double & t_max, LeafVisitor visit) const
+{
+    if(root==nullptr) return;
+
+    // nodes yet to visit, the closest one on top. Each step replaces a node with
+    // at most 8 children, hence the stack never exceeds 8*(depth+1) entries
+    RayNode              buf[256];
+    std::vector<RayNode> deep_tree;
+    RayNode             *stack = buf;
+    if(8*(tree_depth+1)>256)
+    {
+        deep_tree.resize(8*(tree_depth+1));
+        stack = deep_tree.data();
+    }
+
+    double t;
+    vec3d  pos;
+    if(!root->bbox.intersects_ray(p, dir, t, pos) || t>t_max) return;
+    uint size = 0;
+    stack[size++] = { root, t };
+
+    while(size>0)
+    {
+        RayNode curr = stack[--size];
+        if(curr.t>t_max) continue;
+
+        if(!curr.node->is_inner())
+        {
+            if(!visit(curr.node)) return;
+            continue;
+        }
+
+        RayNode children[8];
+        uint    n = 0;
+        for(int i=0; i<8; ++i)
+        {
+            const OctreeNode *child = curr.node->children[i];
+            if(child->bbox.intersects_ray(p, dir, t, pos) && t<=t_max) children[n++] = { child, t };
+        }
+        // push far to near, so that the nearest child is visited first
+        // (insertion sort: at most 8 elements, sorted by decreasing t)
+        for(uint i=1; i<n; ++i)
+        {
+            RayNode tmp = children[i];
+            uint    j   = i;
+            while(j>0 && children[j-1].t<tmp.t)
+            {
+                children[j] = children[j-1];
+                --j;
+            }
+            children[j] = tmp;
+        }
+        for(uint i=0; i<n; ++i) stack[size++] = children[i];
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Octree::first_hit(const vec3d                      & p,
+                       const vec3d                      & dir,
+                       const double                       t_min,
+                       const double                       t_max,
+                       const std::function<bool(uint)>  & skip,
+                             double                     & t,
+                             uint                       & id) const
+{
+    bool   found  = false;
+    double best_t = t_max;
+    ray_traversal(p, dir, best_t, [&](const OctreeNode *leaf)
+    {
+        for(uint i : leaf->item_indices)
+        {
+            const SpatialDataStructureItem *it = items[i];
+            double t_hit;
+            vec3d  pos;
+            if(skip && skip(it->id)) continue;
+            if(!it->intersects_ray(p, dir, t_hit, pos) || t_hit<t_min) continue;
+            if(t_hit<best_t || (!found && t_hit==best_t))
+            {
+                best_t = t_hit;
+                id     = it->id;
+                found  = true;
+            }
+        }
+        return true;
+    });
+    if(found) t = best_t;
+    return found;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Octree::any_hit(const vec3d                      & p,
+                     const vec3d                      & dir,
+                     const double                       t_min,
+                     const double                       t_max,
+                     const std::function<bool(uint)>  & skip) const
+{
+    bool found = false;
+    ray_traversal(p, dir, t_max, [&](const OctreeNode *leaf)
+    {
+        for(uint i : leaf->item_indices)
+        {
+            const SpatialDataStructureItem *it = items[i];
+            double t_hit;
+            vec3d  pos;
+            if(skip && skip(it->id)) continue;
+            if(it->intersects_ray(p, dir, t_hit, pos) && t_hit>=t_min && t_hit<=t_max)
+            {
+                found = true;
+                return false; // done
+            }
+        }
+        return true;
+    });
+    return found;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint Octree::k_nearest_hits(const vec3d                      & p,
+                            const vec3d                      & dir,
+                            const double                       t_min,
+                            const double                       t_max,
+                            const std::function<bool(uint)>  & skip,
+                            const uint                         k,
+                                  std::pair<double,uint>       hits[]) const
+{
+    if(k==0) return 0;
+    uint   n     = 0;
+    double bound = t_max; // once the buffer is full, only hits closer than the k-th can get in
+    ray_traversal(p, dir, bound, [&](const OctreeNode *leaf)
+    {
+        for(uint i : leaf->item_indices)
+        {
+            const SpatialDataStructureItem *it = items[i];
+            double t_hit;
+            vec3d  pos;
+            if(skip && skip(it->id)) continue;
+            if(!it->intersects_ray(p, dir, t_hit, pos) || t_hit<t_min || t_hit>bound) continue;
+            if(n==k && t_hit==bound) continue;
+
+            // items spanning multiple leaves are met more than once
+            auto hit = std::make_pair(t_hit,it->id);
+            if(std::find(hits, hits+n, hit)!=hits+n) continue;
+
+            // sorted insertion (drops the farthest hit if the buffer is full)
+            uint j = (n<k) ? n++ : k-1;
+            while(j>0 && hits[j-1]>hit)
+            {
+                hits[j] = hits[j-1];
+                --j;
+            }
+            hits[j] = hit;
+            if(n==k) bound = hits[k-1].first;
+        }
+        return true;
+    });
+    return n;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 // this query becomes exact if CINOLIB_USES_SHEWCHUK_PREDICATES is defined
 CINO_INLINE
 bool Octree::intersects_triangle(const vec3d t[], const bool ignore_if_valid_complex, std::unordered_set<uint> & ids) const
@@ -38,6 +38,7 @@
 
 #include <cinolib/geometry/spatial_data_structure_item.h>
 #include <cinolib/meshes/meshes.h>
+#include <functional>
 #include <queue>
 
 namespace cinolib
@@ -201,6 +202,14 @@ class Octree
         bool intersects_ray(const vec3d & p, const vec3d & dir, double & min_t, uint & id) const; // first hit
         bool intersects_ray(const vec3d & p, const vec3d & dir, std::set<std::pair<double,uint>> & all_hits) const;
 
+        // ray queries restricted to the interval [t_min,t_max] of the ray R(t) := p + t * dir. Items whose id is
+        // rejected by skip (if any) are ignored, e.g. to exclude the element a ray originates from. The tree is
+        // visited front to back and the traversal stops as soon as the result is known. No heap allocation
+        // occurs: k_nearest_hits writes (at most k) hits, sorted by t, in a buffer provided by the caller
+        bool first_hit     (const vec3d & p, const vec3d & dir, const double t_min, const double t_max, const std::function<bool(uint)> & skip, double & t, uint & id) const;
+        bool any_hit       (const vec3d & p, const vec3d & dir, const double t_min, const double t_max, const std::function<bool(uint)> & skip) const;
+        uint k_nearest_hits(const vec3d & p, const vec3d & dir, const double t_min, const double t_max, const std::function<bool(uint)> & skip, const uint k, std::pair<double,uint> hits[]) const;
+
         // note: these queries become exact if CINOLIB_USES_SHEWCHUK_PREDICATES is defined
         bool intersects_segment (const vec3d s[], const bool ignore_if_valid_complex, std::unordered_set<uint> & ids) const;
         bool intersects_triangle(const vec3d t[], const bool ignore_if_valid_complex, std::unordered_set<uint> & ids) const;
@@ -244,6 +253,16 @@ class Octree
             }
         };
         typedef std::priority_queue<Obj,std::vector<Obj>,Greater> PrioQueue;
+
+        // visits the leaves traversed by the ray in front to back order, pruning nodes
+        // farther than t_max (which may shrink meanwhile). Stops when visit returns false
+        struct RayNode
+        {
+            const OctreeNode *node;
+            double            t;
+        };
+        template<class LeafVisitor>
+        void ray_traversal(const vec3d & p, const vec3d & dir, const double & t_max, LeafVisitor visit) const;
 };
 
 }
@@ -0,0 +1,215 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/picking_index.h>
+#include <algorithm>
+#include <numeric>
+
+namespace cinolib
+{
+
+CINO_INLINE
+void PickingIndex::clear()
+{
+    nodes.clear();
+    ids.clear();
+    points.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void PickingIndex::build(const std::vector<AABB>  & boxes,
+                         const std::vector<vec3d> & points,
+                         const uint                 items_per_leaf)
+{
+    assert(boxes.size()==points.size());
+    clear();
+    if(points.empty()) return;
+
+    this->points = points;
+    ids.resize(points.size());
+    std::iota(ids.begin(), ids.end(), 0);
+
+    // top down construction: each node is split at the median of the
+    // representative points, along the longest side of their bounding box
+    nodes.reserve(4*points.size()/std::max(items_per_leaf,1u)+1);
+    nodes.emplace_back();
+    nodes.front().end = (uint)ids.size();
+    std::vector<uint> stack = { 0 };
+    while(!stack.empty())
+    {
+        uint nid = stack.back();
+        stack.pop_back();
+
+        uint beg = nodes.at(nid).beg;
+        uint end = nodes.at(nid).end;
+        AABB bbox, centers;
+        for(uint i=beg; i<end; ++i)
+        {
+            bbox.push(boxes.at(ids.at(i)));
+            centers.push(points.at(ids.at(i)));
+        }
+        nodes.at(nid).bbox = bbox;
+        if(end-beg <= items_per_leaf) continue;
+
+        vec3d delta = centers.delta();
+        int   axis  = (delta[0]>=delta[1] && delta[0]>=delta[2]) ? 0 : ((delta[1]>=delta[2]) ? 1 : 2);
+        uint  mid   = beg + (end-beg)/2;
+        std::nth_element(ids.begin()+beg, ids.begin()+mid, ids.begin()+end, [&](const uint a, const uint b)
+        {
+            return points.at(a)[axis] < points.at(b)[axis];
+        });
+
+        uint child = (uint)nodes.size();
+        nodes.at(nid).child = child;
+        nodes.emplace_back();
+        nodes.emplace_back();
+        nodes.at(child  ).beg = beg;
+        nodes.at(child  ).end = mid;
+        nodes.at(child+1).beg = mid;
+        nodes.at(child+1).end = end;
+        stack.push_back(child);
+        stack.push_back(child+1);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool PickingIndex::closest(const vec3d                     & p,
+                           const std::function<bool(uint)> & valid,
+                                 uint                      & id,
+                                 double                    & dist) const
+{
+    bool   found     = false;
+    double best_dist = inf_double; // squared
+    uint   best_id   = 0;
+
+    if(nodes.empty()) return false;
+    std::vector<uint> stack = { 0 };
+    while(!stack.empty())
+    {
+        const Node & node = nodes.at(stack.back());
+        stack.pop_back();
+
+        // note: ties are not pruned, so that the lowest id can win
+        if(node.bbox.dist_sqrd(p) > best_dist) continue;
+
+        if(node.child==0)
+        {
+            for(uint i=node.beg; i<node.end; ++i)
+            {
+                uint   item = ids.at(i);
+                double d    = points.at(item).dist_sqrd(p);
+                if(d>best_dist || (d==best_dist && item>best_id) || !valid(item)) continue;
+                best_dist = d;
+                best_id   = item;
+                found     = true;
+            }
+        }
+        else
+        {
+            // visit the closest child first
+            uint c0 = node.child;
+            uint c1 = node.child+1;
+            if(nodes.at(c0).bbox.dist_sqrd(p) < nodes.at(c1).bbox.dist_sqrd(p)) std::swap(c0,c1);
+            stack.push_back(c0);
+            stack.push_back(c1);
+        }
+    }
+
+    if(found)
+    {
+        id   = best_id;
+        dist = std::sqrt(best_dist);
+    }
+    return found;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool PickingIndex::first_hit(const vec3d                              & orig,
+                             const vec3d                              & dir,
+                             const std::function<bool(uint,double&)>  & hit,
+                                   uint                               & id,
+                                   double                             & t) const
+{
+    bool   found  = false;
+    double best_t = inf_double;
+    uint   best_id = 0;
+
+    if(nodes.empty()) return false;
+    std::vector<uint> stack = { 0 };
+    while(!stack.empty())
+    {
+        const Node & node = nodes.at(stack.back());
+        stack.pop_back();
+
+        double t_box;
+        vec3d  pos;
+        if(!node.bbox.intersects_ray(orig, dir, t_box, pos) || t_box>best_t) continue;
+
+        if(node.child==0)
+        {
+            for(uint i=node.beg; i<node.end; ++i)
+            {
+                uint   item = ids.at(i);
+                double t_item;
+                if(hit(item, t_item) && t_item>=0 && t_item<best_t)
+                {
+                    best_t  = t_item;
+                    best_id = item;
+                    found   = true;
+                }
+            }
+        }
+        else
+        {
+            stack.push_back(node.child);
+            stack.push_back(node.child+1);
+        }
+    }
+
+    if(found)
+    {
+        id = best_id;
+        t  = best_t;
+    }
+    return found;
+}
+
+}
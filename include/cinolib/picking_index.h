@@ -0,0 +1,110 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_PICKING_INDEX_H
+#define CINO_PICKING_INDEX_H
+
+#include <cinolib/geometry/aabb.h>
+#include <functional>
+
+namespace cinolib
+{
+
+/* Lightweight bounding volume hierarchy used to accelerate mouse picking.
+ * Each item is described by a bounding box (used to answer ray queries) and by
+ * a representative point (used to answer closest point queries and to split the
+ * hierarchy), e.g. a vertex, the midpoint of an edge or the centroid of a polygon.
+ * Queries accept a filter on item ids, so that items can be hidden and unhidden
+ * without re-building the index.
+*/
+
+class PickingIndex
+{
+    public:
+
+        explicit PickingIndex() {}
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void clear();
+        bool empty() const { return ids.empty(); }
+        uint size()  const { return (uint)ids.size(); }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void build(const std::vector<AABB>  & boxes,
+                   const std::vector<vec3d> & points,
+                   const uint                 items_per_leaf = 8);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // id of the item with representative point closest to p, among the items
+        // for which valid(id) is true. In case of ties the item with lowest id wins
+        bool closest(const vec3d                     & p,
+                     const std::function<bool(uint)> & valid,
+                           uint                      & id,
+                           double                    & dist) const;
+
+        // first item hit by the ray R(t) := orig + t * dir. Items whose bounding box
+        // is hit by the ray are tested with hit(id,t), which returns true (and the
+        // ray parameter t) if the ray intersects the actual item
+        bool first_hit(const vec3d                              & orig,
+                       const vec3d                              & dir,
+                       const std::function<bool(uint,double&)>  & hit,
+                             uint                               & id,
+                             double                             & t) const;
+
+    protected:
+
+        struct Node
+        {
+            AABB bbox;
+            uint beg   = 0; // range of ids spanned by the node
+            uint end   = 0;
+            uint child = 0; // children are child and child+1 (0 for leaves)
+        };
+
+        std::vector<Node>  nodes;
+        std::vector<uint>  ids;    // item ids, sorted so that each node spans a contiguous range
+        std::vector<vec3d> points; // representative points, indexed by item id
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "picking_index.cpp"
+#endif
+
+#endif // CINO_PICKING_INDEX_H
@@ -0,0 +1,543 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/quality_batch.h>
+#include <cinolib/min_max_inf.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+
+namespace cinolib
+{
+
+// number of elements processed at once by the kernels
+static const uint QUALITY_BLOCK = 32;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint quality_metric_index(const int metric)
+{
+    for(uint i=0; i<QUALITY_NUM_METRICS; ++i) if(metric == (1<<i)) return i;
+    assert(false && "unknown quality metric");
+    return 0;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// same arithmetic of col0.dot(col1.cross(col2)), so that results are bitwise identical
+CINO_INLINE
+double quality_det(const double ax, const double ay, const double az,
+                          const double bx, const double by, const double bz,
+                          const double cx, const double cy, const double cz)
+{
+    double x = by*cz - bz*cy;
+    double y = bz*cx - bx*cz;
+    double z = bx*cy - by*cx;
+    return ax*x + ay*y + az*z;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void hex_quality_block(const double * soa,
+                       const uint     stride,
+                       const uint     n,
+                       const int      metrics,
+                             float  * out[])
+{
+    static const uint hex_edge_verts[12][2] =
+    {
+        {0,1}, {1,2}, {2,3}, {0,3}, {0,4}, {1,5}, {2,6}, {3,7}, {4,5}, {5,6}, {6,7}, {4,7}
+    };
+    // corner tets, as triplets of (signed) edges (see hex_subtets in quality_hex.cpp)
+    static const uint   subtet_edges[8][3] = { {0,3,4}, {1,0,5}, {2,1,6}, {3,2,7}, {11,8,4}, {8,9,5}, {9,10,6}, {10,11,7} };
+    static const double subtet_signs[8]    = {  1,      -1,      -1,       1,      -1,       1,        1,      -1        };
+
+    const uint B = QUALITY_BLOCK;
+    assert(n<=B);
+
+    // edges, principal axes and their norms
+    double L[12][3][B], L_norm[12][B];
+    double X[3][3][B],  X_norm[3][B];
+    for(uint i=0; i<12; ++i)
+    {
+        const double * a = soa + 3*hex_edge_verts[i][0]*stride;
+        const double * b = soa + 3*hex_edge_verts[i][1]*stride;
+        for(uint k=0; k<3; ++k)
+        for(uint e=0; e<n; ++e)
+        {
+            L[i][k][e] = b[k*stride+e] - a[k*stride+e];
+        }
+        for(uint e=0; e<n; ++e)
+        {
+            L_norm[i][e] = std::sqrt(L[i][0][e]*L[i][0][e] + L[i][1][e]*L[i][1][e] + L[i][2][e]*L[i][2][e]);
+        }
+    }
+    for(uint k=0; k<3; ++k)
+    {
+        const double * p[8];
+        for(uint i=0; i<8; ++i) p[i] = soa + (3*i+k)*stride;
+        for(uint e=0; e<n; ++e)
+        {
+            X[0][k][e] = (p[1][e] - p[0][e]) + (p[2][e] - p[3][e]) + (p[5][e] - p[4][e]) + (p[6][e] - p[7][e]);
+            X[1][k][e] = (p[3][e] - p[0][e]) + (p[2][e] - p[1][e]) + (p[7][e] - p[4][e]) + (p[6][e] - p[5][e]);
+            X[2][k][e] = (p[4][e] - p[0][e]) + (p[5][e] - p[1][e]) + (p[6][e] - p[2][e]) + (p[7][e] - p[3][e]);
+        }
+    }
+    for(uint i=0; i<3; ++i)
+    for(uint e=0; e<n; ++e)
+    {
+        X_norm[i][e] = std::sqrt(X[i][0][e]*X[i][0][e] + X[i][1][e]*X[i][1][e] + X[i][2][e]*X[i][2][e]);
+    }
+
+    if(metrics & (QUALITY_SCALED_JACOBIAN | QUALITY_SKEW))
+    {
+        // unit length edges and axes (null vectors are left untouched)
+        double U[12][3][B], XU[3][3][B];
+        for(uint i=0; i<12; ++i)
+        for(uint k=0; k<3; ++k)
+        for(uint e=0; e<n; ++e)
+        {
+            U[i][k][e] = (L_norm[i][e]>0) ? L[i][k][e]/L_norm[i][e] : L[i][k][e];
+        }
+        for(uint i=0; i<3; ++i)
+        for(uint k=0; k<3; ++k)
+        for(uint e=0; e<n; ++e)
+        {
+            XU[i][k][e] = (X_norm[i][e]>0) ? X[i][k][e]/X_norm[i][e] : X[i][k][e];
+        }
+
+        if(metrics & QUALITY_SCALED_JACOBIAN)
+        {
+            double sj[B];
+            for(uint e=0; e<n; ++e)
+            {
+                sj[e] = quality_det(XU[0][0][e], XU[0][1][e], XU[0][2][e],
+                                    XU[1][0][e], XU[1][1][e], XU[1][2][e],
+                                    XU[2][0][e], XU[2][1][e], XU[2][2][e]);
+            }
+            for(uint t=0; t<8; ++t)
+            {
+                const auto & a = U[subtet_edges[t][0]];
+                const auto & b = U[subtet_edges[t][1]];
+                const auto & c = U[subtet_edges[t][2]];
+                for(uint e=0; e<n; ++e)
+                {
+                    double d = subtet_signs[t] * quality_det(a[0][e], a[1][e], a[2][e],
+                                                             b[0][e], b[1][e], b[2][e],
+                                                             c[0][e], c[1][e], c[2][e]);
+                    sj[e] = std::min(sj[e], d);
+                }
+            }
+            for(uint e=0; e<n; ++e) out[0][e] = float((sj[e] > 1.0001) ? -1.0 : sj[e]);
+        }
+
+        if(metrics & QUALITY_SKEW)
+        {
+            for(uint e=0; e<n; ++e)
+            {
+                double d01 = XU[0][0][e]*XU[1][0][e] + XU[0][1][e]*XU[1][1][e] + XU[0][2][e]*XU[1][2][e];
+                double d02 = XU[0][0][e]*XU[2][0][e] + XU[0][1][e]*XU[2][1][e] + XU[0][2][e]*XU[2][2][e];
+                double d12 = XU[1][0][e]*XU[2][0][e] + XU[1][1][e]*XU[2][1][e] + XU[1][2][e]*XU[2][2][e];
+                double s   = std::max(std::fabs(d01), std::max(std::fabs(d02), std::fabs(d12)));
+                bool   deg = X_norm[0][e]<=0 || X_norm[1][e]<=0 || X_norm[2][e]<=0;
+                out[2][e]  = float(deg ? 0.0 : s);
+            }
+        }
+    }
+
+    if(metrics & (QUALITY_ODDY | QUALITY_VOLUME))
+    {
+        double det_X[B];
+        for(uint e=0; e<n; ++e)
+        {
+            det_X[e] = quality_det(X[0][0][e], X[0][1][e], X[0][2][e],
+                                   X[1][0][e], X[1][1][e], X[1][2][e],
+                                   X[2][0][e], X[2][1][e], X[2][2][e]);
+        }
+
+        if(metrics & QUALITY_ODDY)
+        {
+            static const double four_over_three = 4.0/3.0;
+            double oddy[B];
+            bool   deg[B];
+            for(uint e=0; e<n; ++e)
+            {
+                oddy[e] = -max_double;
+                deg[e]  = false;
+            }
+            for(uint t=0; t<9; ++t)
+            {
+                for(uint e=0; e<n; ++e)
+                {
+                    double a[3], b[3], c[3], s = 1.0;
+                    for(uint k=0; k<3; ++k)
+                    {
+                        a[k] = (t<8) ? L[subtet_edges[t%8][0]][k][e] : X[0][k][e];
+                        b[k] = (t<8) ? L[subtet_edges[t%8][1]][k][e] : X[1][k][e];
+                        c[k] = (t<8) ? L[subtet_edges[t%8][2]][k][e] : X[2][k][e];
+                    }
+                    if(t<8) s = subtet_signs[t];
+                    double det = (t<8) ? s * quality_det(a[0], a[1], a[2], b[0], b[1], b[2], c[0], c[1], c[2]) : det_X[e];
+                    if(det > min_double)
+                    {
+                        // flipping the sign of some columns does not change AtA
+                        double a11 = a[0]*a[0] + a[1]*a[1] + a[2]*a[2];
+                        double a12 = a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+                        double a13 = a[0]*c[0] + a[1]*c[1] + a[2]*c[2];
+                        double a22 = b[0]*b[0] + b[1]*b[1] + b[2]*b[2];
+                        double a23 = b[0]*c[0] + b[1]*c[1] + b[2]*c[2];
+                        double a33 = c[0]*c[0] + c[1]*c[1] + c[2]*c[2];
+                        double AtA_sqrd = a11*a11 + 2.0*a12*a12 + 2.0*a13*a13 + a22*a22 + 2.0*a23*a23 +a33*a33;
+                        double A_sqrd   = a11 + a22 + a33;
+                        float  o        = float((AtA_sqrd - A_sqrd*A_sqrd/3.0) / std::pow(det,four_over_three));
+                        oddy[e] = std::max(oddy[e], double(o));
+                    }
+                    else deg[e] = true;
+                }
+            }
+            for(uint e=0; e<n; ++e) out[1][e] = float(deg[e] ? max_double : oddy[e]);
+        }
+
+        if(metrics & QUALITY_VOLUME)
+        {
+            for(uint e=0; e<n; ++e) out[4][e] = float(det_X[e]/64.0);
+        }
+    }
+
+    if(metrics & QUALITY_EDGE_RATIO)
+    {
+        for(uint e=0; e<n; ++e)
+        {
+            double l_min = L_norm[0][e];
+            double l_max = L_norm[0][e];
+            for(uint i=1; i<12; ++i)
+            {
+                l_min = std::min(l_min, L_norm[i][e]);
+                l_max = std::max(l_max, L_norm[i][e]);
+            }
+            out[3][e] = float(l_max/l_min);
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void tet_quality_block(const double * soa,
+                       const uint     stride,
+                       const uint     n,
+                       const int      metrics,
+                             float  * out[])
+{
+    static const uint   tet_edge_verts[6][2] = { {0,1}, {1,2}, {2,0}, {0,3}, {1,3}, {2,3} };
+    static const double sqrt_2 = 1.414213562373095;
+
+    const uint B = QUALITY_BLOCK;
+    assert(n<=B);
+
+    double L[6][3][B], L_norm[6][B], J[B];
+    for(uint i=0; i<6; ++i)
+    {
+        const double * a = soa + 3*tet_edge_verts[i][0]*stride;
+        const double * b = soa + 3*tet_edge_verts[i][1]*stride;
+        for(uint k=0; k<3; ++k)
+        for(uint e=0; e<n; ++e)
+        {
+            L[i][k][e] = b[k*stride+e] - a[k*stride+e];
+        }
+        for(uint e=0; e<n; ++e)
+        {
+            L_norm[i][e] = std::sqrt(L[i][0][e]*L[i][0][e] + L[i][1][e]*L[i][1][e] + L[i][2][e]*L[i][2][e]);
+        }
+    }
+    for(uint e=0; e<n; ++e)
+    {
+        // (L2 x L0) . L3
+        J[e] = quality_det(L[3][0][e], L[3][1][e], L[3][2][e],
+                           L[2][0][e], L[2][1][e], L[2][2][e],
+                           L[0][0][e], L[0][1][e], L[0][2][e]);
+    }
+
+    if(metrics & QUALITY_SCALED_JACOBIAN)
+    {
+        for(uint e=0; e<n; ++e)
+        {
+            double lambda = J[e];
+            lambda = std::max(lambda, L_norm[0][e] * L_norm[2][e] * L_norm[3][e]);
+            lambda = std::max(lambda, L_norm[0][e] * L_norm[1][e] * L_norm[4][e]);
+            lambda = std::max(lambda, L_norm[1][e] * L_norm[2][e] * L_norm[5][e]);
+            lambda = std::max(lambda, L_norm[3][e] * L_norm[4][e] * L_norm[5][e]);
+            out[0][e] = float(J[e] * sqrt_2 / lambda);
+        }
+    }
+
+    if(metrics & QUALITY_EDGE_RATIO)
+    {
+        for(uint e=0; e<n; ++e)
+        {
+            double l_min = L_norm[0][e];
+            double l_max = L_norm[0][e];
+            for(uint i=1; i<6; ++i)
+            {
+                l_min = std::min(l_min, L_norm[i][e]);
+                l_max = std::max(l_max, L_norm[i][e]);
+            }
+            out[3][e] = float(l_max/l_min);
+        }
+    }
+
+    if(metrics & QUALITY_VOLUME)
+    {
+        for(uint e=0; e<n; ++e) out[4][e] = float(J[e]/6.0);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void hex_quality_batch(const double * soa,
+                       const uint     stride,
+                       const uint     n,
+                       const int      metrics,
+                             float  * out[])
+{
+    for(uint beg=0; beg<n; beg+=QUALITY_BLOCK)
+    {
+        float * block_out[QUALITY_NUM_METRICS];
+        for(uint i=0; i<QUALITY_NUM_METRICS; ++i) block_out[i] = (out[i]!=nullptr) ? out[i]+beg : nullptr;
+        hex_quality_block(soa+beg, stride, std::min(QUALITY_BLOCK, n-beg), metrics, block_out);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void tet_quality_batch(const double * soa,
+                       const uint     stride,
+                       const uint     n,
+                       const int      metrics,
+                             float  * out[])
+{
+    for(uint beg=0; beg<n; beg+=QUALITY_BLOCK)
+    {
+        float * block_out[QUALITY_NUM_METRICS];
+        for(uint i=0; i<QUALITY_NUM_METRICS; ++i) block_out[i] = (out[i]!=nullptr) ? out[i]+beg : nullptr;
+        tet_quality_block(soa+beg, stride, std::min(QUALITY_BLOCK, n-beg), metrics, block_out);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// gathers the corners of blocks of polys in SoA layout and runs the kernel on them
+template<class Mesh, typename Kernel>
+CINO_INLINE
+QualityReport poly_quality(const Mesh & m, const uint n_corners, const int metrics, const uint n_bins, Kernel kernel)
+{
+    QualityReport r;
+    r.metrics = metrics;
+    for(uint i=0; i<QUALITY_NUM_METRICS; ++i)
+    {
+        if(metrics & (1<<i)) r.values[i].resize(m.num_polys());
+    }
+
+    uint n_blocks = (m.num_polys() + QUALITY_BLOCK - 1) / QUALITY_BLOCK;
+    PARALLEL_FOR(0, n_blocks, 64, [&](const uint b)
+    {
+        uint   beg = b*QUALITY_BLOCK;
+        uint   n   = std::min(QUALITY_BLOCK, m.num_polys()-beg);
+        double soa[3*8*QUALITY_BLOCK];
+        for(uint i=0; i<n_corners; ++i)
+        for(uint e=0; e<n; ++e)
+        {
+            const vec3d & p = m.vert(m.adj_p2v(beg+e).at(i));
+            soa[(3*i+0)*QUALITY_BLOCK + e] = p.x();
+            soa[(3*i+1)*QUALITY_BLOCK + e] = p.y();
+            soa[(3*i+2)*QUALITY_BLOCK + e] = p.z();
+        }
+        float * out[QUALITY_NUM_METRICS];
+        for(uint i=0; i<QUALITY_NUM_METRICS; ++i) out[i] = (r.values[i].empty()) ? nullptr : r.values[i].data()+beg;
+        kernel(soa, QUALITY_BLOCK, n, metrics, out);
+    });
+
+    for(uint i=0; i<QUALITY_NUM_METRICS; ++i)
+    {
+        if(metrics & (1<<i)) r.stats[i] = quality_stats(r.values[i], n_bins);
+    }
+    return r;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+QualityReport hex_quality(const Hexmesh<M,V,E,F,P> & m,
+                          const int                  metrics,
+                          const uint                 n_bins)
+{
+    return poly_quality(m, 8, metrics, n_bins, hex_quality_block);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+QualityReport tet_quality(const Tetmesh<M,V,E,F,P> & m,
+                          const int                  metrics,
+                          const uint                 n_bins)
+{
+    assert(!(metrics & (QUALITY_ODDY | QUALITY_SKEW)) && "metric not available for tetrahedra");
+    return poly_quality(m, 4, metrics & ~(QUALITY_ODDY | QUALITY_SKEW), n_bins, tet_quality_block);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+QualityStats quality_stats(const std::vector<float> & values, const uint n_bins)
+{
+    QualityStats s;
+    if(values.empty()) return s;
+
+    // non finite values (e.g. Oddy metric of degenerate elements) are only counted.
+    // NaNs have no ordering, and would make min/max and nth_element meaningless
+    std::vector<float> tmp;
+    tmp.reserve(values.size());
+    double sum = 0;
+    for(float v : values)
+    {
+        if(std::isfinite(v))
+        {
+            sum += v;
+            tmp.push_back(v);
+        }
+        else ++s.n_inf;
+    }
+    if(tmp.empty())
+    {
+        if(n_bins>0)
+        {
+            s.histogram.assign(n_bins, 0);
+            s.histogram.back() = s.n_inf;
+        }
+        return s;
+    }
+    s.avg   = sum/tmp.size();
+    s.min   = *std::min_element(tmp.begin(), tmp.end());
+    s.max   = *std::max_element(tmp.begin(), tmp.end());
+    s.h_min = s.min;
+    s.h_max = s.max;
+
+    // percentiles (nearest rank)
+    double * p[5]   = { &s.p1, &s.p5, &s.p50, &s.p95, &s.p99 };
+    double   pct[5] = {  0.01,  0.05,  0.50,   0.95,   0.99  };
+    auto beg = tmp.begin();
+    for(uint i=0; i<5; ++i)
+    {
+        auto nth = tmp.begin() + std::min(tmp.size()-1, size_t(pct[i]*(tmp.size()-1) + 0.5));
+        std::nth_element(beg, nth, tmp.end());
+        *p[i] = *nth;
+        beg   = nth;
+    }
+
+    if(n_bins>0)
+    {
+        s.histogram.assign(n_bins, 0);
+        double range = s.h_max - s.h_min;
+        for(float v : values)
+        {
+            uint bin = n_bins-1;
+            if(std::isfinite(v) && range>0) bin = std::min(n_bins-1, uint((v - s.h_min)/range*n_bins));
+            else if(std::isfinite(v))       bin = 0;
+            ++s.histogram.at(bin);
+        }
+    }
+    return s;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+const std::vector<float> & QualityReport::per_elem(const int metric) const
+{
+    return values[quality_metric_index(metric)];
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+const QualityStats & QualityReport::summary(const int metric) const
+{
+    return stats[quality_metric_index(metric)];
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void QualityReport::copy_to_mesh(Mesh & m, const int metric) const
+{
+    const std::vector<float> & q = per_elem(metric);
+    assert(q.size()==m.num_polys());
+    for(uint pid=0; pid<m.num_polys(); ++pid) m.poly_data(pid).quality = q.at(pid);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void QualityReport::print() const
+{
+    static const std::string names[QUALITY_NUM_METRICS] =
+    {
+        "Scaled Jacobian", "Oddy", "Skew", "Edge Ratio", "Volume"
+    };
+    for(uint i=0; i<QUALITY_NUM_METRICS; ++i)
+    {
+        if(!(metrics & (1<<i))) continue;
+        const QualityStats & s = stats[i];
+        std::cout << names[i] << "\n"
+                  << "    min " << s.min << "  avg " << s.avg << "  max " << s.max << "\n";
+        if(s.n_inf>0) std::cout << "    " << s.n_inf << " non finite values (excluded from the stats)\n";
+        std::cout << "    percentiles (1/5/50/95/99) " << s.p1 << " / " << s.p5 << " / " << s.p50 << " / " << s.p95 << " / " << s.p99 << "\n";
+        if(s.histogram.empty()) continue;
+        std::cout << "    histogram [" << s.h_min << "," << s.h_max << "]";
+        for(uint c : s.histogram) std::cout << " " << c;
+        std::cout << "\n";
+    }
+    std::cout << std::endl;
+}
+
+}
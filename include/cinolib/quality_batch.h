@@ -0,0 +1,157 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_QUALITY_BATCH
+#define CINO_QUALITY_BATCH
+
+#include <cinolib/cino_inline.h>
+#include <cinolib/meshes/hexmesh.h>
+#include <cinolib/meshes/tetmesh.h>
+
+/*
+ * Batched evaluation of element quality over whole meshes. Several metrics are
+ * computed in one pass over the elements, which are processed in parallel in
+ * small blocks. Within each block corner coordinates are stored as a structure
+ * of arrays (SoA), so that the inner loops of the kernels run over consecutive
+ * elements and can be vectorized by the compiler. Each metric returns the same
+ * values of its scalar counterpart in quality_hex.h and quality_tet.h
+ *
+ * Metrics are based on:
+ *
+ * The Verdict Geometric Quality Library
+ * SANDIA Report SAND2007-1751
+ *
+*/
+
+namespace cinolib
+{
+
+enum
+{
+    QUALITY_SCALED_JACOBIAN = 0x01,
+    QUALITY_ODDY            = 0x02, // hexahedra only
+    QUALITY_SKEW            = 0x04, // hexahedra only
+    QUALITY_EDGE_RATIO      = 0x08,
+    QUALITY_VOLUME          = 0x10,
+    QUALITY_ALL             = 0x1F,
+};
+
+static const uint QUALITY_NUM_METRICS = 5;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct QualityStats
+{
+    double            min = 0;   // min, max, avg and percentiles consider finite values only
+    double            max = 0;   //
+    double            avg = 0;   //
+    uint              n_inf = 0; // number of non finite values (e.g. Oddy metric of degenerate elements)
+    double            p1  = 0;   // 1st  percentile
+    double            p5  = 0;   // 5th  percentile
+    double            p50 = 0;   // median
+    double            p95 = 0;   // 95th percentile
+    double            p99 = 0;   // 99th percentile
+    double            h_min = 0; // histogram range (same as min,max)
+    double            h_max = 0; //
+    std::vector<uint> histogram; // uniform bins in [h_min,h_max]. Non finite values go in the last bin
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct QualityReport
+{
+    int                metrics = 0;                 // metrics that have been computed
+    std::vector<float> values[QUALITY_NUM_METRICS]; // per element values (one array per metric)
+    QualityStats       stats [QUALITY_NUM_METRICS]; // statistics (one per metric)
+
+    // access by metric flag (e.g. QUALITY_ODDY)
+    const std::vector<float> & per_elem(const int metric) const;
+    const QualityStats       & summary (const int metric) const;
+
+    // copies a metric into the quality field of mesh polys (e.g. for MeshSlicer::Q_thresh)
+    template<class Mesh>
+    void copy_to_mesh(Mesh & m, const int metric) const;
+
+    void print() const;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Kernels operating on n elements, with corners in SoA layout: the k-th coordinate
+// (x,y,z) of the i-th corner of element e is soa[(3*i+k)*stride + e]. Values of each
+// metric are written in out[j][e], where j is the index of the metric flag (i.e.
+// out[0] for QUALITY_SCALED_JACOBIAN, out[1] for QUALITY_ODDY...). Metrics not listed
+// in the input mask are skipped, and the corresponding pointer can be null
+
+CINO_INLINE
+void hex_quality_batch(const double * soa,
+                       const uint     stride,
+                       const uint     n,
+                       const int      metrics,
+                             float  * out[]);
+
+CINO_INLINE
+void tet_quality_batch(const double * soa,
+                       const uint     stride,
+                       const uint     n,
+                       const int      metrics,
+                             float  * out[]);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+QualityReport hex_quality(const Hexmesh<M,V,E,F,P> & m,
+                          const int                  metrics = QUALITY_ALL,
+                          const uint                 n_bins  = 20);
+
+template<class M, class V, class E, class F, class P>
+CINO_INLINE
+QualityReport tet_quality(const Tetmesh<M,V,E,F,P> & m,
+                          const int                  metrics = QUALITY_SCALED_JACOBIAN | QUALITY_EDGE_RATIO | QUALITY_VOLUME,
+                          const uint                 n_bins  = 20);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+QualityStats quality_stats(const std::vector<float> & values, const uint n_bins = 20);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "quality_batch.cpp"
+#endif
+
+#endif // CINO_QUALITY_BATCH
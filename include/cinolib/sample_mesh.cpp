@@ -34,38 +34,139 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/sample_mesh.h>
-#include <cinolib/geodesics.h>
+#include <cinolib/min_max_inf.h>
+#include <queue>
 
 namespace cinolib
 {
 
+// Propagates the distance from a set of new samples, updating the running distance
+// field dist. The visit stops where the distance from the new samples exceeds the
+// current one. Every vertex whose distance decreases is (re)inserted in the max heap
+// used to select the next samples. Outdated heap entries are left there, and will be
+// discarded when popped
+//
 template<class M, class V, class E, class P>
 CINO_INLINE
-void sample_mesh(AbstractPolygonMesh<M,V,E,P> & m, const uint n_samples, std::vector<uint> & samples)
+void fps_propagate(const AbstractMesh<M,V,E,P>                    & m,
+                   const std::vector<uint>                        & sources,
+                         std::vector<double>                      & dist,
+                         std::priority_queue<std::pair<double,uint>> & max_heap)
 {
-    assert(n_samples > 0);
+    typedef std::pair<double,uint> Entry;
+    std::priority_queue<Entry,std::vector<Entry>,std::greater<Entry>> q;
+    for(uint vid : sources)
+    {
+        dist.at(vid) = 0.0;
+        q.push(std::make_pair(0.0,vid));
+    }
+
+    while(!q.empty())
+    {
+        Entry e = q.top();
+        q.pop();
+        uint vid = e.second;
+        if(e.first > dist.at(vid)) continue; // outdated entry
+
+        for(uint nbr : m.adj_v2v(vid))
+        {
+            double new_dist = dist.at(vid) + m.vert(vid).dist(m.vert(nbr));
+            if(new_dist < dist.at(nbr))
+            {
+                dist.at(nbr) = new_dist;
+                q.push(std::make_pair(new_dist,nbr));
+                max_heap.push(std::make_pair(new_dist,nbr));
+            }
+        }
+    }
+}
 
-    srand(time(NULL));
-    samples = { rand()%m.num_verts() };
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void farthest_point_sampling(const AbstractMesh<M,V,E,P> & m,
+                             const uint                    n_samples,
+                                   std::vector<uint>     & samples,
+                             const uint                    seed)
+{
+    farthest_point_sampling_batched(m, n_samples, 1, samples, seed);
+}
 
-    GeodesicsCache cache;
-    ScalarField f = compute_geodesics_amortized(m, cache, samples);
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-    for(uint i=1; i<n_samples; ++i)
+template<class M, class V, class E, class P>
+CINO_INLINE
+void farthest_point_sampling_batched(const AbstractMesh<M,V,E,P> & m,
+                                     const uint                    n_samples,
+                                     const uint                    batch_size,
+                                           std::vector<uint>     & samples,
+                                     const uint                    seed)
+{
+    assert(seed < m.num_verts());
+    assert(batch_size > 0);
+
+    samples.clear();
+    if(n_samples==0) return;
+
+    std::vector<double> dist(m.num_verts(), inf_double);
+    std::priority_queue<std::pair<double,uint>> max_heap;
+
+    samples.push_back(seed);
+    fps_propagate(m, samples, dist, max_heap);
+
+    // vertices not reachable from the seed (e.g. other connected components) are
+    // infinitely far from all samples. Give them a chance to be picked, in id order
+    for(uint vid=0; vid<m.num_verts(); ++vid)
     {
-        double dist = f[samples.back()];
-        uint   sample;
-        for(uint vid=0; vid<m.num_verts(); ++vid)
+        if(dist.at(vid)==inf_double) max_heap.push(std::make_pair(inf_double,vid));
+    }
+
+    std::vector<uint> batch;
+    std::vector<std::pair<double,uint>> rejected;
+    while(samples.size()<n_samples && !max_heap.empty())
+    {
+        batch.clear();
+        rejected.clear();
+        uint n = std::min(batch_size, n_samples - uint(samples.size()));
+        while(batch.size()<n && !max_heap.empty())
         {
-            if(f[vid] < dist)
+            auto top = max_heap.top();
+            max_heap.pop();
+            uint vid = top.second;
+            if(top.first != dist.at(vid)) continue; // outdated entry
+            if(dist.at(vid) == 0.0) break;          // all vertices have been sampled already
+
+            bool separated = true;
+            for(uint s : batch)
             {
-                dist   = f[vid];
-                sample = vid;
+                if(m.vert(s).dist(m.vert(vid)) < dist.at(vid))
+                {
+                    separated = false;
+                    break;
+                }
             }
+            if(separated) batch.push_back(vid);
+            else          rejected.push_back(top);
         }
-        samples.push_back(sample);
-        f = compute_geodesics_amortized(m, cache, samples);
+        if(batch.empty()) break;
+
+        // rejected candidates are still valid, put them back
+        for(auto & e : rejected) max_heap.push(e);
+
+        samples.insert(samples.end(), batch.begin(), batch.end());
+        fps_propagate(m, batch, dist, max_heap);
     }
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void sample_mesh(AbstractPolygonMesh<M,V,E,P> & m, const uint n_samples, std::vector<uint> & samples)
+{
+    assert(n_samples > 0);
+    farthest_point_sampling(m, n_samples, samples, 0);
+}
+
 }
@@ -41,10 +41,18 @@
 namespace cinolib
 {
 
-/* This is just an awful method that selects a subset of mesh vertices from an input mesh.
- * It works by starting from a random vertex, and iteratively picking as next vertex the one
- * that is furthest from all the previously selected vertices. Distance computation is cheap
- * because the amortized heat based geodesics are used.
+/* Farthest point sampling of mesh vertices. Starting from a seed vertex, the method
+ * iteratively picks as next sample the vertex that is furthest from all the previously
+ * selected ones, where distances are measured along the mesh edges (i.e. shortest paths
+ * on the edge graph).
+ *
+ * Rather than re-computing distances from scratch at each iteration, a running field
+ * containing the distance of each vertex from its closest sample is kept up to date.
+ * When a sample is added, its distance is propagated with a Dijkstra visit that stops
+ * as soon as the new distance exceeds the current one, hence it only visits the portion
+ * of the mesh that is closer to the new sample than to any previous one. The vertex with
+ * highest distance is fetched from a max heap with lazy deletion. The output is fully
+ * determined by the seed vertex.
  *
  * For a more serious resource to solve this problem, one may refer to:
  *
@@ -53,6 +61,38 @@ namespace cinolib
  * M.Corsini, P.Cignoni, R.Scopigno
 */
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+void farthest_point_sampling(const AbstractMesh<M,V,E,P> & m,
+                             const uint                    n_samples,
+                                   std::vector<uint>     & samples,
+                             const uint                    seed = 0);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Batched variant of the above, which selects up to batch_size samples per round and
+ * propagates their distances with a single multi source visit. Candidates are popped from
+ * the heap in decreasing distance order, and a candidate is accepted only if its euclidean
+ * distance from the samples already accepted in the same round is not smaller than its
+ * distance from the previous samples. Since the euclidean distance is a lower bound of the
+ * distance along edges, samples selected in the same round are at least as well separated
+ * as they would be with the one-at-a-time strategy. Setting batch_size to 1 gives the same
+ * output as farthest_point_sampling.
+*/
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void farthest_point_sampling_batched(const AbstractMesh<M,V,E,P> & m,
+                                     const uint                    n_samples,
+                                     const uint                    batch_size,
+                                           std::vector<uint>     & samples,
+                                     const uint                    seed = 0);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Selects a subset of mesh vertices using farthest point sampling (see above),
+// starting from vertex zero
+//
 template<class M, class V, class E, class P>
 CINO_INLINE
 void sample_mesh(AbstractPolygonMesh<M,V,E,P> & m, const uint n_samples, std::vector<uint> & samples);
@@ -37,6 +37,8 @@
 #include <cinolib/laplacian.h>
 #include <cinolib/linear_solvers.h>
 #include <cinolib/octree.h>
+#include <cinolib/smoothing_engine.h>
+#include <cinolib/parallel_for.h>
 
 namespace cinolib
 {
@@ -78,6 +80,7 @@ void mesh_smoother(      AbstractPolygonMesh<M1,V1,E1,P1> & m,
 
     // LABEL MESH VERTICES
     enum { REGULAR, CORNER, FEATURE };
+    std::vector<uint> verts_of_type[3];
     for(uint vid=0; vid<m.num_verts(); ++vid)
     {
         uint count = 0;
@@ -92,8 +95,37 @@ void mesh_smoother(      AbstractPolygonMesh<M1,V1,E1,P1> & m,
             case 2  : m.vert_data(vid).label = FEATURE; break;
             default : m.vert_data(vid).label = CORNER;  break;
         }
+        verts_of_type[m.vert_data(vid).label].push_back(vid);
     }
 
+    // PROJECTION ONTO THE TARGET (surface to surface, feature lines to feature lines, corners to corners)
+    // closest point queries are independent from one another, and are computed in parallel
+    struct Proj
+    {
+        vec3d  p;
+        double dist;
+        uint   id;
+    };
+    std::vector<Proj> proj(m.num_verts());
+    auto closest_points = [&]()
+    {
+        PARALLEL_FOR(0, m.num_verts(), 1000, [&](const uint vid)
+        {
+            Proj & pr = proj.at(vid);
+            switch(m.vert_data(vid).label)
+            {
+                case REGULAR: o_srf.closest_point   (m.vert(vid), pr.id, pr.p, pr.dist); break;
+                case FEATURE: o_line.closest_point  (m.vert(vid), pr.id, pr.p, pr.dist); break;
+                case CORNER:  o_corner.closest_point(m.vert(vid), pr.id, pr.p, pr.dist); break;
+                default: assert(false && "unknown vertex type");
+            }
+        });
+    };
+    SmoothingEngine projector(m);
+    projector.add_class(verts_of_type[REGULAR], nullptr, [&](const uint, const vec3d & p) { return o_srf.closest_point(p);    });
+    projector.add_class(verts_of_type[FEATURE], nullptr, [&](const uint, const vec3d & p) { return o_line.closest_point(p);   });
+    projector.add_class(verts_of_type[CORNER],  nullptr, [&](const uint, const vec3d & p) { return o_corner.closest_point(p); });
+
     std::vector<Entry>  entries; // coeff matrix
     std::vector<double> w;       // weights matrix
     std::vector<double> rhs;     // right hand side
@@ -123,11 +155,9 @@ void mesh_smoother(      AbstractPolygonMesh<M1,V1,E1,P1> & m,
     // where <n,d> is the plane tangent to the mesh at v_i
     auto tangent_space = [&](const uint vid)
     {
-        vec3d  p;
-        double dist;
-        uint   pid;
-        o_srf.closest_point(m.vert(vid), pid, p, dist);
-        vec3d n = target.poly_data(pid).normal;
+        const vec3d  & p    = proj.at(vid).p;
+        const double & dist = proj.at(vid).dist;
+        vec3d n = target.poly_data(proj.at(vid).id).normal;
 
         // reduces energy for mapping to distant points
         // because they are likely to be wrong assignments
@@ -152,11 +182,8 @@ void mesh_smoother(      AbstractPolygonMesh<M1,V1,E1,P1> & m,
     // parameterized by the extra varaible t
     auto tangent_line = [&](const uint vid)
     {
-        vec3d  p;
-        double dist;
-        uint   eid;
-        o_line.closest_point(m.vert(vid), eid, p, dist);
-        vec3d dir = target.edge_vec(eid,true);
+        const vec3d & p = proj.at(vid).p;
+        vec3d dir = target.edge_vec(proj.at(vid).id,true);
 
         uint  nv    = m.num_verts();
         uint  col_x = vid;
@@ -193,10 +220,8 @@ void mesh_smoother(      AbstractPolygonMesh<M1,V1,E1,P1> & m,
     // where v_i* is the current position of v_i
     auto corner = [&](const uint vid)
     {
-        vec3d  p;
-        double dist;
-        uint   pid;
-        o_corner.closest_point(m.vert(vid), pid, p, dist);
+        const vec3d  & p    = proj.at(vid).p;
+        const double & dist = proj.at(vid).dist;
 
         // discards mappings to distant corners because they are likely to be wrong assignments
         // (e.g. if the feature networks of source and target meshes mismatch)
@@ -227,6 +252,7 @@ void mesh_smoother(      AbstractPolygonMesh<M1,V1,E1,P1> & m,
     for(uint i=0; i<opt.n_iters; ++i)
     {
         laplacian();
+        closest_points();
         for(uint vid=0; vid<m.num_verts(); ++vid)
         {
             switch(m.vert_data(vid).label)
@@ -246,24 +272,15 @@ void mesh_smoother(      AbstractPolygonMesh<M1,V1,E1,P1> & m,
         solve_weighted_least_squares(A, W, RHS, res);
 
         uint nv = m.num_verts();
-        for(uint vid=0; vid<nv; ++vid)
+        PARALLEL_FOR(0, nv, 1000, [&](const uint vid)
         {
-            vec3d p(res[vid], res[nv+vid], res[2*nv+vid]);
-
-            switch(m.vert_data(vid).label)
-            {
-                case REGULAR: m.vert(vid) = (opt.reproject_on_target) ? o_srf.closest_point(p)    : p; break;
-                case CORNER:  m.vert(vid) = (opt.reproject_on_target) ? o_corner.closest_point(p) : p; break;
-                case FEATURE:
-                {
-                    const auto & line = feature_data.at(vid);
-                    p += line.first * res[line.second];
-                    m.vert(vid) = (opt.reproject_on_target) ? o_line.closest_point(p) : p;
-                    break;
-                }
-                default: assert(false && "unknown vertex type");
-            }
+            m.vert(vid) = vec3d(res[vid], res[nv+vid], res[2*nv+vid]);
+        });
+        for(const auto & obj : feature_data)
+        {
+            m.vert(obj.first) += obj.second.first * res[obj.second.second];
         }
+        if(opt.reproject_on_target) projector.project(m.vector_verts());
 
         if(i<opt.n_iters)
         {
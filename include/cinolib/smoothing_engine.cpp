@@ -0,0 +1,154 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/smoothing_engine.h>
+#include <cinolib/parallel_for.h>
+
+namespace cinolib
+{
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+SmoothingEngine::SmoothingEngine(const AbstractMesh<M,V,E,P> & m, const int mode)
+: smooth_mode(mode)
+{
+    vert_class.resize(m.num_verts(), -1);
+
+    if(smooth_mode==SMOOTH_GAUSS_SEIDEL)
+    {
+        // greedy coloring, in order of vertex ID
+        uint n_colors = 0;
+        vert_color.resize(m.num_verts(), 0);
+        std::vector<int> used;
+        for(uint vid=0; vid<m.num_verts(); ++vid)
+        {
+            used.assign(n_colors+1, -1);
+            for(uint nbr : m.adj_v2v(vid))
+            {
+                if(nbr<vid) used.at(vert_color.at(nbr)) = int(vid);
+            }
+            uint c = 0;
+            while(used.at(c)==int(vid)) ++c;
+            vert_color.at(vid) = c;
+            n_colors = std::max(n_colors, c+1);
+        }
+        color_verts.resize(n_colors);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint SmoothingEngine::add_class(const std::vector<uint> & vids,
+                                const UpdateFunc        & update,
+                                const ProjFunc          & proj)
+{
+    int id = int(updates.size());
+    updates.push_back(update);
+    projs.push_back(proj);
+    for(uint vid : vids)
+    {
+        assert(vert_class.at(vid)==-1 && "vertex already assigned to a class");
+        vert_class.at(vid) = id;
+        active.push_back(vid);
+        if(smooth_mode==SMOOTH_GAUSS_SEIDEL) color_verts.at(vert_color.at(vid)).push_back(vid);
+    }
+    return uint(id);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void SmoothingEngine::smooth(std::vector<vec3d> & verts, const uint n_iters) const
+{
+    assert(verts.size()==vert_class.size());
+
+    if(smooth_mode==SMOOTH_JACOBI)
+    {
+        std::vector<vec3d> next = verts;
+        for(uint i=0; i<n_iters; ++i)
+        {
+            PARALLEL_FOR(0, uint(active.size()), 1000, [&](const uint j)
+            {
+                uint vid = active.at(j);
+                next.at(vid) = apply(vid, verts);
+            });
+            // non active vertices are the same in both buffers
+            verts.swap(next);
+        }
+    }
+    else
+    {
+        for(uint i=0; i<n_iters; ++i)
+        {
+            for(const auto & vids : color_verts)
+            {
+                PARALLEL_FOR(0, uint(vids.size()), 1000, [&](const uint j)
+                {
+                    uint vid = vids.at(j);
+                    verts.at(vid) = apply(vid, verts);
+                });
+            }
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void SmoothingEngine::project(std::vector<vec3d> & verts) const
+{
+    assert(verts.size()==vert_class.size());
+
+    PARALLEL_FOR(0, uint(active.size()), 1000, [&](const uint j)
+    {
+        uint vid = active.at(j);
+        const ProjFunc & proj = projs.at(vert_class.at(vid));
+        if(proj) verts.at(vid) = proj(vid, verts.at(vid));
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+vec3d SmoothingEngine::apply(const uint vid, const std::vector<vec3d> & verts) const
+{
+    int   c = vert_class.at(vid);
+    vec3d p = (updates.at(c)) ? updates.at(c)(vid, verts) : verts.at(vid);
+    if(projs.at(c)) p = projs.at(c)(vid, p);
+    return p;
+}
+
+}
@@ -0,0 +1,123 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_SMOOTHING_ENGINE_H
+#define CINO_SMOOTHING_ENGINE_H
+
+#include <functional>
+#include <cinolib/meshes/abstract_mesh.h>
+
+namespace cinolib
+{
+
+enum
+{
+    SMOOTH_JACOBI,       // double buffered: each vertex reads the positions computed at the previous iteration
+    SMOOTH_GAUSS_SEIDEL, // graph colored: colors are processed in sequence, vertices with the same color in parallel
+};
+
+/* Iterative vertex smoothing over a mesh. Vertices are grouped in classes
+ * (e.g. corners, feature lines, surface, interior), each class having its own
+ * update rule and (optionally) a projection onto a constraint, such as a target
+ * surface or a crease line. Vertices that do not belong to any class are never
+ * moved. The engine operates on an array of positions rather than on the mesh
+ * itself, so that it can be used to smooth either the actual mesh or a copy of
+ * its vertices.
+ *
+ * Results are bitwise identical across runs and regardless of the number of
+ * threads. In SMOOTH_JACOBI mode each vertex reads the positions of the previous
+ * iteration from a separate buffer. In SMOOTH_GAUSS_SEIDEL mode vertices are
+ * greedily colored such that adjacent vertices have different colors, and each
+ * vertex sees the positions already updated for the previous colors. This second
+ * mode typically converges faster, but requires update rules to only read the
+ * position of the vertex itself and of its one ring (adj_v2v).
+*/
+
+class SmoothingEngine
+{
+    public:
+
+        // new position of vertex vid, computed from the current positions in verts
+        typedef std::function<vec3d(const uint vid, const std::vector<vec3d> & verts)> UpdateFunc;
+
+        // projection of a new position of vertex vid onto its constraint
+        typedef std::function<vec3d(const uint vid, const vec3d & p)> ProjFunc;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        explicit SmoothingEngine(){}
+
+        template<class M, class V, class E, class P>
+        explicit SmoothingEngine(const AbstractMesh<M,V,E,P> & m, const int mode = SMOOTH_JACOBI);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // adds a class of vertices and returns its ID. An empty update rule leaves
+        // positions unchanged (and just applies the projection, if any)
+        uint add_class(const std::vector<uint> & vids,
+                       const UpdateFunc        & update,
+                       const ProjFunc          & proj = nullptr);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void smooth (std::vector<vec3d> & verts, const uint n_iters = 1) const; // update + projection
+        void project(std::vector<vec3d> & verts) const;                        // projection only
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        int  mode()        const { return smooth_mode; }
+        uint num_classes() const { return uint(updates.size()); }
+        uint num_colors()  const { return uint(color_verts.size()); }
+
+    protected:
+
+        int                            smooth_mode = SMOOTH_JACOBI;
+        std::vector<int>               vert_class;  // -1 for vertices that must not move
+        std::vector<uint>              vert_color;  // SMOOTH_GAUSS_SEIDEL only
+        std::vector<uint>              active;      // all the vertices that belong to some class
+        std::vector<std::vector<uint>> color_verts; // active vertices, grouped by color
+        std::vector<UpdateFunc>        updates;
+        std::vector<ProjFunc>          projs;
+
+        vec3d apply(const uint vid, const std::vector<vec3d> & verts) const;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "smoothing_engine.cpp"
+#endif
+
+#endif // CINO_SMOOTHING_ENGINE_H
@@ -0,0 +1,217 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/spectral_descriptors.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/sampling.h>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+#ifdef CINOLIB_USES_SPECTRA
+#include <cinolib/laplacian.h>
+#include <cinolib/vertex_mass.h>
+#include <cinolib/matrix_eigenfunctions.h>
+#endif
+
+namespace cinolib
+{
+
+CINO_INLINE
+SpectralDescriptors::SpectralDescriptors(const Eigen::VectorXd & mass,
+                                         const Eigen::VectorXd & eigenvalues,
+                                         const Eigen::MatrixXd & eigenvectors)
+    : mass(mass)
+    , evals(eigenvalues)
+    , evecs(eigenvectors)
+{
+    assert(evecs.rows()==mass.size());
+    assert(evecs.cols()==evals.size());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+#ifdef CINOLIB_USES_SPECTRA
+template<class M, class V, class E, class P>
+CINO_INLINE
+SpectralDescriptors::SpectralDescriptors(const AbstractMesh<M,V,E,P> & m, const uint n_eigs)
+{
+    uint nv = m.num_verts();
+    uint nf = std::min(n_eigs, (nv-1)/2); // Spectra needs 2*nf+1 <= nv
+
+    // the generalized problem -L phi = lambda M phi is made symmetric by the change of
+    // variable psi = M^1/2 phi, obtaining (-M^-1/2 L M^-1/2) psi = lambda psi
+    mass = mass_matrix(m).diagonal();
+    Eigen::VectorXd inv_sqrt_mass = mass.cwiseSqrt().cwiseInverse();
+    Eigen::SparseMatrix<double> S = -(inv_sqrt_mass.asDiagonal() * laplacian(m, COTANGENT) * inv_sqrt_mass.asDiagonal());
+
+    std::vector<double> f, f_min, f_max;
+    bool ok = matrix_eigenfunctions(S, true, int(nf), f, f_min, f_max);
+    assert(ok && "eigendecomposition failed");
+    if(!ok) nf = 0;
+
+    // eigenvalues are retrieved from the (unit length) eigenvectors as Rayleigh quotients
+    Eigen::Map<Eigen::MatrixXd> psi(f.data(), nv, nf);
+    Eigen::VectorXd lambda = (psi.transpose() * S * psi).diagonal();
+
+    std::vector<uint> order(nf);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](const uint i, const uint j) { return lambda[i] < lambda[j]; });
+
+    evals.resize(nf);
+    evecs.resize(nv,nf);
+    for(uint i=0; i<nf; ++i)
+    {
+        evals[i]     = std::max(0.0, lambda[order[i]]); // clamp numerical noise around zero
+        evecs.col(i) = inv_sqrt_mass.asDiagonal() * psi.col(order[i]);
+    }
+}
+#endif
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Eigen::MatrixXd SpectralDescriptors::filters(const std::vector<double> & timesteps, const bool backward_euler) const
+{
+    Eigen::MatrixXd K(evals.size(), timesteps.size());
+    for(uint i=0; i<timesteps.size(); ++i)
+    {
+        double t = timesteps.at(i);
+        if(backward_euler) K.col(i) = (1.0 + t*evals.array()).inverse();
+        else               K.col(i) = (-t*evals.array()).exp();
+    }
+    return K;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Eigen::MatrixXd SpectralDescriptors::heat_diffusion(const std::vector<uint>   & landmarks,
+                                                    const std::vector<double> & timesteps,
+                                                    const bool                  backward_euler,
+                                                    const bool                  normalize_columns) const
+{
+    uint nl = landmarks.size();
+    Eigen::MatrixXd K = filters(timesteps, backward_euler);
+    Eigen::MatrixXd A(evecs.rows(), nl*timesteps.size());
+
+    // coefficients of the delta function at each landmark: phi_i(v)
+    Eigen::MatrixXd C(evals.size(), nl);
+    for(uint j=0; j<nl; ++j) C.col(j) = evecs.row(landmarks.at(j)).transpose();
+
+    PARALLEL_FOR(0, timesteps.size(), 1, [&](const uint i)
+    {
+        A.middleCols(i*nl, nl) = evecs * (K.col(i).asDiagonal() * C);
+        if(normalize_columns) // Useful for visualization but "physically wrong"...
+        {
+            for(uint j=0; j<nl; ++j)
+            {
+                auto   col = A.col(i*nl+j);
+                double min = col.minCoeff();
+                double max = col.maxCoeff();
+                if(max-min>0) col = (col.array()-min)/(max-min);
+            }
+        }
+    });
+    return A;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Eigen::MatrixXd SpectralDescriptors::HKS(const std::vector<double> & timesteps) const
+{
+    Eigen::MatrixXd K    = filters(timesteps, false);
+    Eigen::MatrixXd phi2 = evecs.cwiseAbs2();
+    Eigen::MatrixXd D(evecs.rows(), timesteps.size());
+    PARALLEL_FOR(0, timesteps.size(), 1, [&](const uint i)
+    {
+        D.col(i) = phi2 * K.col(i);
+    });
+    return D;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Eigen::MatrixXd SpectralDescriptors::WKS(const uint n_energies, const double variance) const
+{
+    assert(evals.size()>=2 && n_energies>=2);
+
+    // This follows the reference implementation of Aubry et al.
+    // (the first eigenvalue is zero and is therefore excluded)
+    Eigen::VectorXd log_E = evals.array().abs().max(1e-6).log();
+    std::vector<double> e = sample_within_interval(log_E[1], log_E.maxCoeff()/1.02, n_energies);
+    double sigma = (e.at(1)-e.at(0))*variance;
+
+    Eigen::MatrixXd phi2 = evecs.cwiseAbs2();
+    Eigen::MatrixXd D(evecs.rows(), n_energies);
+    PARALLEL_FOR(0, n_energies, 1, [&](const uint i)
+    {
+        Eigen::VectorXd w = (-(e.at(i)-log_E.array()).square()/(2.0*sigma*sigma)).exp();
+        w[0] = 0;
+        D.col(i) = phi2 * w / w.sum();
+    });
+    return D;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double SpectralDescriptors::truncation_error(const double t, const bool backward_euler) const
+{
+    // The discarded part of the spectrum is estimated with Weyl's law, assuming that
+    // the eigenvalues grow linearly with their index, up to the number of vertices
+    uint k = evals.size();
+    uint n = mass.size();
+    if(k==0) return 1.0;
+    if(k>=n) return 0.0;
+
+    auto filter = [&](const double lambda)
+    {
+        return backward_euler ? 1.0/(1.0 + t*lambda) : std::exp(-t*lambda);
+    };
+
+    double kept = 0;
+    for(uint i=0; i<k; ++i) kept += std::pow(filter(evals[i]), 2);
+
+    double tail = 0;
+    double step = evals[k-1]/std::max(1u, k-1);
+    for(uint i=k; i<n; ++i) tail += std::pow(filter(step*i), 2);
+
+    return std::sqrt(tail/(tail+kept));
+}
+
+}
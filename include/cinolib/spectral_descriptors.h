@@ -0,0 +1,131 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2026: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_SPECTRAL_DESCRIPTORS_H
+#define CINO_SPECTRAL_DESCRIPTORS_H
+
+#include <cinolib/meshes/abstract_mesh.h>
+#include <Eigen/Dense>
+
+namespace cinolib
+{
+
+/* Evaluates spectral shape descriptors from a (truncated) eigenbasis of the Laplace-
+ * Beltrami operator, that is from the first k solutions of the generalized problem
+ *
+ *     -L phi_i = lambda_i M phi_i,   with phi_i^T M phi_j = delta_ij
+ *
+ * where L is the cotangent Laplacian and M the (diagonal) mass matrix. The basis is
+ * computed only once. All the descriptors below are then obtained for any number
+ * of timesteps (or energies) with dense products between the basis and a k x #t
+ * matrix of spectral filters, evaluated in parallel across timesteps.
+ *
+ * Filters that decay slowly with lambda (e.g. the backward Euler step used by HKS(),
+ * which decays only as 1/lambda) need many eigenfunctions to be accurate. The method
+ * truncation_error() gives an estimate of the weight of the discarded part of the
+ * spectrum. In case it is too high, use HKS_krylov() (HKS.h), which computes the
+ * same diffusion without any eigendecomposition.
+ *
+ * References:
+ *
+ *     J. Sun, M. Ovsjanikov, L. Guibas
+ *     A Concise and Provably Informative Multi-Scale Signature Based on Heat Diffusion
+ *     Computer Graphics Forum (SGP), 2009
+ *
+ *     M. Aubry, U. Schlickewei, D. Cremers
+ *     The Wave Kernel Signature: A Quantum Mechanical Approach to Shape Analysis
+ *     ICCV Workshops, 2011
+*/
+
+class SpectralDescriptors
+{
+    public:
+
+        // eigenvalues sorted in ascending order, one eigenvector per column (M-orthonormal)
+        SpectralDescriptors(const Eigen::VectorXd & mass,
+                            const Eigen::VectorXd & eigenvalues,
+                            const Eigen::MatrixXd & eigenvectors);
+
+#ifdef CINOLIB_USES_SPECTRA
+        // computes the first n_eigs eigenfunctions of the cotangent Laplacian of m
+        template<class M, class V, class E, class P>
+        SpectralDescriptors(const AbstractMesh<M,V,E,P> & m, const uint n_eigs = 200);
+#endif
+
+        //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // Heat diffused from each landmark, one column for each (timestep,landmark) pair,
+        // with the same layout of HKS(). If backward_euler is true the result approximates
+        // the output of HKS(), i.e. (M - t*L)^-1 e_v. Otherwise the exact heat kernel
+        // exp(-t*lambda) is used
+        Eigen::MatrixXd heat_diffusion(const std::vector<uint>   & landmarks,
+                                       const std::vector<double> & timesteps,
+                                       const bool                  backward_euler    = true,
+                                       const bool                  normalize_columns = false) const;
+
+        // Heat Kernel Signature (Sun et al.), one row per vertex, one column per timestep
+        Eigen::MatrixXd HKS(const std::vector<double> & timesteps) const;
+
+        // Wave Kernel Signature (Aubry et al.), one row per vertex, one column per energy.
+        // Energies are uniformly sampled in the log spectrum, with the variance suggested
+        // by the authors
+        Eigen::MatrixXd WKS(const uint n_energies, const double variance = 7.0) const;
+
+        // relative weight of the discarded spectrum for timestep t (0 means exact)
+        double truncation_error(const double t, const bool backward_euler = true) const;
+
+        //:::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        const Eigen::VectorXd & eigenvalues()  const { return evals; }
+        const Eigen::MatrixXd & eigenvectors() const { return evecs; }
+              uint            num_eigs()     const { return uint(evals.size()); }
+
+    protected:
+
+        // evaluates the filter of all eigenvalues, for each timestep (one column per timestep)
+        Eigen::MatrixXd filters(const std::vector<double> & timesteps, const bool backward_euler) const;
+
+        Eigen::VectorXd mass;
+        Eigen::VectorXd evals;
+        Eigen::MatrixXd evecs;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "spectral_descriptors.cpp"
+#endif
+
+#endif // CINO_SPECTRAL_DESCRIPTORS_H
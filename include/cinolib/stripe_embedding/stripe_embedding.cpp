@@ -38,18 +38,20 @@
 #include <cinolib/split_separating_simplices.h>
 #include <cinolib/geometry/n_sided_poygon.h>
 #include <cinolib/how_many_seconds.h>
+#include <cinolib/parallel_for.h>
+#include <atomic>
+#include <thread>
 
 namespace cinolib
 {
 
-void embed_strip(SE_data & data, const std::vector<uint> & chain, const uint pivot)
+// bookkeeping for a stripe: flags the inner vertices of the chain as embedded,
+// labels the chain edges and records how each vertex will be positioned (see SE_source)
+void mark_strip(SE_data & data, const std::vector<uint> & chain, const uint pivot)
 {
     assert(data.embedded.at(chain.front()));
     assert(data.embedded.at(chain.back()));
 
-    double delta_x = data.coords_d[2*chain.front()  ] - data.coords_d[2*chain.back()  ];
-    double delta_y = data.coords_d[2*chain.front()+1] - data.coords_d[2*chain.back()+1];
-
     for(uint i=1; i<chain.size(); ++i)
     {
         int eid = data.m.edge_id(chain[i],chain[i-1]);
@@ -62,32 +64,62 @@ void embed_strip(SE_data & data, const std::vector<uint> & chain, const uint piv
         data.embedded.at(chain[i]) = true;
         data.embedded_verts++;
 
-        double t = (chain.size()-i-1)/double(chain.size());
-        data.coords_d.at(2*chain[i]  ) = data.coords_d[2*chain.back()  ] + t*delta_x;
-        data.coords_d.at(2*chain[i]+1) = data.coords_d[2*chain.back()+1] + t*delta_y;
+        SE_source & src = data.source.at(chain[i]);
+        src.front = chain.front();
+        src.back  = chain.back();
+        src.t     = (chain.size()-i-1)/double(chain.size());
+    }
+    ++data.fresh_id;
+
+    if(data.store_stripes) // just for visuals
+    {
+        data.stripes_offset.push_back(data.stripes.size());
+        data.stripes.push_back(pivot);
+        for(uint vid : chain) data.stripes.push_back(vid);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// computes the coordinates of the inner vertices of a chain already processed by mark_strip.
+// Stripes with disjoint supports write disjoint entries, hence they can be placed concurrently
+void place_strip(SE_data & data, const std::vector<uint> & chain)
+{
+    double delta_x = data.coords_d[2*chain.front()  ] - data.coords_d[2*chain.back()  ];
+    double delta_y = data.coords_d[2*chain.front()+1] - data.coords_d[2*chain.back()+1];
+
+    for(uint i=1; i+1<chain.size(); ++i)
+    {
+        const SE_source & src = data.source.at(chain[i]);
+
+        data.coords_d.at(2*chain[i]  ) = data.coords_d[2*chain.back()  ] + src.t*delta_x;
+        data.coords_d.at(2*chain[i]+1) = data.coords_d[2*chain.back()+1] + src.t*delta_y;
+
+        if(data.escalate_precision) continue; // higher precision only where needed (see promote)
 
         if(data.use_rationals)
         {
-            CGAL_Q t = (chain.size()-i-1)/double(chain.size());
+            CGAL_Q t = src.t;
             data.coords_q.at(2*chain[i]  ) = data.coords_q[2*chain.front()  ]*t + data.coords_q[2*chain.back()  ]*(1-t);
             data.coords_q.at(2*chain[i]+1) = data.coords_q[2*chain.front()+1]*t + data.coords_q[2*chain.back()+1]*(1-t);
         }
 
         if(data.use_MPFR)
         {
-            mpfr::mpreal t = (chain.size()-i-1)/double(chain.size());
+            // explicit precision: the MPFR default precision is thread local
+            mpfr::mpreal t(src.t, data.MPFR_precision);
             data.coords_m.at(2*chain[i]  ) = data.coords_m[2*chain.front()  ]*t + data.coords_m[2*chain.back()  ]*(1-t);
             data.coords_m.at(2*chain[i]+1) = data.coords_m[2*chain.front()+1]*t + data.coords_m[2*chain.back()+1]*(1-t);
         }
     }
-    ++data.fresh_id;
+}
 
-    if(data.store_stripes) // just for visuals
-    {
-        data.stripes_offset.push_back(data.stripes.size());
-        data.stripes.push_back(pivot);
-        for(uint vid : chain) data.stripes.push_back(vid);
-    }
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+void embed_strip(SE_data & data, const std::vector<uint> & chain, const uint pivot)
+{
+    mark_strip(data,chain,pivot);
+    place_strip(data,chain);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -127,9 +159,13 @@ void init(SE_data & data)
     data.edge_chain_id.resize(data.m.num_edges(),-1);
     data.m.vert_order_all_one_rings();
 
+    data.source.resize(data.m.num_verts());
     data.coords_d.resize(data.m.num_verts()*2,0);
-    if(data.use_rationals) data.coords_q.resize(data.m.num_verts()*2,0);
-    if(data.use_MPFR)      data.coords_m.resize(data.m.num_verts()*2,0);
+    if(!data.escalate_precision)
+    {
+        if(data.use_rationals) data.coords_q.resize(data.m.num_verts()*2,0);
+        if(data.use_MPFR)      data.coords_m.resize(data.m.num_verts()*2,0);
+    }
 
     // if there are no boundary conditions, map to the polygon prescribed in data.target_domain
     data.boundary = data.m.get_ordered_boundary_vertices();
@@ -148,6 +184,9 @@ void init(SE_data & data)
         data.embedded_verts++;
         data.coords_d.at(2*vid  ) = pos.x();
         data.coords_d.at(2*vid+1) = pos.y();
+        data.source.at(vid) = { vid, vid, 1.0 };
+
+        if(data.escalate_precision) continue;
 
         if(data.use_rationals)
         {
@@ -239,6 +278,120 @@ bool expand_strips_around_pivot(SE_data & data, const uint pivot)
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// collects up to max_stripes stripes with disjoint supports (pivot + chain) from the queue,
+// and places them at once. Pivots that cannot expand now, or whose support overlaps with a
+// stripe already in the batch, are pushed back in the queue after the batch has been placed.
+// Chains are all computed w.r.t. the same embedding state, but since their supports are
+// disjoint each of them remains valid after the other stripes in the batch are embedded
+uint expand_strips_in_batch(SE_data & data, std::vector<bool> & busy, const uint max_stripes)
+{
+    std::vector<uint> pivots, deferred;
+    std::vector<std::vector<uint>> chains;
+    while(!data.q.empty() && chains.size()<max_stripes)
+    {
+        uint vid = data.q.front();
+        data.q.pop();
+        ++data.iters;
+
+        std::vector<uint> chain = make_chain(data,vid);
+        if(chain.empty()) continue;
+
+        bool ok = !busy.at(vid) && colinearity_test_passed(data,chain);
+        for(uint i=0; ok && i<chain.size(); ++i) ok = !busy.at(chain[i]);
+        if(!ok)
+        {
+            deferred.push_back(vid);
+            continue;
+        }
+
+        busy.at(vid) = true;
+        for(uint v : chain) busy.at(v) = true;
+        pivots.push_back(vid);
+        chains.push_back(chain);
+    }
+
+    for(uint i=0; i<chains.size(); ++i) mark_strip(data, chains.at(i), pivots.at(i));
+
+    // computing coordinates with doubles is way too cheap to be worth spawning threads
+    bool exact = !data.escalate_precision && (data.use_rationals || data.use_MPFR);
+    PARALLEL_FOR(0, chains.size(), (exact) ? 16 : 10000, [&](int i)
+    {
+        place_strip(data, chains.at(i));
+    });
+
+    for(uint i=0; i<chains.size(); ++i)
+    {
+        busy.at(pivots.at(i)) = false;
+        for(uint vid : chains.at(i))
+        {
+            busy.at(vid) = false;
+            data.q.push(vid);
+        }
+        if(chain_starting_index(data,pivots.at(i))>=0) data.q.push(pivots.at(i));
+    }
+    for(uint vid : deferred) data.q.push(vid);
+
+    return chains.size();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// computes rational/MPFR coordinates for vid, and for all the (not yet promoted) vertices
+// it depends upon, i.e. the endpoints of its chain, the endpoints of their chains, and so on
+void promote(SE_data & data, const uint vid)
+{
+    std::vector<uint> stack = { vid };
+    while(!stack.empty())
+    {
+        uint v = stack.back();
+        if(data.promoted.at(v))
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        const SE_source & src = data.source.at(v);
+        if(src.front==v) // boundary condition (exactly represented by doubles)
+        {
+            if(data.use_rationals)
+            {
+                data.coords_q.at(2*v  ) = data.coords_d.at(2*v  );
+                data.coords_q.at(2*v+1) = data.coords_d.at(2*v+1);
+            }
+            if(data.use_MPFR)
+            {
+                data.coords_m.at(2*v  ) = mpfr::mpreal(data.coords_d.at(2*v  ), data.MPFR_precision);
+                data.coords_m.at(2*v+1) = mpfr::mpreal(data.coords_d.at(2*v+1), data.MPFR_precision);
+            }
+        }
+        else
+        {
+            bool ready = true;
+            if(!data.promoted.at(src.front)) { stack.push_back(src.front); ready = false; }
+            if(!data.promoted.at(src.back )) { stack.push_back(src.back ); ready = false; }
+            if(!ready) continue;
+
+            if(data.use_rationals)
+            {
+                CGAL_Q t = src.t;
+                data.coords_q.at(2*v  ) = data.coords_q[2*src.front  ]*t + data.coords_q[2*src.back  ]*(1-t);
+                data.coords_q.at(2*v+1) = data.coords_q[2*src.front+1]*t + data.coords_q[2*src.back+1]*(1-t);
+            }
+            if(data.use_MPFR)
+            {
+                mpfr::mpreal t(src.t, data.MPFR_precision);
+                data.coords_m.at(2*v  ) = data.coords_m[2*src.front  ]*t + data.coords_m[2*src.back  ]*(1-t);
+                data.coords_m.at(2*v+1) = data.coords_m[2*src.front+1]*t + data.coords_m[2*src.back+1]*(1-t);
+            }
+        }
+        data.promoted.at(v) = true;
+        data.promotions++;
+        stack.pop_back();
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 CINO_INLINE
 void stripe_embedding(SE_data & data)
 {
@@ -247,27 +400,77 @@ void stripe_embedding(SE_data & data)
     if(!data.initialized) init(data);
 
     uint count = 0;
-    while(!data.q.empty())
+    if(data.batch_size<=1)
     {
-        uint vid = data.q.front();
-        data.q.pop();
-        if(expand_strips_around_pivot(data,vid)) ++count;
-        ++data.iters;        
-        if(chain_starting_index(data,vid)>=0) data.q.push(vid);
-        if(data.stop || (data.step_by_step && count==data.step_size)) break;
+        while(!data.q.empty())
+        {
+            uint vid = data.q.front();
+            data.q.pop();
+            if(expand_strips_around_pivot(data,vid)) ++count;
+            ++data.iters;
+            if(chain_starting_index(data,vid)>=0) data.q.push(vid);
+            if(data.stop || (data.step_by_step && count==data.step_size)) break;
+        }
+    }
+    else
+    {
+        std::vector<bool> busy(data.m.num_verts(),false);
+        while(!data.q.empty())
+        {
+            uint max_stripes = data.batch_size;
+            if(data.step_by_step) max_stripes = std::min(max_stripes, uint(data.step_size)-count);
+            count += expand_strips_in_batch(data, busy, max_stripes);
+            if(data.stop || (data.step_by_step && count>=uint(data.step_size))) break;
+        }
     }
 
     if(data.embedded_verts==data.m.num_verts())
     {
         data.converged = true;
-        for(uint pid=0; pid<data.m.num_polys(); ++pid)
+        if(!data.escalate_precision)
+        {
+            for(uint pid=0; pid<data.m.num_polys(); ++pid)
+            {
+                uint v0 = data.m.poly_vert_id(pid,0);
+                uint v1 = data.m.poly_vert_id(pid,1);
+                uint v2 = data.m.poly_vert_id(pid,2);
+                if(                      flipped_d(data,v0,v1,v2)) data.flips_d++;
+                if(data.use_rationals && flipped_q(data,v0,v1,v2)) data.flips_q++;
+                if(data.use_MPFR      && flipped_m(data,v0,v1,v2)) data.flips_m++;
+            }
+        }
+        else
         {
-            uint v0 = data.m.poly_vert_id(pid,0);
-            uint v1 = data.m.poly_vert_id(pid,1);
-            uint v2 = data.m.poly_vert_id(pid,2);
-            if(                      flipped_d(data,v0,v1,v2)) data.flips_d++;
-            if(data.use_rationals && flipped_q(data,v0,v1,v2)) data.flips_q++;
-            if(data.use_MPFR      && flipped_m(data,v0,v1,v2)) data.flips_m++;
+            // with exact arithmetic SE is guaranteed to produce no flips, hence elements that
+            // are valid with doubles are deemed valid. Higher precision coordinates are computed
+            // only for the (few) elements that flipped with doubles
+            std::vector<uint> flipped;
+            for(uint pid=0; pid<data.m.num_polys(); ++pid)
+            {
+                if(flipped_d(data, data.m.poly_vert_id(pid,0),
+                                   data.m.poly_vert_id(pid,1),
+                                   data.m.poly_vert_id(pid,2))) flipped.push_back(pid);
+            }
+            data.flips_d = flipped.size();
+
+            if(!flipped.empty() && (data.use_rationals || data.use_MPFR))
+            {
+                data.promoted.resize(data.m.num_verts(),false);
+                if(data.use_rationals) data.coords_q.resize(data.m.num_verts()*2,0);
+                if(data.use_MPFR)      data.coords_m.resize(data.m.num_verts()*2,mpfr::mpreal(0,data.MPFR_precision));
+            }
+            for(uint pid : flipped)
+            {
+                if(!data.use_rationals && !data.use_MPFR) break;
+                uint v0 = data.m.poly_vert_id(pid,0);
+                uint v1 = data.m.poly_vert_id(pid,1);
+                uint v2 = data.m.poly_vert_id(pid,2);
+                promote(data,v0);
+                promote(data,v1);
+                promote(data,v2);
+                if(data.use_rationals && flipped_q(data,v0,v1,v2)) data.flips_q++;
+                if(data.use_MPFR      && flipped_m(data,v0,v1,v2)) data.flips_m++;
+            }
         }
     }
 
@@ -275,4 +478,24 @@ void stripe_embedding(SE_data & data)
     data.runtime = how_many_seconds(tic,toc);
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void stripe_embedding(std::vector<SE_data> & charts)
+{
+    // charts may have very different sizes, hence they are dynamically
+    // assigned to the threads, rather than in fixed sub ranges as in PARALLEL_FOR
+    std::atomic<uint> next(0);
+    auto worker = [&]()
+    {
+        for(uint i=next++; i<charts.size(); i=next++) stripe_embedding(charts.at(i));
+    };
+
+    uint n_threads = std::max(1u, std::thread::hardware_concurrency());
+    n_threads = std::min(n_threads, uint(charts.size()));
+    std::vector<std::thread> pool;
+    for(uint i=0; i<n_threads; ++i) pool.emplace_back(worker);
+    for(std::thread & t : pool) t.join();
+}
+
 }
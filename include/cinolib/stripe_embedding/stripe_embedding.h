@@ -59,11 +59,27 @@ namespace cinolib
  *
  * For interactive use, call init(data) first and then call stripe_embedding(data).
  * See the dedicated example (#48) in cinolib/examples.
+ *
+ * For batch processing of many charts, set batch_size>1 to place independent stripes
+ * concurrently, and escalate_precision=true to evaluate rationals/MPFR only for the
+ * vertices involved in a flip, rather than carrying exact coordinates for the whole mesh.
 */
 
+typedef MaybeDrawableTrimesh<> SE_mesh;
+
+// each embedded vertex is a convex combination of the endpoints of the chain it belongs to:
+// pos = t*front + (1-t)*back. Boundary vertices have front==back==vid.
+// This is all that is needed to recompute its coordinates with a different numeric model
+struct SE_source
+{
+    uint   front;
+    uint   back;
+    double t;
+};
+
 struct SE_data
 {
-    DrawableTrimesh<> m; // input mesh (may be refined during map generation)
+    SE_mesh m; // input mesh (may be refined during map generation)
 
     // If provided, SE will use the input boundary conditions.
     // Otherwise, it will generate a map to the polygon indicated in target_domain
@@ -77,6 +93,17 @@ struct SE_data
 
     mpfr_prec_t MPFR_precision = 512; // # of bits for the mantissa when MPFR is used
 
+    // if true, the embedding is computed with doubles only, and rationals/MPFR (if enabled)
+    // are evaluated only for the vertices of the elements that flipped with doubles, and for
+    // the vertices they depend upon. Higher precision coords are valid only where promoted is true
+    bool escalate_precision = false;
+    std::vector<SE_source> source;   // how each vertex was embedded
+    std::vector<bool>      promoted; // true if coords_q/coords_m are valid for a vertex
+
+    // max number of stripes with disjoint supports placed at once. Vertex coordinates
+    // of the stripes in a batch are computed in parallel (1 => serial expansion)
+    uint batch_size = 1;
+
     // embeddings with the various numerical models
     std::vector<double>       coords_d;
     std::vector<CGAL_Q>       coords_q;
@@ -109,6 +136,7 @@ struct SE_data
     bool  converged   = false;
     uint  edge_splits = 0;
     uint  iters       = 0;
+    uint  promotions  = 0; // # of vertices promoted to rationals/MPFR (escalate_precision only)
 };
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -116,6 +144,13 @@ struct SE_data
 CINO_INLINE
 void stripe_embedding(SE_data & data);
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// maps a batch of charts. Charts are processed in parallel (one thread per chart),
+// hence stripes within each chart are better placed serially (batch_size=1)
+CINO_INLINE
+void stripe_embedding(std::vector<SE_data> & charts);
+
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/vertex_mass.h>
+#include <cinolib/parallel_for.h>
 
 namespace cinolib
 {
@@ -42,26 +43,45 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 Eigen::SparseMatrix<double> mass_matrix(const AbstractMesh<M,V,E,P> & m, const int n)
 {
-    typedef Eigen::Triplet<double> Entry;
+    MassMatrixCache cache;
+    mass_matrix(m, cache, n);
+    return std::move(cache.MM);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+const Eigen::SparseMatrix<double> & mass_matrix(const AbstractMesh<M,V,E,P> & m,
+                                                      MassMatrixCache       & cache,
+                                                const int                     n)
+{
     uint nv = m.num_verts();
-    std::vector<uint> base(n);
-    for(int i=0; i<n; ++i) base[i] = nv*i;
 
-    std::vector<Entry>  entries;
-    for(uint vid=0; vid<m.num_verts(); ++vid)
+    if(cache.nv!=nv || cache.n!=n) // (re)build the (diagonal) sparsity pattern
     {
-        double mass = m.vert_mass(vid);
-        for(int i=0; i<n; ++i) entries.push_back(Entry(base[i] + vid, base[i] + vid, mass));
+        std::vector<int>    outer(n*nv+1);
+        std::vector<int>    inner(n*nv);
+        std::vector<double> vals (n*nv, 0.0);
+        for(uint i=0; i<n*nv; ++i)
+        {
+            outer[i] = int(i);
+            inner[i] = int(i);
+        }
+        outer[n*nv] = int(n*nv);
+        cache.MM = Eigen::Map<const Eigen::SparseMatrix<double>>(n*nv, n*nv, n*nv, outer.data(), inner.data(), vals.data());
+        cache.nv = nv;
+        cache.n  = n;
     }
 
-    nv = n*m.num_verts();
-    Eigen::SparseMatrix<double> MM(nv, nv);
-    MM.setFromTriplets(entries.begin(), entries.end());
+    double *vals = cache.MM.valuePtr();
+    PARALLEL_FOR(0, nv, 1000, [&](const uint vid)
+    {
+        double mass = m.vert_mass(vid);
+        for(int i=0; i<n; ++i) vals[i*nv + vid] = mass;
+    });
 
-    return MM;
+    return cache.MM;
 }
 
-
 }
-
@@ -52,6 +52,26 @@ Eigen::SparseMatrix<double> mass_matrix(const AbstractMesh<M,V,E,P> & m,
                                                           //          | 0 M |   | 0 M 0 |
                                                           //                    | 0 0 M |
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Mass matrix assembly with cached sparsity pattern (see LaplacianCache in
+ * laplacian.h). After the first call, only the diagonal is refilled, in parallel
+*/
+struct MassMatrixCache
+{
+    Eigen::SparseMatrix<double> MM;
+    uint                        nv = 0;
+    int                         n  = 0;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+const Eigen::SparseMatrix<double> & mass_matrix(const AbstractMesh<M,V,E,P> & m,
+                                                      MassMatrixCache       & cache,
+                                                const int                     n = 1);
+
 }
 
 #ifndef  CINO_STATIC_LIB
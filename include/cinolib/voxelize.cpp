@@ -36,7 +36,10 @@
 #include <cinolib/voxelize.h>
 #include <cinolib/serialize_index.h>
 #include <cinolib/parallel_for.h>
+#include <cinolib/standard_elements_tables.h>
+#include <cinolib/min_max_inf.h>
 #include <mutex>
+#include <algorithm>
 
 namespace cinolib
 {
@@ -179,5 +182,206 @@ void voxelize(const std::function<double(const vec3d & p)> & f,
     });
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class F>
+CINO_INLINE
+void voxelize_cached(const F                   & f,
+                     const AABB                & volume,
+                     const uint                  max_voxels_per_side,
+                           VoxelGrid           & g,
+                           std::vector<double> & corner_vals)
+{
+    // determine grid size across all dimensions
+    g.bbox = volume;
+    g.len = g.bbox.delta().max_entry() / max_voxels_per_side;
+    g.dim[0] = int(ceil(g.bbox.delta_x()/g.len));
+    g.dim[1] = int(ceil(g.bbox.delta_y()/g.len));
+    g.dim[2] = int(ceil(g.bbox.delta_z()/g.len));
+
+    // sample f once at each lattice point. Corners are
+    // indexed as in voxel_corner_index, with (dim+1) points per side
+    uint n_corners = (g.dim[0]+1)*(g.dim[1]+1)*(g.dim[2]+1);
+    corner_vals.resize(n_corners);
+    PARALLEL_FOR(0, n_corners, 10000, [&](uint index)
+    {
+        vec3u ijk = deserialize_3D_index(index,g.dim[1]+1,g.dim[2]+1);
+        corner_vals[index] = f(voxel_corner_xyz(g,ijk.ptr(),0));
+    });
+
+    // flag voxels depending on how function f evaluates at the voxel corners
+    uint size = g.dim[0]*g.dim[1]*g.dim[2];
+    g.voxels = new int[size];
+    PARALLEL_FOR(0, size, 100000, [&](uint index)
+    {
+        vec3u ijk = deserialize_3D_index(index,g.dim[1],g.dim[2]);
+        bool negative = false;
+        bool positive = false;
+        bool zero     = false;
+        for(uint off=0; off<8; ++off)
+        {
+            double fp = corner_vals[voxel_corner_index(g,ijk.ptr(),off)];
+            positive |= (fp>0);
+            negative |= (fp<0);
+            zero     |= (fp==0);
+        }
+        if( positive && !negative && !zero) g.voxels[index] = VOXEL_OUTSIDE; else
+        if(!positive &&  negative && !zero) g.voxels[index] = VOXEL_INSIDE;  else
+        g.voxels[index] = VOXEL_BOUNDARY;
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class F>
+CINO_INLINE
+void voxelize_cached(const F         & f,
+                     const AABB      & volume,
+                     const uint        max_voxels_per_side,
+                           VoxelGrid & g)
+{
+    std::vector<double> corner_vals;
+    voxelize_cached(f, volume, max_voxels_per_side, g, corner_vals);
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class F>
+CINO_INLINE
+void voxelize_adaptive(const F         & f,
+                       const AABB      & volume,
+                       const uint        max_voxels_per_side,
+                             VoxelGrid & g,
+                       const double      lipschitz)
+{
+    // determine grid size across all dimensions
+    g.bbox = volume;
+    g.len = g.bbox.delta().max_entry() / max_voxels_per_side;
+    g.dim[0] = int(ceil(g.bbox.delta_x()/g.len));
+    g.dim[1] = int(ceil(g.bbox.delta_y()/g.len));
+    g.dim[2] = int(ceil(g.bbox.delta_z()/g.len));
+
+    uint size = g.dim[0]*g.dim[1]*g.dim[2];
+    g.voxels = new int[size];
+
+    // lattice values are computed lazily, and only at block corners
+    uint lattice_dim[3] = { g.dim[0]+1, g.dim[1]+1, g.dim[2]+1 };
+    uint n_corners = lattice_dim[0]*lattice_dim[1]*lattice_dim[2];
+    std::vector<double> corner_vals(n_corners);
+    std::vector<bool>   corner_done(n_corners,false);
+
+    // a block spans voxels [ijk, ijk+size) along each axis, clamped to the grid
+    struct Block
+    {
+        uint ijk[3];
+        uint size;
+    };
+    auto block_corner = [&](const Block & b, const uint off)
+    {
+        vec3u c;
+        for(int i=0; i<3; ++i)
+        {
+            c[i] = std::min(b.ijk[i] + b.size*uint(REFERENCE_HEX_VERTS[off][i]), g.dim[i]);
+        }
+        return c;
+    };
+
+    // start from a single block containing the whole grid
+    uint root_size = 1;
+    while(root_size < std::max(g.dim[0],std::max(g.dim[1],g.dim[2]))) root_size *= 2;
+    std::vector<Block> blocks;
+    blocks.push_back({{0,0,0},root_size});
+
+    while(!blocks.empty())
+    {
+        // gather all the lattice points not yet evaluated...
+        std::vector<uint> todo;
+        todo.reserve(blocks.size()*8);
+        for(const Block & b : blocks)
+        {
+            for(uint off=0; off<8; ++off)
+            {
+                vec3u c = block_corner(b,off);
+                uint  index = serialize_3D_index(c[0],c[1],c[2],lattice_dim[1],lattice_dim[2]);
+                if(!corner_done[index]) todo.push_back(index);
+            }
+        }
+        std::sort(todo.begin(), todo.end());
+        todo.erase(std::unique(todo.begin(), todo.end()), todo.end());
+
+        // ...and evaluate them in one batch
+        PARALLEL_FOR(0, todo.size(), 1000, [&](uint i)
+        {
+            vec3u ijk = deserialize_3D_index(todo.at(i),lattice_dim[1],lattice_dim[2]);
+            corner_vals.at(todo.at(i)) = f(voxel_corner_xyz(g,ijk.ptr(),0));
+        });
+        for(uint index : todo) corner_done.at(index) = true;
+
+        // classify blocks. Blocks are disjoint, hence they can be filled in parallel
+        std::vector<char> split(blocks.size(),false); // not vector<bool>, as it is written concurrently
+        PARALLEL_FOR(0, blocks.size(), 1000, [&](uint bid)
+        {
+            const Block & b = blocks.at(bid);
+            bool   negative = false;
+            bool   positive = false;
+            bool   zero     = false;
+            double min_abs  = inf_double;
+            for(uint off=0; off<8; ++off)
+            {
+                vec3u  c  = block_corner(b,off);
+                double fp = corner_vals.at(serialize_3D_index(c[0],c[1],c[2],lattice_dim[1],lattice_dim[2]));
+                positive |= (fp>0);
+                negative |= (fp<0);
+                zero     |= (fp==0);
+                min_abs   = std::min(min_abs, std::fabs(fp));
+            }
+            vec3u  beg = block_corner(b,0);
+            vec3u  end = block_corner(b,6);
+            int    label;
+            if( positive && !negative && !zero) label = VOXEL_OUTSIDE; else
+            if(!positive &&  negative && !zero) label = VOXEL_INSIDE;  else
+            label = VOXEL_BOUNDARY;
+
+            if(b.size>1)
+            {
+                // no guarantee that the zero level set does not cross the block
+                vec3d  delta(end[0]-beg[0], end[1]-beg[1], end[2]-beg[2]);
+                double half_diag = 0.5 * g.len * delta.norm();
+                if(label==VOXEL_BOUNDARY || min_abs <= lipschitz*half_diag)
+                {
+                    split.at(bid) = true;
+                    return;
+                }
+            }
+
+            for(uint i=beg[0]; i<end[0]; ++i)
+            for(uint j=beg[1]; j<end[1]; ++j)
+            for(uint k=beg[2]; k<end[2]; ++k)
+            {
+                g.voxels[serialize_3D_index(i,j,k,g.dim[1],g.dim[2])] = label;
+            }
+        });
+
+        // move to the next level of the octree
+        std::vector<Block> children;
+        for(uint bid=0; bid<blocks.size(); ++bid)
+        {
+            if(!split.at(bid)) continue;
+            const Block & b = blocks.at(bid);
+            uint s = b.size/2;
+            for(uint off=0; off<8; ++off)
+            {
+                Block c = {{ b.ijk[0] + s*uint(REFERENCE_HEX_VERTS[off][0]),
+                             b.ijk[1] + s*uint(REFERENCE_HEX_VERTS[off][1]),
+                             b.ijk[2] + s*uint(REFERENCE_HEX_VERTS[off][2]) }, s};
+                if(c.ijk[0]<g.dim[0] && c.ijk[1]<g.dim[1] && c.ijk[2]<g.dim[2])
+                {
+                    children.push_back(c);
+                }
+            }
+        }
+        blocks.swap(children);
+    }
+}
+
+}
@@ -63,6 +63,50 @@ void voxelize(const std::function<double(const vec3d & p)> & f,
               const AABB                                   & volume,
               const uint                                     max_voxels_per_side,
                     VoxelGrid                              & g);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Same as above, but f is evaluated only once per grid corner (rather than
+// up to eight times), and the values are cached in a buffer with one entry
+// per lattice point, indexed as in voxel_corner_index. The function f can
+// be any callable object (lambda, functor,...) taking a vec3d and returning
+// a double. Being a template parameter, calls to f can be inlined.
+//
+template<class F>
+CINO_INLINE
+void voxelize_cached(const F                   & f,
+                     const AABB                & volume,
+                     const uint                  max_voxels_per_side,
+                           VoxelGrid           & g,
+                           std::vector<double> & corner_vals);
+
+template<class F>
+CINO_INLINE
+void voxelize_cached(const F         & f,
+                     const AABB      & volume,
+                     const uint        max_voxels_per_side,
+                           VoxelGrid & g);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Octree-adaptive variant of the analytic voxelizer. The grid is visited
+// top-down with blocks of 2^k x 2^k x 2^k voxels, and f is evaluated only
+// at the corners of the blocks met along the way (in one parallel batch per
+// octree level). A block is subdivided only if its corners have different
+// signs, or if the gradient bound does not exclude a zero crossing inside it,
+// that is, if min|f(corner)| <= lipschitz * half_diagonal. If lipschitz is an
+// upper bound of |grad(f)| (e.g. 1 for signed distance functions) the output
+// grid is identical to the one produced by the dense voxelizers above. Setting
+// lipschitz to zero only checks corner signs, which is faster but may miss
+// features smaller than the coarse blocks.
+//
+template<class F>
+CINO_INLINE
+void voxelize_adaptive(const F         & f,
+                       const AABB      & volume,
+                       const uint        max_voxels_per_side,
+                             VoxelGrid & g,
+                       const double      lipschitz = 1.0);
 }
 
 #ifndef  CINO_STATIC_LIB
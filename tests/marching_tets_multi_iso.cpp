@@ -0,0 +1,48 @@
+#include <cinolib/meshes/meshes.h>
+#include <cinolib/marching_tets.h>
+#include "test_utils.h"
+
+// Extracting many level sets at once must give the same meshes obtained with
+// one single isovalue call each, also when appending to non empty buffers
+
+int main()
+{
+    using namespace cinolib;
+
+    Tetmesh<> m(std::string(DATA_PATH "/sphere.mesh").c_str());
+    for(uint vid=0; vid<m.num_verts(); ++vid) m.vert_data(vid).uvw[0] = m.vert(vid).x();
+
+    double c = m.bbox().center().x();
+    double d = m.bbox().delta_x();
+    std::vector<double> isovalues = { c-0.3*d, c, c+0.1*d, c+0.4*d };
+
+    std::vector<std::vector<vec3d>> verts;
+    std::vector<std::vector<uint>>  tris;
+    std::vector<std::vector<vec3d>> norms;
+    marching_tets(m, isovalues, verts, tris, norms);
+    CINO_CHECK(verts.size()==isovalues.size());
+
+    for(uint i=0; i<isovalues.size(); ++i)
+    {
+        std::vector<vec3d> v, n;
+        std::vector<uint>  t;
+        marching_tets(m, isovalues.at(i), v, t, n);
+        CINO_CHECK(!t.empty());
+        CINO_CHECK(v==verts.at(i));
+        CINO_CHECK(t==tris.at(i));
+        CINO_CHECK(n==norms.at(i));
+    }
+
+    // a second extraction is appended to the first one
+    marching_tets(m, isovalues, verts, tris, norms);
+    for(uint i=0; i<isovalues.size(); ++i)
+    {
+        uint nv = uint(verts.at(i).size()/2);
+        uint nt = uint(tris.at(i).size()/2);
+        for(uint j=0; j<nt; ++j)
+        {
+            CINO_CHECK(tris.at(i).at(nt+j)==tris.at(i).at(j)+nv);
+        }
+    }
+    return EXIT_SUCCESS;
+}
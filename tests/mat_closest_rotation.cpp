@@ -0,0 +1,62 @@
+#include <cinolib/geometry/vec_mat.h>
+#include "test_utils.h"
+#include <random>
+
+// The dedicated 3x3 polar kernel (fixed number of Jacobi sweeps, no data dependent
+// branches) must return a proper rotation maximizing trace(R^T*m), and match the
+// generic SVD based closest_orthogonal_matrix wherever the solution is unique
+
+using namespace cinolib;
+
+double max_abs(const mat3d & m)
+{
+    double res = 0;
+    for(uint i=0; i<9; ++i) res = std::max(res, std::fabs(m[i]));
+    return res;
+}
+
+void check(const mat3d & m, const bool unique)
+{
+    mat3d R   = m.closest_rotation();
+    mat3d ref = m.closest_orthogonal_matrix(true);
+    CINO_CHECK(max_abs(R.transpose()*R - mat3d::DIAG(1)) < 1e-12);
+    CINO_CHECK(std::fabs(R.det()-1) < 1e-12);
+    double scale = std::max(1.0, max_abs(m));
+    CINO_CHECK((R.transpose()*m).trace() >= (ref.transpose()*m).trace() - 1e-12*scale);
+    if(unique) CINO_CHECK(max_abs(R-ref) < 1e-9);
+}
+
+int main()
+{
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> rnd(-1,1);
+    auto random_mat = [&]() { mat3d m; for(uint i=0; i<9; ++i) m[i] = rnd(rng); return m; };
+
+    for(uint i=0; i<10000; ++i)
+    {
+        // generic matrices (about half of them with negative determinant)
+        mat3d m = random_mat();
+        check(m, true);
+
+        // rank 2 and rank 1 matrices
+        mat3d a = random_mat(), b = random_mat();
+        mat3d P = mat3d::DIAG(1); P(2,2) = 0;
+        check(a*P*b, false);
+        P(1,1) = 0;
+        check(a*P*b, false);
+
+        // near rotations, as in the local step of ARAP
+        vec3d axis(rnd(rng),rnd(rng),rnd(rng));
+        axis.normalize();
+        mat3d Q = mat3d::ROT_3D(axis, 3*rnd(rng));
+        check(Q + random_mat()*1e-3, true);
+        check(Q*(1+rnd(rng)), true);
+    }
+
+    // degenerate inputs
+    check(mat3d::ZERO(),   false);
+    check(mat3d::DIAG(1),  true);
+    check(mat3d::DIAG(-1), false);
+
+    return EXIT_SUCCESS;
+}
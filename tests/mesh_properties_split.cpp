@@ -0,0 +1,54 @@
+#include <cinolib/meshes/meshes.h>
+#include "test_utils.h"
+
+// Polygons and polyhedra created by splits and collapses must inherit the
+// properties of the element they come from, exactly like their attributes
+
+template<class Mesh>
+void tag_polys(Mesh & m)
+{
+    std::vector<int> & part = m.template poly_add_property<int>("part", -1);
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    {
+        part.at(pid) = int(pid%7);
+        m.poly_data(pid).label = int(pid%7);
+    }
+}
+
+template<class Mesh>
+void check_polys(const Mesh & m)
+{
+    const std::vector<int> & part = m.template poly_property<int>("part");
+    CINO_CHECK(part.size()==m.num_polys());
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    {
+        CINO_CHECK(part.at(pid)==m.poly_data(pid).label);
+    }
+}
+
+int main()
+{
+    using namespace cinolib;
+
+    Trimesh<> tri(std::string(DATA_PATH "/sphere_coarse.obj").c_str());
+    tag_polys(tri);
+    tri.edge_split(0);
+    tri.poly_split(1);
+    tri.edge_collapse(2, 0.5, false);
+    check_polys(tri);
+
+    Tetmesh<> tet(std::string(DATA_PATH "/sphere.mesh").c_str());
+    tag_polys(tet);
+    tet.edge_split(0);
+    tet.face_split(1);
+    tet.poly_split(2);
+    tet.edge_collapse(3, 0.5, false, false);
+    check_polys(tet);
+
+    Polyhedralmesh<> poly(std::string(DATA_PATH "/eight_voronoi.hedra").c_str());
+    tag_polys(poly);
+    poly.edge_split(0, poly.edge_sample_at(0,0.5));
+    check_polys(poly);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,43 @@
+#include <cinolib/meshes/meshes.h>
+#include "test_utils.h"
+
+// Refreshing the faces incident to dirty verts must rebuild their
+// tessellation from scratch, and not append to the one already there
+
+template<class Mesh>
+void check_update_dirty(Mesh & m)
+{
+    std::vector<std::vector<uint>> tris(m.num_faces());
+    std::vector<double>            area(m.num_faces());
+    for(uint fid=0; fid<m.num_faces(); ++fid)
+    {
+        tris.at(fid) = m.face_tessellation(fid);
+        area.at(fid) = m.face_area(fid);
+    }
+
+    for(int i=0; i<2; ++i)
+    {
+        for(uint vid=0; vid<m.num_verts(); ++vid) m.vert_mark_dirty(vid);
+        m.update_dirty();
+        CINO_CHECK(!m.has_dirty_verts());
+
+        for(uint fid=0; fid<m.num_faces(); ++fid)
+        {
+            CINO_CHECK(m.face_tessellation(fid)==tris.at(fid));
+            CINO_CHECK(m.face_area(fid)==area.at(fid));
+        }
+    }
+}
+
+int main()
+{
+    using namespace cinolib;
+
+    Hexmesh<> hex(std::string(DATA_PATH "/rockerarm.mesh").c_str());
+    check_update_dirty(hex);
+
+    Polyhedralmesh<> poly(std::string(DATA_PATH "/eight_voronoi.hedra").c_str());
+    check_update_dirty(poly);
+
+    return EXIT_SUCCESS;
+}
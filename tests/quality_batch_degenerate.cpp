@@ -0,0 +1,60 @@
+#include <cinolib/meshes/meshes.h>
+#include <cinolib/quality_batch.h>
+#include <cmath>
+#include <limits>
+#include "test_utils.h"
+
+// A single degenerate element must not spoil the statistics of a metric
+
+int main()
+{
+    using namespace cinolib;
+
+    std::vector<vec3d> verts =
+    {
+        vec3d(0,0,0), vec3d(1,0,0), vec3d(1,1,0), vec3d(0,1,0),
+        vec3d(0,0,1), vec3d(1,0,1), vec3d(1,1,1), vec3d(0,1,1),
+        vec3d(2,0,0), vec3d(3,0,0), vec3d(3,1,0), vec3d(2,1,0),
+        vec3d(2,0,0), vec3d(3,0,0), vec3d(3,1,0), vec3d(2,1,0),
+    };
+    std::vector<uint> hexa =
+    {
+         0, 1, 2, 3, 4, 5, 6, 7, // unit cube
+         8, 9,10,11,12,13,14,15, // degenerate (zero height)
+    };
+    Hexmesh<> m(verts, hexa);
+    CINO_CHECK(m.num_polys()==2);
+
+    QualityReport r = hex_quality(m);
+    const QualityStats & oddy = r.summary(QUALITY_ODDY);
+    CINO_CHECK(!std::isfinite(r.per_elem(QUALITY_ODDY).at(1)));
+    CINO_CHECK(oddy.n_inf==1);
+    CINO_CHECK(std::isfinite(oddy.avg));
+    CINO_CHECK(std::fabs(oddy.avg - r.per_elem(QUALITY_ODDY).at(0)) < 1e-6);
+    CINO_CHECK(std::isfinite(oddy.h_max));
+
+    const QualityStats & sj = r.summary(QUALITY_SCALED_JACOBIAN);
+    CINO_CHECK(sj.n_inf==0);
+    CINO_CHECK(std::isfinite(sj.avg));
+
+    // NaNs must not reach min/max and the percentiles
+    std::vector<float> vals;
+    for(uint i=0; i<100; ++i)
+    {
+        vals.push_back(float(i));
+        if(i%10==0) vals.push_back(std::nanf(""));
+    }
+    vals.push_back(std::numeric_limits<float>::infinity());
+    QualityStats s = quality_stats(vals, 10);
+    CINO_CHECK(s.n_inf==11);
+    CINO_CHECK(s.min==0 && s.max==99);
+    CINO_CHECK(std::fabs(s.avg-49.5) < 1e-6);
+    CINO_CHECK(s.p1==1 && s.p5==5 && s.p50==50 && s.p95==94 && s.p99==98);
+    CINO_CHECK(s.histogram.front()==10 && s.histogram.back()==10+11);
+
+    s = quality_stats({ std::nanf(""), std::nanf("") }, 10);
+    CINO_CHECK(s.n_inf==2 && s.min==0 && s.max==0 && s.p50==0);
+    CINO_CHECK(s.histogram.back()==2);
+
+    return EXIT_SUCCESS;
+}
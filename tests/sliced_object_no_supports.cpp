@@ -0,0 +1,25 @@
+#include <cinolib/3d_printing/sliced_object.h>
+#include "test_utils.h"
+
+// A sliced object can be built from its slice contours alone. Supports are
+// optional, and ignored altogether if the thickening radius is not positive
+
+int main()
+{
+    using namespace cinolib;
+
+    // two square slices. Note that SlicedObj names "holes" the external
+    // contours and "polys" the internal ones (see read_CLI)
+    std::vector<std::vector<std::vector<vec3d>>> external(2), internal(2), hatches(2);
+    for(uint sid=0; sid<2; ++sid)
+    {
+        double z = 0.1*sid;
+        external.at(sid).push_back({vec3d(0,0,z), vec3d(1,0,z), vec3d(1,1,z), vec3d(0,1,z), vec3d(0,0,z)});
+    }
+
+    SlicedObj<> obj(internal, external, {}, hatches, 0);
+    CINO_CHECK(obj.num_slices()==2);
+    CINO_CHECK(obj.num_polys()>0);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,21 @@
+#ifndef CINO_TEST_UTILS_H
+#define CINO_TEST_UTILS_H
+
+#include <iostream>
+#include <cstdlib>
+
+// minimal check facility for the regression tests: on failure, print
+// the failing condition and its location, and exit with an error code
+#define CINO_CHECK(cond)                                                           \
+    do                                                                             \
+    {                                                                              \
+        if(!(cond))                                                                \
+        {                                                                          \
+            std::cerr << "CHECK FAILED : " << #cond << " (" << __FILE__ << ":"     \
+                      << __LINE__ << ")" << std::endl;                             \
+            exit(EXIT_FAILURE);                                                    \
+        }                                                                          \
+    }                                                                              \
+    while(false)
+
+#endif // CINO_TEST_UTILS_H
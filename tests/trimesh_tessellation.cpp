@@ -0,0 +1,40 @@
+#include <cinolib/meshes/meshes.h>
+#include "test_utils.h"
+
+// The triangles of a Trimesh are their own tessellation, but a Trimesh may
+// still contain non triangular polys (e.g. when loaded from a quad mesh), which
+// must be tessellated as in any other polygon mesh
+
+template<class Mesh>
+void check_tessellation(const Mesh & m)
+{
+    for(uint pid=0; pid<m.num_polys(); ++pid)
+    {
+        const std::vector<uint> & tris = m.poly_tessellation(pid);
+        CINO_CHECK(tris.size()==3*(m.adj_p2v(pid).size()-2)); // verts_per_poly is always 3 for a Trimesh
+        for(uint vid : tris) CINO_CHECK(m.poly_contains_vert(pid,vid));
+    }
+}
+
+int main()
+{
+    using namespace cinolib;
+
+    Trimesh<> tri(std::string(DATA_PATH "/sphere_coarse.obj").c_str());
+    check_tessellation(tri);
+    for(uint pid=0; pid<tri.num_polys(); ++pid)
+    {
+        CINO_CHECK(&tri.poly_tessellation(pid)==&tri.adj_p2v(pid));
+    }
+
+    Trimesh<>     quad_tri (std::string(DATA_PATH "/cubespikes.obj").c_str());
+    Polygonmesh<> quad_poly(std::string(DATA_PATH "/cubespikes.obj").c_str());
+    CINO_CHECK(quad_tri.num_polys()==quad_poly.num_polys());
+    check_tessellation(quad_tri);
+    for(uint pid=0; pid<quad_tri.num_polys(); ++pid)
+    {
+        CINO_CHECK(quad_tri.poly_tessellation(pid)==quad_poly.poly_tessellation(pid));
+    }
+
+    return EXIT_SUCCESS;
+}
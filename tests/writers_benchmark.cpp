@@ -0,0 +1,131 @@
+#include <cinolib/io/read_write.h>
+#include <cinolib/vector_serialization.h>
+#include <cinolib/standard_elements_tables.h>
+#include <cinolib/how_many_seconds.h>
+#include <chrono>
+#include <random>
+
+// Throughput of the mesh writers, compared with the plain fprintf writers they
+// replaced (reproduced below as a reference). Not a regression test: it is built
+// with the tests but not run by ctest. Usage: writers_benchmark [grid_size] [out_dir]
+
+using namespace cinolib;
+
+void legacy_write_OBJ(const char * filename, const std::vector<double> & xyz, const std::vector<std::vector<uint>> & poly)
+{
+    FILE *fp = fopen(filename, "w");
+    for(uint i=0; i<xyz.size(); i+=3) fprintf(fp, "v %.17g %.17g %.17g\n", xyz[i], xyz[i+1], xyz[i+2]);
+    for(auto p : poly)
+    {
+        fprintf(fp, "f ");
+        for(uint vid : p) fprintf(fp, "%d ", vid+1);
+        fprintf(fp, "\n");
+    }
+    fclose(fp);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+void legacy_write_MESH(const char * filename, const std::vector<vec3d> & verts, const std::vector<std::vector<uint>> & tets)
+{
+    FILE *fp = fopen(filename, "w");
+    fprintf(fp, "MeshVersionFormatted 1\nDimension 3\n");
+    fprintf(fp, "Vertices\n%d\n", uint(verts.size()));
+    for(const vec3d & p : verts) fprintf(fp, "%.17g %.17g %.17g %d\n", p.x(), p.y(), p.z(), 0);
+    fprintf(fp, "Tetrahedra\n%d\n", uint(tets.size()));
+    for(const auto & t : tets) fprintf(fp, "%d %d %d %d %d\n", t.at(0)+1, t.at(1)+1, t.at(2)+1, t.at(3)+1, 0);
+    fprintf(fp, "End\n");
+    fclose(fp);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+void legacy_write_STL(const char * filename, const std::vector<double> & xyz, const std::vector<std::vector<uint>> & tris, const std::vector<double> & normals)
+{
+    FILE *fp = fopen(filename, "w");
+    fprintf(fp, "solid cinolib_mesh\n");
+    for(uint pid=0; pid<tris.size(); ++pid)
+    {
+        fprintf(fp, "facet normal %f %f %f\n", normals.at(pid*3+0), normals.at(pid*3+1), normals.at(pid*3+2));
+        fprintf(fp, "  outer loop\n");
+        for(uint vid : tris.at(pid)) fprintf(fp, "    vertex %f %f %f\n", xyz.at(vid*3+0), xyz.at(vid*3+1), xyz.at(vid*3+2));
+        fprintf(fp, "  endloop\n");
+        fprintf(fp, "endfacet\n");
+    }
+    fprintf(fp, "endsolid cinolib_mesh\n");
+    fclose(fp);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename Func>
+void time_it(const std::string & name, Func f)
+{
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    f();
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    std::cout << name << "\t" << how_many_seconds(t0,t1) << "s" << std::endl;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+int main(int argc, char **argv)
+{
+    uint        n   = (argc>1) ? uint(atoi(argv[1])) : 40;
+    std::string dir = (argc>2) ? std::string(argv[2]) : std::string(".");
+
+    // jittered n^3 grid, each cell split into 6 tets (jittering gives full precision doubles)
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> jitter(-0.25,0.25);
+    std::vector<vec3d> verts;
+    for(uint i=0; i<=n; ++i)
+    for(uint j=0; j<=n; ++j)
+    for(uint k=0; k<=n; ++k)
+    {
+        verts.push_back(vec3d(i+jitter(rng), j+jitter(rng), k+jitter(rng)));
+    }
+    auto vid = [n](uint i, uint j, uint k) { return (i*(n+1)+j)*(n+1)+k; };
+    std::vector<std::vector<uint>> tets;
+    for(uint i=0; i<n; ++i)
+    for(uint j=0; j<n; ++j)
+    for(uint k=0; k<n; ++k)
+    {
+        uint c[8] = { vid(i,j,k  ), vid(i+1,j,k  ), vid(i+1,j+1,k  ), vid(i,j+1,k  ),
+                      vid(i,j,k+1), vid(i+1,j,k+1), vid(i+1,j+1,k+1), vid(i,j+1,k+1) };
+        tets.push_back({c[0],c[1],c[2],c[6]});
+        tets.push_back({c[0],c[2],c[3],c[6]});
+        tets.push_back({c[0],c[3],c[7],c[6]});
+        tets.push_back({c[0],c[7],c[4],c[6]});
+        tets.push_back({c[0],c[4],c[5],c[6]});
+        tets.push_back({c[0],c[5],c[1],c[6]});
+    }
+
+    // surface writers get the faces of all the tets
+    std::vector<std::vector<uint>> tris;
+    std::vector<double>            normals;
+    for(const auto & t : tets)
+    {
+        for(uint f=0; f<4; ++f)
+        {
+            tris.push_back({t.at(TET_FACES[f][0]), t.at(TET_FACES[f][1]), t.at(TET_FACES[f][2])});
+            vec3d nf = (verts.at(tris.back()[1])-verts.at(tris.back()[0])).cross(verts.at(tris.back()[2])-verts.at(tris.back()[0]));
+            nf.normalize();
+            normals.insert(normals.end(), {nf.x(), nf.y(), nf.z()});
+        }
+    }
+    std::vector<double> xyz = serialized_xyz_from_vec3d(verts);
+
+    std::cout << verts.size() << " verts, " << tets.size() << " tets, " << tris.size() << " tris" << std::endl;
+
+    time_it("OBJ (legacy)",         [&]{ legacy_write_OBJ ((dir + "/bench_legacy.obj" ).c_str(), xyz, tris);            });
+    time_it("OBJ",                  [&]{ write_OBJ        ((dir + "/bench.obj"        ).c_str(), xyz, tris);            });
+    time_it("MESH (legacy)",        [&]{ legacy_write_MESH((dir + "/bench_legacy.mesh").c_str(), verts, tets);          });
+    time_it("MESH",                 [&]{ write_MESH       ((dir + "/bench.mesh"       ).c_str(), verts, tets);          });
+    time_it("STL ascii (legacy)",   [&]{ legacy_write_STL ((dir + "/bench_legacy.stl" ).c_str(), xyz, tris, normals);   });
+    time_it("STL ascii",            [&]{ write_STL        ((dir + "/bench.stl"        ).c_str(), xyz, tris, normals);   });
+    time_it("STL binary",           [&]{ write_STL        ((dir + "/bench_bin.stl"    ).c_str(), xyz, tris, normals, true); });
+    time_it("VTU",                  [&]{ write_VTU        ((dir + "/bench.vtu"        ).c_str(), verts, tets);          });
+    time_it("VTK",                  [&]{ write_VTK        ((dir + "/bench.vtk"        ).c_str(), verts, tets);          });
+
+    return EXIT_SUCCESS;
+}